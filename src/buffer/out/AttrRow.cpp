@@ -4,15 +4,114 @@
 #include "precomp.h"
 #include "AttrRow.hpp"
 
+#include <til/heap_usage.h>
+
 // Routine Description:
 // - constructor
 // Arguments:
 // - cchRowWidth - the length of the default text attribute
 // - attr - the default text attribute
+// - table - the attribute table of the buffer this row belongs to
 // Return Value:
 // - constructed object
-ATTR_ROW::ATTR_ROW(const til::CoordType width, const TextAttribute attr) :
-    _data(gsl::narrow_cast<uint16_t>(width), attr) {}
+ATTR_ROW::ATTR_ROW(const til::CoordType width, const TextAttribute attr, TextAttributeTable& table) :
+    _data(gsl::narrow_cast<uint16_t>(width), table.Intern(attr)),
+    _table{ &table }
+{
+    _MarkChanged();
+}
+
+ATTR_ROW::~ATTR_ROW()
+{
+    _table->_Unregister(*this);
+}
+
+// Routine Description:
+// - Copies another row of the same attribute table.
+ATTR_ROW::ATTR_ROW(const ATTR_ROW& other) :
+    _data{ other._data },
+    _table{ other._table }
+{
+    _MarkChanged();
+}
+
+// Routine Description:
+// - Moves another row, including the ids it was counted for and its place in the list of dirty rows.
+ATTR_ROW::ATTR_ROW(ATTR_ROW&& other) noexcept :
+    _data{ std::move(other._data) },
+    _table{ other._table },
+    _counted{ std::move(other._counted) },
+    _dirtySlot{ std::exchange(other._dirtySlot, TextAttributeTable::NotDirty) }
+{
+    other._counted.clear();
+    if (_dirtySlot != TextAttributeTable::NotDirty)
+    {
+        til::at(_table->_dirty, _dirtySlot) = this;
+    }
+}
+
+// Routine Description:
+// - Copies the attributes of another row into this one.
+//   The row keeps using its own attribute table, even if the other row belongs to a different buffer.
+// Arguments:
+// - other - the row to copy the attributes from
+// Return Value:
+// - this row
+ATTR_ROW& ATTR_ROW::operator=(const ATTR_ROW& other)
+{
+    if (_table == other._table)
+    {
+        _data = other._data;
+        _MarkChanged();
+        return *this;
+    }
+
+    // Each run is written into the row right after its attribute was interned,
+    // so that the ids interned so far are in use if our table recycles ids in the meantime.
+    _data = rle_vector{ other._data.size(), TextAttributeTable::DefaultId };
+    _MarkChanged();
+    uint16_t begin = 0;
+    for (const auto& run : other._data.runs())
+    {
+        const auto end = gsl::narrow_cast<uint16_t>(begin + run.length);
+        _data.replace(begin, end, _table->Intern(other._table->Resolve(run.value)));
+        _MarkChanged();
+        begin = end;
+    }
+    return *this;
+}
+
+// Routine Description:
+// - Moves the attributes of another row into this one. See operator=(const ATTR_ROW&).
+ATTR_ROW& ATTR_ROW::operator=(ATTR_ROW&& other)
+{
+    if (_table == other._table)
+    {
+        if (this != &other)
+        {
+            _table->_Unregister(*this);
+            _data = std::move(other._data);
+            _counted = std::move(other._counted);
+            other._counted.clear();
+            _dirtySlot = std::exchange(other._dirtySlot, TextAttributeTable::NotDirty);
+            if (_dirtySlot != TextAttributeTable::NotDirty)
+            {
+                til::at(_table->_dirty, _dirtySlot) = this;
+            }
+        }
+        return *this;
+    }
+    return *this = other;
+}
+
+// Routine Description:
+// - Tells the attribute table that the ids of this row need to be recounted.
+//   Must be called after every change to _data, as the table may recycle
+//   the ids that aren't counted for any row on the next call to Intern().
+void ATTR_ROW::_MarkChanged()
+{
+    _table->_MarkDirty(*this);
+}
 
 // Routine Description:
 // - Sets all properties of the ATTR_ROW to default values
@@ -20,7 +119,8 @@ ATTR_ROW::ATTR_ROW(const til::CoordType width, const TextAttribute attr) :
 // - attr - The default text attributes to use on text in this row.
 void ATTR_ROW::Reset(const TextAttribute attr)
 {
-    _data.replace(0, _data.size(), attr);
+    _data.replace(0, _data.size(), _table->Intern(attr));
+    _MarkChanged();
 }
 
 // Routine Description:
@@ -35,6 +135,7 @@ void ATTR_ROW::Reset(const TextAttribute attr)
 void ATTR_ROW::Resize(const til::CoordType newWidth)
 {
     _data.resize_trailing_extent(gsl::narrow<uint16_t>(newWidth));
+    _MarkChanged();
 }
 
 // Routine Description:
@@ -47,7 +148,27 @@ void ATTR_ROW::Resize(const til::CoordType newWidth)
 // - will throw on error
 TextAttribute ATTR_ROW::GetAttrByColumn(const til::CoordType column) const
 {
-    return _data.at(gsl::narrow<uint16_t>(column));
+    return _table->Resolve(_data.at(gsl::narrow<uint16_t>(column)));
+}
+
+// Routine Description:
+// - Provides access to the run length encoded attributes of this row.
+// Return Value:
+// - The runs of attributes, from left to right.
+ATTR_ROW::run_view ATTR_ROW::GetRuns() const noexcept
+{
+    return { _data.runs(), _table };
+}
+
+// Routine Description:
+// - Gets the number of bytes the attribute runs occupy on the heap.
+//   Two runs are stored inline, so only rows with more than two runs allocate.
+//   The attribute table is shared by all rows of the buffer and isn't included.
+// Return Value:
+// - The number of bytes allocated for the runs of this row.
+size_t ATTR_ROW::GetHeapUsage() const noexcept
+{
+    return til::heap_usage(_data.runs()) + til::heap_usage(_counted);
 }
 
 // Routine Description:
@@ -59,9 +180,10 @@ std::vector<uint16_t> ATTR_ROW::GetHyperlinks() const
     std::vector<uint16_t> ids;
     for (const auto& run : _data.runs())
     {
-        if (run.value.IsHyperlink())
+        const auto& attr = _table->Resolve(run.value);
+        if (attr.IsHyperlink())
         {
-            ids.emplace_back(run.value.GetHyperlinkId());
+            ids.emplace_back(attr.GetHyperlinkId());
         }
     }
     return ids;
@@ -76,7 +198,8 @@ std::vector<uint16_t> ATTR_ROW::GetHyperlinks() const
 // - <none>
 bool ATTR_ROW::SetAttrToEnd(const til::CoordType beginIndex, const TextAttribute attr)
 {
-    _data.replace(gsl::narrow<uint16_t>(beginIndex), _data.size(), attr);
+    _data.replace(gsl::narrow<uint16_t>(beginIndex), _data.size(), _table->Intern(attr));
+    _MarkChanged();
     return true;
 }
 
@@ -90,7 +213,12 @@ bool ATTR_ROW::SetAttrToEnd(const til::CoordType beginIndex, const TextAttribute
 // - <none>
 void ATTR_ROW::ReplaceAttrs(const TextAttribute& toBeReplacedAttr, const TextAttribute& replaceWith)
 {
-    _data.replace_values(toBeReplacedAttr, replaceWith);
+    // If the attribute was never interned, no row can use it.
+    if (const auto id = _table->Find(toBeReplacedAttr))
+    {
+        _data.replace_values(*id, _table->Intern(replaceWith));
+        _MarkChanged();
+    }
 }
 
 // Routine Description:
@@ -105,30 +233,41 @@ void ATTR_ROW::ReplaceAttrs(const TextAttribute& toBeReplacedAttr, const TextAtt
 // - <none>
 void ATTR_ROW::Replace(const til::CoordType beginIndex, const til::CoordType endIndex, const TextAttribute& newAttr)
 {
-    _data.replace(gsl::narrow<uint16_t>(beginIndex), gsl::narrow<uint16_t>(endIndex), newAttr);
+    _data.replace(gsl::narrow<uint16_t>(beginIndex), gsl::narrow<uint16_t>(endIndex), _table->Intern(newAttr));
+    _MarkChanged();
 }
 
 ATTR_ROW::const_iterator ATTR_ROW::begin() const noexcept
 {
-    return _data.begin();
+    return { _data.begin(), _table };
 }
 
 ATTR_ROW::const_iterator ATTR_ROW::end() const noexcept
 {
-    return _data.end();
+    return { _data.end(), _table };
 }
 
 ATTR_ROW::const_iterator ATTR_ROW::cbegin() const noexcept
 {
-    return _data.cbegin();
+    return { _data.cbegin(), _table };
 }
 
 ATTR_ROW::const_iterator ATTR_ROW::cend() const noexcept
 {
-    return _data.cend();
+    return { _data.cend(), _table };
 }
 
 bool operator==(const ATTR_ROW& a, const ATTR_ROW& b) noexcept
 {
-    return a._data == b._data;
+    if (a._table == b._table)
+    {
+        return a._data == b._data;
+    }
+
+    // The runs of both rows are compacted, so equal rows consist of the same runs.
+    const auto& aRuns = a._data.runs();
+    const auto& bRuns = b._data.runs();
+    return std::equal(aRuns.begin(), aRuns.end(), bRuns.begin(), bRuns.end(), [&](const auto& aRun, const auto& bRun) {
+        return aRun.length == bRun.length && a._table->Resolve(aRun.value) == b._table->Resolve(bRun.value);
+    });
 }
@@ -22,26 +22,150 @@ Revision History:
 
 #include "til/rle.h"
 #include "TextAttribute.hpp"
+#include "TextAttributeTable.hpp"
 
+// The attributes are stored as runs of ids into the TextAttributeTable of the buffer,
+// which makes a run 8 bytes large, so that two of them fit into the row itself.
+// Every change to the runs must be reported to the table with _MarkChanged().
 class ATTR_ROW final
 {
-    using rle_vector = til::small_rle<TextAttribute, uint16_t, 1>;
+    using id_type = TextAttributeTable::id_type;
+    using rle_vector = til::small_rle<id_type, uint16_t, 2>;
+    using id_vector = boost::container::small_vector<id_type, 2>;
 
 public:
-    using const_iterator = rle_vector::const_iterator;
-
-    ATTR_ROW(til::CoordType width, TextAttribute attr);
-
-    ~ATTR_ROW() = default;
-
-    ATTR_ROW(const ATTR_ROW&) = default;
-    ATTR_ROW& operator=(const ATTR_ROW&) = default;
-    ATTR_ROW(ATTR_ROW&&)
-    noexcept = default;
-    ATTR_ROW& operator=(ATTR_ROW&&) noexcept = default;
+    // Iterates over the attribute of each column.
+    class const_iterator
+    {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = TextAttribute;
+        using difference_type = rle_vector::const_iterator::difference_type;
+        using pointer = const TextAttribute*;
+        using reference = const TextAttribute&;
+
+        const_iterator(rle_vector::const_iterator it, const TextAttributeTable* table) noexcept :
+            _it{ it },
+            _table{ table }
+        {
+        }
+
+        // The reference is only valid until the next attribute is interned into the table.
+        [[nodiscard]] reference operator*() const noexcept { return _table->Resolve(*_it); }
+        [[nodiscard]] pointer operator->() const noexcept { return &operator*(); }
+        [[nodiscard]] reference operator[](const difference_type offset) const noexcept { return *operator+(offset); }
+
+        const_iterator& operator++() noexcept
+        {
+            ++_it;
+            return *this;
+        }
+
+        const_iterator operator++(int) noexcept
+        {
+            auto tmp = *this;
+            ++_it;
+            return tmp;
+        }
+
+        const_iterator& operator--() noexcept
+        {
+            --_it;
+            return *this;
+        }
+
+        const_iterator operator--(int) noexcept
+        {
+            auto tmp = *this;
+            --_it;
+            return tmp;
+        }
+
+        const_iterator& operator+=(const difference_type offset) noexcept
+        {
+            _it += offset;
+            return *this;
+        }
+
+        const_iterator& operator-=(const difference_type offset) noexcept
+        {
+            _it -= offset;
+            return *this;
+        }
+
+        [[nodiscard]] const_iterator operator+(const difference_type offset) const noexcept { return { _it + offset, _table }; }
+        [[nodiscard]] const_iterator operator-(const difference_type offset) const noexcept { return { _it - offset, _table }; }
+        [[nodiscard]] difference_type operator-(const const_iterator& right) const noexcept { return _it - right._it; }
+
+        [[nodiscard]] bool operator==(const const_iterator& right) const noexcept { return _it == right._it; }
+        [[nodiscard]] bool operator!=(const const_iterator& right) const noexcept { return _it != right._it; }
+        [[nodiscard]] bool operator<(const const_iterator& right) const noexcept { return _it < right._it; }
+        [[nodiscard]] bool operator>(const const_iterator& right) const noexcept { return _it > right._it; }
+        [[nodiscard]] bool operator<=(const const_iterator& right) const noexcept { return _it <= right._it; }
+        [[nodiscard]] bool operator>=(const const_iterator& right) const noexcept { return _it >= right._it; }
+
+    private:
+        rle_vector::const_iterator _it;
+        const TextAttributeTable* _table;
+    };
+
+    // The runs of attributes of the row, with their ids resolved.
+    class run_view
+    {
+    public:
+        using value_type = til::rle_pair<TextAttribute, uint16_t>;
+
+        class iterator
+        {
+        public:
+            iterator(rle_vector::container::const_iterator it, const TextAttributeTable* table) noexcept :
+                _it{ it },
+                _table{ table }
+            {
+            }
+
+            [[nodiscard]] value_type operator*() const noexcept { return { _table->Resolve(_it->value), _it->length }; }
+            iterator& operator++() noexcept
+            {
+                ++_it;
+                return *this;
+            }
+            [[nodiscard]] bool operator==(const iterator& right) const noexcept { return _it == right._it; }
+            [[nodiscard]] bool operator!=(const iterator& right) const noexcept { return _it != right._it; }
+
+        private:
+            rle_vector::container::const_iterator _it;
+            const TextAttributeTable* _table;
+        };
+
+        run_view(const rle_vector::container& runs, const TextAttributeTable* table) noexcept :
+            _runs{ runs },
+            _table{ table }
+        {
+        }
+
+        iterator begin() const noexcept { return { _runs.begin(), _table }; }
+        iterator end() const noexcept { return { _runs.end(), _table }; }
+        size_t size() const noexcept { return _runs.size(); }
+
+    private:
+        const rle_vector::container& _runs;
+        const TextAttributeTable* _table;
+    };
+
+    ATTR_ROW(til::CoordType width, TextAttribute attr, TextAttributeTable& table);
+
+    ~ATTR_ROW();
+
+    ATTR_ROW(const ATTR_ROW& other);
+    ATTR_ROW& operator=(const ATTR_ROW& other);
+    ATTR_ROW(ATTR_ROW&& other) noexcept;
+    ATTR_ROW& operator=(ATTR_ROW&& other);
 
     TextAttribute GetAttrByColumn(til::CoordType column) const;
     std::vector<uint16_t> GetHyperlinks() const;
+    run_view GetRuns() const noexcept;
+    size_t GetHeapUsage() const noexcept;
 
     bool SetAttrToEnd(til::CoordType beginIndex, TextAttribute attr);
     void ReplaceAttrs(const TextAttribute& toBeReplacedAttr, const TextAttribute& replaceWith);
@@ -56,11 +180,18 @@ public:
 
     friend bool operator==(const ATTR_ROW& a, const ATTR_ROW& b) noexcept;
     friend class ROW;
+    friend class TextAttributeTable;
 
 private:
     void Reset(const TextAttribute attr);
+    void _MarkChanged();
 
     rle_vector _data;
+    TextAttributeTable* _table;
+    // The ids this row was counted for by the table, sorted and without duplicates.
+    id_vector _counted;
+    // The index of this row in the table's list of dirty rows.
+    size_t _dirtySlot = TextAttributeTable::NotDirty;
 
 #ifdef UNIT_TESTING
     friend class CommonState;
@@ -7,6 +7,8 @@
 #include "unicode.hpp"
 #include "Row.hpp"
 
+#include <til/heap_usage.h>
+
 // Routine Description:
 // - constructor
 // Arguments:
@@ -271,6 +273,16 @@ til::point CharRow::GetStorageKey(const til::CoordType column) const noexcept
     return { column, _pParent->GetId() };
 }
 
+// Routine Description:
+// - Gets the number of bytes the cells occupy on the heap. Rows are stored
+//   inline up to a certain width and only wider rows allocate their cells.
+// Return Value:
+// - the number of bytes allocated for the cells of this row
+size_t CharRow::GetHeapUsage() const noexcept
+{
+    return til::heap_usage(_data);
+}
+
 // Routine Description:
 // - Updates the pointer to the parent row (which might change if we shuffle the rows around)
 // Arguments:
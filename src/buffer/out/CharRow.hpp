@@ -86,6 +86,8 @@ public:
 
     void UpdateParent(ROW* const pParent);
 
+    size_t GetHeapUsage() const noexcept;
+
     friend CharRowCellReference;
     friend class ROW;
 
@@ -20,14 +20,23 @@ ROW::ROW(const til::CoordType rowId, const til::CoordType rowWidth, const TextAt
     _id{ rowId },
     _rowWidth{ rowWidth },
     _charRow{ rowWidth, this },
-    _attrRow{ rowWidth, fillAttribute },
+    _attrRow{ rowWidth, fillAttribute, pParent->GetAttributeTable() },
     _lineRendition{ LineRendition::SingleWidth },
     _wrapForced{ false },
     _doubleBytePadded{ false },
-    _pParent{ pParent }
+    _pParent{ pParent },
+    _revision{ s_NextRevision() }
 {
 }
 
+uint64_t ROW::s_NextRevision() noexcept
+{
+    // Rows of different buffers (and thus different console locks) may be modified
+    // concurrently, but the revisions only need to be unique, not ordered.
+    static std::atomic<uint64_t> revision{ 0 };
+    return revision.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
 // Routine Description:
 // - Sets all properties of the ROW to default values
 // Arguments:
@@ -36,6 +45,7 @@ ROW::ROW(const til::CoordType rowId, const til::CoordType rowWidth, const TextAt
 // - <none>
 bool ROW::Reset(const TextAttribute Attr)
 {
+    _Touch();
     _lineRendition = LineRendition::SingleWidth;
     _wrapForced = false;
     _doubleBytePadded = false;
@@ -60,6 +70,7 @@ bool ROW::Reset(const TextAttribute Attr)
 // - S_OK if successful, otherwise relevant error
 [[nodiscard]] HRESULT ROW::Resize(const til::CoordType width)
 {
+    _Touch();
     RETURN_IF_FAILED(_charRow.Resize(width));
     try
     {
@@ -81,6 +92,7 @@ bool ROW::Reset(const TextAttribute Attr)
 void ROW::ClearColumn(const til::CoordType column)
 {
     THROW_HR_IF(E_INVALIDARG, column >= _charRow.size());
+    _Touch();
     _charRow.ClearCell(column);
 }
 
@@ -107,6 +119,7 @@ OutputCellIterator ROW::WriteCells(OutputCellIterator it, const til::CoordType i
 {
     THROW_HR_IF(E_INVALIDARG, index >= _charRow.size());
     THROW_HR_IF(E_INVALIDARG, limitRight.value_or(0) >= _charRow.size());
+    _Touch();
 
     // If we're given a right-side column limit, use it. Otherwise, the write limit is the final column index available in the char row.
     const auto finalColumnInRow = limitRight.value_or(_charRow.size() - 1);
@@ -196,3 +209,103 @@ OutputCellIterator ROW::WriteCells(OutputCellIterator it, const til::CoordType i
 
     return it;
 }
+
+// Routine Description:
+// - copies a span of cells, including their attributes and any glyphs kept in the
+//   UnicodeStorage, from the source row into this row. The source may be this row,
+//   in which case the spans may overlap (memmove semantics).
+// - Wide glyphs that are cut in half by the edges of either span are replaced by spaces,
+//   so that the row never contains a leading half without its trailing half or vice versa.
+// Arguments:
+// - source - the row to copy from. It must belong to the same TextBuffer.
+// - sourceLeft - the first column of the span in the source row
+// - targetLeft - the first column of the span in this row
+// - count - the number of cells to copy
+void ROW::CopyCellsFrom(const ROW& source, const til::CoordType sourceLeft, const til::CoordType targetLeft, const til::CoordType count)
+{
+    THROW_HR_IF(E_INVALIDARG, count < 0 || sourceLeft < 0 || targetLeft < 0);
+    THROW_HR_IF(E_INVALIDARG, sourceLeft + count > source.size() || targetLeft + count > size());
+
+    if (count == 0 || (&source == this && sourceLeft == targetLeft))
+    {
+        return;
+    }
+
+    _Touch();
+
+    auto& storage = GetUnicodeStorage();
+    const auto& sourceCells = source._charRow._data;
+    auto& targetCells = _charRow._data;
+
+    // Glyphs in the UnicodeStorage are keyed by their position. Fetch the ones we're about to move
+    // before anything is overwritten and drop the ones of the cells that are going to be replaced.
+    // Most rows don't have any, so this usually doesn't allocate.
+    std::vector<std::pair<til::CoordType, UnicodeStorage::mapped_type>> glyphs;
+    for (til::CoordType i = 0; i < count; ++i)
+    {
+        if (til::at(sourceCells, sourceLeft + i).DbcsAttr().IsGlyphStored())
+        {
+            glyphs.emplace_back(i, storage.GetText(source._charRow.GetStorageKey(sourceLeft + i)));
+        }
+    }
+    for (til::CoordType i = 0; i < count; ++i)
+    {
+        if (til::at(targetCells, targetLeft + i).DbcsAttr().IsGlyphStored())
+        {
+            storage.Erase(_charRow.GetStorageKey(targetLeft + i));
+        }
+    }
+
+    // The attributes are sliced out into a copy, so this is safe for overlapping spans as well.
+    const auto attrs = source._attrRow._data.slice(gsl::narrow<uint16_t>(sourceLeft), gsl::narrow<uint16_t>(sourceLeft + count));
+
+    const auto sourceBegin = sourceCells.begin() + sourceLeft;
+    const auto targetBegin = targetCells.begin() + targetLeft;
+    if (&source == this && targetLeft > sourceLeft)
+    {
+        std::copy_backward(sourceBegin, sourceBegin + count, targetBegin + count);
+    }
+    else
+    {
+        std::copy(sourceBegin, sourceBegin + count, targetBegin);
+    }
+
+    _attrRow._data.replace(gsl::narrow<uint16_t>(targetLeft), gsl::narrow<uint16_t>(targetLeft + count), attrs.runs());
+    _attrRow._MarkChanged();
+
+    for (auto& [offset, glyph] : glyphs)
+    {
+        storage.StoreGlyph(_charRow.GetStorageKey(targetLeft + offset), glyph);
+    }
+
+    // Clean up wide glyphs split by the edges of the source span...
+    const auto targetRight = targetLeft + count - 1;
+    if (_charRow.DbcsAttrAt(targetLeft).IsTrailing())
+    {
+        _ClearHalfOfWideGlyph(targetLeft);
+    }
+    if (_charRow.DbcsAttrAt(targetRight).IsLeading())
+    {
+        _ClearHalfOfWideGlyph(targetRight);
+    }
+    // ...and those next to the target span that just lost their other half.
+    if (targetLeft > 0 && _charRow.DbcsAttrAt(targetLeft - 1).IsLeading())
+    {
+        _ClearHalfOfWideGlyph(targetLeft - 1);
+    }
+    if (targetRight + 1 < size() && _charRow.DbcsAttrAt(targetRight + 1).IsTrailing())
+    {
+        _ClearHalfOfWideGlyph(targetRight + 1);
+    }
+}
+
+// Routine Description:
+// - replaces one half of a wide glyph with a space, keeping its attributes.
+void ROW::_ClearHalfOfWideGlyph(const til::CoordType column)
+{
+    if (_charRow.DbcsAttrAt(column).IsGlyphStored())
+    {
+        GetUnicodeStorage().Erase(_charRow.GetStorageKey(column));
+    }
+    _charRow.ClearCell(column);
+}
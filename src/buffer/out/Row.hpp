@@ -36,24 +36,53 @@ public:
 
     til::CoordType size() const noexcept { return _rowWidth; }
 
-    void SetWrapForced(const bool wrap) noexcept { _wrapForced = wrap; }
+    void SetWrapForced(const bool wrap) noexcept
+    {
+        _wrapForced = wrap;
+        _Touch();
+    }
     bool WasWrapForced() const noexcept { return _wrapForced; }
 
-    void SetDoubleBytePadded(const bool doubleBytePadded) noexcept { _doubleBytePadded = doubleBytePadded; }
+    void SetDoubleBytePadded(const bool doubleBytePadded) noexcept
+    {
+        _doubleBytePadded = doubleBytePadded;
+        _Touch();
+    }
     bool WasDoubleBytePadded() const noexcept { return _doubleBytePadded; }
 
     const CharRow& GetCharRow() const noexcept { return _charRow; }
-    CharRow& GetCharRow() noexcept { return _charRow; }
+    CharRow& GetCharRow() noexcept
+    {
+        _Touch();
+        return _charRow;
+    }
 
     const ATTR_ROW& GetAttrRow() const noexcept { return _attrRow; }
-    ATTR_ROW& GetAttrRow() noexcept { return _attrRow; }
+    ATTR_ROW& GetAttrRow() noexcept
+    {
+        _Touch();
+        return _attrRow;
+    }
 
     LineRendition GetLineRendition() const noexcept { return _lineRendition; }
-    void SetLineRendition(const LineRendition lineRendition) noexcept { _lineRendition = lineRendition; }
+    void SetLineRendition(const LineRendition lineRendition) noexcept
+    {
+        _lineRendition = lineRendition;
+        _Touch();
+    }
 
     til::CoordType GetId() const noexcept { return _id; }
     void SetId(const til::CoordType id) noexcept { _id = id; }
 
+    // Every (potential) modification of the row assigns it a new revision, which is unique
+    // across all rows of all buffers. Consumers that cache row contents, like the
+    // UIA text snapshot, can use it to cheaply find the rows that changed since.
+    uint64_t GetRevision() const noexcept { return _revision; }
+
+    // The number of bytes this row occupies, including the cells and attribute runs it allocated on the heap.
+    // The glyphs of the row that are stored in the buffer's UnicodeStorage aren't included.
+    size_t GetMemoryUsage() const noexcept { return sizeof(ROW) + _charRow.GetHeapUsage() + _attrRow.GetHeapUsage(); }
+
     bool Reset(const TextAttribute Attr);
     [[nodiscard]] HRESULT Resize(const til::CoordType width);
 
@@ -64,6 +93,7 @@ public:
     const UnicodeStorage& GetUnicodeStorage() const noexcept;
 
     OutputCellIterator WriteCells(OutputCellIterator it, const til::CoordType index, const std::optional<bool> wrap = std::nullopt, std::optional<til::CoordType> limitRight = std::nullopt);
+    void CopyCellsFrom(const ROW& source, const til::CoordType sourceLeft, const til::CoordType targetLeft, const til::CoordType count);
 
 #ifdef UNIT_TESTING
     friend constexpr bool operator==(const ROW& a, const ROW& b) noexcept;
@@ -71,6 +101,10 @@ public:
 #endif
 
 private:
+    static uint64_t s_NextRevision() noexcept;
+    void _Touch() noexcept { _revision = s_NextRevision(); }
+    void _ClearHalfOfWideGlyph(const til::CoordType column);
+
     CharRow _charRow;
     ATTR_ROW _attrRow;
     LineRendition _lineRendition;
@@ -81,6 +115,7 @@ private:
     // Occurs when the user runs out of text to support a double byte character and we're forced to the next line
     bool _doubleBytePadded;
     TextBuffer* _pParent; // non ownership pointer
+    uint64_t _revision;
 };
 
 #ifdef UNIT_TESTING
@@ -0,0 +1,235 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "TextAttributeTable.hpp"
+
+#include "AttrRow.hpp"
+
+#include <til/hash.h>
+#include <til/heap_usage.h>
+
+TextAttributeTable::TextAttributeTable() :
+    _attributes{ TextAttribute{} },
+    _ids{ { TextAttribute{}, DefaultId } },
+    _usage(1)
+{
+}
+
+// Routine Description:
+// - Returns the id of the given attribute, assigning it a new one if it wasn't interned yet.
+// - A new id must be written into a row before the next call to Intern(), as it's
+//   recycled by the next Collect() if no row uses it by then.
+// Arguments:
+// - attr - the attribute to intern. It's taken by value, as it may refer into this table.
+// Return Value:
+// - the id of the attribute
+TextAttributeTable::id_type TextAttributeTable::Intern(const TextAttribute attr)
+{
+    if (attr == _lastAttribute)
+    {
+        return _lastId;
+    }
+
+    id_type id;
+    if (const auto it = _ids.find(attr); it != _ids.end())
+    {
+        id = it->second;
+    }
+    else
+    {
+        if (_free.empty() && _internedSinceCollect >= CollectInterval)
+        {
+            Collect();
+        }
+
+        if (!_free.empty())
+        {
+            id = _free.back();
+            _ids.emplace(attr, id);
+            _free.pop_back();
+            til::at(_attributes, id) = attr;
+        }
+        else
+        {
+            THROW_HR_IF(E_OUTOFMEMORY, _attributes.size() > std::numeric_limits<id_type>::max());
+            id = gsl::narrow_cast<id_type>(_attributes.size());
+            _usage.resize(_attributes.size() + 1);
+            _attributes.emplace_back(attr);
+            if (_unreferenced.capacity() < _attributes.capacity())
+            {
+                _unreferenced.reserve(_attributes.capacity());
+            }
+            _ids.emplace(attr, id);
+        }
+
+        // The id isn't used by any row yet. If that doesn't change, the next Collect() recycles it.
+        _Enqueue(id);
+        _internedSinceCollect++;
+    }
+
+    _lastAttribute = attr;
+    _lastId = id;
+    return id;
+}
+
+// Routine Description:
+// - Returns the id of the given attribute, if it was interned.
+// Arguments:
+// - attr - the attribute to look up
+// Return Value:
+// - the id of the attribute or nullopt
+std::optional<TextAttributeTable::id_type> TextAttributeTable::Find(const TextAttribute& attr) const noexcept
+{
+    const auto it = _ids.find(attr);
+    return it != _ids.end() ? std::optional{ it->second } : std::nullopt;
+}
+
+// Routine Description:
+// - Recounts the ids of the rows that changed since the last call
+//   and recycles the ids that aren't used by any row anymore.
+// Return Value:
+// - the number of ids that are available now
+size_t TextAttributeTable::Collect()
+{
+    _internedSinceCollect = 0;
+
+    // Rows are only removed once they were recounted, so that
+    // the table stays consistent if recounting one of them throws.
+    while (!_dirty.empty())
+    {
+        const auto row = _dirty.back();
+        _Recount(*row);
+        row->_dirtySlot = NotDirty;
+        _dirty.pop_back();
+    }
+
+    _free.reserve(_free.size() + _unreferenced.size());
+    for (const auto id : _unreferenced)
+    {
+        auto& usage = til::at(_usage, id);
+        usage.queued = false;
+        if (usage.rows == 0 && id != DefaultId)
+        {
+            const auto it = _ids.find(til::at(_attributes, id));
+            if (it != _ids.end() && it->second == id)
+            {
+                _ids.erase(it);
+            }
+            _free.emplace_back(id);
+        }
+    }
+    _unreferenced.clear();
+
+    _lastAttribute = TextAttribute{};
+    _lastId = DefaultId;
+    return _free.size();
+}
+
+// Routine Description:
+// - Returns the number of distinct attributes in the table, including the ones
+//   that aren't used anymore but weren't recycled yet.
+size_t TextAttributeTable::Size() const noexcept
+{
+    return _ids.size();
+}
+
+// Routine Description:
+// - Gets the number of bytes the table occupies on the heap.
+size_t TextAttributeTable::GetHeapUsage() const noexcept
+{
+    return til::heap_usage(_attributes) + til::heap_usage(_ids) + til::heap_usage(_usage) + til::heap_usage(_free) +
+           til::heap_usage(_dirty) + til::heap_usage(_unreferenced);
+}
+
+// Routine Description:
+// - Remembers that the ids of the given row need to be recounted by the next Collect().
+// Arguments:
+// - row - a row of this table that changed
+void TextAttributeTable::_MarkDirty(ATTR_ROW& row)
+{
+    if (row._dirtySlot == NotDirty)
+    {
+        _dirty.emplace_back(&row);
+        row._dirtySlot = _dirty.size() - 1;
+    }
+}
+
+// Routine Description:
+// - Forgets the given row, because it's about to be destroyed or overwritten.
+//   The ids it was counted for are released.
+// Arguments:
+// - row - a row of this table
+void TextAttributeTable::_Unregister(ATTR_ROW& row) noexcept
+{
+    if (row._dirtySlot != NotDirty)
+    {
+        // Swap-remove the row from the list and tell the row that took its place.
+        const auto last = _dirty.back();
+        til::at(_dirty, row._dirtySlot) = last;
+        last->_dirtySlot = row._dirtySlot;
+        _dirty.pop_back();
+        row._dirtySlot = NotDirty;
+    }
+
+    for (const auto id : row._counted)
+    {
+        _Release(id);
+    }
+    row._counted.clear();
+}
+
+// Routine Description:
+// - Counts the ids the given row uses now, instead of the ones it used when it was last counted.
+// Arguments:
+// - row - a row of this table
+void TextAttributeTable::_Recount(ATTR_ROW& row)
+{
+    ATTR_ROW::id_vector ids;
+    for (const auto& run : row._data.runs())
+    {
+        ids.emplace_back(run.value);
+    }
+    std::sort(ids.begin(), ids.end());
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+
+    // The new ids are counted first, so that the ones the row still uses aren't queued needlessly.
+    for (const auto id : ids)
+    {
+        til::at(_usage, id).rows++;
+    }
+    for (const auto id : row._counted)
+    {
+        _Release(id);
+    }
+    row._counted = std::move(ids);
+}
+
+void TextAttributeTable::_Release(const id_type id) noexcept
+{
+    auto& usage = til::at(_usage, id);
+    if (--usage.rows == 0)
+    {
+        _Enqueue(id);
+    }
+}
+
+void TextAttributeTable::_Enqueue(const id_type id) noexcept
+{
+    auto& usage = til::at(_usage, id);
+    if (!usage.queued)
+    {
+        usage.queued = true;
+        // This never allocates, as the capacity is kept at the number of ids and each id is queued at most once.
+        _unreferenced.emplace_back(id);
+    }
+}
+
+size_t TextAttributeTable::AttributeHash::operator()(const TextAttribute& attr) const noexcept
+{
+    // TextAttribute compares its bytes with memcmp(), so they're hashed the same way.
+    til::hasher h;
+#pragma warning(suppress : 26490) // Don't use reinterpret_cast (type.1).
+    h.write(reinterpret_cast<const uint8_t*>(&attr), sizeof(attr));
+    return h.finalize();
+}
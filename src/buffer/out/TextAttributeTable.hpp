@@ -0,0 +1,94 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- TextAttributeTable.hpp
+
+Abstract:
+- Deduplicates the text attributes of a buffer and assigns each of them a 32-bit id,
+  so that rows can store runs of ids instead of runs of full attributes.
+- Ids are copied around with the runs of a row far too often to count references
+  on every write. Instead, a row that changes is only put on a list of dirty rows,
+  and Collect() recounts the ids of just those rows and recycles the ones that no
+  row uses anymore. Its cost is thus proportional to the rows that changed since.
+--*/
+
+#pragma once
+
+#include "TextAttribute.hpp"
+
+class ATTR_ROW;
+
+class TextAttributeTable final
+{
+public:
+    using id_type = uint32_t;
+
+    // The id of the default attribute (TextAttribute{}). It's never recycled.
+    static constexpr id_type DefaultId = 0;
+
+    TextAttributeTable();
+
+    // Rows refer to their table, so it can neither be copied nor moved.
+    // It must outlive all of its rows.
+    TextAttributeTable(const TextAttributeTable&) = delete;
+    TextAttributeTable& operator=(const TextAttributeTable&) = delete;
+
+    id_type Intern(const TextAttribute attr);
+    std::optional<id_type> Find(const TextAttribute& attr) const noexcept;
+
+    // The returned reference is only valid until the next call to Intern().
+    const TextAttribute& Resolve(const id_type id) const noexcept
+    {
+        return til::at(_attributes, id);
+    }
+
+    size_t Collect();
+    size_t Size() const noexcept;
+    size_t GetHeapUsage() const noexcept;
+
+private:
+    friend class ATTR_ROW;
+
+    struct Usage
+    {
+        // The number of rows that use this id, as of the last time they were recounted.
+        uint32_t rows = 0;
+        // Whether the id is in _unreferenced.
+        bool queued = false;
+    };
+
+    static constexpr size_t NotDirty = std::numeric_limits<size_t>::max();
+
+    void _MarkDirty(ATTR_ROW& row);
+    void _Unregister(ATTR_ROW& row) noexcept;
+    void _Recount(ATTR_ROW& row);
+    void _Release(const id_type id) noexcept;
+    void _Enqueue(const id_type id) noexcept;
+
+    struct AttributeHash
+    {
+        size_t operator()(const TextAttribute& attr) const noexcept;
+    };
+
+    std::vector<TextAttribute> _attributes;
+    std::unordered_map<TextAttribute, id_type, AttributeHash> _ids;
+    std::vector<Usage> _usage;
+    std::vector<id_type> _free;
+
+    // The rows that changed since the last Collect(). Each row knows its index in here.
+    std::vector<ATTR_ROW*> _dirty;
+    // The ids that may not be used by any row anymore. Each id is queued at most once,
+    // so its capacity is kept at the number of ids and releasing an id never allocates.
+    std::vector<id_type> _unreferenced;
+
+    // Consecutive writes tend to use the same attribute.
+    TextAttribute _lastAttribute;
+    id_type _lastId = DefaultId;
+
+    // The number of attributes that were assigned an id since the last collection.
+    // Collections are spaced out by CollectInterval, so that their cost is amortized.
+    static constexpr size_t CollectInterval = 4096;
+    size_t _internedSinceCollect = 0;
+};
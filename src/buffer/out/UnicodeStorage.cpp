@@ -4,6 +4,8 @@
 #include "precomp.h"
 #include "UnicodeStorage.hpp"
 
+#include <til/heap_usage.h>
+
 UnicodeStorage::UnicodeStorage() noexcept :
     _map{}
 {
@@ -40,6 +42,15 @@ void UnicodeStorage::Erase(const key_type key) noexcept
     _map.erase(key);
 }
 
+// Routine Description:
+// - Gets the number of bytes the stored glyphs occupy on the heap, including the map's bookkeeping.
+// Return Value:
+// - the approximate number of bytes allocated by the storage
+size_t UnicodeStorage::GetHeapUsage() const noexcept
+{
+    return til::heap_usage(_map);
+}
+
 // Routine Description:
 // - Remaps all of the stored items to new coordinate positions
 //   based on a bulk rearrangement of row IDs and potential row width resize.
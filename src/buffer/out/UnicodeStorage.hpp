@@ -56,6 +56,8 @@ public:
 
     void Remap(const std::unordered_map<til::CoordType, til::CoordType>& rowMap, const std::optional<til::CoordType> width);
 
+    size_t GetHeapUsage() const noexcept;
+
 private:
     std::unordered_map<key_type, mapped_type> _map;
 
@@ -7,8 +7,7 @@
 
 #include "CharRow.hpp"
 #include "textBuffer.hpp"
-#include "../types/inc/Utf16Parser.hpp"
-#include "../types/inc/GlyphWidth.hpp"
+#include "../types/inc/GraphemeClusterIterator.hpp"
 
 using namespace Microsoft::Console::Types;
 
@@ -332,15 +331,13 @@ void Search::_UpdateNextPosition()
 // - Structured text data for comparison to screen buffer text data.
 std::vector<std::vector<wchar_t>> Search::s_CreateNeedleFromString(const std::wstring& wstr)
 {
-    const auto charData = Utf16Parser::Parse(wstr);
+    // The buffer stores one code point per cell, which is what the needle has to match.
+    const GraphemeClusters codepoints{ wstr, GraphemeClusterIterator::Segmentation::Codepoints };
     std::vector<std::vector<wchar_t>> cells;
-    for (const auto chars : charData)
+    for (auto it = codepoints.begin(); it != codepoints.end(); ++it)
     {
-        if (IsGlyphFullWidth(std::wstring_view{ chars.data(), chars.size() }))
-        {
-            cells.emplace_back(chars);
-        }
-        cells.emplace_back(chars);
+        const auto chars = *it;
+        cells.insert(cells.end(), gsl::narrow_cast<size_t>(it.Columns()), { chars.begin(), chars.end() });
     }
     return cells;
 }
@@ -57,6 +57,8 @@ public:
 
     std::pair<til::point, til::point> GetFoundLocation() const noexcept;
 
+    static std::vector<std::vector<wchar_t>> s_CreateNeedleFromString(const std::wstring& wstr);
+
 private:
     wchar_t _ApplySensitivity(const wchar_t wch) const noexcept;
     bool _FindNeedleInHaystackAt(const til::point pos, til::point& start, til::point& end) const;
@@ -68,8 +70,6 @@ private:
 
     static til::point s_GetInitialAnchor(const Microsoft::Console::Types::IUiaData& uiaData, const Direction dir);
 
-    static std::vector<std::vector<wchar_t>> s_CreateNeedleFromString(const std::wstring& wstr);
-
     bool _reachedEnd = false;
     til::point _coordNext;
     til::point _coordSelStart;
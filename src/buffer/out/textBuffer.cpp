@@ -9,8 +9,10 @@
 #include "../renderer/base/renderer.hpp"
 #include "../types/inc/utils.hpp"
 #include "../types/inc/convert.hpp"
-#include "../../types/inc/Utf16Parser.hpp"
-#include "../../types/inc/GlyphWidth.hpp"
+#include "../../types/inc/GraphemeClusterIterator.hpp"
+
+#include <til/heap_usage.h>
+#include <til/trace.h>
 
 #pragma hdrstop
 
@@ -38,6 +40,7 @@ TextBuffer::TextBuffer(const til::size screenBufferSize,
     _firstRow{ 0 },
     _currentAttributes{ defaultAttributes },
     _cursor{ cursorSize, *this },
+    _attributeTable{},
     _storage{},
     _unicodeStorage{},
     _isActiveBuffer{ isActiveBuffer },
@@ -392,6 +395,134 @@ OutputCellIterator TextBuffer::WriteLine(const OutputCellIterator givenIt,
     return newIt;
 }
 
+// Routine Description:
+// - Writes cells to the output buffer like Write(), but skips the cells that already hold
+//   the same contents, so that only the spans of cells that actually changed get written
+//   and invalidated. Full-screen applications tend to present their entire back buffer on
+//   every frame (e.g. with WriteConsoleOutput), even though only a few cells change in between.
+// Arguments:
+// - givenIt - Iterator representing output cell data to write
+// - target - the row/column to start writing the text to
+// - wrap - change the wrap flag if we hit the end of the row while writing and there's still more data
+// Return Value:
+// - The final position of the iterator
+OutputCellIterator TextBuffer::WriteIfChanged(const OutputCellIterator givenIt,
+                                              const til::point target,
+                                              const std::optional<bool> wrap)
+{
+    auto it = givenIt;
+    auto lineTarget = target;
+    const auto size = GetSize();
+
+    while (it && size.IsInBounds(lineTarget))
+    {
+        it = _WriteLineIfChanged(it, lineTarget, wrap);
+        lineTarget.X = 0;
+        ++lineTarget.Y;
+    }
+
+    return it;
+}
+
+// Routine Description:
+// - Writes one line of text to the output buffer like WriteLine(), but only writes the runs of cells that changed.
+// Arguments:
+// - givenIt - The iterator that will dereference into cell data to insert
+// - target - Coordinate targeted within output buffer
+// - wrap - change the wrap flag if we hit the end of the row while writing and there's still more data in the iterator.
+// Return Value:
+// - The iterator, but advanced to where we stopped writing.
+OutputCellIterator TextBuffer::_WriteLineIfChanged(const OutputCellIterator givenIt,
+                                                   const til::point target,
+                                                   const std::optional<bool> wrap)
+{
+    if (!GetSize().IsInBounds(target))
+    {
+        return givenIt;
+    }
+
+    // Only read through the const row, so that unchanged rows aren't marked as touched.
+    const auto& row = std::as_const(*this).GetRowByOffset(target.Y);
+    const auto& charRow = row.GetCharRow();
+    const auto rowWidth = row.size();
+    auto attrIt = row.GetAttrRow().begin() + target.X;
+
+    // The iterator positioned at the first cell of the current run of changed cells.
+    std::optional<OutputCellIterator> runIt;
+    til::CoordType runStart = 0;
+    auto previousIt = givenIt;
+    auto previousWasLeading = false;
+
+    // Without a limit, WriteLine() writes until it runs out of cells or reaches the end of the row.
+    const auto writeRun = [&](const std::optional<til::CoordType> limitRight) {
+        // WriteLine() changes the wrap flag whenever it fills the column at limitRight.
+        WriteLine(*runIt, { runStart, target.Y }, limitRight ? std::optional<bool>{} : wrap, limitRight);
+        runIt.reset();
+    };
+
+    auto it = givenIt;
+    auto column = target.X;
+    for (; it && column < rowWidth; ++it, ++column, ++attrIt)
+    {
+        const auto& cell = *it;
+        const auto dbcsAttr = cell.DbcsAttr();
+
+        // WriteLine() doesn't map these cells 1:1 onto columns: it pads over trailing halves in
+        // the first column and leading halves in the last one. Leave the rest of the line to it.
+        if (cell.TextAttrBehavior() != TextAttributeBehavior::Stored ||
+            (column == 0 && dbcsAttr.IsTrailing()) ||
+            (column == rowWidth - 1 && dbcsAttr.IsLeading()))
+        {
+            if (!runIt)
+            {
+                runIt = it;
+                runStart = column;
+            }
+            return WriteLine(*runIt, { runStart, target.Y }, wrap);
+        }
+
+        const auto changed = cell.Chars() != std::wstring_view{ charRow.GlyphAt(column) } ||
+                             dbcsAttr != charRow.DbcsAttrAt(column) ||
+                             cell.TextAttr() != *attrIt;
+
+        if (changed && !runIt)
+        {
+            // Both halves of a wide glyph are written and invalidated together.
+            if (dbcsAttr.IsTrailing() && column > target.X)
+            {
+                runIt = previousIt;
+                runStart = column - 1;
+            }
+            else
+            {
+                runIt = it;
+                runStart = column;
+            }
+        }
+        // A run can't end on a leading half, as WriteLine() would pad it out at the run's right edge.
+        else if (!changed && runIt && !previousWasLeading)
+        {
+            writeRun(column - 1);
+            // Writing may have reallocated the attribute runs.
+            attrIt = row.GetAttrRow().begin() + column;
+        }
+
+        previousIt = it;
+        previousWasLeading = dbcsAttr.IsLeading();
+    }
+
+    if (runIt)
+    {
+        writeRun(std::nullopt);
+    }
+    else if (wrap.has_value() && column == rowWidth && row.WasWrapForced() != *wrap)
+    {
+        GetRowByOffset(target.Y).SetWrapForced(*wrap);
+    }
+
+    return it;
+}
+
 //Routine Description:
 // - Inserts one codepoint into the buffer at the current cursor position and advances the cursor as appropriate.
 //Arguments:
@@ -584,10 +715,22 @@ bool TextBuffer::IncrementCircularBuffer(const bool inVtMode)
         {
             _firstRow = 0;
         }
+
+        _circularBufferIncrements++;
     }
     return fSuccess;
 }
 
+// Routine Description:
+// - Returns how often IncrementCircularBuffer() moved the top of the buffer
+//   over the lifetime of this buffer. Callers that copy the buffer in pieces
+//   can use the difference between two calls to find out by how many rows
+//   the contents shifted up in the meantime.
+uint64_t TextBuffer::GetCircularBufferIncrements() const noexcept
+{
+    return _circularBufferIncrements;
+}
+
 //Routine Description:
 // - Retrieves the position of the last non-space character in the given
 //   viewport
@@ -785,6 +928,43 @@ void TextBuffer::ScrollRows(const til::CoordType firstRow, const til::CoordType
     _RefreshRowIDs(std::nullopt);
 }
 
+// Routine Description:
+// - Moves the contents of a rectangular region of the buffer to another location,
+//   one span of cells per row. The regions may overlap. Unlike ScrollRows, this
+//   works for regions narrower than the buffer, but copies the cells instead of
+//   rotating the rows.
+// Arguments:
+// - source - the region to copy. It must lie within the buffer.
+// - targetOrigin - the top left corner of the region to copy to. The target region
+//   has the same dimensions as the source and must lie within the buffer, too.
+void TextBuffer::CopyRectangle(const Viewport& source, const til::point targetOrigin)
+{
+    const auto target = Viewport::FromDimensions(targetOrigin, source.Dimensions());
+    THROW_HR_IF(E_INVALIDARG, !_size.IsInBounds(source) || !_size.IsInBounds(target));
+
+    if (source.Origin() == targetOrigin || !source.IsValid())
+    {
+        return;
+    }
+
+    // Like memmove(): when moving down, start with the bottom row, so that
+    // no row of the source is overwritten before it has been copied.
+    const auto height = source.Height();
+    const auto movingDown = targetOrigin.Y > source.Top();
+    for (til::CoordType i = 0; i < height; ++i)
+    {
+        const auto offset = movingDown ? height - 1 - i : i;
+        const auto& sourceRow = GetRowByOffset(source.Top() + offset);
+        auto& targetRow = GetRowByOffset(targetOrigin.Y + offset);
+        targetRow.CopyCellsFrom(sourceRow, source.Left(), targetOrigin.X, source.Width());
+    }
+
+    // Wide glyphs right next to the target may have been cleared as well.
+    const auto left = std::max(0, target.Left() - 1);
+    const auto right = std::min(_size.RightInclusive(), target.RightInclusive() + 1);
+    TriggerRedraw(Viewport::FromInclusive({ left, target.Top(), right, target.BottomInclusive() }));
+}
+
 Cursor& TextBuffer::GetCursor() noexcept
 {
     return _cursor;
@@ -956,6 +1136,16 @@ UnicodeStorage& TextBuffer::GetUnicodeStorage() noexcept
     return _unicodeStorage;
 }
 
+const TextAttributeTable& TextBuffer::GetAttributeTable() const noexcept
+{
+    return _attributeTable;
+}
+
+TextAttributeTable& TextBuffer::GetAttributeTable() noexcept
+{
+    return _attributeTable;
+}
+
 void TextBuffer::SetAsActiveBuffer(const bool isActiveBuffer) noexcept
 {
     _isActiveBuffer = isActiveBuffer;
@@ -1702,8 +1892,134 @@ void TextBuffer::_ExpandTextRow(til::inclusive_rect& textRow) const
     }
 }
 
+namespace
+{
+    // An append-only string that stores its contents in a list of fixed size chunks.
+    // Unlike std::string or std::ostringstream it never has to copy what was already
+    // written when it grows, which matters when formatting large selections.
+    class ChunkedStringBuilder
+    {
+    public:
+        void Append(std::string_view str)
+        {
+            while (!str.empty())
+            {
+                if (_chunks.empty() || _chunks.back().size() == ChunkSize)
+                {
+                    _chunks.emplace_back().reserve(ChunkSize);
+                }
+
+                auto& chunk = _chunks.back();
+                const auto count = std::min(str.size(), ChunkSize - chunk.size());
+                chunk.append(str.data(), count);
+                str = str.substr(count);
+                _size += count;
+            }
+        }
+
+        template<typename S, typename... Args>
+        void AppendFormatted(S&& format, Args&&... args)
+        {
+            fmt::basic_memory_buffer<char, 64> buf;
+            fmt::format_to(std::back_inserter(buf), std::forward<S>(format), std::forward<Args>(args)...);
+            Append({ buf.data(), buf.size() });
+        }
+
+        void AppendColor(const COLORREF color)
+        {
+            AppendFormatted(FMT_COMPILE("#{:02X}{:02X}{:02X}"), GetRValue(color), GetGValue(color), GetBValue(color));
+        }
+
+        size_t Size() const noexcept
+        {
+            return _size;
+        }
+
+        void CopyTo(std::string& str) const
+        {
+            str.reserve(str.size() + _size);
+            for (const auto& chunk : _chunks)
+            {
+                str.append(chunk);
+            }
+        }
+
+    private:
+        static constexpr size_t ChunkSize = 64 * 1024;
+
+        std::vector<std::string> _chunks;
+        size_t _size = 0;
+    };
+
+    // Returns the part of the row's text that should be formatted.
+    // \r and \n don't have color attributes and aren't HTML/RTF friendly,
+    // so the row ends at the first one of them. Line breaks are added separately.
+    std::wstring_view TrimLineBreak(const std::wstring_view rowText) noexcept
+    {
+        return rowText.substr(0, rowText.find_first_of(L"\r\n"));
+    }
+
+    void AppendHTMLText(ChunkedStringBuilder& builder, const std::string_view text)
+    {
+        auto remaining = text;
+        while (!remaining.empty())
+        {
+            const auto special = remaining.find_first_of("<>&");
+            builder.Append(remaining.substr(0, special));
+            if (special == std::string_view::npos)
+            {
+                break;
+            }
+
+            switch (til::at(remaining, special))
+            {
+            case '<':
+                builder.Append("&lt;");
+                break;
+            case '>':
+                builder.Append("&gt;");
+                break;
+            default:
+                builder.Append("&amp;");
+                break;
+            }
+            remaining = remaining.substr(special + 1);
+        }
+    }
+
+    void AppendRTFText(ChunkedStringBuilder& builder, const std::wstring_view text)
+    {
+        fmt::basic_memory_buffer<char, 256> buf;
+        for (const auto codeUnit : text)
+        {
+            if (codeUnit <= 127)
+            {
+                switch (codeUnit)
+                {
+                case L'\\':
+                case L'{':
+                case L'}':
+                    buf.push_back('\\');
+                    buf.push_back(gsl::narrow<char>(codeUnit));
+                    break;
+                default:
+                    buf.push_back(gsl::narrow<char>(codeUnit));
+                }
+            }
+            else
+            {
+                // Windows uses unsigned wchar_t - RTF uses signed ones.
+                fmt::format_to(std::back_inserter(buf), FMT_COMPILE("\\u{}?"), til::bit_cast<int16_t>(codeUnit));
+            }
+        }
+        builder.Append({ buf.data(), buf.size() });
+    }
+}
+
 // Routine Description:
 // - Retrieves the text data from the selected region and presents it in a clipboard-ready format (given little post-processing).
+// - The colors are resolved once per attribute run instead of once per cell
+//   and stored as runs as well, so that the result stays small even for huge selections.
 // Arguments:
 // - includeCRLF - inject CRLF pairs to the end of each line
 // - trimTrailingWhitespace - remove the trailing whitespace at the end of each line
@@ -1711,7 +2027,7 @@ void TextBuffer::_ExpandTextRow(til::inclusive_rect& textRow) const
 // - GetAttributeColors - function used to map TextAttribute to RGB COLORREFs. If null, only extract the text.
 // - formatWrappedRows - if set we will apply formatting (CRLF inclusion and whitespace trimming) on wrapped rows
 // Return Value:
-// - The text, background color, and foreground color data of the selected region of the text buffer.
+// - The text and color runs of the selected region of the text buffer.
 const TextBuffer::TextAndColor TextBuffer::GetText(const bool includeCRLF,
                                                    const bool trimTrailingWhitespace,
                                                    const std::vector<til::inclusive_rect>& selectionRects,
@@ -1726,61 +2042,71 @@ const TextBuffer::TextAndColor TextBuffer::GetText(const bool includeCRLF,
     data.text.reserve(rows);
     if (copyTextColor)
     {
-        data.FgAttr.reserve(rows);
-        data.BkAttr.reserve(rows);
+        data.colorRuns.reserve(rows);
     }
 
     // for each row in the selection
     for (size_t i = 0; i < rows; i++)
     {
-        const auto iRow = selectionRects.at(i).Top;
-
-        const auto highlight = Viewport::FromInclusive(selectionRects.at(i));
-
-        // retrieve the data from the screen buffer
-        auto it = GetCellDataAt(highlight.Origin(), highlight);
+        const auto& selectionRect = selectionRects.at(i);
+        const auto& row = GetRowByOffset(selectionRect.Top);
+        const auto& charRow = row.GetCharRow();
 
         // allocate a string buffer
         std::wstring selectionText;
-        std::vector<COLORREF> selectionFgAttr;
-        std::vector<COLORREF> selectionBkAttr;
+        std::vector<TextAndColor::ColorRun> selectionColorRuns;
 
         // preallocate to avoid reallocs
-        selectionText.reserve(gsl::narrow<size_t>(highlight.Width()) + 2); // + 2 for \r\n if we munged it
-        if (copyTextColor)
-        {
-            selectionFgAttr.reserve(gsl::narrow<size_t>(highlight.Width()) + 2);
-            selectionBkAttr.reserve(gsl::narrow<size_t>(highlight.Width()) + 2);
-        }
+        selectionText.reserve(gsl::narrow<size_t>(selectionRect.Right - selectionRect.Left + 1) + 2); // + 2 for \r\n if we munged it
+
+        const auto appendColorRun = [&](const COLORREF foreground, const COLORREF background, const size_t length) {
+            if (!selectionColorRuns.empty() && selectionColorRuns.back().foreground == foreground && selectionColorRuns.back().background == background)
+            {
+                selectionColorRuns.back().length += length;
+            }
+            else if (length != 0)
+            {
+                selectionColorRuns.push_back({ foreground, background, length });
+            }
+        };
 
-        // copy char data into the string buffer, skipping trailing bytes
-        while (it)
+        // copy char data into the string buffer, skipping trailing bytes,
+        // one attribute run at a time
+        til::CoordType runBegin = 0;
+        for (const auto& attrRun : row.GetAttrRow().GetRuns())
         {
-            const auto& cell = *it;
+            const auto runEnd = runBegin + attrRun.length;
+            const auto begin = std::max(runBegin, selectionRect.Left);
+            const auto end = std::min(runEnd, selectionRect.Right + 1);
+            runBegin = runEnd;
 
-            if (!cell.DbcsAttr().IsTrailing())
+            if (begin >= end)
             {
-                const auto chars = cell.Chars();
-                selectionText.append(chars);
+                if (runBegin > selectionRect.Right)
+                {
+                    break;
+                }
+                continue;
+            }
 
-                if (copyTextColor)
+            const auto textBefore = selectionText.size();
+            for (auto col = begin; col < end; ++col)
+            {
+                if (!charRow.DbcsAttrAt(col).IsTrailing())
                 {
-                    const auto cellData = cell.TextAttr();
-                    const auto [CellFgAttr, CellBkAttr] = GetAttributeColors(cellData);
-                    for (size_t j = 0; j < chars.size(); ++j)
-                    {
-                        selectionFgAttr.push_back(CellFgAttr);
-                        selectionBkAttr.push_back(CellBkAttr);
-                    }
+                    selectionText.append(charRow.GlyphAt(col));
                 }
             }
-#pragma warning(suppress : 26444)
-            // TODO GH 2675: figure out why there's custom construction/destruction happening here
-            it++;
+
+            if (copyTextColor)
+            {
+                const auto [CellFgAttr, CellBkAttr] = GetAttributeColors(attrRun.value);
+                appendColorRun(CellFgAttr, CellBkAttr, selectionText.size() - textBefore);
+            }
         }
 
         // We apply formatting to rows if the row was NOT wrapped or formatting of wrapped rows is allowed
-        const auto shouldFormatRow = formatWrappedRows || !GetRowByOffset(iRow).WasWrapForced();
+        const auto shouldFormatRow = formatWrappedRows || !row.WasWrapForced();
 
         if (trimTrailingWhitespace)
         {
@@ -1792,8 +2118,10 @@ const TextBuffer::TextAndColor TextBuffer::GetText(const bool includeCRLF,
                     selectionText.pop_back();
                     if (copyTextColor)
                     {
-                        selectionFgAttr.pop_back();
-                        selectionBkAttr.pop_back();
+                        if (--selectionColorRuns.back().length == 0)
+                        {
+                            selectionColorRuns.pop_back();
+                        }
                     }
                 }
             }
@@ -1813,10 +2141,7 @@ const TextBuffer::TextAndColor TextBuffer::GetText(const bool includeCRLF,
                 {
                     // can't see CR/LF so just use black FG & BK
                     const auto Blackness = RGB(0x00, 0x00, 0x00);
-                    selectionFgAttr.push_back(Blackness);
-                    selectionFgAttr.push_back(Blackness);
-                    selectionBkAttr.push_back(Blackness);
-                    selectionBkAttr.push_back(Blackness);
+                    appendColorRun(Blackness, Blackness, 2);
                 }
             }
         }
@@ -1824,8 +2149,7 @@ const TextBuffer::TextAndColor TextBuffer::GetText(const bool includeCRLF,
         data.text.emplace_back(std::move(selectionText));
         if (copyTextColor)
         {
-            data.FgAttr.emplace_back(std::move(selectionFgAttr));
-            data.BkAttr.emplace_back(std::move(selectionBkAttr));
+            data.colorRuns.emplace_back(std::move(selectionColorRuns));
         }
     }
 
@@ -1848,171 +2172,132 @@ std::string TextBuffer::GenHTML(const TextAndColor& rows,
 {
     try
     {
-        std::ostringstream htmlBuilder;
+        ChunkedStringBuilder htmlBuilder;
 
         // First we have to add some standard
         // HTML boiler plate required for CF_HTML
         // as part of the HTML Clipboard format
-        const std::string htmlHeader =
+        constexpr std::string_view htmlHeader =
             "<!DOCTYPE><HTML><HEAD></HEAD><BODY>";
-        htmlBuilder << htmlHeader;
+        htmlBuilder.Append(htmlHeader);
 
-        htmlBuilder << "<!--StartFragment -->";
+        htmlBuilder.Append("<!--StartFragment -->");
 
         // apply global style in div element
         {
-            htmlBuilder << "<DIV STYLE=\"";
-            htmlBuilder << "display:inline-block;";
-            htmlBuilder << "white-space:pre;";
-
-            htmlBuilder << "background-color:";
-            htmlBuilder << Utils::ColorToHexString(backgroundColor);
-            htmlBuilder << ";";
-
-            htmlBuilder << "font-family:";
-            htmlBuilder << "'";
-            htmlBuilder << ConvertToA(CP_UTF8, fontFaceName);
-            htmlBuilder << "',";
+            htmlBuilder.Append("<DIV STYLE=\"");
+            htmlBuilder.Append("display:inline-block;");
+            htmlBuilder.Append("white-space:pre;");
+
+            htmlBuilder.Append("background-color:");
+            htmlBuilder.AppendColor(backgroundColor);
+            htmlBuilder.Append(";");
+
+            htmlBuilder.Append("font-family:");
+            htmlBuilder.Append("'");
+            htmlBuilder.Append(til::u16u8(fontFaceName));
+            htmlBuilder.Append("',");
             // even with different font, add monospace as fallback
-            htmlBuilder << "monospace;";
+            htmlBuilder.Append("monospace;");
 
-            htmlBuilder << "font-size:";
-            htmlBuilder << fontHeightPoints;
-            htmlBuilder << "pt;";
+            htmlBuilder.AppendFormatted(FMT_COMPILE("font-size:{}pt;"), fontHeightPoints);
 
             // note: MS Word doesn't support padding (in this way at least)
-            htmlBuilder << "padding:";
-            htmlBuilder << 4; // todo: customizable padding
-            htmlBuilder << "px;";
+            htmlBuilder.AppendFormatted(FMT_COMPILE("padding:{}px;"), 4); // todo: customizable padding
 
-            htmlBuilder << "\">";
+            htmlBuilder.Append("\">");
         }
 
         // copy text and info color from buffer
         auto hasWrittenAnyText = false;
         std::optional<COLORREF> fgColor = std::nullopt;
         std::optional<COLORREF> bkColor = std::nullopt;
+        std::string utf8Text;
         for (size_t row = 0; row < rows.text.size(); row++)
         {
-            size_t startOffset = 0;
-
             if (row != 0)
             {
-                htmlBuilder << "<BR>";
+                htmlBuilder.Append("<BR>");
             }
 
-            for (size_t col = 0; col < rows.text.at(row).length(); col++)
+            const auto rowText = TrimLineBreak(rows.text.at(row));
+            size_t offset = 0;
+            for (const auto& run : rows.colorRuns.at(row))
             {
-                const auto writeAccumulatedChars = [&](bool includeCurrent) {
-                    if (col >= startOffset)
-                    {
-                        const auto unescapedText = ConvertToA(CP_UTF8, std::wstring_view(rows.text.at(row)).substr(startOffset, col - startOffset + includeCurrent));
-                        for (const auto c : unescapedText)
-                        {
-                            switch (c)
-                            {
-                            case '<':
-                                htmlBuilder << "&lt;";
-                                break;
-                            case '>':
-                                htmlBuilder << "&gt;";
-                                break;
-                            case '&':
-                                htmlBuilder << "&amp;";
-                                break;
-                            default:
-                                htmlBuilder << c;
-                            }
-                        }
-
-                        startOffset = col;
-                    }
-                };
-
-                if (rows.text.at(row).at(col) == '\r' || rows.text.at(row).at(col) == '\n')
+                if (offset >= rowText.size())
                 {
-                    // do not include \r nor \n as they don't have color attributes
-                    // and are not HTML friendly. For line break use '<BR>' instead.
-                    writeAccumulatedChars(false);
                     break;
                 }
 
-                auto colorChanged = false;
-                if (!fgColor.has_value() || rows.FgAttr.at(row).at(col) != fgColor.value())
+                if (fgColor != run.foreground || bkColor != run.background)
                 {
-                    fgColor = rows.FgAttr.at(row).at(col);
-                    colorChanged = true;
-                }
-
-                if (!bkColor.has_value() || rows.BkAttr.at(row).at(col) != bkColor.value())
-                {
-                    bkColor = rows.BkAttr.at(row).at(col);
-                    colorChanged = true;
-                }
-
-                if (colorChanged)
-                {
-                    writeAccumulatedChars(false);
+                    fgColor = run.foreground;
+                    bkColor = run.background;
 
                     if (hasWrittenAnyText)
                     {
-                        htmlBuilder << "</SPAN>";
+                        htmlBuilder.Append("</SPAN>");
                     }
 
-                    htmlBuilder << "<SPAN STYLE=\"";
-                    htmlBuilder << "color:";
-                    htmlBuilder << Utils::ColorToHexString(fgColor.value());
-                    htmlBuilder << ";";
-                    htmlBuilder << "background-color:";
-                    htmlBuilder << Utils::ColorToHexString(bkColor.value());
-                    htmlBuilder << ";";
-                    htmlBuilder << "\">";
+                    htmlBuilder.Append("<SPAN STYLE=\"");
+                    htmlBuilder.Append("color:");
+                    htmlBuilder.AppendColor(run.foreground);
+                    htmlBuilder.Append(";");
+                    htmlBuilder.Append("background-color:");
+                    htmlBuilder.AppendColor(run.background);
+                    htmlBuilder.Append(";");
+                    htmlBuilder.Append("\">");
                 }
 
                 hasWrittenAnyText = true;
 
-                // if this is the last character in the row, flush the whole row
-                if (col == rows.text.at(row).length() - 1)
-                {
-                    writeAccumulatedChars(true);
-                }
+                THROW_IF_FAILED(til::u16u8(rowText.substr(offset, run.length), utf8Text));
+                AppendHTMLText(htmlBuilder, utf8Text);
+                offset += run.length;
             }
         }
 
         if (hasWrittenAnyText)
         {
             // last opened span wasn't closed in loop above, so close it now
-            htmlBuilder << "</SPAN>";
+            htmlBuilder.Append("</SPAN>");
         }
 
-        htmlBuilder << "</DIV>";
+        htmlBuilder.Append("</DIV>");
 
-        htmlBuilder << "<!--EndFragment -->";
+        htmlBuilder.Append("<!--EndFragment -->");
 
         constexpr std::string_view HtmlFooter = "</BODY></HTML>";
-        htmlBuilder << HtmlFooter;
+        htmlBuilder.Append(HtmlFooter);
 
         // once filled with values, there will be exactly 157 bytes in the clipboard header
         constexpr size_t ClipboardHeaderSize = 157;
 
         // these values are byte offsets from start of clipboard
         const auto htmlStartPos = ClipboardHeaderSize;
-        const auto htmlEndPos = ClipboardHeaderSize + gsl::narrow<size_t>(htmlBuilder.tellp());
-        const auto fragStartPos = ClipboardHeaderSize + gsl::narrow<size_t>(htmlHeader.length());
+        const auto htmlEndPos = ClipboardHeaderSize + htmlBuilder.Size();
+        const auto fragStartPos = ClipboardHeaderSize + htmlHeader.length();
         const auto fragEndPos = htmlEndPos - HtmlFooter.length();
 
         // header required by HTML 0.9 format
-        std::ostringstream clipHeaderBuilder;
-        clipHeaderBuilder << "Version:0.9\r\n";
-        clipHeaderBuilder << std::setfill('0');
-        clipHeaderBuilder << "StartHTML:" << std::setw(10) << htmlStartPos << "\r\n";
-        clipHeaderBuilder << "EndHTML:" << std::setw(10) << htmlEndPos << "\r\n";
-        clipHeaderBuilder << "StartFragment:" << std::setw(10) << fragStartPos << "\r\n";
-        clipHeaderBuilder << "EndFragment:" << std::setw(10) << fragEndPos << "\r\n";
-        clipHeaderBuilder << "StartSelection:" << std::setw(10) << fragStartPos << "\r\n";
-        clipHeaderBuilder << "EndSelection:" << std::setw(10) << fragEndPos << "\r\n";
-
-        return clipHeaderBuilder.str() + htmlBuilder.str();
+        std::string html;
+        html.reserve(ClipboardHeaderSize + htmlBuilder.Size());
+        fmt::format_to(std::back_inserter(html),
+                       FMT_COMPILE("Version:0.9\r\n"
+                                   "StartHTML:{:010}\r\n"
+                                   "EndHTML:{:010}\r\n"
+                                   "StartFragment:{:010}\r\n"
+                                   "EndFragment:{:010}\r\n"
+                                   "StartSelection:{:010}\r\n"
+                                   "EndSelection:{:010}\r\n"),
+                       htmlStartPos,
+                       htmlEndPos,
+                       fragStartPos,
+                       fragEndPos,
+                       fragStartPos,
+                       fragEndPos);
+        htmlBuilder.CopyTo(html);
+        return html;
     }
     catch (...)
     {
@@ -2036,22 +2321,6 @@ std::string TextBuffer::GenRTF(const TextAndColor& rows, const int fontHeightPoi
 {
     try
     {
-        std::ostringstream rtfBuilder;
-
-        // start rtf
-        rtfBuilder << "{";
-
-        // Standard RTF header.
-        // This is similar to the header generated by WordPad.
-        // \ansi - specifies that the ANSI char set is used in the current doc
-        // \ansicpg1252 - represents the ANSI code page which is used to perform the Unicode to ANSI conversion when writing RTF text
-        // \deff0 - specifies that the default font for the document is the one at index 0 in the font table
-        // \nouicompat - ?
-        rtfBuilder << "\\rtf1\\ansi\\ansicpg1252\\deff0\\nouicompat";
-
-        // font table
-        rtfBuilder << "{\\fonttbl{\\f0\\fmodern\\fcharset0 " << ConvertToA(CP_UTF8, fontFaceName) << ";}}";
-
         // map to keep track of colors:
         // keys are colors represented by COLORREF
         // values are indices of the corresponding colors in the color table
@@ -2059,133 +2328,94 @@ std::string TextBuffer::GenRTF(const TextAndColor& rows, const int fontHeightPoi
         auto nextColorIndex = 1; // leave 0 for the default color and start from 1.
 
         // RTF color table
-        std::ostringstream colorTableBuilder;
-        colorTableBuilder << "{\\colortbl ;";
-        colorTableBuilder << "\\red" << static_cast<int>(GetRValue(backgroundColor))
-                          << "\\green" << static_cast<int>(GetGValue(backgroundColor))
-                          << "\\blue" << static_cast<int>(GetBValue(backgroundColor))
-                          << ";";
-        colorMap[backgroundColor] = nextColorIndex++;
+        ChunkedStringBuilder colorTableBuilder;
+        colorTableBuilder.Append("{\\colortbl ;");
+        const auto getColorIndex = [&](const COLORREF color) {
+            const auto [it, inserted] = colorMap.emplace(color, nextColorIndex);
+            if (inserted)
+            {
+                // color not present in the map, so add it
+                colorTableBuilder.AppendFormatted(FMT_COMPILE("\\red{}\\green{}\\blue{};"), GetRValue(color), GetGValue(color), GetBValue(color));
+                nextColorIndex++;
+            }
+            return it->second;
+        };
+        getColorIndex(backgroundColor);
 
         // content
-        std::ostringstream contentBuilder;
-        contentBuilder << "\\viewkind4\\uc4";
+        ChunkedStringBuilder contentBuilder;
+        contentBuilder.Append("\\viewkind4\\uc4");
 
         // paragraph styles
         // \fs specifies font size in half-points i.e. \fs20 results in a font size
         // of 10 pts. That's why, font size is multiplied by 2 here.
-        contentBuilder << "\\pard\\slmult1\\f0\\fs" << std::to_string(2 * fontHeightPoints)
-                       << "\\highlight1"
-                       << " ";
+        contentBuilder.AppendFormatted(FMT_COMPILE("\\pard\\slmult1\\f0\\fs{}\\highlight1 "), 2 * fontHeightPoints);
 
         std::optional<COLORREF> fgColor = std::nullopt;
         std::optional<COLORREF> bkColor = std::nullopt;
         for (size_t row = 0; row < rows.text.size(); ++row)
         {
-            size_t startOffset = 0;
-
             if (row != 0)
             {
-                contentBuilder << "\\line "; // new line
+                contentBuilder.Append("\\line "); // new line
             }
 
-            for (size_t col = 0; col < rows.text.at(row).length(); ++col)
+            const auto rowText = TrimLineBreak(rows.text.at(row));
+            size_t offset = 0;
+            for (const auto& run : rows.colorRuns.at(row))
             {
-                const auto writeAccumulatedChars = [&](bool includeCurrent) {
-                    if (col >= startOffset)
-                    {
-                        const auto text = std::wstring_view{ rows.text.at(row) }.substr(startOffset, col - startOffset + includeCurrent);
-                        _AppendRTFText(contentBuilder, text);
-
-                        startOffset = col;
-                    }
-                };
-
-                if (rows.text.at(row).at(col) == '\r' || rows.text.at(row).at(col) == '\n')
+                if (offset >= rowText.size())
                 {
-                    // do not include \r nor \n as they don't have color attributes.
-                    // For line break use \line instead.
-                    writeAccumulatedChars(false);
                     break;
                 }
 
-                auto colorChanged = false;
-                if (!fgColor.has_value() || rows.FgAttr.at(row).at(col) != fgColor.value())
+                if (fgColor != run.foreground || bkColor != run.background)
                 {
-                    fgColor = rows.FgAttr.at(row).at(col);
-                    colorChanged = true;
-                }
+                    fgColor = run.foreground;
+                    bkColor = run.background;
 
-                if (!bkColor.has_value() || rows.BkAttr.at(row).at(col) != bkColor.value())
-                {
-                    bkColor = rows.BkAttr.at(row).at(col);
-                    colorChanged = true;
+                    const auto bkColorIndex = getColorIndex(run.background);
+                    const auto fgColorIndex = getColorIndex(run.foreground);
+                    contentBuilder.AppendFormatted(FMT_COMPILE("\\highlight{}\\cf{} "), bkColorIndex, fgColorIndex);
                 }
 
-                if (colorChanged)
-                {
-                    writeAccumulatedChars(false);
+                AppendRTFText(contentBuilder, rowText.substr(offset, run.length));
+                offset += run.length;
+            }
+        }
 
-                    auto bkColorIndex = 0;
-                    if (colorMap.find(bkColor.value()) != colorMap.end())
-                    {
-                        // color already exists in the map, just retrieve the index
-                        bkColorIndex = colorMap[bkColor.value()];
-                    }
-                    else
-                    {
-                        // color not present in the map, so add it
-                        colorTableBuilder << "\\red" << static_cast<int>(GetRValue(bkColor.value()))
-                                          << "\\green" << static_cast<int>(GetGValue(bkColor.value()))
-                                          << "\\blue" << static_cast<int>(GetBValue(bkColor.value()))
-                                          << ";";
-                        colorMap[bkColor.value()] = nextColorIndex;
-                        bkColorIndex = nextColorIndex++;
-                    }
+        // end colortbl
+        colorTableBuilder.Append("}");
 
-                    auto fgColorIndex = 0;
-                    if (colorMap.find(fgColor.value()) != colorMap.end())
-                    {
-                        // color already exists in the map, just retrieve the index
-                        fgColorIndex = colorMap[fgColor.value()];
-                    }
-                    else
-                    {
-                        // color not present in the map, so add it
-                        colorTableBuilder << "\\red" << static_cast<int>(GetRValue(fgColor.value()))
-                                          << "\\green" << static_cast<int>(GetGValue(fgColor.value()))
-                                          << "\\blue" << static_cast<int>(GetBValue(fgColor.value()))
-                                          << ";";
-                        colorMap[fgColor.value()] = nextColorIndex;
-                        fgColorIndex = nextColorIndex++;
-                    }
+        std::string rtf;
+        rtf.reserve(colorTableBuilder.Size() + contentBuilder.Size() + 128);
 
-                    contentBuilder << "\\highlight" << bkColorIndex
-                                   << "\\cf" << fgColorIndex
-                                   << " ";
-                }
+        // start rtf
+        rtf.append("{");
 
-                // if this is the last character in the row, flush the whole row
-                if (col == rows.text.at(row).length() - 1)
-                {
-                    writeAccumulatedChars(true);
-                }
-            }
-        }
+        // Standard RTF header.
+        // This is similar to the header generated by WordPad.
+        // \ansi - specifies that the ANSI char set is used in the current doc
+        // \ansicpg1252 - represents the ANSI code page which is used to perform the Unicode to ANSI conversion when writing RTF text
+        // \deff0 - specifies that the default font for the document is the one at index 0 in the font table
+        // \nouicompat - ?
+        rtf.append("\\rtf1\\ansi\\ansicpg1252\\deff0\\nouicompat");
 
-        // end colortbl
-        colorTableBuilder << "}";
+        // font table
+        rtf.append("{\\fonttbl{\\f0\\fmodern\\fcharset0 ");
+        rtf.append(til::u16u8(fontFaceName));
+        rtf.append(";}}");
 
         // add color table to the final RTF
-        rtfBuilder << colorTableBuilder.str();
+        colorTableBuilder.CopyTo(rtf);
 
         // add the text content to the final RTF
-        rtfBuilder << contentBuilder.str();
+        contentBuilder.CopyTo(rtf);
 
         // end rtf
-        rtfBuilder << "}";
+        rtf.append("}");
 
-        return rtfBuilder.str();
+        return rtf;
     }
     catch (...)
     {
@@ -2194,31 +2424,6 @@ std::string TextBuffer::GenRTF(const TextAndColor& rows, const int fontHeightPoi
     }
 }
 
-void TextBuffer::_AppendRTFText(std::ostringstream& contentBuilder, const std::wstring_view& text)
-{
-    for (const auto codeUnit : text)
-    {
-        if (codeUnit <= 127)
-        {
-            switch (codeUnit)
-            {
-            case L'\\':
-            case L'{':
-            case L'}':
-                contentBuilder << "\\" << gsl::narrow<char>(codeUnit);
-                break;
-            default:
-                contentBuilder << gsl::narrow<char>(codeUnit);
-            }
-        }
-        else
-        {
-            // Windows uses unsigned wchar_t - RTF uses signed ones.
-            contentBuilder << "\\u" << std::to_string(til::bit_cast<int16_t>(codeUnit)) << "?";
-        }
-    }
-}
-
 // Function Description:
 // - Reflow the contents from the old buffer into the new buffer. The new buffer
 //   can have different dimensions than the old buffer. If it does, then this
@@ -2240,6 +2445,8 @@ HRESULT TextBuffer::Reflow(TextBuffer& oldBuffer,
                            const std::optional<Viewport> lastCharacterViewport,
                            std::optional<std::reference_wrapper<PositionInformation>> positionInfo)
 {
+    TIL_TRACE_SPAN("reflow", "TextBuffer::Reflow");
+
     const auto& oldCursor = oldBuffer.GetCursor();
     auto& newCursor = newBuffer.GetCursor();
 
@@ -2715,6 +2922,18 @@ PointTree TextBuffer::GetPatterns(const til::CoordType firstRow, const til::Coor
         concatAll += row.GetText();
     }
 
+    // The buffer stores one code point per cell, so that's what the columns need to be counted by.
+    const auto countColumns = [](const std::wstring_view text) {
+        til::CoordType columns = 0;
+        const GraphemeClusters codepoints{ text, GraphemeClusterIterator::Segmentation::Codepoints };
+        for (auto it = codepoints.begin(); it != codepoints.end(); ++it)
+        {
+            columns += it.Columns();
+        }
+        return columns;
+    };
+    const std::wstring_view concatView{ concatAll };
+
     // for each pattern we know of, iterate through the string
     for (const auto& idAndPattern : _idsAndPatterns)
     {
@@ -2731,20 +2950,10 @@ PointTree TextBuffer::GetPatterns(const til::CoordType firstRow, const til::Coor
             // when we find a match, the prefix is text that is between this
             // match and the previous match, so we use the size of the prefix
             // along with the size of the match to determine the locations
-            til::CoordType prefixSize = 0;
-            for (const auto parsedGlyph : Utf16Parser::Parse(i->prefix().str()))
-            {
-                const std::wstring_view glyph{ parsedGlyph.data(), parsedGlyph.size() };
-                prefixSize += IsGlyphFullWidth(glyph) ? 2 : 1;
-            }
-            const auto start = lenUpToThis + prefixSize;
-            til::CoordType matchSize = 0;
-            for (const auto parsedGlyph : Utf16Parser::Parse(i->str()))
-            {
-                const std::wstring_view glyph{ parsedGlyph.data(), parsedGlyph.size() };
-                matchSize += IsGlyphFullWidth(glyph) ? 2 : 1;
-            }
-            const auto end = start + matchSize;
+            const auto prefix = i->prefix();
+            const auto prefixOffset = gsl::narrow_cast<size_t>(prefix.first - concatAll.cbegin());
+            const auto start = lenUpToThis + countColumns(concatView.substr(prefixOffset, gsl::narrow_cast<size_t>(prefix.length())));
+            const auto end = start + countColumns(concatView.substr(gsl::narrow_cast<size_t>(i->position()), gsl::narrow_cast<size_t>(i->length())));
             lenUpToThis = end;
 
             const til::point startCoord{ start % rowSize, start / rowSize };
@@ -2761,3 +2970,25 @@ PointTree TextBuffer::GetPatterns(const til::CoordType firstRow, const til::Coor
     PointTree result(std::move(intervals));
     return result;
 }
+
+// Method Description:
+// - Adds up the memory used by the rows and the side tables of the buffer. The
+//   heap allocations of the standard containers are estimates, see til::heap_usage.
+// Return value:
+// - The number of bytes used by each component of the buffer
+TextBuffer::MemoryStats TextBuffer::GetMemoryStats() const noexcept
+{
+    MemoryStats stats;
+    stats.rows = _storage.capacity() * sizeof(ROW);
+    for (const auto& row : _storage)
+    {
+        stats.cells += row.GetCharRow().GetHeapUsage();
+        stats.attributes += row.GetAttrRow().GetHeapUsage();
+        stats.largestRow = std::max(stats.largestRow, row.GetMemoryUsage());
+    }
+    stats.attributeTable = _attributeTable.GetHeapUsage();
+    stats.unicodeStorage = _unicodeStorage.GetHeapUsage();
+    stats.hyperlinks = til::heap_usage(_hyperlinkMap) + til::heap_usage(_hyperlinkCustomIdMap);
+    stats.patterns = til::heap_usage(_idsAndPatterns);
+    return stats;
+}
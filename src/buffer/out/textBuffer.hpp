@@ -54,6 +54,7 @@ filling in the last row, and updating the screen.
 #include "cursor.h"
 #include "Row.hpp"
 #include "TextAttribute.hpp"
+#include "TextAttributeTable.hpp"
 #include "UnicodeStorage.hpp"
 #include "../types/inc/Viewport.hpp"
 
@@ -101,6 +102,10 @@ public:
                                  const std::optional<bool> setWrap = std::nullopt,
                                  const std::optional<til::CoordType> limitRight = std::nullopt);
 
+    OutputCellIterator WriteIfChanged(const OutputCellIterator givenIt,
+                                      const til::point target,
+                                      const std::optional<bool> wrap = true);
+
     bool InsertCharacter(const wchar_t wch, const DbcsAttribute dbcsAttribute, const TextAttribute attr);
     bool InsertCharacter(const std::wstring_view chars, const DbcsAttribute dbcsAttribute, const TextAttribute attr);
     bool IncrementCursor();
@@ -108,6 +113,7 @@ public:
 
     // Scroll needs access to this to quickly rotate around the buffer.
     bool IncrementCircularBuffer(const bool inVtMode = false);
+    uint64_t GetCircularBufferIncrements() const noexcept;
 
     til::point GetLastNonSpaceCharacter(std::optional<const Microsoft::Console::Types::Viewport> viewOptional = std::nullopt) const;
 
@@ -119,6 +125,7 @@ public:
     const Microsoft::Console::Types::Viewport GetSize() const noexcept;
 
     void ScrollRows(const til::CoordType firstRow, const til::CoordType size, const til::CoordType delta);
+    void CopyRectangle(const Microsoft::Console::Types::Viewport& source, const til::point targetOrigin);
 
     til::CoordType TotalRowCount() const noexcept;
 
@@ -143,6 +150,9 @@ public:
     const UnicodeStorage& GetUnicodeStorage() const noexcept;
     UnicodeStorage& GetUnicodeStorage() noexcept;
 
+    const TextAttributeTable& GetAttributeTable() const noexcept;
+    TextAttributeTable& GetAttributeTable() noexcept;
+
     void SetAsActiveBuffer(const bool isActiveBuffer) noexcept;
     bool IsActiveBuffer() const noexcept;
 
@@ -177,9 +187,19 @@ public:
     class TextAndColor
     {
     public:
+        // A piece of a row's text that is drawn in the same colors.
+        struct ColorRun
+        {
+            COLORREF foreground;
+            COLORREF background;
+            // The number of UTF-16 code units of the row's text this run covers.
+            size_t length;
+        };
+
         std::vector<std::wstring> text;
-        std::vector<std::vector<COLORREF>> FgAttr;
-        std::vector<std::vector<COLORREF>> BkAttr;
+        // The color runs of each row, covering its text from left to right.
+        // This is empty if the colors weren't requested.
+        std::vector<std::vector<ColorRun>> colorRuns;
     };
 
     const TextAndColor GetText(const bool includeCRLF,
@@ -214,13 +234,46 @@ public:
     void CopyPatterns(const TextBuffer& OtherBuffer);
     interval_tree::IntervalTree<til::point, size_t> GetPatterns(const til::CoordType firstRow, const til::CoordType lastRow) const;
 
+    // The number of bytes the buffer occupies, broken down by component.
+    struct MemoryStats
+    {
+        // The rows themselves, including the cells and the attribute runs each row stores inline.
+        size_t rows{ 0 };
+        // The cells of rows that are too wide to be stored inline.
+        size_t cells{ 0 };
+        // The attribute runs of rows that use more than two attributes.
+        size_t attributes{ 0 };
+        // The distinct attributes the rows refer to.
+        size_t attributeTable{ 0 };
+        // The glyphs that don't fit into a single cell.
+        size_t unicodeStorage{ 0 };
+        size_t hyperlinks{ 0 };
+        size_t patterns{ 0 };
+        // The number of bytes used by the row that uses the most memory.
+        size_t largestRow{ 0 };
+
+        size_t Total() const noexcept
+        {
+            return rows + cells + attributes + attributeTable + unicodeStorage + hyperlinks + patterns;
+        }
+    };
+
+    MemoryStats GetMemoryStats() const noexcept;
+
 private:
+    OutputCellIterator _WriteLineIfChanged(const OutputCellIterator givenIt,
+                                           const til::point target,
+                                           const std::optional<bool> wrap);
+
     void _UpdateSize();
     Microsoft::Console::Types::Viewport _size;
+    // The rows refer to the attributes in this table, so it has to outlive them.
+    TextAttributeTable _attributeTable;
     std::vector<ROW> _storage;
     Cursor _cursor;
 
     til::CoordType _firstRow; // indexes top row (not necessarily 0)
+    uint64_t _circularBufferIncrements{ 0 }; // the number of rows that scrolled out at the top so far
 
     TextAttribute _currentAttributes;
 
@@ -260,8 +313,6 @@ private:
 
     void _PruneHyperlinks();
 
-    static void _AppendRTFText(std::ostringstream& contentBuilder, const std::wstring_view& text);
-
     std::unordered_map<size_t, std::wstring> _idsAndPatterns;
     size_t _currentPatternId;
 
@@ -0,0 +1,172 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "WexTestClass.h"
+#include "../../inc/consoletaeftemplates.hpp"
+
+#include "../AttrRow.hpp"
+#include "../TextAttributeTable.hpp"
+
+using namespace WEX::Common;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+
+class TextAttributeTableTests
+{
+    TEST_CLASS(TextAttributeTableTests);
+
+    // Returns a distinct attribute for every i < 2^24.
+    static TextAttribute _attribute(const size_t i) noexcept
+    {
+        return TextAttribute{ gsl::narrow_cast<COLORREF>(i), RGB(0, 0, 0) };
+    }
+
+    TEST_METHOD(InternDeduplicates)
+    {
+        TextAttributeTable table;
+        const TextAttribute red{ FOREGROUND_RED };
+        const TextAttribute blue{ FOREGROUND_BLUE };
+
+        VERIFY_ARE_EQUAL(TextAttributeTable::DefaultId, table.Intern(TextAttribute{}));
+
+        const auto redId = table.Intern(red);
+        const auto blueId = table.Intern(blue);
+        VERIFY_ARE_NOT_EQUAL(redId, blueId);
+        VERIFY_ARE_EQUAL(redId, table.Intern(red));
+        VERIFY_ARE_EQUAL(blueId, table.Intern(TextAttribute{ FOREGROUND_BLUE }));
+        VERIFY_ARE_EQUAL(3u, table.Size());
+
+        VERIFY_ARE_EQUAL(red, table.Resolve(redId));
+        VERIFY_ARE_EQUAL(blue, table.Resolve(blueId));
+        VERIFY_ARE_EQUAL(redId, table.Find(red).value());
+        VERIFY_IS_FALSE(table.Find(TextAttribute{ FOREGROUND_GREEN }).has_value());
+    }
+
+    TEST_METHOD(CollectRecyclesIdsOfChangedRows)
+    {
+        TextAttributeTable table;
+        const TextAttribute red{ FOREGROUND_RED };
+        const TextAttribute green{ FOREGROUND_GREEN };
+        const TextAttribute blue{ FOREGROUND_BLUE };
+
+        ATTR_ROW row{ 10, red, table };
+        std::optional<ATTR_ROW> other{ std::in_place, 10, green, table };
+        table.Collect();
+        VERIFY_IS_TRUE(table.Find(red).has_value());
+        VERIFY_IS_TRUE(table.Find(green).has_value());
+
+        Log::Comment(L"An attribute that was overwritten is recycled.");
+        row.Replace(0, 10, blue);
+        table.Collect();
+        VERIFY_IS_FALSE(table.Find(red).has_value());
+        VERIFY_ARE_EQUAL(blue, row.GetAttrByColumn(0));
+
+        Log::Comment(L"The attributes of a destroyed row are recycled.");
+        other.reset();
+        table.Collect();
+        VERIFY_IS_FALSE(table.Find(green).has_value());
+
+        Log::Comment(L"Unchanged rows keep their ids.");
+        const auto blueId = table.Find(blue).value();
+        table.Collect();
+        VERIFY_ARE_EQUAL(blueId, table.Find(blue).value());
+        VERIFY_ARE_EQUAL(2u, table.Size());
+
+        Log::Comment(L"Interned attributes that no row uses are recycled.");
+        const auto redId = table.Intern(red);
+        table.Collect();
+        VERIFY_IS_FALSE(table.Find(red).has_value());
+        VERIFY_ARE_EQUAL(redId, table.Intern(green));
+    }
+
+    TEST_METHOD(RecyclesUnusedIdsWhileInterning)
+    {
+        TextAttributeTable table;
+        std::vector<ATTR_ROW> live;
+        live.reserve(5000);
+
+        // Only every other attribute stays in use.
+        ATTR_ROW scratch{ 1, TextAttribute{}, table };
+        for (size_t i = 1; i <= 10000; ++i)
+        {
+            if (i % 2)
+            {
+                live.emplace_back(1, _attribute(i), table);
+            }
+            else
+            {
+                scratch.Replace(0, 1, _attribute(i));
+            }
+        }
+
+        // The ids of the attributes that were overwritten got recycled along the way.
+        VERIFY_IS_LESS_THAN(table.Size(), 10000u);
+        size_t mismatches = 0;
+        for (size_t i = 0; i < live.size(); ++i)
+        {
+            mismatches += live[i].GetAttrByColumn(0) != _attribute(i * 2 + 1);
+        }
+        VERIFY_ARE_EQUAL(0u, mismatches);
+        VERIFY_ARE_EQUAL(_attribute(10000), scratch.GetAttrByColumn(0));
+    }
+
+    TEST_METHOD(AttributesSurviveExhaustingSixteenBitIds)
+    {
+        TextAttributeTable table;
+        constexpr size_t count = 70000;
+        std::vector<ATTR_ROW> rows;
+        rows.reserve(count);
+
+        for (size_t i = 1; i <= count; ++i)
+        {
+            rows.emplace_back(1, _attribute(i), table);
+        }
+        table.Collect();
+
+        // Every attribute is still in use, so none of them may be recycled or replaced.
+        VERIFY_ARE_EQUAL(count + 1, table.Size());
+        size_t mismatches = 0;
+        for (size_t i = 0; i < count; ++i)
+        {
+            mismatches += rows[i].GetAttrByColumn(0) != _attribute(i + 1);
+        }
+        VERIFY_ARE_EQUAL(0u, mismatches);
+
+        // Rows that are moved around, like when the buffer scrolls, keep their attributes as well.
+        std::rotate(rows.begin(), rows.begin() + 1000, rows.end());
+        rows.erase(rows.end() - 1000, rows.end());
+        table.Collect();
+        VERIFY_ARE_EQUAL(count - 1000 + 1, table.Size());
+        for (size_t i = 0; i < count - 1000; ++i)
+        {
+            mismatches += rows[i].GetAttrByColumn(0) != _attribute(i + 1001);
+        }
+        VERIFY_ARE_EQUAL(0u, mismatches);
+    }
+
+    TEST_METHOD(CopyRowBetweenTables)
+    {
+        TextAttributeTable source;
+        TextAttributeTable target;
+        const TextAttribute red{ FOREGROUND_RED };
+        const TextAttribute blue{ FOREGROUND_BLUE };
+
+        // Intern the attributes in a different order, so that their ids differ.
+        target.Intern(blue);
+
+        ATTR_ROW sourceRow{ 10, red, source };
+        sourceRow.Replace(2, 5, blue);
+        ATTR_ROW targetRow{ 10, TextAttribute{}, target };
+        targetRow = sourceRow;
+
+        const std::vector<TextAttribute> expected{ red, red, blue, blue, blue, red, red, red, red, red };
+        VERIFY_IS_TRUE(expected == (std::vector<TextAttribute>{ targetRow.begin(), targetRow.end() }));
+        VERIFY_IS_TRUE(sourceRow == targetRow);
+        VERIFY_ARE_EQUAL(3u, targetRow.GetRuns().size());
+
+        targetRow.ReplaceAttrs(blue, TextAttribute{});
+        VERIFY_ARE_EQUAL(TextAttribute{}, targetRow.GetAttrByColumn(3));
+        VERIFY_IS_FALSE(sourceRow == targetRow);
+    }
+};
@@ -5,6 +5,7 @@
 #include "WexTestClass.h"
 #include "../../inc/consoletaeftemplates.hpp"
 #include "../../../renderer/inc/RenderSettings.hpp"
+#include "../../../types/inc/ColorFix.hpp"
 
 #include "../TextAttribute.hpp"
 
@@ -25,6 +26,7 @@ class TextAttributeTests
     TEST_METHOD(TestReverseDefaultColors);
     TEST_METHOD(TestRoundtripDefaultColors);
     TEST_METHOD(TestIntenseAsBright);
+    TEST_METHOD(TestAdjustedRgbColors);
 
     RenderSettings _renderSettings;
     const COLORREF _defaultFg = RGB(1, 2, 3);
@@ -325,3 +327,45 @@ void TextAttributeTests::TestIntenseAsBright()
     // Restore the default IntenseIsBright mode.
     _renderSettings.SetRenderMode(RenderSettings::Mode::IntenseIsBright, true);
 }
+
+void TextAttributeTests::TestAdjustedRgbColors()
+{
+    if constexpr (!Feature_AdjustIndistinguishableText::IsEnabled())
+    {
+        Log::Result(TestResults::Skipped);
+        return;
+    }
+
+    const auto darkGray = RGB(30, 30, 30);
+    const auto black = RGB(0, 0, 0);
+    const auto expected = ColorFix::GetPerceivableColor(darkGray, black);
+    VERIFY_ARE_NOT_EQUAL(darkGray, expected);
+
+    TextAttribute attr{ darkGray, black };
+    VERIFY_ARE_EQUAL(std::make_pair(darkGray, black), _renderSettings.GetAttributeColors(attr));
+
+    _renderSettings.SetRenderMode(RenderSettings::Mode::DistinguishableColors, true);
+    auto restoreMode = wil::scope_exit([&] { _renderSettings.SetRenderMode(RenderSettings::Mode::DistinguishableColors, false); });
+
+    Log::Comment(L"RGB colors are adjusted like indexed ones. The second lookup is served from the cache.");
+    VERIFY_ARE_EQUAL(std::make_pair(expected, black), _renderSettings.GetAttributeColors(attr));
+    VERIFY_ARE_EQUAL(std::make_pair(expected, black), _renderSettings.GetAttributeColors(attr));
+
+    Log::Comment(L"Colors that differ only in the bits implied by the cache index mustn't be mixed up.");
+    const auto otherBlack = RGB(1, 0, 0);
+    attr.SetBackground(otherBlack);
+    VERIFY_ARE_EQUAL(std::make_pair(ColorFix::GetPerceivableColor(darkGray, otherBlack), otherBlack), _renderSettings.GetAttributeColors(attr));
+
+    Log::Comment(L"Reverse video adjusts the swapped colors.");
+    attr.SetBackground(black);
+    attr.SetReverseVideo(true);
+    VERIFY_ARE_EQUAL(std::make_pair(ColorFix::GetPerceivableColor(black, darkGray), darkGray), _renderSettings.GetAttributeColors(attr));
+    attr.SetReverseVideo(false);
+
+    Log::Comment(L"Identical and faint colors are left alone.");
+    attr.SetForeground(black);
+    VERIFY_ARE_EQUAL(std::make_pair(black, black), _renderSettings.GetAttributeColors(attr));
+    attr.SetForeground(darkGray);
+    attr.SetFaint(true);
+    VERIFY_ARE_EQUAL(std::make_pair((darkGray >> 1) & 0x7F7F7F, black), _renderSettings.GetAttributeColors(attr));
+}
@@ -444,8 +444,7 @@ namespace winrt::TerminalApp::implementation
 
                 if (!path.empty())
                 {
-                    const auto buffer = control.ReadEntireBuffer();
-                    CascadiaSettings::ExportFile(path, buffer);
+                    co_await control.ExportBufferAsync(path, BufferExportFormat::PlainText);
                 }
             }
         }
@@ -14,6 +14,8 @@
 #include "../../types/inc/Environment.hpp"
 #include "LibraryResources.h"
 
+#include <til/io_reactor.h>
+
 using namespace ::Microsoft::Console;
 using namespace std::string_view_literals;
 
@@ -37,12 +39,154 @@ static constexpr auto _errorFormat = L"{0} ({0:#010x})"sv;
 
 namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
 {
+    // All connections read their output on a single reactor with a few workers,
+    // instead of one thread each. It's intentionally leaked, because its workers
+    // must not be joined while the module is being unloaded.
+    static til::io_reactor& _outputReactor()
+    {
+        static const auto reactor = [] {
+            til::io_reactor_options options;
+            options.workers = std::clamp<size_t>(std::thread::hardware_concurrency() / 4, 2, 4);
+            return new til::io_reactor{ options };
+        }();
+        return *reactor;
+    }
+
+    // Reads the output of a pseudoconsole on the output reactor and hands it to its connection.
+    // Our own output pipes are read with overlapped I/O on the thread pool's completion port.
+    // Pipes received in a handoff don't support that, so each of their reads blocks a thread
+    // pool thread instead. The reader holds a reference to its connection until the end.
+    struct ConptyConnection::OutputReader final : til::io_reactor::source
+    {
+        OutputReader(ConptyConnection& connection, const bool overlapped) :
+            _connection{ connection.get_strong() },
+            _pipe{ connection._outPipe.get() }
+        {
+            _drained.create(wil::EventOptions::ManualReset);
+
+            if (overlapped)
+            {
+                _io.reset(CreateThreadpoolIo(_pipe, &_ioCallback, this, nullptr));
+                THROW_LAST_ERROR_IF(!_io);
+            }
+        }
+
+        void begin_read(til::io_reactor& reactor, gsl::span<char> buffer) noexcept override
+        {
+            _reactor = &reactor;
+            _buffer = buffer;
+
+            if (!_io)
+            {
+                if (!TrySubmitThreadpoolCallback(&_readCallback, this, nullptr))
+                {
+                    reactor.complete(*this, 0, GetLastError());
+                }
+                return;
+            }
+
+            _overlapped = {};
+            StartThreadpoolIo(_io.get());
+            if (!ReadFile(_pipe, _buffer.data(), gsl::narrow_cast<DWORD>(_buffer.size()), nullptr, &_overlapped))
+            {
+                const auto lastError = GetLastError();
+                if (lastError != ERROR_IO_PENDING)
+                {
+                    CancelThreadpoolIo(_io.get());
+                    reactor.complete(*this, 0, lastError);
+                }
+            }
+        }
+
+        void consume(std::string_view data) override
+        {
+            _connection->_OnOutput(data);
+        }
+
+        void end(uint32_t error) override
+        {
+            // Our reference to the connection is released once we're done,
+            // because the connection holds onto us to wait for the end.
+            const auto connection = std::move(_connection);
+            const auto signal = wil::scope_exit([&]() noexcept { _drained.SetEvent(); });
+            connection->_OnOutputEnd(error);
+        }
+
+        // Waits until all output was handed to the connection.
+        void WaitForEnd() const noexcept
+        {
+            LOG_LAST_ERROR_IF(WAIT_FAILED == WaitForSingleObject(_drained.get(), INFINITE));
+        }
+
+    private:
+        static void CALLBACK _ioCallback(PTP_CALLBACK_INSTANCE /*instance*/, PVOID context, PVOID /*overlapped*/, ULONG result, ULONG_PTR bytesTransferred, PTP_IO /*io*/) noexcept
+        try
+        {
+            const auto self = static_cast<OutputReader*>(context);
+            self->_reactor->complete(*self, bytesTransferred, result);
+        }
+        CATCH_LOG()
+
+        static void CALLBACK _readCallback(PTP_CALLBACK_INSTANCE instance, PVOID context) noexcept
+        try
+        {
+            // The read blocks until the conpty writes something, which may take arbitrarily long.
+            CallbackMayRunLong(instance);
+
+            const auto self = static_cast<OutputReader*>(context);
+            DWORD read{};
+            const auto lastError = ReadFile(self->_pipe, self->_buffer.data(), gsl::narrow_cast<DWORD>(self->_buffer.size()), &read, nullptr) ? ERROR_SUCCESS : GetLastError();
+            self->_reactor->complete(*self, read, lastError);
+        }
+        CATCH_LOG()
+
+        winrt::com_ptr<ConptyConnection> _connection;
+        HANDLE _pipe;
+        wil::unique_event _drained;
+        wil::unique_threadpool_io _io;
+        til::io_reactor* _reactor = nullptr;
+        gsl::span<char> _buffer;
+        OVERLAPPED _overlapped{};
+    };
+
+    // Function Description:
+    // - creates a pipe for reading the output of the conpty. Unlike an anonymous pipe, our
+    //   side of it supports overlapped I/O, so that it can be read on the shared output reactor.
+    // Arguments:
+    // - read: Receives our side of the pipe, opened for overlapped reads.
+    // - write: Receives the conpty's side of the pipe, opened for synchronous writes.
+    static HRESULT _CreateOverlappedOutputPipe(wil::unique_hfile& read, wil::unique_hfile& write) noexcept
+    try
+    {
+        // Without a buffer, every write of the pseudoconsole would block until we've read it.
+        // This is larger than the reactor's reads, so that it can keep writing while we process a read.
+        static constexpr DWORD bufferSize = 64 * 1024;
+        static std::atomic<uint32_t> counter;
+        const auto name = fmt::format(FMT_COMPILE(L"\\\\.\\pipe\\WindowsTerminal-{}-{}-output"), GetCurrentProcessId(), counter.fetch_add(1, std::memory_order_relaxed));
+
+        // FILE_FLAG_FIRST_PIPE_INSTANCE makes this fail if anyone else created a pipe with this name before us.
+        read.reset(CreateNamedPipeW(name.c_str(),
+                                    PIPE_ACCESS_INBOUND | FILE_FLAG_OVERLAPPED | FILE_FLAG_FIRST_PIPE_INSTANCE,
+                                    PIPE_TYPE_BYTE | PIPE_READMODE_BYTE | PIPE_WAIT | PIPE_REJECT_REMOTE_CLIENTS,
+                                    1,
+                                    bufferSize,
+                                    bufferSize,
+                                    0,
+                                    nullptr));
+        RETURN_LAST_ERROR_IF(!read);
+
+        write.reset(CreateFileW(name.c_str(), GENERIC_WRITE, 0, nullptr, OPEN_EXISTING, 0, nullptr));
+        RETURN_LAST_ERROR_IF(!write);
+        return S_OK;
+    }
+    CATCH_RETURN()
+
     // Function Description:
-    // - creates some basic anonymous pipes and passes them to CreatePseudoConsole
+    // - creates the pipes for a conpty and passes them to CreatePseudoConsole
     // Arguments:
     // - size: The size of the conpty to create, in characters.
     // - phInput: Receives the handle to the newly-created anonymous pipe for writing input to the conpty.
-    // - phOutput: Receives the handle to the newly-created anonymous pipe for reading the output of the conpty.
+    // - phOutput: Receives the handle to the newly-created overlapped pipe for reading the output of the conpty.
     // - phPc: Receives a token value to identify this conpty
 #pragma warning(suppress : 26430) // This statement sufficiently checks the out parameters. Analyzer cannot find this.
     static HRESULT _CreatePseudoConsoleAndPipes(const COORD size, const DWORD dwFlags, HANDLE* phInput, HANDLE* phOutput, HPCON* phPC) noexcept
@@ -53,7 +197,7 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
         wil::unique_hfile inPipeOurSide, inPipePseudoConsoleSide;
 
         RETURN_IF_WIN32_BOOL_FALSE(CreatePipe(&inPipePseudoConsoleSide, &inPipeOurSide, nullptr, 0));
-        RETURN_IF_WIN32_BOOL_FALSE(CreatePipe(&outPipeOurSide, &outPipePseudoConsoleSide, nullptr, 0));
+        RETURN_IF_FAILED(_CreateOverlappedOutputPipe(outPipeOurSide, outPipePseudoConsoleSide));
         RETURN_IF_FAILED(ConptyCreatePseudoConsole(size, inPipePseudoConsoleSide.get(), outPipePseudoConsoleSide.get(), dwFlags, phPC));
         *phInput = inPipeOurSide.release();
         *phOutput = outPipeOurSide.release();
@@ -297,6 +441,7 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
 
         // If we do not have pipes already, then this is a fresh connection... not an inbound one that is a received
         // handoff from an already-started PTY process.
+        auto overlappedOutput = false;
         if (!_inPipe)
         {
             DWORD flags = PSEUDOCONSOLE_RESIZE_QUIRK | PSEUDOCONSOLE_WIN32_INPUT_MODE;
@@ -310,6 +455,7 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
             }
 
             THROW_IF_FAILED(_CreatePseudoConsoleAndPipes(til::unwrap_coord_size(dimensions), flags, &_inPipe, &_outPipe, &_hPC));
+            overlappedOutput = true;
 
             if (_initialParentHwnd != 0)
             {
@@ -349,27 +495,11 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
 
         _startTime = std::chrono::high_resolution_clock::now();
 
-        // Create our own output handling thread
+        // Start reading our output on the shared reactor.
         // This must be done after the pipes are populated.
         // Each connection needs to make sure to drain the output from its backing host.
-        _hOutputThread.reset(CreateThread(
-            nullptr,
-            0,
-            [](LPVOID lpParameter) noexcept {
-                const auto pInstance = static_cast<ConptyConnection*>(lpParameter);
-                if (pInstance)
-                {
-                    return pInstance->_OutputThread();
-                }
-                return gsl::narrow_cast<DWORD>(E_INVALIDARG);
-            },
-            this,
-            0,
-            nullptr));
-
-        THROW_LAST_ERROR_IF_NULL(_hOutputThread);
-
-        LOG_IF_FAILED(SetThreadDescription(_hOutputThread.get(), L"ConptyConnection Output Thread"));
+        _outputReader = std::make_shared<OutputReader>(*this, overlappedOutput);
+        _outputReactor().add(_outputReader);
 
         _clientExitWait.reset(CreateThreadpoolWait(
             [](PTP_CALLBACK_INSTANCE /*callbackInstance*/, PVOID context, PTP_WAIT /*wait*/, TP_WAIT_RESULT /*waitResult*/) noexcept {
@@ -450,9 +580,9 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
 
         // Close the pseudoconsole and wait for all output to drain.
         _hPC.reset();
-        if (auto localOutputThreadHandle = std::move(_hOutputThread))
+        if (const auto localOutputReader = std::move(_outputReader))
         {
-            LOG_LAST_ERROR_IF(WAIT_FAILED == WaitForSingleObject(localOutputThreadHandle.get(), INFINITE));
+            localOutputReader->WaitForEnd();
         }
 
         _indicateExitWithStatus(exitCode);
@@ -542,12 +672,11 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
             _inPipe.reset(); // break the pipes
             _outPipe.reset();
 
-            if (_hOutputThread)
+            if (const auto localOutputReader = std::move(_outputReader))
             {
-                // Tear down our output thread -- now that the output pipe was closed on the
+                // Tear down our output reader -- now that the output pipe was closed on the
                 // far side, we can run down our local reader.
-                LOG_LAST_ERROR_IF(WAIT_FAILED == WaitForSingleObject(_hOutputThread.get(), INFINITE));
-                _hOutputThread.reset();
+                localOutputReader->WaitForEnd();
             }
 
             if (_piClient.hProcess)
@@ -594,72 +723,83 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
         return commandline.to_hstring();
     }
 
-    DWORD ConptyConnection::_OutputThread()
+    // Method Description:
+    // - called by our output reader with each chunk of output of the pseudoconsole,
+    //   in the order it was read. It's never called concurrently.
+    void ConptyConnection::_OnOutput(const std::string_view data)
     {
-        // Keep us alive until the output thread terminates; the destructor
-        // won't wait for us, and the known exit points _do_.
-        auto strongThis{ get_strong() };
-
-        // process the data of the output pipe in a loop
-        while (true)
+        if (_outputFailed)
         {
-            DWORD read{};
+            return;
+        }
 
-            const auto readFail{ !ReadFile(_outPipe.get(), _buffer.data(), gsl::narrow_cast<DWORD>(_buffer.size()), &read, nullptr) };
-            if (readFail) // reading failed (we must check this first, because read will also be 0.)
+        const auto result{ til::u8u16(data, _u16Str, _u8State) };
+        if (FAILED(result))
+        {
+            _outputFailed = true;
+            if (_isStateAtOrBeyond(ConnectionState::Closing))
             {
-                const auto lastError = GetLastError();
-                if (lastError != ERROR_BROKEN_PIPE && !_isStateAtOrBeyond(ConnectionState::Closing))
-                {
-                    // EXIT POINT
-                    _indicateExitWithStatus(HRESULT_FROM_WIN32(lastError)); // print a message
-                    _transitionToState(ConnectionState::Failed);
-                    return gsl::narrow_cast<DWORD>(HRESULT_FROM_WIN32(lastError));
-                }
-                // else we call convertUTF8ChunkToUTF16 with an empty string_view to convert possible remaining partials to U+FFFD
+                // This termination was expected.
+                return;
             }
 
-            const auto result{ til::u8u16(std::string_view{ _buffer.data(), read }, _u16Str, _u8State) };
-            if (FAILED(result))
-            {
-                if (_isStateAtOrBeyond(ConnectionState::Closing))
-                {
-                    // This termination was expected.
-                    return 0;
-                }
-
-                // EXIT POINT
-                _indicateExitWithStatus(result); // print a message
-                _transitionToState(ConnectionState::Failed);
-                return gsl::narrow_cast<DWORD>(result);
-            }
+            // EXIT POINT
+            _indicateExitWithStatus(result); // print a message
+            _transitionToState(ConnectionState::Failed);
+            return;
+        }
 
-            if (_u16Str.empty())
-            {
-                return 0;
-            }
+        // The data may have been nothing but the beginning of a multi-byte sequence.
+        if (_u16Str.empty())
+        {
+            return;
+        }
 
-            if (!_receivedFirstByte)
-            {
-                const auto now = std::chrono::high_resolution_clock::now();
-                const std::chrono::duration<double> delta = now - _startTime;
+        if (!_receivedFirstByte)
+        {
+            const auto now = std::chrono::high_resolution_clock::now();
+            const std::chrono::duration<double> delta = now - _startTime;
 
 #pragma warning(suppress : 26477 26485 26494 26482 26446) // We don't control TraceLoggingWrite
-                TraceLoggingWrite(g_hTerminalConnectionProvider,
-                                  "ReceivedFirstByte",
-                                  TraceLoggingDescription("An event emitted when the connection receives the first byte"),
-                                  TraceLoggingGuid(_guid, "SessionGuid", "The WT_SESSION's GUID"),
-                                  TraceLoggingFloat64(delta.count(), "Duration"),
-                                  TraceLoggingKeyword(MICROSOFT_KEYWORD_MEASURES),
-                                  TelemetryPrivacyDataTag(PDT_ProductAndServicePerformance));
-                _receivedFirstByte = true;
-            }
+            TraceLoggingWrite(g_hTerminalConnectionProvider,
+                              "ReceivedFirstByte",
+                              TraceLoggingDescription("An event emitted when the connection receives the first byte"),
+                              TraceLoggingGuid(_guid, "SessionGuid", "The WT_SESSION's GUID"),
+                              TraceLoggingFloat64(delta.count(), "Duration"),
+                              TraceLoggingKeyword(MICROSOFT_KEYWORD_MEASURES),
+                              TelemetryPrivacyDataTag(PDT_ProductAndServicePerformance));
+            _receivedFirstByte = true;
+        }
 
-            // Pass the output to our registered event handlers
-            _TerminalOutputHandlers(_u16Str);
+        // Pass the output to our registered event handlers
+        _TerminalOutputHandlers(_u16Str);
+    }
+
+    // Method Description:
+    // - called by our output reader once the output pipe was closed or reading from it failed.
+    // Arguments:
+    // - error: the error the last read failed with, or 0 if it returned no data.
+    void ConptyConnection::_OnOutputEnd(const uint32_t error)
+    {
+        if (_outputFailed)
+        {
+            return;
         }
 
-        return 0;
+        if (error != ERROR_SUCCESS && error != ERROR_BROKEN_PIPE && !_isStateAtOrBeyond(ConnectionState::Closing))
+        {
+            // EXIT POINT
+            _indicateExitWithStatus(HRESULT_FROM_WIN32(error)); // print a message
+            _transitionToState(ConnectionState::Failed);
+            return;
+        }
+
+        // Convert possible remaining partials to U+FFFD.
+        const auto result{ til::u8u16({}, _u16Str, _u8State) };
+        if (SUCCEEDED(result) && !_u16Str.empty())
+        {
+            _TerminalOutputHandlers(_u16Str);
+        }
     }
 
     static winrt::event<NewConnectionHandler> _newConnectionHandlers;
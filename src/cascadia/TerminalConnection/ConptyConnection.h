@@ -60,6 +60,8 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
         WINRT_CALLBACK(TerminalOutput, TerminalOutputHandler);
 
     private:
+        struct OutputReader;
+
         static HRESULT NewHandoff(HANDLE in, HANDLE out, HANDLE signal, HANDLE ref, HANDLE server, HANDLE client) noexcept;
         static winrt::hstring _commandlineFromProcess(HANDLE process);
 
@@ -83,17 +85,18 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
 
         wil::unique_hfile _inPipe; // The pipe for writing input to
         wil::unique_hfile _outPipe; // The pipe for reading output from
-        wil::unique_handle _hOutputThread;
+        std::shared_ptr<OutputReader> _outputReader;
         wil::unique_process_information _piClient;
         wil::unique_static_pseudoconsole_handle _hPC;
         wil::unique_threadpool_wait _clientExitWait;
 
         til::u8state _u8State{};
         std::wstring _u16Str{};
-        std::array<char, 4096> _buffer{};
+        bool _outputFailed{ false };
         bool _passthroughMode{};
 
-        DWORD _OutputThread();
+        void _OnOutput(const std::string_view data);
+        void _OnOutputEnd(const uint32_t error);
     };
 }
 
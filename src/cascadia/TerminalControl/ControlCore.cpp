@@ -88,6 +88,7 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         _EnsureStaticInitialization();
 
         _settings = winrt::make_self<implementation::ControlSettings>(settings, unfocusedAppearance);
+        _coalesceOutput.store(_settings->SkipUnseenOutput(), std::memory_order_relaxed);
 
         _terminal = std::make_unique<::Microsoft::Terminal::Core::Terminal>();
 
@@ -140,7 +141,9 @@ namespace winrt::Microsoft::Terminal::Control::implementation
             // to paint itself *after* we hand off its ownership to the renderer.
             // We split up construction and initialization of the render thread object this way
             // because the renderer and render thread have circular references to each other.
-            auto renderThread = std::make_unique<::Microsoft::Console::Render::RenderThread>();
+            // All panes of the process paint on the threads of the shared scheduler, which
+            // prioritizes the focused pane and throttles the others (see _updatePaintPriority).
+            auto renderThread = std::make_unique<::Microsoft::Console::Render::RenderThread>(::Microsoft::Console::Render::RenderScheduler::Shared());
             auto* const localPointerToThread = renderThread.get();
 
             // Now create the renderer and initialize the render thread.
@@ -157,6 +160,21 @@ namespace winrt::Microsoft::Terminal::Control::implementation
                 }
             });
 
+            // Only frames of the engine that paints into the swap chain are visible to the user,
+            // not those of the UIA engine. _renderEngine is only compared, so it may still be null.
+            _renderer->SetFrameStartedCallback([this](::Microsoft::Console::Render::IRenderEngine* engine) {
+                if (engine == _renderEngine.get())
+                {
+                    _latencyTracker.OnFrameStarted();
+                }
+            });
+            _renderer->SetFramePresentedCallback([this](::Microsoft::Console::Render::IRenderEngine* engine) {
+                if (engine == _renderEngine.get())
+                {
+                    _latencyTracker.OnFramePresented();
+                }
+            });
+
             THROW_IF_FAILED(localPointerToThread->Initialize(_renderer.get()));
         }
 
@@ -367,6 +385,10 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         }
         else
         {
+            _recordSession([&](auto& recorder) {
+                recorder.RecordInput(wstr);
+            });
+            _latencyTracker.OnInputSent();
             _connection.WriteInput(wstr);
         }
     }
@@ -386,6 +408,8 @@ namespace winrt::Microsoft::Terminal::Control::implementation
                                     const WORD scanCode,
                                     const ::Microsoft::Terminal::Core::ControlKeyStates modifiers)
     {
+        _latencyTracker.BeginInput();
+        const auto endInput = wil::scope_exit([&]() { _latencyTracker.EndInput(); });
         return _terminal->SendCharEvent(ch, scanCode, modifiers);
     }
 
@@ -404,6 +428,13 @@ namespace winrt::Microsoft::Terminal::Control::implementation
                                       const ControlKeyStates modifiers,
                                       const bool keyDown)
     {
+        // Measure the latency of key presses from here, see GetInputLatencyStatistics.
+        if (keyDown)
+        {
+            _latencyTracker.BeginInput();
+        }
+        const auto endInput = wil::scope_exit([&]() { _latencyTracker.EndInput(); });
+
         // Update the selection, if it's present
         // GH#6423 - don't dismiss selection if the key that was pressed was a
         // modifier key. We'll wait for a real keystroke to dismiss the
@@ -680,6 +711,7 @@ namespace winrt::Microsoft::Terminal::Control::implementation
     void ControlCore::UpdateSettings(const IControlSettings& settings, const IControlAppearance& newAppearance)
     {
         _settings = winrt::make_self<implementation::ControlSettings>(settings, newAppearance);
+        _coalesceOutput.store(_settings->SkipUnseenOutput(), std::memory_order_relaxed);
 
         auto lock = _terminal->LockForWriting();
 
@@ -916,6 +948,9 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         const auto hr = _terminal->UserResize({ vp.Width(), vp.Height() });
         if (SUCCEEDED(hr) && hr != S_FALSE)
         {
+            _recordSession([&](auto& recorder) {
+                recorder.RecordResize({ vp.Width(), vp.Height() });
+            });
             _connection.Resize(vp.Height(), vp.Width());
         }
     }
@@ -1039,43 +1074,83 @@ namespace winrt::Microsoft::Terminal::Control::implementation
 
         // extract text from buffer
         // RetrieveSelectedTextFromBuffer will lock while it's reading
-        const auto bufferData = _terminal->RetrieveSelectedTextFromBuffer(singleLine);
+        auto bufferData = _terminal->RetrieveSelectedTextFromBuffer(singleLine);
+
+        const auto bgColor = _terminal->GetAttributeColors({}).second;
+
+        // bufferData is a copy of the selection, so the rest
+        // of the work doesn't need to block the UI thread.
+        _asyncCopyToClipboard(std::move(bufferData),
+                              _actualFont.GetUnscaledSize().Y,
+                              std::wstring{ _actualFont.GetFaceName() },
+                              bgColor,
+                              formats);
+        return true;
+    }
+
+    // Method Description:
+    // - Converts the given selection to text, HTML and RTF on a background thread
+    //   and then raises the CopyToClipboard event with the results.
+    //   Formatting large selections can take a while, and none of it needs the terminal lock.
+    // Arguments:
+    // - bufferData - the text and colors of the selection
+    // - fontHeightPoints - the unscaled font height
+    // - fontFaceName - the name of the font used
+    // - backgroundColor - the default background color
+    // - formats - the formats to generate. nullptr means all of them.
+    // Return Value:
+    // - <none>
+    winrt::fire_and_forget ControlCore::_asyncCopyToClipboard(TextBuffer::TextAndColor bufferData,
+                                                              const int fontHeightPoints,
+                                                              const std::wstring fontFaceName,
+                                                              const COLORREF backgroundColor,
+                                                              const Windows::Foundation::IReference<CopyFormat> formats)
+    {
+        auto weakThis{ get_weak() };
+
+        co_await winrt::resume_background();
 
         // convert text: vector<string> --> string
+        size_t textLength = 0;
+        for (const auto& text : bufferData.text)
+        {
+            textLength += text.size();
+        }
         std::wstring textData;
+        textData.reserve(textLength);
         for (const auto& text : bufferData.text)
         {
             textData += text;
         }
 
-        const auto bgColor = _terminal->GetAttributeColors({}).second;
-
         // convert text to HTML format
         // GH#5347 - Don't provide a title for the generated HTML, as many
         // web applications will paste the title first, followed by the HTML
         // content, which is unexpected.
         const auto htmlData = formats == nullptr || WI_IsFlagSet(formats.Value(), CopyFormat::HTML) ?
                                   TextBuffer::GenHTML(bufferData,
-                                                      _actualFont.GetUnscaledSize().Y,
-                                                      _actualFont.GetFaceName(),
-                                                      bgColor) :
+                                                      fontHeightPoints,
+                                                      fontFaceName,
+                                                      backgroundColor) :
                                   "";
 
         // convert to RTF format
         const auto rtfData = formats == nullptr || WI_IsFlagSet(formats.Value(), CopyFormat::RTF) ?
                                  TextBuffer::GenRTF(bufferData,
-                                                    _actualFont.GetUnscaledSize().Y,
-                                                    _actualFont.GetFaceName(),
-                                                    bgColor) :
+                                                    fontHeightPoints,
+                                                    fontFaceName,
+                                                    backgroundColor) :
                                  "";
 
-        // send data up for clipboard
-        _CopyToClipboardHandlers(*this,
-                                 winrt::make<CopyToClipboardEventArgs>(winrt::hstring{ textData },
-                                                                       winrt::to_hstring(htmlData),
-                                                                       winrt::to_hstring(rtfData),
-                                                                       formats));
-        return true;
+        if (auto core{ weakThis.get() })
+        {
+            // send data up for clipboard
+            core->_CopyToClipboardHandlers(*core,
+                                           winrt::make<CopyToClipboardEventArgs>(winrt::hstring{ textData },
+                                                                                 winrt::to_hstring(htmlData),
+                                                                                 winrt::to_hstring(rtfData),
+                                                                                 formats));
+        }
     }
 
     void ControlCore::SelectAll()
@@ -1424,6 +1499,40 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         return _terminal.get();
     }
 
+    // Method Description:
+    // - Reports how much memory the terminal's buffers and side tables use,
+    //   so that the panes that use the most memory can be found.
+    // Return Value:
+    // - The number of bytes used by each component of the terminal
+    ::Microsoft::Terminal::Core::Terminal::MemoryStats ControlCore::GetMemoryStats() const
+    {
+        auto lock = _terminal->LockForReading();
+        return _terminal->GetMemoryStats();
+    }
+
+    // Method Description:
+    // - Enables or disables measuring the time from a key press until the frame
+    //   that shows its echo was presented. Enabling it discards previous statistics.
+    // Arguments:
+    // - enabled: whether to measure the latency
+    // Return Value:
+    // - <none>
+    void ControlCore::SetInputLatencyTracking(const bool enabled)
+    {
+        _latencyTracker.SetEnabled(enabled);
+    }
+
+    // Method Description:
+    // - Returns the input latencies measured since SetInputLatencyTracking was enabled.
+    //   See LatencyTracker.hpp for what exactly is measured.
+    // Return Value:
+    // - The distribution of the latencies until the input was sent, the output
+    //   arrived and the frame with the output was presented
+    ::Microsoft::Terminal::Core::InputLatencyStatistics ControlCore::GetInputLatencyStatistics() const
+    {
+        return _latencyTracker.GetStatistics();
+    }
+
     // Method Description:
     // - Search text in text buffer. This is triggered if the user click
     //   search button or press enter.
@@ -1701,10 +1810,26 @@ namespace winrt::Microsoft::Terminal::Control::implementation
     {
         try
         {
-            _terminal->Write(hstr);
+            _recordSession([&](auto& recorder) {
+                recorder.RecordOutput(hstr);
+            });
+
+            // The terminal can only skip the output that a single Write pushes out of the buffer
+            // again, but ConPTY hands it out in chunks of at most 16 KiB, which is fewer lines
+            // than the default history has rows. While the previous output is still being written,
+            // which is all the time when a process floods us, the next chunks are collected instead,
+            // so that they're written in one go. Once a batch is being written, all output has to
+            // go through _pendingOutput until it's done, or it'd be written out of order.
+            if (_coalesceOutput.load(std::memory_order_relaxed) || _pendingOutput.IsFlushing())
+            {
+                if (_pendingOutput.Append(hstr))
+                {
+                    _asyncFlushPendingOutput();
+                }
+                return;
+            }
 
-            // Start the throttled update of where our hyperlinks are.
-            _updatePatternLocations->Run();
+            _writeOutput(hstr);
         }
         catch (...)
         {
@@ -1713,6 +1838,38 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         }
     }
 
+    void ControlCore::_writeOutput(const std::wstring_view text)
+    {
+        _terminal->Write(text);
+        _latencyTracker.OnOutput();
+
+        // Start the throttled update of where our hyperlinks are.
+        _updatePatternLocations->Run();
+    }
+
+    // Method Description:
+    // - Writes the output collected by _pendingOutput on a background thread,
+    //   until no more has arrived while the previous batch was being written.
+    winrt::fire_and_forget ControlCore::_asyncFlushPendingOutput()
+    {
+        auto strongThis{ get_strong() };
+        co_await winrt::resume_background();
+
+        std::wstring text;
+        while (_pendingOutput.Take(text))
+        {
+            try
+            {
+                _writeOutput(text);
+            }
+            catch (...)
+            {
+                // Same as in _connectionOutputHandler. The flush has to continue
+                // regardless, because the output thread may be waiting for it.
+            }
+        }
+    }
+
     // Method Description:
     // - Clear the contents of the buffer. The region cleared is given by
     //   clearType:
@@ -1772,6 +1929,135 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         return hstring(ss.str());
     }
 
+    // Method Description:
+    // - Writes the contents of the buffer to the given file in the given format.
+    //   Unlike ReadEntireBuffer, the buffer is never copied as a whole: it's
+    //   copied and formatted in small batches on a background thread and
+    //   streamed to the file, so that the terminal lock is only held briefly.
+    // Arguments:
+    // - path: The file to write to. It's replaced if it already exists.
+    // - format: The format to write the buffer in.
+    // Return Value:
+    // - <none>
+    Windows::Foundation::IAsyncAction ControlCore::ExportBufferAsync(const hstring path, const Control::BufferExportFormat format)
+    {
+        auto strongThis{ get_strong() };
+        co_await winrt::resume_background();
+
+        ::Microsoft::Terminal::Core::BufferExportOptions options;
+        switch (format)
+        {
+        case Control::BufferExportFormat::VirtualTerminal:
+            options.format = ::Microsoft::Terminal::Core::BufferExportFormat::VirtualTerminal;
+            break;
+        case Control::BufferExportFormat::JsonLines:
+            options.format = ::Microsoft::Terminal::Core::BufferExportFormat::JsonLines;
+            break;
+        default:
+            options.format = ::Microsoft::Terminal::Core::BufferExportFormat::PlainText;
+            break;
+        }
+
+        wil::unique_hfile file{ CreateFileW(path.c_str(),
+                                            GENERIC_WRITE,
+                                            FILE_SHARE_READ | FILE_SHARE_DELETE,
+                                            nullptr,
+                                            CREATE_ALWAYS,
+                                            FILE_ATTRIBUTE_NORMAL,
+                                            nullptr) };
+        THROW_LAST_ERROR_IF(!file);
+
+        ::Microsoft::Terminal::Core::BufferExporter exporter{ *_terminal, ::Microsoft::Terminal::Core::BufferExporter::CreateFileSink(file.get()) };
+        const auto result = exporter.Export(options);
+
+        // The buffer keeps changing while it's exported. Don't let the user
+        // believe the file holds everything if rows went missing meanwhile.
+        if (!result.complete || result.droppedRows)
+        {
+            LOG_HR_MSG(E_ABORT, "Buffer export truncated: %zu rows written, %zu rows dropped, complete: %d", result.rows, result.droppedRows, result.complete);
+            const winrt::hstring message{ fmt::format(std::wstring_view{ RS_(L"NoticeBufferExportIncomplete") }, std::wstring_view{ path }, result.rows) };
+            auto noticeArgs = winrt::make<NoticeEventArgs>(NoticeLevel::Warning, message);
+            _RaiseNoticeHandlers(*this, std::move(noticeArgs));
+        }
+    }
+
+    // Method Description:
+    // - Starts recording the output of the connection, the input sent to it
+    //   and any resizes into the given file, replacing any active recording.
+    //   The recording can be replayed with ::Microsoft::Terminal::Core::SessionReplay.
+    // Arguments:
+    // - path: The file to write the recording to.
+    // Return Value:
+    // - <none>
+    void ControlCore::StartSessionRecording(const hstring& path)
+    {
+        std::shared_ptr<::Microsoft::Terminal::Core::SessionRecorder> recorder = ::Microsoft::Terminal::Core::SessionRecorder::CreateForFile(path);
+
+        // The replay needs to know the size the session started out with.
+        try
+        {
+            const auto lock = _terminal->LockForReading();
+            recorder->RecordResize(_terminal->GetViewport().Dimensions());
+        }
+        catch (...)
+        {
+            LOG_CAUGHT_EXCEPTION();
+            return;
+        }
+
+        auto previous = std::exchange(*_sessionRecorder.lock(), std::move(recorder));
+        if (previous)
+        {
+            previous->Flush();
+        }
+    }
+
+    // Method Description:
+    // - Stops the active session recording, if any, and flushes it to disk.
+    void ControlCore::StopSessionRecording()
+    {
+        auto previous = std::exchange(*_sessionRecorder.lock(), nullptr);
+        if (previous)
+        {
+            previous->Flush();
+        }
+    }
+
+    // Method Description:
+    // - Calls func with the active session recorder, if any. A recording must never
+    //   affect the session it records, for instance by losing output when the disk is
+    //   full. So if it fails, the error is logged and the recording is stopped.
+    template<typename Func>
+    void ControlCore::_recordSession(Func&& func) noexcept
+    {
+        const auto recorder = *_sessionRecorder.lock_shared();
+        if (!recorder)
+        {
+            return;
+        }
+
+        try
+        {
+            func(*recorder);
+        }
+        catch (...)
+        {
+            LOG_CAUGHT_EXCEPTION();
+
+            // Unless another recording was started in the meantime.
+            auto active = _sessionRecorder.lock();
+            if (*active == recorder)
+            {
+                *active = nullptr;
+            }
+        }
+    }
+
+    bool ControlCore::IsRecordingSession() const
+    {
+        return *_sessionRecorder.lock_shared() != nullptr;
+    }
+
     // Helper to check if we're on Windows 11 or not. This is used to check if
     // we need to use acrylic to achieve transparency, because vintage opacity
     // doesn't work in islands on win10.
@@ -1920,6 +2206,9 @@ namespace winrt::Microsoft::Terminal::Control::implementation
     // - <none>
     void ControlCore::WindowVisibilityChanged(const bool showOrHide)
     {
+        _windowVisible = showOrHide;
+        _updatePaintPriority();
+
         if (_initializedTerminal)
         {
             // show is true, hide is false
@@ -1960,6 +2249,29 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         const auto previous = std::exchange(_isReadOnly, false);
         const auto restore = wil::scope_exit([&]() { _isReadOnly = previous; });
         _terminal->FocusChanged(focused);
+
+        _focused = focused;
+        _updatePaintPriority();
+    }
+
+    // Method Description:
+    // - Panes of a hidden window aren't painted at all until the window is shown
+    //   again. Visible panes that don't have focus are painted at a reduced rate,
+    //   so that they can't slow down the focused one.
+    void ControlCore::_updatePaintPriority()
+    {
+        using ::Microsoft::Console::Render::PaintPriority;
+
+        auto priority = PaintPriority::Unfocused;
+        if (!_windowVisible)
+        {
+            priority = PaintPriority::Hidden;
+        }
+        else if (_focused)
+        {
+            priority = PaintPriority::Focused;
+        }
+        _renderer->SetPaintPriority(priority);
     }
 
     bool ControlCore::_isBackgroundTransparent()
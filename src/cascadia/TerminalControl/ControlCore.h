@@ -20,8 +20,13 @@
 #include "../../audio/midi/MidiAudio.hpp"
 #include "../../renderer/base/Renderer.hpp"
 #include "../../cascadia/TerminalCore/Terminal.hpp"
+#include "../../cascadia/TerminalCore/SessionRecording.hpp"
+#include "../../cascadia/TerminalCore/BufferExport.hpp"
+#include "../../cascadia/TerminalCore/LatencyTracker.hpp"
+#include "../../cascadia/TerminalCore/OutputCoalescer.hpp"
 #include "../buffer/out/search.h"
 
+#include <til/mutex.h>
 #include <til/ticket_lock.h>
 
 namespace ControlUnitTests
@@ -103,6 +108,9 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         Windows::Foundation::IReference<Core::Point> HoveredCell() const;
 
         ::Microsoft::Console::Types::IUiaData* GetUiaData() const;
+        ::Microsoft::Terminal::Core::Terminal::MemoryStats GetMemoryStats() const;
+        void SetInputLatencyTracking(const bool enabled);
+        ::Microsoft::Terminal::Core::InputLatencyStatistics GetInputLatencyStatistics() const;
 
         void Close();
 
@@ -182,6 +190,11 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         void ToggleReadOnlyMode();
 
         hstring ReadEntireBuffer() const;
+        Windows::Foundation::IAsyncAction ExportBufferAsync(const hstring path, const Control::BufferExportFormat format);
+
+        void StartSessionRecording(const hstring& path);
+        void StopSessionRecording();
+        bool IsRecordingSession() const;
 
         static bool IsVintageOpacityAvailable() noexcept;
 
@@ -233,6 +246,14 @@ namespace winrt::Microsoft::Terminal::Control::implementation
 
         std::unique_ptr<::Microsoft::Terminal::Core::Terminal> _terminal{ nullptr };
 
+        // Accessed from both the UI thread and the connection's output thread.
+        til::shared_mutex<std::shared_ptr<::Microsoft::Terminal::Core::SessionRecorder>> _sessionRecorder;
+        // Hooked into the input, output and render threads. Disabled unless SetInputLatencyTracking was called.
+        ::Microsoft::Terminal::Core::LatencyTracker _latencyTracker;
+        // The connection's output is written in batches while SkipUnseenOutput is enabled. See _connectionOutputHandler.
+        ::Microsoft::Terminal::Core::OutputCoalescer _pendingOutput;
+        std::atomic<bool> _coalesceOutput{ false };
+
         // NOTE: _renderEngine must be ordered before _renderer.
         //
         // As _renderer has a dependency on _renderEngine (through a raw pointer)
@@ -253,6 +274,8 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         uint16_t _lastHoveredId{ 0 };
 
         bool _isReadOnly{ false };
+        bool _focused{ false };
+        bool _windowVisible{ true };
 
         std::optional<interval_tree::IntervalTree<til::point, size_t>::interval> _lastHoveredInterval{ std::nullopt };
 
@@ -270,6 +293,12 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         std::shared_ptr<ThrottledFuncTrailing<Control::ScrollPositionChangedArgs>> _updateScrollBar;
 
         winrt::fire_and_forget _asyncCloseConnection();
+        winrt::fire_and_forget _asyncFlushPendingOutput();
+        winrt::fire_and_forget _asyncCopyToClipboard(TextBuffer::TextAndColor bufferData,
+                                                     const int fontHeightPoints,
+                                                     const std::wstring fontFaceName,
+                                                     const COLORREF backgroundColor,
+                                                     const Windows::Foundation::IReference<CopyFormat> formats);
 
         bool _setFontSizeUnderLock(int fontSize);
         void _updateFont(const bool initialUpdate = false);
@@ -308,11 +337,15 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         void _raiseReadOnlyWarning();
         void _updateAntiAliasingMode();
         void _connectionOutputHandler(const hstring& hstr);
+        template<typename Func>
+        void _recordSession(Func&& func) noexcept;
+        void _writeOutput(const std::wstring_view text);
         void _updateHoveredCell(const std::optional<til::point> terminalPosition);
         void _setOpacity(const double opacity);
 
         bool _isBackgroundTransparent();
         void _focusChanged(bool focused);
+        void _updatePaintPriority();
 
         inline bool _IsClosing() const noexcept
         {
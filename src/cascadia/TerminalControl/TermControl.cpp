@@ -2993,6 +2993,11 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         return _core.ReadEntireBuffer();
     }
 
+    Windows::Foundation::IAsyncAction TermControl::ExportBufferAsync(const hstring& path, const Control::BufferExportFormat format) const
+    {
+        return _core.ExportBufferAsync(path, format);
+    }
+
     Core::Scheme TermControl::ColorScheme() const noexcept
     {
         return _core.ColorScheme();
@@ -0,0 +1,343 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "pch.h"
+#include "BufferExport.hpp"
+#include "Terminal.hpp"
+
+using namespace Microsoft::Terminal::Core;
+
+// Appends an SGR sequence that resets all attributes and then applies the given ones.
+static void appendSgr(std::string& out, const TextAttribute& attr)
+{
+    out.append("\x1b[0");
+
+    if (attr.IsIntense())
+    {
+        out.append(";1");
+    }
+    if (attr.IsFaint())
+    {
+        out.append(";2");
+    }
+    if (attr.IsItalic())
+    {
+        out.append(";3");
+    }
+    if (attr.IsDoublyUnderlined())
+    {
+        out.append(";21");
+    }
+    else if (attr.IsUnderlined())
+    {
+        out.append(";4");
+    }
+    if (attr.IsBlinking())
+    {
+        out.append(";5");
+    }
+    if (attr.IsReverseVideo())
+    {
+        out.append(";7");
+    }
+    if (attr.IsInvisible())
+    {
+        out.append(";8");
+    }
+    if (attr.IsCrossedOut())
+    {
+        out.append(";9");
+    }
+    if (attr.IsOverlined())
+    {
+        out.append(";53");
+    }
+
+    const auto appendColor = [&](const TextColor& color, const bool isForeground) {
+        if (color.IsIndex16())
+        {
+            // See VtEngine::_SetGraphicsRendition16Color.
+            const auto index = color.GetIndex();
+            const auto base = WI_IsFlagSet(index, FOREGROUND_INTENSITY) ? (isForeground ? 90 : 100) : (isForeground ? 30 : 40);
+            fmt::format_to(std::back_inserter(out), FMT_COMPILE(";{}"), base + (index & 7));
+        }
+        else if (color.IsIndex256())
+        {
+            fmt::format_to(std::back_inserter(out), FMT_COMPILE(";{};5;{}"), isForeground ? 38 : 48, color.GetIndex());
+        }
+        else if (color.IsRgb())
+        {
+            const auto rgb = color.GetRGB();
+            fmt::format_to(std::back_inserter(out), FMT_COMPILE(";{};2;{};{};{}"), isForeground ? 38 : 48, GetRValue(rgb), GetGValue(rgb), GetBValue(rgb));
+        }
+    };
+    appendColor(attr.GetForeground(), true);
+    appendColor(attr.GetBackground(), false);
+
+    out.push_back('m');
+}
+
+// Appends the given UTF-8 text as the contents of a JSON string.
+static void appendJsonString(std::string& out, const std::string_view text)
+{
+    for (const auto ch : text)
+    {
+        switch (ch)
+        {
+        case '"':
+            out.append("\\\"");
+            break;
+        case '\\':
+            out.append("\\\\");
+            break;
+        case '\n':
+            out.append("\\n");
+            break;
+        case '\r':
+            out.append("\\r");
+            break;
+        case '\t':
+            out.append("\\t");
+            break;
+        default:
+            if (static_cast<uint8_t>(ch) < 0x20)
+            {
+                fmt::format_to(std::back_inserter(out), FMT_COMPILE("\\u{:04x}"), static_cast<uint8_t>(ch));
+            }
+            else
+            {
+                out.push_back(ch);
+            }
+            break;
+        }
+    }
+}
+
+BufferExporter::BufferExporter(Terminal& terminal, Sink sink) :
+    _terminal{ terminal },
+    _sink{ std::move(sink) }
+{
+}
+
+BufferExporter::Sink BufferExporter::CreateFileSink(HANDLE file)
+{
+    return [file](std::string_view bytes) {
+        while (!bytes.empty())
+        {
+            DWORD written = 0;
+            const auto toWrite = gsl::narrow_cast<DWORD>(std::min<size_t>(bytes.size(), MAXDWORD));
+            THROW_IF_WIN32_BOOL_FALSE(WriteFile(file, bytes.data(), toWrite, &written, nullptr));
+            bytes.remove_prefix(written);
+        }
+    };
+}
+
+// Routine Description:
+// - Writes the requested rows of the terminal's active buffer to the sink.
+// - The terminal must not be locked by the calling thread. The lock is
+//   acquired once per batch of rows and released while they're formatted.
+// Arguments:
+// - options: the format and the range of rows to export
+// Return Value:
+// - The number of rows and bytes that were written.
+BufferExportResult BufferExporter::Export(const BufferExportOptions& options)
+{
+    THROW_HR_IF(E_INVALIDARG, options.rowsPerBatch <= 0);
+
+    _format = options.format;
+    _buffer.clear();
+    _bytesWritten = 0;
+
+    BufferExportResult result;
+    const TextBuffer* buffer = nullptr;
+    til::size size;
+    uint64_t increments = 0;
+    til::CoordType next = std::max(0, options.firstRow);
+    til::CoordType last = 0;
+    // The number of rows the buffer scrolled up since the export started.
+    size_t shifted = 0;
+    std::vector<CapturedRow> batch;
+
+    {
+        const auto lock = _terminal.LockForReading();
+        const auto& textBuffer = _terminal.GetTextBuffer();
+        buffer = &textBuffer;
+        size = textBuffer.GetSize().Dimensions();
+        increments = textBuffer.GetCircularBufferIncrements();
+        last = std::min(options.lastRow.value_or(textBuffer.GetLastNonSpaceCharacter().y), size.height - 1);
+    }
+
+    while (next <= last)
+    {
+        {
+            const auto lock = _terminal.LockForReading();
+            const auto& textBuffer = _terminal.GetTextBuffer();
+            if (&textBuffer != buffer || textBuffer.GetSize().Dimensions() != size)
+            {
+                result.complete = false;
+                break;
+            }
+
+            // Account for any rows that scrolled out at the top since the previous batch.
+            const auto currentIncrements = textBuffer.GetCircularBufferIncrements();
+            if (currentIncrements != increments)
+            {
+                const auto delta = gsl::narrow_cast<til::CoordType>(std::min<uint64_t>(currentIncrements - increments, size.height));
+                increments = currentIncrements;
+                shifted += delta;
+                next -= delta;
+                last -= delta;
+                if (next < 0)
+                {
+                    result.droppedRows += gsl::narrow_cast<size_t>(std::min(-next, last - next + 1));
+                    next = 0;
+                }
+                if (next > last)
+                {
+                    break;
+                }
+            }
+
+            const auto end = std::min(last + 1, next + options.rowsPerBatch);
+            batch.resize(gsl::narrow_cast<size_t>(end - next));
+            for (auto& captured : batch)
+            {
+                const auto& row = textBuffer.GetRowByOffset(next++);
+                const auto& charRow = row.GetCharRow();
+
+                captured.text.clear();
+                captured.runs.clear();
+                captured.wrapForced = row.WasWrapForced();
+
+                til::CoordType column = 0;
+                for (const auto& run : row.GetAttrRow().GetRuns())
+                {
+                    const auto textBefore = captured.text.size();
+                    const auto runEnd = column + run.length;
+                    for (; column < runEnd; ++column)
+                    {
+                        if (!charRow.DbcsAttrAt(column).IsTrailing())
+                        {
+                            captured.text.append(charRow.GlyphAt(column));
+                        }
+                    }
+                    captured.runs.push_back({ run.value, captured.text.size() - textBefore });
+                }
+            }
+        }
+
+        auto rowNumber = gsl::narrow_cast<size_t>(next) - batch.size() + shifted;
+        for (auto& captured : batch)
+        {
+            _formatRow(captured, rowNumber++);
+        }
+        result.rows += batch.size();
+
+        if (_buffer.size() >= FlushThreshold)
+        {
+            _flush();
+        }
+    }
+
+    _flush();
+    result.bytes = _bytesWritten;
+    return result;
+}
+
+// Routine Description:
+// - Formats a single row into the output buffer.
+//   Trailing whitespace is trimmed from rows that didn't wrap onto the next one.
+void BufferExporter::_formatRow(CapturedRow& row, const size_t rowNumber)
+{
+    if (!row.wrapForced)
+    {
+        while (!row.text.empty() && row.text.back() == UNICODE_SPACE)
+        {
+            row.text.pop_back();
+            while (!row.runs.empty() && row.runs.back().length == 0)
+            {
+                row.runs.pop_back();
+            }
+            if (!row.runs.empty())
+            {
+                row.runs.back().length--;
+            }
+        }
+    }
+
+    switch (_format)
+    {
+    case BufferExportFormat::VirtualTerminal:
+        _formatVirtualTerminal(row);
+        break;
+    case BufferExportFormat::JsonLines:
+        _formatJsonLine(row, rowNumber);
+        break;
+    default:
+        THROW_IF_FAILED(til::u16u8(row.text, _scratch));
+        _buffer.append(_scratch);
+        if (!row.wrapForced)
+        {
+            _buffer.append("\r\n");
+        }
+        break;
+    }
+}
+
+// Routine Description:
+// - Formats a row as text, preceding each change of attributes with an SGR sequence.
+//   Each row starts out with the default attributes and resets them at its end,
+//   so that rows can be read individually.
+void BufferExporter::_formatVirtualTerminal(const CapturedRow& row)
+{
+    const TextAttribute defaultAttributes{};
+    auto active = defaultAttributes;
+    const std::wstring_view text{ row.text };
+    size_t offset = 0;
+
+    for (const auto& run : row.runs)
+    {
+        if (run.length == 0)
+        {
+            continue;
+        }
+
+        if (run.attr != active)
+        {
+            appendSgr(_buffer, run.attr);
+            active = run.attr;
+        }
+
+        THROW_IF_FAILED(til::u16u8(text.substr(offset, run.length), _scratch));
+        _buffer.append(_scratch);
+        offset += run.length;
+    }
+
+    if (active != defaultAttributes)
+    {
+        _buffer.append("\x1b[m");
+    }
+    if (!row.wrapForced)
+    {
+        _buffer.append("\r\n");
+    }
+}
+
+void BufferExporter::_formatJsonLine(const CapturedRow& row, const size_t rowNumber)
+{
+    THROW_IF_FAILED(til::u16u8(row.text, _scratch));
+
+    fmt::format_to(std::back_inserter(_buffer), FMT_COMPILE("{{\"row\":{},\"text\":\""), rowNumber);
+    appendJsonString(_buffer, _scratch);
+    _buffer.append(row.wrapForced ? "\",\"wrapped\":true}\n" : "\",\"wrapped\":false}\n");
+}
+
+void BufferExporter::_flush()
+{
+    if (!_buffer.empty())
+    {
+        _sink(_buffer);
+        _bytesWritten += _buffer.size();
+        _buffer.clear();
+    }
+}
@@ -0,0 +1,104 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- BufferExport.hpp
+
+Abstract:
+- Streams the contents of a Terminal's text buffer, or a range of its rows,
+  to a sink as UTF-8 encoded plain text, text with VT (SGR) sequences that
+  reproduce the attributes of the buffer, or JSON lines.
+- The buffer is never copied as a whole: rows are copied out in small batches
+  while holding the read lock, and formatted and written without holding it.
+  Output is handed to the sink in bounded chunks.
+- Since the terminal keeps running during an export, the buffer can scroll
+  between two batches. The exporter keeps track of the rows that scrolled out
+  at the top via TextBuffer::GetCircularBufferIncrements() and continues with
+  the row that followed the previous batch. Rows that scrolled out of the
+  scrollback entirely before they could be copied are counted as dropped.
+--*/
+
+#pragma once
+
+namespace Microsoft::Terminal::Core
+{
+    class Terminal;
+
+    enum class BufferExportFormat
+    {
+        // The text of each row, without trailing whitespace. Rows that were
+        // wrapped are joined with the following one.
+        PlainText,
+        // Like PlainText, but each attribute change is preceded by an SGR sequence.
+        VirtualTerminal,
+        // One JSON object per row: {"row":<number>,"text":"<text>","wrapped":<bool>}
+        JsonLines,
+    };
+
+    struct BufferExportOptions
+    {
+        BufferExportFormat format = BufferExportFormat::PlainText;
+        // The first and last (inclusive) row to export, relative to the top of the buffer
+        // at the time the export started. By default everything up to the last row with
+        // text in it is exported.
+        til::CoordType firstRow = 0;
+        std::optional<til::CoordType> lastRow;
+        // The number of rows copied out of the buffer each time the lock is acquired.
+        til::CoordType rowsPerBatch = 256;
+    };
+
+    struct BufferExportResult
+    {
+        size_t rows = 0;
+        size_t bytes = 0;
+        // Rows that scrolled out of the buffer before they could be exported.
+        size_t droppedRows = 0;
+        // False if the buffer was replaced during the export, for instance because
+        // the terminal was resized or switched to the alternate screen buffer.
+        bool complete = true;
+    };
+
+    class BufferExporter
+    {
+    public:
+        using Sink = std::function<void(std::string_view)>;
+
+        BufferExporter(Terminal& terminal, Sink sink);
+
+        // Returns a sink that writes to the given file handle, which must stay open during the export.
+        static Sink CreateFileSink(HANDLE file);
+
+        [[nodiscard]] BufferExportResult Export(const BufferExportOptions& options);
+
+    private:
+        // Output is buffered and only handed to the sink once this much data accumulated.
+        static constexpr size_t FlushThreshold = 64 * 1024;
+
+        struct CapturedRun
+        {
+            TextAttribute attr;
+            // The number of UTF-16 code units of the row's text this run covers.
+            size_t length;
+        };
+
+        struct CapturedRow
+        {
+            std::wstring text;
+            std::vector<CapturedRun> runs;
+            bool wrapForced = false;
+        };
+
+        void _formatRow(CapturedRow& row, const size_t rowNumber);
+        void _formatVirtualTerminal(const CapturedRow& row);
+        void _formatJsonLine(const CapturedRow& row, const size_t rowNumber);
+        void _flush();
+
+        Terminal& _terminal;
+        Sink _sink;
+        BufferExportFormat _format = BufferExportFormat::PlainText;
+        std::string _buffer;
+        std::string _scratch;
+        size_t _bytesWritten = 0;
+    };
+}
@@ -0,0 +1,247 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "pch.h"
+#include "LatencyTracker.hpp"
+
+#include <bit>
+
+using namespace Microsoft::Terminal::Core;
+
+void LatencyHistogram::Add(const std::chrono::microseconds value) noexcept
+{
+    const auto v = std::min<uint64_t>(gsl::narrow_cast<uint64_t>(std::max<int64_t>(value.count(), 0)), (uint64_t{ 1 } << MaxValueBits) - 1);
+
+    til::at(_buckets, _bucketIndex(v))++;
+    _min = _count ? std::min(_min, v) : v;
+    _max = std::max(_max, v);
+    _sum += v;
+    _count++;
+}
+
+void LatencyHistogram::Clear() noexcept
+{
+    *this = {};
+}
+
+size_t LatencyHistogram::Count() const noexcept
+{
+    return _count;
+}
+
+std::chrono::microseconds LatencyHistogram::Min() const noexcept
+{
+    return std::chrono::microseconds{ gsl::narrow_cast<int64_t>(_min) };
+}
+
+std::chrono::microseconds LatencyHistogram::Max() const noexcept
+{
+    return std::chrono::microseconds{ gsl::narrow_cast<int64_t>(_max) };
+}
+
+std::chrono::microseconds LatencyHistogram::Mean() const noexcept
+{
+    return std::chrono::microseconds{ _count ? gsl::narrow_cast<int64_t>(_sum / _count) : 0 };
+}
+
+std::chrono::microseconds LatencyHistogram::Percentile(const double percentile) const noexcept
+{
+    if (!_count)
+    {
+        return {};
+    }
+
+    // The rank of the value we're looking for, counting from 1.
+    const auto rank = std::clamp<uint64_t>(gsl::narrow_cast<uint64_t>(std::ceil(percentile / 100.0 * _count)), 1, _count);
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BucketCount; ++i)
+    {
+        seen += til::at(_buckets, i);
+        if (seen >= rank)
+        {
+            return std::chrono::microseconds{ gsl::narrow_cast<int64_t>(std::min(_bucketUpperBound(i), _max)) };
+        }
+    }
+
+    return Max();
+}
+
+// The first 8 buckets hold the values 0-7. After that, every power of two is split
+// into 8 buckets: 8-15 are 8 buckets with a width of 1, 16-31 have a width of 2 and so on.
+size_t LatencyHistogram::_bucketIndex(const uint64_t value) noexcept
+{
+    constexpr auto subBuckets = size_t{ 1 } << SubBucketBits;
+    if (value < subBuckets)
+    {
+        return gsl::narrow_cast<size_t>(value);
+    }
+
+    const auto msb = gsl::narrow_cast<size_t>(63 - std::countl_zero(value));
+    const auto shift = msb - SubBucketBits;
+    return ((shift + 1) << SubBucketBits) + gsl::narrow_cast<size_t>((value >> shift) & (subBuckets - 1));
+}
+
+uint64_t LatencyHistogram::_bucketUpperBound(const size_t index) noexcept
+{
+    constexpr auto subBuckets = size_t{ 1 } << SubBucketBits;
+    if (index < subBuckets)
+    {
+        return index;
+    }
+
+    const auto shift = (index >> SubBucketBits) - 1;
+    const auto lower = (uint64_t{ subBuckets } + (index & (subBuckets - 1))) << shift;
+    return lower + (uint64_t{ 1 } << shift) - 1;
+}
+
+// Method Description:
+// - Enables or disables tracking. Any data collected so far is discarded.
+void LatencyTracker::SetEnabled(const bool enabled)
+{
+    Reset();
+    _enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool LatencyTracker::IsEnabled() const noexcept
+{
+    return _enabled.load(std::memory_order_relaxed);
+}
+
+void LatencyTracker::BeginInput()
+{
+    if (!IsEnabled())
+    {
+        return;
+    }
+
+    const auto now = clock::now();
+    const std::lock_guard guard{ _lock };
+    _inputBegin = now;
+}
+
+void LatencyTracker::EndInput()
+{
+    if (!IsEnabled())
+    {
+        return;
+    }
+
+    const std::lock_guard guard{ _lock };
+    _inputBegin.reset();
+}
+
+// Method Description:
+// - Tags the input that is about to be written to the connection, if it belongs
+//   to a key press. Input that doesn't, like responses to queries or pasted text,
+//   isn't tracked and neither is any input after the first for the same key press.
+// Return Value:
+// - The sequence id of the input, or 0 if it isn't tracked.
+uint64_t LatencyTracker::OnInputSent()
+{
+    if (!IsEnabled())
+    {
+        return 0;
+    }
+
+    const auto now = clock::now();
+    const std::lock_guard guard{ _lock };
+
+    if (!_inputBegin)
+    {
+        return 0;
+    }
+
+    if (_pending.size() >= MaxPendingInputs)
+    {
+        _pending.pop_front();
+        _statistics.dropped++;
+    }
+
+    auto& input = _pending.emplace_back();
+    input.id = _nextId++;
+    input.pressed = *_inputBegin;
+    input.sent = now;
+    _inputBegin.reset();
+    return input.id;
+}
+
+// Method Description:
+// - Correlates all inputs that haven't seen any output yet with this chunk.
+// - This is called after the chunk was written into the buffer, because only then
+//   can a frame show it. A frame that starts painting in between will show the
+//   output but won't be attributed to it, overestimating its latency by a frame.
+//   The opposite order would underestimate it, which is worse for a measurement.
+void LatencyTracker::OnOutput()
+{
+    if (!IsEnabled())
+    {
+        return;
+    }
+
+    const auto now = clock::now();
+    const std::lock_guard guard{ _lock };
+
+    _outputSequence++;
+    for (auto it = _pending.rbegin(); it != _pending.rend() && it->outputSequence == 0; ++it)
+    {
+        it->output = now;
+        it->outputSequence = _outputSequence;
+    }
+}
+
+void LatencyTracker::OnFrameStarted()
+{
+    if (!IsEnabled())
+    {
+        return;
+    }
+
+    const std::lock_guard guard{ _lock };
+    _frameOutputSequence = _outputSequence;
+}
+
+// Method Description:
+// - Completes all inputs whose output was written into the buffer before the frame
+//   started painting, because the frame that was just presented contains it.
+void LatencyTracker::OnFramePresented()
+{
+    if (!IsEnabled())
+    {
+        return;
+    }
+
+    const auto now = clock::now();
+    const std::lock_guard guard{ _lock };
+
+    while (!_pending.empty())
+    {
+        const auto& input = _pending.front();
+        if (input.outputSequence == 0 || input.outputSequence > _frameOutputSequence)
+        {
+            break;
+        }
+
+        using std::chrono::duration_cast;
+        using std::chrono::microseconds;
+        _statistics.input.Add(duration_cast<microseconds>(input.sent - input.pressed));
+        _statistics.output.Add(duration_cast<microseconds>(input.output - input.pressed));
+        _statistics.paint.Add(duration_cast<microseconds>(now - input.pressed));
+        _pending.pop_front();
+    }
+}
+
+InputLatencyStatistics LatencyTracker::GetStatistics() const
+{
+    const std::lock_guard guard{ _lock };
+    return _statistics;
+}
+
+void LatencyTracker::Reset()
+{
+    const std::lock_guard guard{ _lock };
+    _inputBegin.reset();
+    _pending.clear();
+    _frameOutputSequence = _outputSequence;
+    _statistics = {};
+}
@@ -0,0 +1,115 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- LatencyTracker.hpp
+
+Abstract:
+- Measures the time from a key press to the frame that shows its result.
+- A key press is tagged with a sequence id once its input is written to the
+  connection. It's then correlated with the first chunk of output that arrives
+  afterwards, which usually is the echo of the input, and with the first frame
+  that is presented after that output was written into the buffer.
+- The latencies are collected into histograms, which can be read at any time.
+- The hooks are called by ControlCore for input and output and by the Renderer
+  for frames, so they can be called from any thread. Tracking is disabled by
+  default, in which case each hook costs a single atomic load.
+--*/
+
+#pragma once
+
+namespace Microsoft::Terminal::Core
+{
+    // A histogram of durations with logarithmic buckets: every power of two microseconds is
+    // split into 8 buckets, which bounds the error of the reported percentiles to 12.5%.
+    class LatencyHistogram
+    {
+    public:
+        void Add(const std::chrono::microseconds value) noexcept;
+        void Clear() noexcept;
+
+        size_t Count() const noexcept;
+        std::chrono::microseconds Min() const noexcept;
+        std::chrono::microseconds Max() const noexcept;
+        std::chrono::microseconds Mean() const noexcept;
+        // Returns an upper bound of the given percentile (0-100) of the recorded values.
+        std::chrono::microseconds Percentile(const double percentile) const noexcept;
+
+    private:
+        static constexpr size_t SubBucketBits = 3;
+        // Values are clamped to 2^40us, which is about 12 days.
+        static constexpr size_t MaxValueBits = 40;
+        static constexpr size_t BucketCount = (MaxValueBits - SubBucketBits + 1) << SubBucketBits;
+
+        static size_t _bucketIndex(const uint64_t value) noexcept;
+        static uint64_t _bucketUpperBound(const size_t index) noexcept;
+
+        std::array<uint64_t, BucketCount> _buckets{};
+        size_t _count = 0;
+        uint64_t _sum = 0;
+        uint64_t _min = 0;
+        uint64_t _max = 0;
+    };
+
+    struct InputLatencyStatistics
+    {
+        // From the key press until its input was written to the connection.
+        LatencyHistogram input;
+        // From the key press until the first output that arrived afterwards was written into the buffer.
+        LatencyHistogram output;
+        // From the key press until the first frame with that output was presented.
+        LatencyHistogram paint;
+        // Key presses that were given up on, because no output followed them.
+        size_t dropped = 0;
+    };
+
+    class LatencyTracker
+    {
+    public:
+        using clock = std::chrono::steady_clock;
+
+        // Key presses whose output is still outstanding beyond this count are dropped, oldest first.
+        // This happens if the connection doesn't echo, for instance while a password is entered.
+        static constexpr size_t MaxPendingInputs = 64;
+
+        void SetEnabled(const bool enabled);
+        bool IsEnabled() const noexcept;
+
+        // A key press is handled between these two calls. The first input
+        // written to the connection in between is attributed to it.
+        void BeginInput();
+        void EndInput();
+        // Returns the sequence id the input was tagged with, or 0 if it isn't tracked.
+        uint64_t OnInputSent();
+        // Called after a chunk of output was written into the buffer.
+        void OnOutput();
+        // Called under the console lock when a frame starts painting and after it was presented.
+        void OnFrameStarted();
+        void OnFramePresented();
+
+        InputLatencyStatistics GetStatistics() const;
+        void Reset();
+
+    private:
+        struct PendingInput
+        {
+            uint64_t id = 0;
+            clock::time_point pressed;
+            clock::time_point sent;
+            clock::time_point output;
+            // The number of the output chunk that followed the input, or 0 if none did yet.
+            uint64_t outputSequence = 0;
+        };
+
+        std::atomic<bool> _enabled{ false };
+        mutable std::mutex _lock;
+        std::optional<clock::time_point> _inputBegin;
+        // Ordered by id. Inputs without output are always at the end.
+        std::deque<PendingInput> _pending;
+        uint64_t _nextId = 1;
+        uint64_t _outputSequence = 0;
+        uint64_t _frameOutputSequence = 0;
+        InputLatencyStatistics _statistics;
+    };
+}
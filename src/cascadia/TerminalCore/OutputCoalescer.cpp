@@ -0,0 +1,43 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "pch.h"
+#include "OutputCoalescer.hpp"
+
+using namespace Microsoft::Terminal::Core;
+
+// Method Description:
+// - Appends the output to the pending output.
+// Return Value:
+// - true if no flush is running and the caller has to start one.
+bool OutputCoalescer::Append(const std::wstring_view text)
+{
+    std::unique_lock lock{ _mutex };
+    _cv.wait(lock, [&]() { return !_flushing || _pending.size() < MaxPendingSize; });
+
+    _pending.append(text);
+    return !std::exchange(_flushing, true);
+}
+
+// Method Description:
+// - Takes all pending output. It's swapped with the given string, whose
+//   contents are discarded, so that both of their allocations are reused.
+// Return Value:
+// - false if there wasn't any pending output, which ends the flush.
+bool OutputCoalescer::Take(std::wstring& text)
+{
+    {
+        const std::scoped_lock lock{ _mutex };
+        text.clear();
+        _pending.swap(text);
+        _flushing = !text.empty();
+    }
+    _cv.notify_all();
+    return !text.empty();
+}
+
+bool OutputCoalescer::IsFlushing() const
+{
+    const std::scoped_lock lock{ _mutex };
+    return _flushing;
+}
@@ -0,0 +1,41 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- OutputCoalescer.hpp
+
+Abstract:
+- Collects the output that arrives from the connection while the previous output
+  is still being written into the buffer, so that it can be written in one go.
+- ConPTY hands out its output in chunks of at most 16 KiB, which is fewer lines
+  than the default history has rows. Terminal::Write can only skip the lines that
+  a single call would push out of the buffer, so it needs the larger batches.
+- The connection's output thread calls Append and, if that returns true, starts
+  a flush on another thread, which calls Take until it returns false.
+--*/
+
+#pragma once
+
+#include <condition_variable>
+
+namespace Microsoft::Terminal::Core
+{
+    class OutputCoalescer
+    {
+    public:
+        // Append blocks while this many characters are pending, so that a process
+        // that outputs faster than we can write it doesn't use up all memory.
+        static constexpr size_t MaxPendingSize = 4 * 1024 * 1024;
+
+        bool Append(const std::wstring_view text);
+        bool Take(std::wstring& text);
+        bool IsFlushing() const;
+
+    private:
+        mutable std::mutex _mutex;
+        std::condition_variable _cv;
+        std::wstring _pending;
+        bool _flushing = false;
+    };
+}
@@ -0,0 +1,360 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "pch.h"
+#include "SessionRecording.hpp"
+#include "Terminal.hpp"
+
+using namespace Microsoft::Terminal::Core;
+
+static constexpr std::string_view recordingMagic{ "WTRC" };
+static constexpr uint8_t recordingVersion = 1;
+
+static void appendVarint(std::string& out, uint64_t value)
+{
+    do
+    {
+        auto byte = gsl::narrow_cast<uint8_t>(value & 0x7f);
+        value >>= 7;
+        if (value)
+        {
+            byte |= 0x80;
+        }
+        out.push_back(static_cast<char>(byte));
+    } while (value);
+}
+
+static uint64_t readVarint(std::string_view& in)
+{
+    uint64_t value = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7)
+    {
+        THROW_HR_IF(E_UNEXPECTED, in.empty());
+        const auto byte = static_cast<uint8_t>(in.front());
+        in.remove_prefix(1);
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if (!(byte & 0x80))
+        {
+            return value;
+        }
+    }
+    THROW_HR(E_UNEXPECTED);
+}
+
+SessionRecorder::SessionRecorder(Sink sink) :
+    _sink{ std::move(sink) }
+{
+    _buffer.append(recordingMagic);
+    _buffer.push_back(static_cast<char>(recordingVersion));
+}
+
+SessionRecorder::~SessionRecorder()
+{
+    try
+    {
+        Flush();
+    }
+    CATCH_LOG()
+}
+
+// Routine Description:
+// - Creates a recorder that writes into the given file, replacing it if it exists.
+std::unique_ptr<SessionRecorder> SessionRecorder::CreateForFile(const std::wstring_view path)
+{
+    const std::wstring pathString{ path };
+    auto file = std::make_shared<wil::unique_hfile>(CreateFileW(pathString.c_str(),
+                                                                GENERIC_WRITE,
+                                                                FILE_SHARE_READ | FILE_SHARE_DELETE,
+                                                                nullptr,
+                                                                CREATE_ALWAYS,
+                                                                FILE_ATTRIBUTE_NORMAL,
+                                                                nullptr));
+    THROW_LAST_ERROR_IF(!*file);
+
+    return std::make_unique<SessionRecorder>([file](std::string_view bytes) {
+        while (!bytes.empty())
+        {
+            DWORD written = 0;
+            const auto toWrite = gsl::narrow_cast<DWORD>(std::min<size_t>(bytes.size(), MAXDWORD));
+            THROW_IF_WIN32_BOOL_FALSE(WriteFile(file->get(), bytes.data(), toWrite, &written, nullptr));
+            bytes.remove_prefix(written);
+        }
+    });
+}
+
+void SessionRecorder::RecordOutput(const std::wstring_view text)
+{
+    _recordText(RecordedEventKind::Output, text, _outputState);
+}
+
+void SessionRecorder::RecordInput(const std::wstring_view text)
+{
+    _recordText(RecordedEventKind::Input, text, _inputState);
+}
+
+void SessionRecorder::RecordResize(const til::size size)
+{
+    std::lock_guard guard{ _lock };
+    _beginEvent(RecordedEventKind::Resize);
+    appendVarint(_buffer, gsl::narrow<uint64_t>(size.width));
+    appendVarint(_buffer, gsl::narrow<uint64_t>(size.height));
+    _flushIfNeeded();
+}
+
+// Routine Description:
+// - Hands all buffered events to the sink.
+void SessionRecorder::Flush()
+{
+    std::lock_guard guard{ _lock };
+    if (!_buffer.empty())
+    {
+        _sink(_buffer);
+        _buffer.clear();
+    }
+}
+
+// Routine Description:
+// - Records a chunk of text. Surrogate pairs split across chunks are
+//   carried over to the next chunk of the same kind by the given state.
+void SessionRecorder::_recordText(const RecordedEventKind kind, const std::wstring_view text, til::u16state& state)
+{
+    if (text.empty())
+    {
+        return;
+    }
+
+    std::lock_guard guard{ _lock };
+    THROW_IF_FAILED(til::u16u8(text, _scratch, state));
+    if (_scratch.empty())
+    {
+        return;
+    }
+
+    _beginEvent(kind);
+    appendVarint(_buffer, _scratch.size());
+    _buffer.append(_scratch);
+    _flushIfNeeded();
+}
+
+// Routine Description:
+// - Writes the kind and timestamp of a new event. The caller must hold _lock.
+void SessionRecorder::_beginEvent(const RecordedEventKind kind)
+{
+    const auto now = std::chrono::steady_clock::now();
+    const auto delta = _hasEvents ? std::chrono::duration_cast<std::chrono::microseconds>(now - _lastEvent) : std::chrono::microseconds::zero();
+    _lastEvent = now;
+    _hasEvents = true;
+
+    _buffer.push_back(static_cast<char>(kind));
+    appendVarint(_buffer, gsl::narrow_cast<uint64_t>(delta.count()));
+}
+
+void SessionRecorder::_flushIfNeeded()
+{
+    if (_buffer.size() >= FlushThreshold)
+    {
+        _sink(_buffer);
+        _buffer.clear();
+    }
+}
+
+// Routine Description:
+// - Parses a recording produced by SessionRecorder.
+// - Throws E_UNEXPECTED if the data is truncated or malformed.
+SessionRecording SessionRecording::Parse(std::string_view bytes)
+{
+    THROW_HR_IF(E_UNEXPECTED, !til::starts_with(bytes, recordingMagic));
+    bytes.remove_prefix(recordingMagic.size());
+    THROW_HR_IF(E_UNEXPECTED, bytes.empty() || static_cast<uint8_t>(bytes.front()) != recordingVersion);
+    bytes.remove_prefix(1);
+
+    SessionRecording recording;
+    std::chrono::microseconds timestamp{};
+
+    while (!bytes.empty())
+    {
+        auto& event = recording._events.emplace_back();
+        event.kind = static_cast<RecordedEventKind>(bytes.front());
+        bytes.remove_prefix(1);
+
+        timestamp += std::chrono::microseconds{ gsl::narrow<int64_t>(readVarint(bytes)) };
+        event.timestamp = timestamp;
+
+        switch (event.kind)
+        {
+        case RecordedEventKind::Output:
+        case RecordedEventKind::Input:
+        {
+            const auto length = readVarint(bytes);
+            THROW_HR_IF(E_UNEXPECTED, length > bytes.size());
+            THROW_IF_FAILED(til::u8u16(bytes.substr(0, gsl::narrow_cast<size_t>(length)), event.text));
+            bytes.remove_prefix(gsl::narrow_cast<size_t>(length));
+            break;
+        }
+        case RecordedEventKind::Resize:
+            event.size.width = gsl::narrow<til::CoordType>(readVarint(bytes));
+            event.size.height = gsl::narrow<til::CoordType>(readVarint(bytes));
+            break;
+        default:
+            THROW_HR(E_UNEXPECTED);
+        }
+    }
+
+    return recording;
+}
+
+SessionRecording SessionRecording::Load(const std::wstring_view path)
+{
+    const std::wstring pathString{ path };
+    wil::unique_hfile file{ CreateFileW(pathString.c_str(),
+                                        GENERIC_READ,
+                                        FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                                        nullptr,
+                                        OPEN_EXISTING,
+                                        FILE_ATTRIBUTE_NORMAL,
+                                        nullptr) };
+    THROW_LAST_ERROR_IF(!file);
+
+    LARGE_INTEGER fileSize{};
+    THROW_IF_WIN32_BOOL_FALSE(GetFileSizeEx(file.get(), &fileSize));
+
+    std::string buffer(gsl::narrow<size_t>(fileSize.QuadPart), '\0');
+    for (size_t offset = 0; offset < buffer.size();)
+    {
+        DWORD read = 0;
+        const auto toRead = gsl::narrow_cast<DWORD>(std::min<size_t>(buffer.size() - offset, MAXDWORD));
+        THROW_IF_WIN32_BOOL_FALSE(ReadFile(file.get(), buffer.data() + offset, toRead, &read, nullptr));
+        THROW_HR_IF(E_UNEXPECTED, read == 0);
+        offset += read;
+    }
+
+    return Parse(buffer);
+}
+
+const std::vector<RecordedEvent>& SessionRecording::Events() const noexcept
+{
+    return _events;
+}
+
+std::chrono::microseconds SessionRecording::Duration() const noexcept
+{
+    return _events.empty() ? std::chrono::microseconds::zero() : _events.back().timestamp;
+}
+
+double ReplayStatistics::CharactersPerSecond() const noexcept
+{
+    const auto seconds = std::chrono::duration<double>(elapsed).count();
+    return seconds > 0 ? static_cast<double>(characters) / seconds : 0.0;
+}
+
+// Routine Description:
+// - Returns the given percentile (0 to 100) of the per-chunk write latencies.
+std::chrono::nanoseconds ReplayStatistics::LatencyPercentile(const double percentile) const
+{
+    if (chunkLatencies.empty())
+    {
+        return {};
+    }
+
+    auto sorted = chunkLatencies;
+    const auto clamped = std::clamp(percentile, 0.0, 100.0);
+    const auto index = gsl::narrow_cast<size_t>(clamped / 100.0 * static_cast<double>(sorted.size() - 1) + 0.5);
+    std::nth_element(sorted.begin(), sorted.begin() + index, sorted.end());
+    return sorted[index];
+}
+
+SessionReplay::SessionReplay(Terminal& terminal) noexcept :
+    _terminal{ terminal }
+{
+}
+
+void SessionReplay::SetPacing(const Pacing pacing) noexcept
+{
+    _pacing = pacing;
+}
+
+void SessionReplay::SetFrameInterval(const std::chrono::nanoseconds interval) noexcept
+{
+    _frameInterval = interval;
+}
+
+void SessionReplay::SetPaintCallback(PaintCallback callback)
+{
+    _paintCallback = std::move(callback);
+}
+
+// Routine Description:
+// - Feeds all output and resize events of the recording into the terminal.
+//   Input events are skipped, as they were consumed by the client application.
+// - Frames are painted whenever at least one frame interval passed since the
+//   last one, just like the render thread would, plus once at the very end.
+// Return Value:
+// - Statistics about the replay.
+ReplayStatistics SessionReplay::Run(const SessionRecording& recording)
+{
+    using clock = std::chrono::steady_clock;
+
+    ReplayStatistics stats;
+    stats.chunkLatencies.reserve(recording.Events().size());
+
+    const auto start = clock::now();
+    auto lastFrame = start;
+    auto dirty = false;
+
+    for (const auto& event : recording.Events())
+    {
+        if (_pacing == Pacing::Original)
+        {
+            std::this_thread::sleep_until(start + event.timestamp);
+        }
+
+        const auto before = clock::now();
+
+        switch (event.kind)
+        {
+        case RecordedEventKind::Output:
+            _terminal.Write(event.text);
+            stats.chunks++;
+            stats.characters += event.text.size();
+            break;
+        case RecordedEventKind::Resize:
+            LOG_IF_FAILED(_terminal.UserResize(event.size));
+            stats.resizes++;
+            break;
+        default:
+            continue;
+        }
+
+        const auto after = clock::now();
+        if (event.kind == RecordedEventKind::Output)
+        {
+            stats.chunkLatencies.emplace_back(after - before);
+        }
+        stats.busy += after - before;
+        dirty = true;
+
+        if (after - lastFrame >= _frameInterval)
+        {
+            _paint(stats);
+            lastFrame = clock::now();
+            dirty = false;
+        }
+    }
+
+    if (dirty)
+    {
+        _paint(stats);
+    }
+
+    stats.elapsed = clock::now() - start;
+    return stats;
+}
+
+void SessionReplay::_paint(ReplayStatistics& stats)
+{
+    if (_paintCallback)
+    {
+        _paintCallback();
+    }
+    stats.frames++;
+}
@@ -0,0 +1,145 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- SessionRecording.hpp
+
+Abstract:
+- A compact, timestamped recording of the traffic of a terminal connection,
+  and a driver that can replay such a recording into a Terminal instance.
+- The recorder is fed with the raw output of the connection, any input
+  written to it and resize events. Each event is stored with the time that
+  elapsed since the previous one, so that a replay can reproduce the original
+  pacing of the session. Alternatively a recording can be replayed as fast as
+  possible to measure the throughput of the parser and the text buffer.
+
+File format (all integers are LEB128 encoded unsigned varints):
+- "WTRC" magic, followed by a single version byte.
+- A sequence of events: a kind byte, the delta to the previous event in
+  microseconds and a kind-specific payload:
+  * Output/Input: byte length + UTF-8 encoded text
+  * Resize: columns + rows
+--*/
+
+#pragma once
+
+namespace Microsoft::Terminal::Core
+{
+    class Terminal;
+
+    enum class RecordedEventKind : uint8_t
+    {
+        Output = 1,
+        Input = 2,
+        Resize = 3,
+    };
+
+    struct RecordedEvent
+    {
+        RecordedEventKind kind{ RecordedEventKind::Output };
+        // Time since the start of the recording.
+        std::chrono::microseconds timestamp{};
+        // UTF-16 text for Output and Input events.
+        std::wstring text;
+        // New viewport size for Resize events.
+        til::size size;
+    };
+
+    class SessionRecorder
+    {
+    public:
+        using Sink = std::function<void(std::string_view)>;
+
+        explicit SessionRecorder(Sink sink);
+        ~SessionRecorder();
+
+        SessionRecorder(const SessionRecorder&) = delete;
+        SessionRecorder& operator=(const SessionRecorder&) = delete;
+        SessionRecorder(SessionRecorder&&) = delete;
+        SessionRecorder& operator=(SessionRecorder&&) = delete;
+
+        static std::unique_ptr<SessionRecorder> CreateForFile(const std::wstring_view path);
+
+        void RecordOutput(const std::wstring_view text);
+        void RecordInput(const std::wstring_view text);
+        void RecordResize(const til::size size);
+        void Flush();
+
+    private:
+        // Output is buffered and only handed to the sink once this much data accumulated.
+        static constexpr size_t FlushThreshold = 64 * 1024;
+
+        void _recordText(const RecordedEventKind kind, const std::wstring_view text, til::u16state& state);
+        void _beginEvent(const RecordedEventKind kind);
+        void _flushIfNeeded();
+
+        std::mutex _lock;
+        Sink _sink;
+        std::string _buffer;
+        std::string _scratch;
+        til::u16state _outputState;
+        til::u16state _inputState;
+        std::chrono::steady_clock::time_point _lastEvent;
+        bool _hasEvents = false;
+    };
+
+    class SessionRecording
+    {
+    public:
+        static SessionRecording Parse(const std::string_view bytes);
+        static SessionRecording Load(const std::wstring_view path);
+
+        const std::vector<RecordedEvent>& Events() const noexcept;
+        std::chrono::microseconds Duration() const noexcept;
+
+    private:
+        std::vector<RecordedEvent> _events;
+    };
+
+    struct ReplayStatistics
+    {
+        size_t chunks = 0;
+        size_t characters = 0;
+        size_t resizes = 0;
+        size_t frames = 0;
+        std::chrono::nanoseconds elapsed{};
+        std::chrono::nanoseconds busy{};
+        // The time it took Terminal::Write to process each output chunk.
+        std::vector<std::chrono::nanoseconds> chunkLatencies;
+
+        double CharactersPerSecond() const noexcept;
+        std::chrono::nanoseconds LatencyPercentile(const double percentile) const;
+    };
+
+    class SessionReplay
+    {
+    public:
+        enum class Pacing
+        {
+            // Waits between events as long as the original session did.
+            Original,
+            // Processes all events back to back.
+            AsFastAsPossible,
+        };
+
+        // Invoked at most once per frame interval to emulate the render thread.
+        using PaintCallback = std::function<void()>;
+
+        explicit SessionReplay(Terminal& terminal) noexcept;
+
+        void SetPacing(const Pacing pacing) noexcept;
+        void SetFrameInterval(const std::chrono::nanoseconds interval) noexcept;
+        void SetPaintCallback(PaintCallback callback);
+
+        ReplayStatistics Run(const SessionRecording& recording);
+
+    private:
+        void _paint(ReplayStatistics& stats);
+
+        Terminal& _terminal;
+        PaintCallback _paintCallback;
+        Pacing _pacing = Pacing::AsFastAsPossible;
+        std::chrono::nanoseconds _frameInterval = std::chrono::nanoseconds{ 16'666'667 };
+    };
+}
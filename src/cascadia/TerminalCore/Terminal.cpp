@@ -10,6 +10,8 @@
 #include "../../types/inc/colorTable.hpp"
 
 #include <winrt/Microsoft.Terminal.Core.h>
+#include <til/heap_usage.h>
+#include <til/trace.h>
 
 using namespace winrt::Microsoft::Terminal::Core;
 using namespace Microsoft::Terminal::Core;
@@ -35,6 +37,97 @@ static std::wstring _KeyEventsToText(std::deque<std::unique_ptr<IInputEvent>>& i
     return wstr;
 }
 
+// Returns the length of the SGR sequence at the start of the string, or 0 if it doesn't start with one.
+static size_t _SgrSequenceLength(const std::wstring_view str) noexcept
+{
+    if (str.size() < 3 || str[0] != L'\x1b' || str[1] != L'[')
+    {
+        return 0;
+    }
+
+    for (size_t i = 2; i < str.size(); ++i)
+    {
+        const auto wch = str[i];
+        if (wch == L'm')
+        {
+            return i + 1;
+        }
+        if ((wch < L'0' || wch > L'9') && wch != L';' && wch != L':')
+        {
+            return 0;
+        }
+    }
+    return 0;
+}
+
+// Returns true if the given SGR sequence resets all attributes before applying
+// the rest of its parameters, which it does if the first parameter is 0 or omitted.
+static bool _SgrSequenceResets(const std::wstring_view sgr) noexcept
+{
+    size_t i = 2;
+    while (sgr.at(i) == L'0')
+    {
+        ++i;
+    }
+    return sgr.at(i) == L';' || sgr.at(i) == L'm';
+}
+
+// Routine Description:
+// - Finds how much of the given output would be pushed out of a buffer with
+//   the given number of rows by the rest of the output.
+// - That's only provable for output that consists of nothing but text, CR, LF
+//   and SGR sequences. Anything else could move the cursor around or change
+//   state that outlives the lines, so no part of such output is skipped.
+// Arguments:
+// - str - The output.
+// - rows - The number of rows of the buffer.
+// Return Value:
+// - The offset just past the last CRLF that is followed by at least as many
+//   line feeds as the buffer has rows, or 0 if there's no such CRLF.
+static size_t _FindUnseenOutputEnd(const std::wstring_view str, const size_t rows) noexcept
+{
+    if (str.size() <= rows)
+    {
+        return 0;
+    }
+
+    size_t lineFeeds = 0;
+    for (size_t i = 0; i < str.size();)
+    {
+        const auto wch = str[i];
+        if (wch == L'\n')
+        {
+            lineFeeds++;
+            i++;
+        }
+        // C1 control characters are accepted by the Terminal's state machine.
+        else if (wch == L'\r' || (wch >= L' ' && wch != L'\x7f' && (wch < L'\x80' || wch > L'\x9f')))
+        {
+            i++;
+        }
+        else if (const auto length = _SgrSequenceLength(str.substr(i)))
+        {
+            i += length;
+        }
+        else
+        {
+            return 0;
+        }
+    }
+
+    size_t end = 0;
+    for (auto i = str.find(L'\n'); i != std::wstring_view::npos && lineFeeds > rows; i = str.find(L'\n', i + 1))
+    {
+        // lineFeeds is the number of line feeds from this one on.
+        lineFeeds--;
+        if (i != 0 && str[i - 1] == L'\r')
+        {
+            end = i + 1;
+        }
+    }
+    return end;
+}
+
 #pragma warning(suppress : 26455) // default constructor is throwing, too much effort to rearrange at this time.
 Terminal::Terminal() :
     _mutableViewport{ Viewport::Empty() },
@@ -53,7 +146,8 @@ Terminal::Terminal() :
     _taskbarState{ 0 },
     _taskbarProgress{ 0 },
     _trimBlockSelection{ false },
-    _autoMarkPrompts{ false }
+    _autoMarkPrompts{ false },
+    _skipUnseenOutput{ false }
 {
     auto passAlongInput = [&](std::deque<std::unique_ptr<IInputEvent>>& inEventsToWrite) {
         if (!_pfnWriteInput)
@@ -126,6 +220,7 @@ void Terminal::UpdateSettings(ICoreSettings settings)
     _startingTitle = settings.StartingTitle();
     _trimBlockSelection = settings.TrimBlockSelection();
     _autoMarkPrompts = settings.AutoMarkPrompts();
+    _skipUnseenOutput = settings.SkipUnseenOutput();
 
     _terminalInput->ForceDisableWin32InputMode(settings.ForceVTInput());
 
@@ -481,12 +576,13 @@ std::wstring_view Terminal::GetWorkingDirectory()
 
 void Terminal::Write(std::wstring_view stringView)
 {
+    TIL_TRACE_SPAN("terminal", "Terminal::Write");
     auto lock = LockForWriting();
 
     auto& cursor = _activeBuffer().GetCursor();
     const til::point cursorPosBefore{ cursor.GetPosition() };
 
-    _stateMachine->ProcessString(stringView);
+    _stateMachine->ProcessString(_SkipUnseenOutput(stringView));
 
     const til::point cursorPosAfter{ cursor.GetPosition() };
 
@@ -500,6 +596,64 @@ void Terminal::Write(std::wstring_view stringView)
     }
 }
 
+// Method Description:
+// - If enabled, skips the leading lines of the given output that the rest of it
+//   would push out of the buffer before anyone could see them. When a process
+//   floods the terminal with plain text, like `cat` of a huge log, most lines
+//   then don't have to be written into the buffer, but the result is the same.
+// - This only applies while the cursor is on the last row of the buffer and the
+//   viewport follows the output. Every line feed then pushes out one row, so that
+//   as many line feeds as the buffer has rows push out every row there was.
+// Arguments:
+// - stringView - The output.
+// Return Value:
+// - The part of the output that still needs to be processed.
+std::wstring_view Terminal::_SkipUnseenOutput(const std::wstring_view stringView)
+{
+    if (!_skipUnseenOutput ||
+        _inAltBuffer() ||
+        _scrollOffset != 0 ||
+        IsSelectionActive() ||
+        !_stateMachine->IsInGroundState() ||
+        !_stateMachine->GetParserMode(StateMachine::Mode::Ansi))
+    {
+        return stringView;
+    }
+
+    auto& buffer = _activeBuffer();
+    const auto rows = buffer.GetSize().Height();
+    if (buffer.GetCursor().GetPosition().y != rows - 1)
+    {
+        return stringView;
+    }
+
+    const auto end = _FindUnseenOutputEnd(stringView, gsl::narrow_cast<size_t>(rows));
+    if (end == 0)
+    {
+        return stringView;
+    }
+
+    // The skipped output ends with a CRLF, so the rest of it starts in the first column.
+    // The attributes set by its SGR sequences are the only other thing that outlives it,
+    // and only those set since the last sequence that reset all of them.
+    const auto skipped = stringView.substr(0, end);
+    size_t applyFrom = 0;
+    for (auto i = skipped.find(L'\x1b'); i != std::wstring_view::npos; i = skipped.find(L'\x1b', i + 1))
+    {
+        if (_SgrSequenceResets(skipped.substr(i)))
+        {
+            applyFrom = i;
+        }
+    }
+    for (auto i = skipped.find(L'\x1b', applyFrom); i != std::wstring_view::npos; i = skipped.find(L'\x1b', i + 1))
+    {
+        _stateMachine->ProcessString(skipped.substr(i, _SgrSequenceLength(skipped.substr(i))));
+    }
+    _stateMachine->ProcessString(L"\r");
+
+    return stringView.substr(end);
+}
+
 void Terminal::WritePastedText(std::wstring_view stringView)
 {
     auto option = ::Microsoft::Console::Utils::FilterOption::CarriageReturnNewline |
@@ -1591,6 +1745,29 @@ const std::vector<Microsoft::Console::VirtualTerminal::DispatchTypes::ScrollMark
     return _inAltBuffer() ? _altBufferMarks : _scrollMarks;
 }
 
+// Method Description:
+// - Adds up the memory used by the buffers and the side tables of the terminal.
+//   The caller must hold the read lock.
+// Return Value:
+// - The number of bytes used by each component of the terminal
+Terminal::MemoryStats Terminal::GetMemoryStats() const noexcept
+{
+    MemoryStats stats;
+    stats.mainBuffer = _mainBuffer->GetMemoryStats();
+    if (_altBuffer)
+    {
+        stats.altBuffer = _altBuffer->GetMemoryStats();
+    }
+
+    // The nodes of the interval tree aren't accessible, but there's at most one per interval.
+    size_t intervals = 0;
+    _patternIntervalTree.visit_all([&](const auto&) noexcept { intervals++; });
+    stats.patterns = intervals * (sizeof(PointTree::interval) + sizeof(PointTree));
+
+    stats.scrollMarks = til::heap_usage(_scrollMarks);
+    return stats;
+}
+
 til::color Terminal::GetColorForMark(const Microsoft::Console::VirtualTerminal::DispatchTypes::ScrollMark& mark) const
 {
     if (mark.color.has_value())
@@ -15,6 +15,7 @@
 #include "../../types/inc/Viewport.hpp"
 #include "../../types/inc/GlyphWidth.hpp"
 #include "../../types/IUiaData.h"
+#include "../../types/UiaTextSnapshot.hpp"
 #include "../../cascadia/terminalcore/ITerminalInput.hpp"
 
 #include <til/ticket_lock.h>
@@ -107,6 +108,23 @@ public:
                  const til::point& start,
                  const til::point& end);
 
+    // The number of bytes the terminal's buffers and side tables occupy, broken down by component.
+    struct MemoryStats
+    {
+        TextBuffer::MemoryStats mainBuffer;
+        // All zero while the alternate buffer isn't in use.
+        TextBuffer::MemoryStats altBuffer;
+        size_t patterns{ 0 };
+        size_t scrollMarks{ 0 };
+
+        size_t Total() const noexcept
+        {
+            return mainBuffer.Total() + altBuffer.Total() + patterns + scrollMarks;
+        }
+    };
+
+    MemoryStats GetMemoryStats() const noexcept;
+
 #pragma region ITerminalApi
     // These methods are defined in TerminalApi.cpp
     void PrintString(const std::wstring_view string) override;
@@ -206,6 +224,7 @@ public:
     const std::wstring_view GetConsoleTitle() const noexcept override;
     void ColorSelection(const til::point coordSelectionStart, const til::point coordSelectionEnd, const TextAttribute) override;
     const bool IsUiaDataInitialized() const noexcept override;
+    Microsoft::Console::Types::UiaTextSnapshotCache& GetUiaTextSnapshotCache() noexcept override;
 #pragma endregion
 
     void SetWriteInputCallback(std::function<void(std::wstring_view)> pfn) noexcept;
@@ -331,6 +350,7 @@ private:
     bool _bracketedPasteMode;
     bool _trimBlockSelection;
     bool _autoMarkPrompts;
+    bool _skipUnseenOutput;
 
     size_t _taskbarState;
     size_t _taskbarProgress;
@@ -365,6 +385,7 @@ private:
 
     std::unique_ptr<TextBuffer> _mainBuffer;
     std::unique_ptr<TextBuffer> _altBuffer;
+    Microsoft::Console::Types::UiaTextSnapshotCache _uiaTextSnapshotCache;
     Microsoft::Console::Types::Viewport _mutableViewport;
     til::CoordType _scrollbackLines;
     bool _detectURLs{ false };
@@ -416,6 +437,7 @@ private:
     Microsoft::Console::Types::Viewport _GetMutableViewport() const noexcept;
     Microsoft::Console::Types::Viewport _GetVisibleViewport() const noexcept;
 
+    std::wstring_view _SkipUnseenOutput(const std::wstring_view stringView);
     void _WriteBuffer(const std::wstring_view& stringView);
 
     void _AdjustCursorPosition(const til::point proposedPosition);
@@ -228,3 +228,8 @@ const bool Terminal::IsUiaDataInitialized() const noexcept
     // UiaData are not yet initialized.
     return !!_mainBuffer;
 }
+
+Microsoft::Console::Types::UiaTextSnapshotCache& Terminal::GetUiaTextSnapshotCache() noexcept
+{
+    return _uiaTextSnapshotCache;
+}
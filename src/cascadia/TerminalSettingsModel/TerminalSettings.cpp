@@ -283,6 +283,7 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
         _Elevate = profile.Elevate();
         _AutoMarkPrompts = Feature_ScrollbarMarks::IsEnabled() && profile.AutoMarkPrompts();
         _ShowMarks = Feature_ScrollbarMarks::IsEnabled() && profile.ShowMarks();
+        _SkipUnseenOutput = profile.SkipUnseenOutput();
     }
 
     // Method Description:
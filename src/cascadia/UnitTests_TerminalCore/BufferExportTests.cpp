@@ -0,0 +1,232 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "pch.h"
+#include <WexTestClass.h>
+
+#include "../renderer/inc/DummyRenderer.hpp"
+#include "../cascadia/TerminalCore/Terminal.hpp"
+#include "../cascadia/TerminalCore/BufferExport.hpp"
+
+using namespace Microsoft::Terminal::Core;
+
+using namespace WEX::Common;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+
+namespace TerminalCoreUnitTests
+{
+    class BufferExportTests;
+};
+using namespace TerminalCoreUnitTests;
+
+class TerminalCoreUnitTests::BufferExportTests final
+{
+    TEST_CLASS(BufferExportTests);
+
+    TEST_METHOD(PlainText);
+    TEST_METHOD(VirtualTerminal);
+    TEST_METHOD(JsonLines);
+    TEST_METHOD(RowRange);
+    TEST_METHOD(ScrollDuringExport);
+    TEST_METHOD(ScrollPastRemainingRows);
+
+    TEST_METHOD_SETUP(MethodSetup)
+    {
+        _createTerminal({ 80, 32 }, 100);
+        return true;
+    }
+
+    TEST_METHOD_CLEANUP(MethodCleanup)
+    {
+        emptyRenderer = nullptr;
+        term = nullptr;
+        return true;
+    }
+
+private:
+    void _createTerminal(const til::size viewportSize, const til::CoordType scrollback)
+    {
+        emptyRenderer = nullptr;
+        term = std::make_unique<Terminal>();
+        emptyRenderer = std::make_unique<DummyRenderer>(term.get());
+        term->Create(viewportSize, scrollback, *emptyRenderer);
+    }
+
+    std::string _export(const BufferExportOptions& options, BufferExportResult* result = nullptr)
+    {
+        std::string output;
+        BufferExporter exporter{ *term, [&](std::string_view chunk) { output.append(chunk); } };
+        const auto r = exporter.Export(options);
+        VERIFY_ARE_EQUAL(output.size(), r.bytes);
+        if (result)
+        {
+            *result = r;
+        }
+        return output;
+    }
+
+    // Fills the entire buffer with long, numbered rows, so that an export
+    // needs to flush its output several times.
+    void _writeNumberedRows(const til::CoordType rows)
+    {
+        for (til::CoordType i = 0; i < rows; ++i)
+        {
+            auto line = std::to_wstring(i) + L':' + std::wstring(900, L'x');
+            if (i + 1 < rows)
+            {
+                line += L"\r\n";
+            }
+            term->Write(line);
+        }
+    }
+
+    std::unique_ptr<DummyRenderer> emptyRenderer;
+    std::unique_ptr<Terminal> term;
+};
+
+void BufferExportTests::PlainText()
+{
+    term->Write(L"Hello\r\nWorld   \r\n\r\n\x1b[44m  wide: \x4e16\x754c  \x1b[m");
+
+    BufferExportResult result;
+    const auto output = _export({}, &result);
+    VERIFY_ARE_EQUAL("Hello\r\nWorld\r\n\r\n  wide: \xe4\xb8\x96\xe7\x95\x8c\r\n", output);
+    VERIFY_ARE_EQUAL(4u, result.rows);
+    VERIFY_ARE_EQUAL(0u, result.droppedRows);
+    VERIFY_IS_TRUE(result.complete);
+}
+
+void BufferExportTests::VirtualTerminal()
+{
+    term->Write(L"\x1b[1;31mRed\x1b[m plain\r\n\x1b[4;38;2;1;2;3;48;5;200mrgb\x1b[m");
+
+    BufferExportOptions options;
+    options.format = BufferExportFormat::VirtualTerminal;
+    const auto output = _export(options);
+
+    // Each row starts out with the default attributes and resets them at its end.
+    VERIFY_ARE_EQUAL("\x1b[0;1;31mRed\x1b[0m plain\r\n"
+                     "\x1b[0;4;38;2;1;2;3;48;5;200mrgb\x1b[m\r\n",
+                     output);
+}
+
+void BufferExportTests::JsonLines()
+{
+    term->Write(std::wstring(85, L'x'));
+    term->Write(L"\r\na\"b\\c");
+
+    BufferExportOptions options;
+    options.format = BufferExportFormat::JsonLines;
+    const auto output = _export(options);
+
+    const auto expected = "{\"row\":0,\"text\":\"" + std::string(80, 'x') + "\",\"wrapped\":true}\n" +
+                          "{\"row\":1,\"text\":\"xxxxx\",\"wrapped\":false}\n" +
+                          "{\"row\":2,\"text\":\"a\\\"b\\\\c\",\"wrapped\":false}\n";
+    VERIFY_ARE_EQUAL(expected, output);
+}
+
+void BufferExportTests::RowRange()
+{
+    term->Write(L"zero\r\none\r\ntwo\r\nthree");
+
+    BufferExportOptions options;
+    options.firstRow = 1;
+    options.lastRow = 2;
+    options.rowsPerBatch = 1;
+
+    BufferExportResult result;
+    VERIFY_ARE_EQUAL("one\r\ntwo\r\n", _export(options, &result));
+    VERIFY_ARE_EQUAL(2u, result.rows);
+
+    // Rows past the end of the buffer are ignored.
+    std::string expected{ "three\r\n" };
+    for (auto i = 4; i < term->GetTextBuffer().GetSize().Height(); ++i)
+    {
+        expected += "\r\n";
+    }
+    options.firstRow = 3;
+    options.lastRow = 100000;
+    VERIFY_ARE_EQUAL(expected, _export(options));
+
+    options.rowsPerBatch = 0;
+    VERIFY_THROWS(_export(options), wil::ResultException);
+}
+
+void BufferExportTests::ScrollDuringExport()
+{
+    // Without any scrollback, every new line scrolls a row out of the buffer.
+    _createTerminal({ 1000, 200 }, 0);
+    _writeNumberedRows(200);
+
+    BufferExportOptions options;
+    options.format = BufferExportFormat::JsonLines;
+    options.rowsPerBatch = 10;
+
+    // Emulate output that arrives while the export is running:
+    // the first time output is flushed, the buffer scrolls by 5 rows.
+    std::string pending;
+    auto scrolled = false;
+    BufferExporter exporter{ *term, [&](std::string_view chunk) {
+                                pending.append(chunk);
+                                if (!scrolled)
+                                {
+                                    scrolled = true;
+                                    term->Write(L"\r\n\r\n\r\n\r\n\r\n");
+                                }
+                            } };
+    const auto result = exporter.Export(options);
+
+    VERIFY_IS_TRUE(scrolled);
+    VERIFY_IS_TRUE(result.complete);
+    VERIFY_ARE_EQUAL(0u, result.droppedRows);
+    VERIFY_ARE_EQUAL(200u, result.rows);
+
+    // Every row is exported exactly once, with its number from the time the export started.
+    size_t row = 0;
+    for (size_t begin = 0, end; (end = pending.find('\n', begin)) != std::string::npos; begin = end + 1, ++row)
+    {
+        const auto line = std::string_view{ pending }.substr(begin, end - begin);
+        const auto prefix = fmt::format("{{\"row\":{},\"text\":\"{}:", row, row);
+        VERIFY_IS_TRUE(line.starts_with(prefix));
+    }
+    VERIFY_ARE_EQUAL(200u, row);
+}
+
+void BufferExportTests::ScrollPastRemainingRows()
+{
+    _createTerminal({ 1000, 200 }, 0);
+    _writeNumberedRows(200);
+
+    BufferExportOptions options;
+    options.format = BufferExportFormat::JsonLines;
+    options.rowsPerBatch = 10;
+
+    // The first time output is flushed, 150 rows scroll out, which
+    // includes rows that haven't been exported yet.
+    std::string output;
+    size_t exportedBeforeScroll = 0;
+    BufferExporter exporter{ *term, [&](std::string_view chunk) {
+                                if (output.empty())
+                                {
+                                    exportedBeforeScroll = gsl::narrow_cast<size_t>(std::count(chunk.begin(), chunk.end(), '\n'));
+                                    std::wstring newlines;
+                                    for (auto i = 0; i < 150; ++i)
+                                    {
+                                        newlines += L"\r\n";
+                                    }
+                                    term->Write(newlines);
+                                }
+                                output.append(chunk);
+                            } };
+    const auto result = exporter.Export(options);
+
+    VERIFY_IS_LESS_THAN(exportedBeforeScroll, 150u);
+    VERIFY_IS_TRUE(result.complete);
+    VERIFY_ARE_EQUAL(150u - exportedBeforeScroll, result.droppedRows);
+    VERIFY_ARE_EQUAL(200u, result.rows + result.droppedRows);
+
+    // The rows that were still in the buffer are exported with their original numbers.
+    const auto lastLineBegin = output.rfind('\n', output.size() - 2) + 1;
+    VERIFY_IS_TRUE(std::string_view{ output }.substr(lastLineBegin).starts_with("{\"row\":199,\"text\":\"199:"));
+}
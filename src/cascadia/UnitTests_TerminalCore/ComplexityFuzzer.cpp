@@ -0,0 +1,523 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "pch.h"
+#include "ComplexityFuzzer.hpp"
+#include "../cascadia/TerminalCore/Terminal.hpp"
+
+using namespace Microsoft::Terminal::Core;
+
+template<typename T>
+static T randomInt(std::mt19937& rng, const T min, const T max)
+{
+    return std::uniform_int_distribution<T>{ min, max }(rng);
+}
+
+static bool randomBool(std::mt19937& rng)
+{
+    return (rng() & 1) != 0;
+}
+
+template<typename T, size_t N>
+static const T& randomPick(std::mt19937& rng, const T (&items)[N])
+{
+    return til::at(items, randomInt<size_t>(rng, 0, N - 1));
+}
+
+namespace
+{
+    // Appends events to a case and keeps track of its size, because
+    // recalculating it for every token would be quadratic in itself.
+    class CaseBuilder
+    {
+    public:
+        explicit CaseBuilder(ComplexityCase& events) noexcept :
+            _events{ events },
+            _size{ ComplexityFuzzer::SizeOf(events) }
+        {
+        }
+
+        size_t Size() const noexcept
+        {
+            return _size;
+        }
+
+        void Output(std::wstring text)
+        {
+            _size += text.size();
+            auto& event = _events.emplace_back();
+            event.kind = RecordedEventKind::Output;
+            event.text = std::move(text);
+        }
+
+        void Resize(const til::size size)
+        {
+            _size += ComplexityFuzzer::ResizeEventSize;
+            auto& event = _events.emplace_back();
+            event.kind = RecordedEventKind::Resize;
+            event.size = size;
+        }
+
+    private:
+        ComplexityCase& _events;
+        size_t _size;
+    };
+}
+
+// CSI sequences with far more parameters than any of them takes,
+// either as one endless sequence or as many long ones.
+static void generateParameterFlood(std::mt19937& rng, const size_t size, ComplexityCase& events)
+{
+    static constexpr std::wstring_view finals[]{ L"m", L"H", L"r", L"J", L"K", L"X", L"@", L"P", L"S", L"h", L"l", L"c", L"n" };
+
+    const auto finalChar = randomPick(rng, finals);
+    const std::wstring intro{ (finalChar == L"h" || finalChar == L"l") && randomBool(rng) ? L"\x1b[?" : L"\x1b[" };
+    const auto separator = randomBool(rng) ? L';' : L':';
+    const auto parametersPerSequence = randomBool(rng) ? SIZE_MAX : randomInt<size_t>(rng, 32, 1024);
+
+    CaseBuilder builder{ events };
+    builder.Output(intro);
+    for (size_t parameters = 0; builder.Size() < size; ++parameters)
+    {
+        if (parameters == parametersPerSequence)
+        {
+            builder.Output(std::wstring{ finalChar });
+            builder.Output(intro);
+            parameters = 0;
+        }
+
+        auto parameter = std::to_wstring(randomInt(rng, 0, 99999));
+        parameter.push_back(separator);
+        builder.Output(std::move(parameter));
+    }
+    builder.Output(std::wstring{ finalChar });
+}
+
+// A single OSC string that goes on and on.
+static void generateDeepOsc(std::mt19937& rng, const size_t size, ComplexityCase& events)
+{
+    static constexpr std::wstring_view intros[]{ L"\x1b]0;", L"\x1b]2;", L"\x1b]8;;", L"\x1b]8;id=", L"\x1b]52;c;", L"\x1b]4;1;", L"\x1b]9;9;", L"\x1b]1337;" };
+    static constexpr std::wstring_view base64{ L"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/" };
+    static constexpr std::wstring_view printable{ L" !\"#$%&'()*+,-./0123456789:;<=>?@ABCDEFGHIJKLMNOPQRSTUVWXYZ[\\]^_`abcdefghijklmnopqrstuvwxyz{|}~" };
+
+    const auto intro = randomPick(rng, intros);
+    const auto alphabet = intro == L"\x1b]52;c;" ? base64 : printable;
+
+    CaseBuilder builder{ events };
+    builder.Output(std::wstring{ intro });
+    while (builder.Size() < size)
+    {
+        std::wstring piece(64, L' ');
+        for (auto& ch : piece)
+        {
+            ch = alphabet[randomInt<size_t>(rng, 0, alphabet.size() - 1)];
+        }
+        builder.Output(std::move(piece));
+    }
+    builder.Output(randomBool(rng) ? L"\x07" : L"\x1b\\");
+}
+
+// Scrolling within constantly changing margins, interleaved with resizes.
+static void generateScrollRegionChurn(std::mt19937& rng, const size_t size, ComplexityCase& events)
+{
+    CaseBuilder builder{ events };
+    while (builder.Size() < size)
+    {
+        switch (randomInt(rng, 0, 9))
+        {
+        case 0:
+        {
+            // DECSTBM, including invalid and out of bounds margins.
+            const auto top = randomInt(rng, 0, 30);
+            const auto bottom = randomInt(rng, 0, 60);
+            builder.Output(fmt::format(FMT_COMPILE(L"\x1b[{};{}r"), top, bottom));
+            break;
+        }
+        case 1:
+            builder.Output(fmt::format(FMT_COMPILE(L"\x1b[{}S"), randomInt(rng, 1, 100)));
+            break;
+        case 2:
+            builder.Output(fmt::format(FMT_COMPILE(L"\x1b[{}T"), randomInt(rng, 1, 100)));
+            break;
+        case 3:
+            builder.Output(fmt::format(FMT_COMPILE(L"\x1b[{}L"), randomInt(rng, 1, 100)));
+            break;
+        case 4:
+            builder.Output(fmt::format(FMT_COMPILE(L"\x1b[{}M"), randomInt(rng, 1, 100)));
+            break;
+        case 5:
+            builder.Output(L"\x1bM");
+            break;
+        case 6:
+            builder.Output(std::wstring(randomInt<size_t>(rng, 1, 32), L'\n'));
+            break;
+        case 7:
+            builder.Output(fmt::format(FMT_COMPILE(L"\x1b[{}H"), randomInt(rng, 1, 60)));
+            break;
+        case 8:
+            builder.Output(L"a line of text\r\n");
+            break;
+        default:
+            if (randomInt(rng, 0, 7) == 0)
+            {
+                const auto columns = randomInt<til::CoordType>(rng, 10, 200);
+                const auto rows = randomInt<til::CoordType>(rng, 5, 60);
+                builder.Resize({ columns, rows });
+            }
+            else
+            {
+                // DECOM makes the cursor position relative to the margins.
+                builder.Output(randomBool(rng) ? L"\x1b[?6h" : L"\x1b[?6l");
+            }
+            break;
+        }
+    }
+}
+
+// Many hyperlinks that get scrolled into the scrollback and out of the buffer,
+// either all distinct or picked from a small set of ids.
+static void generateHyperlinkFlood(std::mt19937& rng, const size_t size, ComplexityCase& events)
+{
+    const auto distinctIds = randomBool(rng) ? SIZE_MAX : randomInt<size_t>(rng, 1, 64);
+
+    CaseBuilder builder{ events };
+    for (size_t i = 0; builder.Size() < size; ++i)
+    {
+        const auto id = distinctIds == SIZE_MAX ? i : randomInt<size_t>(rng, 0, distinctIds - 1);
+        builder.Output(fmt::format(FMT_COMPILE(L"\x1b]8;id={0};https://example.com/{0}\x1b\\"), id));
+        builder.Output(std::wstring(randomInt<size_t>(rng, 1, 16), L'x'));
+        builder.Output(L"\x1b]8;;\x1b\\");
+        if (randomInt(rng, 0, 3) == 0)
+        {
+            builder.Output(L"\r\n");
+        }
+    }
+}
+
+// Wide glyphs at the edges of the screen that get partially overwritten, shifted and erased.
+static void generateWideCharPlacement(std::mt19937& rng, const size_t size, ComplexityCase& events)
+{
+    static constexpr std::wstring_view glyphs[]{ L"\x3042", L"\xFF21", L"\xD83D\xDE00", L"\x3042\x0301", L"x" };
+
+    CaseBuilder builder{ events };
+    while (builder.Size() < size)
+    {
+        switch (randomInt(rng, 0, 7))
+        {
+        case 0:
+        {
+            // Columns past the right edge are clamped to the last one.
+            const auto row = randomInt(rng, 1, 40);
+            const auto column = randomBool(rng) ? 9999 : randomInt(rng, 1, 120);
+            builder.Output(fmt::format(FMT_COMPILE(L"\x1b[{};{}H"), row, column));
+            break;
+        }
+        case 1:
+        case 2:
+            builder.Output(std::wstring{ randomPick(rng, glyphs) });
+            break;
+        case 3:
+            builder.Output(fmt::format(FMT_COMPILE(L"\x1b[{}@"), randomInt(rng, 1, 8)));
+            break;
+        case 4:
+            builder.Output(fmt::format(FMT_COMPILE(L"\x1b[{}P"), randomInt(rng, 1, 8)));
+            break;
+        case 5:
+            builder.Output(fmt::format(FMT_COMPILE(L"\x1b[{}X"), randomInt(rng, 1, 8)));
+            break;
+        case 6:
+            builder.Output(randomBool(rng) ? L"\x1b[?7h" : L"\x1b[?7l");
+            break;
+        default:
+            builder.Output(L"\b");
+            break;
+        }
+    }
+}
+
+// Long lines packed with URLs, for the pattern detection that runs over the viewport.
+static void generateUrlText(std::mt19937& rng, const size_t size, ComplexityCase& events)
+{
+    static constexpr std::wstring_view schemes[]{ L"https://", L"http://", L"file://", L"ftp://" };
+    static constexpr std::wstring_view pathChars{ L"abcdefghijklmnopqrstuvwxyz0123456789-._~/?#[]@!$&'()*+,;=%" };
+
+    const auto lineBreaks = randomBool(rng);
+
+    CaseBuilder builder{ events };
+    while (builder.Size() < size)
+    {
+        std::wstring url{ randomPick(rng, schemes) };
+        url.append(L"example.com/");
+        const auto length = randomInt<size_t>(rng, 1, 256);
+        for (size_t i = 0; i < length; ++i)
+        {
+            url.push_back(pathChars[randomInt<size_t>(rng, 0, pathChars.size() - 1)]);
+        }
+        url.push_back(randomBool(rng) ? L' ' : L'"');
+        builder.Output(std::move(url));
+
+        if (lineBreaks && randomInt(rng, 0, 7) == 0)
+        {
+            builder.Output(L"\r\n");
+        }
+    }
+}
+
+static constexpr ComplexityGenerator generators[]{
+    { L"ParameterFlood", generateParameterFlood },
+    { L"DeepOsc", generateDeepOsc },
+    { L"ScrollRegionChurn", generateScrollRegionChurn },
+    { L"HyperlinkFlood", generateHyperlinkFlood },
+    { L"WideCharPlacement", generateWideCharPlacement },
+    { L"UrlText", generateUrlText },
+};
+
+double ComplexityFinding::Growth() const noexcept
+{
+    return smallCost > 0 ? largeCost / smallCost : 0;
+}
+
+// Method Description:
+// - Serializes the input of the finding as a session recording,
+//   which can be loaded with SessionRecording::Load and replayed.
+std::string ComplexityFinding::Serialize() const
+{
+    std::string bytes;
+    {
+        SessionRecorder recorder{ [&](std::string_view chunk) { bytes.append(chunk); } };
+        for (const auto& event : input)
+        {
+            switch (event.kind)
+            {
+            case RecordedEventKind::Output:
+                recorder.RecordOutput(event.text);
+                break;
+            case RecordedEventKind::Resize:
+                recorder.RecordResize(event.size);
+                break;
+            default:
+                break;
+            }
+        }
+    }
+    return bytes;
+}
+
+ComplexityFuzzer::ComplexityFuzzer(TerminalFactory factory) :
+    _factory{ std::move(factory) }
+{
+}
+
+gsl::span<const ComplexityGenerator> ComplexityFuzzer::Generators() noexcept
+{
+    return { generators };
+}
+
+size_t ComplexityFuzzer::SizeOf(const ComplexityCase& events) noexcept
+{
+    size_t size = 0;
+    for (const auto& event : events)
+    {
+        size += event.kind == RecordedEventKind::Resize ? ResizeEventSize : event.text.size();
+    }
+    return size;
+}
+
+ComplexityCase ComplexityFuzzer::Generate(const ComplexityGenerator& generator, const uint32_t seed, const size_t size)
+{
+    std::mt19937 rng{ seed };
+    ComplexityCase events;
+    generator.generate(rng, size, events);
+    return events;
+}
+
+// Method Description:
+// - Removes as many events from the input as possible while the predicate
+//   still holds. This is a simplified delta debugging: it repeatedly tries to
+//   drop ever smaller slices of the input and keeps every attempt that passes.
+// Arguments:
+// - events - The input to minimize. The predicate must hold for it.
+// - predicate - Returns true if the given input still shows the problem.
+// - maxTests - The maximum number of times the predicate is called.
+// Return Value:
+// - The smallest input found that still satisfies the predicate.
+ComplexityCase ComplexityFuzzer::Minimize(ComplexityCase events, const Predicate& predicate, const size_t maxTests)
+{
+    size_t tests = 0;
+    size_t granularity = 2;
+
+    while (events.size() >= 2 && tests < maxTests)
+    {
+        const auto sliceSize = (events.size() + granularity - 1) / granularity;
+        auto reduced = false;
+
+        for (size_t begin = 0; begin < events.size() && tests < maxTests; begin += sliceSize)
+        {
+            const auto end = std::min(begin + sliceSize, events.size());
+
+            ComplexityCase candidate;
+            candidate.reserve(events.size() - (end - begin));
+            candidate.insert(candidate.end(), events.begin(), events.begin() + gsl::narrow_cast<ptrdiff_t>(begin));
+            candidate.insert(candidate.end(), events.begin() + gsl::narrow_cast<ptrdiff_t>(end), events.end());
+
+            tests++;
+            if (predicate(candidate))
+            {
+                events = std::move(candidate);
+                granularity = std::max<size_t>(granularity - 1, 2);
+                reduced = true;
+                break;
+            }
+        }
+
+        if (!reduced)
+        {
+            if (granularity >= events.size())
+            {
+                break;
+            }
+            granularity = std::min(granularity * 2, events.size());
+        }
+    }
+
+    return events;
+}
+
+void ComplexityFuzzer::SetBaseSize(const size_t size) noexcept
+{
+    _baseSize = std::max<size_t>(size, 1);
+}
+
+void ComplexityFuzzer::SetGrowthThreshold(const double threshold) noexcept
+{
+    _growthThreshold = threshold;
+}
+
+void ComplexityFuzzer::SetCostBudget(const double cyclesPerCharacter) noexcept
+{
+    _costBudget = cyclesPerCharacter;
+}
+
+void ComplexityFuzzer::SetRepetitions(const size_t repetitions) noexcept
+{
+    _repetitions = std::max<size_t>(repetitions, 1);
+}
+
+void ComplexityFuzzer::SetScanPatterns(const bool enabled) noexcept
+{
+    _scanPatterns = enabled;
+}
+
+std::vector<ComplexityFinding> ComplexityFuzzer::Run(const uint32_t seed, const size_t iterations)
+{
+    std::vector<ComplexityFinding> findings;
+    for (size_t i = 0; i < iterations; ++i)
+    {
+        for (const auto& generator : Generators())
+        {
+            if (auto finding = RunOne(generator, gsl::narrow_cast<uint32_t>(seed + i)))
+            {
+                findings.emplace_back(std::move(*finding));
+            }
+        }
+    }
+    return findings;
+}
+
+// Method Description:
+// - Measures the input the generator produces for the seed at the base size and
+//   GrowthFactor times that. If the larger input is too expensive, it's minimized
+//   and returned as a finding.
+std::optional<ComplexityFinding> ComplexityFuzzer::RunOne(const ComplexityGenerator& generator, const uint32_t seed)
+{
+    const auto smallInput = Generate(generator, seed, _baseSize);
+    auto largeInput = Generate(generator, seed, _baseSize * GrowthFactor);
+    const auto smallCost = Measure(smallInput);
+    const auto largeCost = Measure(largeInput);
+
+    // Inputs that grow linearly cost about the same per character at any size.
+    const auto limit = std::min(_costBudget, smallCost * _growthThreshold);
+    if (largeCost <= limit)
+    {
+        return std::nullopt;
+    }
+
+    ComplexityFinding finding;
+    finding.generator = generator.name;
+    finding.seed = seed;
+    finding.size = SizeOf(largeInput);
+    finding.smallCost = smallCost;
+    finding.largeCost = largeCost;
+    // Below the base size the fixed costs of a terminal start to dominate, which
+    // would make the minimizer converge on any input that is small enough.
+    finding.input = Minimize(
+        std::move(largeInput),
+        [&](const ComplexityCase& candidate) {
+            return SizeOf(candidate) >= _baseSize && Measure(candidate) > limit;
+        },
+        MaxMinimizationTests);
+    return finding;
+}
+
+double ComplexityFuzzer::Measure(const ComplexityCase& events)
+{
+    // Coalesce the output into chunks before measuring, so that neither the
+    // concatenation nor the number of tokens influences the measurement.
+    ComplexityCase chunks;
+    for (const auto& event : events)
+    {
+        if (event.kind == RecordedEventKind::Output)
+        {
+            if (chunks.empty() || chunks.back().kind != RecordedEventKind::Output || chunks.back().text.size() >= ChunkSize)
+            {
+                chunks.emplace_back().kind = RecordedEventKind::Output;
+            }
+            chunks.back().text.append(event.text);
+        }
+        else if (event.kind == RecordedEventKind::Resize)
+        {
+            chunks.emplace_back(event);
+        }
+    }
+
+    auto cycles = std::numeric_limits<uint64_t>::max();
+    for (size_t i = 0; i < _repetitions; ++i)
+    {
+        cycles = std::min(cycles, _run(_factory(), chunks));
+    }
+    return static_cast<double>(cycles) / std::max<size_t>(SizeOf(events), 1);
+}
+
+// Method Description:
+// - Runs the chunks through the terminal and returns the number of CPU cycles
+//   this thread spent on it. Unlike the elapsed time, the cycle count doesn't
+//   include the time the thread was preempted, which makes it a lot more stable.
+uint64_t ComplexityFuzzer::_run(Terminal& terminal, const ComplexityCase& chunks) const
+{
+    const auto thread = GetCurrentThread();
+    ULONG64 start = 0;
+    ULONG64 end = 0;
+
+    LOG_IF_WIN32_BOOL_FALSE(QueryThreadCycleTime(thread, &start));
+
+    for (const auto& chunk : chunks)
+    {
+        if (chunk.kind == RecordedEventKind::Resize)
+        {
+            LOG_IF_FAILED(terminal.UserResize(chunk.size));
+        }
+        else
+        {
+            terminal.Write(chunk.text);
+        }
+
+        if (_scanPatterns)
+        {
+            auto lock = terminal.LockForWriting();
+            terminal.UpdatePatternsUnderLock();
+        }
+    }
+
+    LOG_IF_WIN32_BOOL_FALSE(QueryThreadCycleTime(thread, &end));
+    return end - start;
+}
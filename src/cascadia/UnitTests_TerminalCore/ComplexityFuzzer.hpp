@@ -0,0 +1,117 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- ComplexityFuzzer.hpp
+
+Abstract:
+- A fuzzer that looks for inputs which are disproportionately expensive to
+  process, instead of inputs that crash. It generates adversarial VT streams
+  (huge parameter lists, long OSC strings, scroll region and resize churn,
+  many hyperlinks, wide glyphs in awkward places, text full of URLs) and runs
+  them through Terminal, that is StateMachine -> AdaptDispatch -> TextBuffer.
+- Every generated stream is measured at two sizes, GrowthFactor apart. The cost
+  is the number of CPU cycles the thread spent, divided by the size of the
+  input. If the cost per character of the larger stream is more than the growth
+  threshold times that of the smaller one, or exceeds the absolute budget, the
+  input is reported. Before it's reported, it's minimized by removing events for
+  as long as the remaining ones stay over the limit.
+- Findings can be serialized as session recordings (see SessionRecording.hpp),
+  so that they can be replayed and profiled with SessionReplay.
+- It's only built into the TerminalCore unit tests, which run it.
+--*/
+
+#pragma once
+
+#include <random>
+
+#include "../cascadia/TerminalCore/SessionRecording.hpp"
+
+namespace Microsoft::Terminal::Core
+{
+    class Terminal;
+
+    // The generated input. Output events are written to the terminal and Resize events resize it.
+    // Every output event is a complete token, like a whole escape sequence, so that removing some
+    // of them while minimizing doesn't produce inputs that are expensive for unrelated reasons.
+    using ComplexityCase = std::vector<RecordedEvent>;
+
+    struct ComplexityGenerator
+    {
+        std::wstring_view name;
+        // Appends events to the case until its ComplexityFuzzer::SizeOf() is at least size.
+        // Given the same rng state, a larger size must produce more of the same kind of
+        // input and not something else, so that both sizes measure the same code paths.
+        void (*generate)(std::mt19937& rng, size_t size, ComplexityCase& events);
+    };
+
+    struct ComplexityFinding
+    {
+        std::wstring_view generator;
+        uint32_t seed = 0;
+        // The size of the larger of the two measured inputs.
+        size_t size = 0;
+        // The cost per character of the smaller and larger input in CPU cycles.
+        double smallCost = 0;
+        double largeCost = 0;
+        // The larger input, minimized.
+        ComplexityCase input;
+
+        double Growth() const noexcept;
+        std::string Serialize() const;
+    };
+
+    class ComplexityFuzzer
+    {
+    public:
+        // Called before every measurement. It must return a terminal in its initial state.
+        using TerminalFactory = std::function<Terminal&()>;
+        using Predicate = std::function<bool(const ComplexityCase&)>;
+
+        static constexpr size_t GrowthFactor = 4;
+        // Resize events count as this many characters, about the length of the equivalent `CSI 8 ; rows ; cols t`.
+        static constexpr size_t ResizeEventSize = 16;
+
+        explicit ComplexityFuzzer(TerminalFactory factory);
+
+        static gsl::span<const ComplexityGenerator> Generators() noexcept;
+        static size_t SizeOf(const ComplexityCase& events) noexcept;
+        static ComplexityCase Generate(const ComplexityGenerator& generator, const uint32_t seed, const size_t size);
+        static ComplexityCase Minimize(ComplexityCase events, const Predicate& predicate, const size_t maxTests);
+
+        // The size of the smaller input. The larger one is GrowthFactor times that.
+        void SetBaseSize(const size_t size) noexcept;
+        // The largest acceptable ratio between the cost per character of the larger and the smaller input.
+        void SetGrowthThreshold(const double threshold) noexcept;
+        // The largest acceptable cost per character in CPU cycles, regardless of growth.
+        void SetCostBudget(const double cyclesPerCharacter) noexcept;
+        // How often each input is measured. The cheapest run counts, which filters out most noise.
+        void SetRepetitions(const size_t repetitions) noexcept;
+        // Whether to scan the viewport for patterns after every chunk, like the control does for URLs.
+        // This requires the terminals returned by the factory to have URL detection enabled.
+        void SetScanPatterns(const bool enabled) noexcept;
+
+        // Runs the given number of seeds through every generator, starting at seed, and returns the findings.
+        std::vector<ComplexityFinding> Run(const uint32_t seed, const size_t iterations);
+        std::optional<ComplexityFinding> RunOne(const ComplexityGenerator& generator, const uint32_t seed);
+
+        // Returns the cost of the input in CPU cycles per character.
+        double Measure(const ComplexityCase& events);
+
+    private:
+        // Output is written in chunks of this size, about what a connection reads at once.
+        static constexpr size_t ChunkSize = 4096;
+        // Minimizing stops after this many measurements.
+        static constexpr size_t MaxMinimizationTests = 256;
+
+        uint64_t _run(Terminal& terminal, const ComplexityCase& events) const;
+
+        TerminalFactory _factory;
+        size_t _baseSize = 16 * 1024;
+        double _growthThreshold = 2.0;
+        double _costBudget = 100'000;
+        size_t _repetitions = 3;
+        bool _scanPatterns = false;
+    };
+}
@@ -0,0 +1,202 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "pch.h"
+#include <WexTestClass.h>
+
+#include "../renderer/inc/DummyRenderer.hpp"
+#include "../cascadia/TerminalCore/Terminal.hpp"
+#include "ComplexityFuzzer.hpp"
+#include "MockTermSettings.h"
+#include "../../inc/TestUtils.h"
+
+using namespace Microsoft::Terminal::Core;
+using namespace TerminalCoreUnitTests;
+
+using namespace WEX::Common;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+
+namespace TerminalCoreUnitTests
+{
+    class ComplexityFuzzerTests;
+};
+
+class TerminalCoreUnitTests::ComplexityFuzzerTests final
+{
+    TEST_CLASS(ComplexityFuzzerTests);
+
+    TEST_METHOD(GeneratorsAreDeterministic);
+    TEST_METHOD(MinimizeKeepsRelevantEvents);
+    TEST_METHOD(MeasureRunsInputThroughTerminal);
+    TEST_METHOD(FindSuperlinearInputs);
+
+    TEST_METHOD_SETUP(MethodSetup)
+    {
+        term = std::make_unique<Terminal>();
+        emptyRenderer = std::make_unique<DummyRenderer>(term.get());
+        term->Create({ 80, 32 }, 100, *emptyRenderer);
+        return true;
+    }
+
+    TEST_METHOD_CLEANUP(MethodCleanup)
+    {
+        emptyRenderer = nullptr;
+        term = nullptr;
+        return true;
+    }
+
+private:
+    static ComplexityCase _textEvents(const std::wstring_view characters)
+    {
+        ComplexityCase events;
+        for (const auto ch : characters)
+        {
+            events.emplace_back().text = std::wstring(1, ch);
+        }
+        return events;
+    }
+
+    static std::wstring _concat(const ComplexityCase& events)
+    {
+        std::wstring text;
+        for (const auto& event : events)
+        {
+            text += event.text;
+        }
+        return text;
+    }
+
+    std::unique_ptr<DummyRenderer> emptyRenderer;
+    std::unique_ptr<Terminal> term;
+};
+
+void ComplexityFuzzerTests::GeneratorsAreDeterministic()
+{
+    for (const auto& generator : ComplexityFuzzer::Generators())
+    {
+        Log::Comment(NoThrowString().Format(L"Generator: %.*s", gsl::narrow_cast<int>(generator.name.size()), generator.name.data()));
+
+        const auto first = ComplexityFuzzer::Generate(generator, 42, 4096);
+        const auto second = ComplexityFuzzer::Generate(generator, 42, 4096);
+        const auto larger = ComplexityFuzzer::Generate(generator, 42, 4 * 4096);
+
+        VERIFY_ARE_EQUAL(first.size(), second.size());
+        for (size_t i = 0; i < first.size(); ++i)
+        {
+            VERIFY_IS_TRUE(first[i].kind == second[i].kind);
+            VERIFY_ARE_EQUAL(first[i].text, second[i].text);
+            VERIFY_ARE_EQUAL(first[i].size, second[i].size);
+        }
+
+        VERIFY_IS_GREATER_THAN_OR_EQUAL(ComplexityFuzzer::SizeOf(first), 4096u);
+        VERIFY_IS_GREATER_THAN_OR_EQUAL(ComplexityFuzzer::SizeOf(larger), 4u * 4096u);
+    }
+}
+
+void ComplexityFuzzerTests::MinimizeKeepsRelevantEvents()
+{
+    const auto events = _textEvents(L"abcdefgh");
+    const auto predicate = [](const ComplexityCase& candidate) {
+        const auto text = _concat(candidate);
+        return text.find(L'c') != std::wstring::npos && text.find(L'f') != std::wstring::npos;
+    };
+
+    VERIFY_ARE_EQUAL(L"cf", _concat(ComplexityFuzzer::Minimize(events, predicate, 100)));
+    // Without any tests the input can't be minimized.
+    VERIFY_ARE_EQUAL(L"abcdefgh", _concat(ComplexityFuzzer::Minimize(events, predicate, 0)));
+    // Running out of tests returns a smaller input that still satisfies the predicate.
+    const auto partial = ComplexityFuzzer::Minimize(events, predicate, 3);
+    VERIFY_IS_LESS_THAN(partial.size(), events.size());
+    VERIFY_IS_TRUE(predicate(partial));
+}
+
+void ComplexityFuzzerTests::MeasureRunsInputThroughTerminal()
+{
+    ComplexityCase events;
+    events.emplace_back().text = L"Hello ";
+    auto& resize = events.emplace_back();
+    resize.kind = RecordedEventKind::Resize;
+    resize.size = { 40, 10 };
+    events.emplace_back().text = L"World";
+
+    VERIFY_ARE_EQUAL(11u + ComplexityFuzzer::ResizeEventSize, ComplexityFuzzer::SizeOf(events));
+
+    size_t terminals = 0;
+    ComplexityFuzzer fuzzer{ [&]() -> Terminal& {
+        terminals++;
+        MethodCleanup();
+        MethodSetup();
+        return *term;
+    } };
+    fuzzer.SetRepetitions(2);
+
+    VERIFY_IS_GREATER_THAN(fuzzer.Measure(events), 0.0);
+    // Every repetition starts with a fresh terminal.
+    VERIFY_ARE_EQUAL(2u, terminals);
+    VERIFY_ARE_EQUAL(40, term->GetViewport().Width());
+    VERIFY_ARE_EQUAL(10, term->GetViewport().Height());
+    TestUtils::VerifyExpectedString(term->GetTextBuffer(), L"Hello World", { 0, 0 });
+}
+
+void ComplexityFuzzerTests::FindSuperlinearInputs()
+{
+    // Runs the given number of fuzzing iterations with every generator, like this:
+    //   te.exe UnitTests_TerminalCore.dll /name:*FindSuperlinearInputs /p:ComplexityFuzzIterations=100
+    // Findings are logged and, if the "ComplexityFuzzOutput" runtime parameter names a
+    // directory, saved there as session recordings. This does nothing by default,
+    // because the results depend on the machine and take a while to produce.
+    String iterationsValue;
+    if (FAILED(RuntimeParameters::TryGetValue(L"ComplexityFuzzIterations", iterationsValue)) || iterationsValue.IsEmpty())
+    {
+        Log::Result(TestResults::Skipped);
+        return;
+    }
+
+    String seedValue;
+    String output;
+    RuntimeParameters::TryGetValue(L"ComplexityFuzzSeed", seedValue);
+    RuntimeParameters::TryGetValue(L"ComplexityFuzzOutput", output);
+    const auto iterations = gsl::narrow_cast<uint32_t>(std::wcstoul(static_cast<const wchar_t*>(iterationsValue), nullptr, 10));
+    const auto seed = seedValue.IsEmpty() ? gsl::narrow_cast<uint32_t>(GetTickCount()) : gsl::narrow_cast<uint32_t>(std::wcstoul(static_cast<const wchar_t*>(seedValue), nullptr, 10));
+
+    // A terminal as the control creates it, with a full scrollback and URL detection.
+    auto settings = winrt::make<MockTermSettings>(9001, 30, 120);
+    settings.DetectURLs(true);
+
+    ComplexityFuzzer fuzzer{ [&]() -> Terminal& {
+        emptyRenderer = nullptr;
+        term = std::make_unique<Terminal>();
+        emptyRenderer = std::make_unique<DummyRenderer>(term.get());
+        term->CreateFromSettings(settings, *emptyRenderer);
+        return *term;
+    } };
+    fuzzer.SetScanPatterns(true);
+
+    Log::Comment(NoThrowString().Format(L"Seed: %u, iterations: %u", seed, iterations));
+    const auto findings = fuzzer.Run(seed, iterations);
+
+    for (const auto& finding : findings)
+    {
+        Log::Comment(NoThrowString().Format(
+            L"%.*s, seed %u: %.0f cycles/char at %zu chars, %.1fx the cost per char at a quarter of the size. Minimized to %zu chars.",
+            gsl::narrow_cast<int>(finding.generator.size()),
+            finding.generator.data(),
+            finding.seed,
+            finding.largeCost,
+            finding.size,
+            finding.Growth(),
+            ComplexityFuzzer::SizeOf(finding.input)));
+
+        if (!output.IsEmpty())
+        {
+            std::filesystem::path path{ static_cast<const wchar_t*>(output) };
+            path /= fmt::format(FMT_COMPILE(L"{}-{}.wtrc"), finding.generator, finding.seed);
+            const auto bytes = finding.Serialize();
+            std::ofstream file{ path, std::ios::binary };
+            file.write(bytes.data(), gsl::narrow_cast<std::streamsize>(bytes.size()));
+        }
+    }
+
+    VERIFY_ARE_EQUAL(0u, findings.size());
+}
@@ -0,0 +1,277 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "pch.h"
+#include <WexTestClass.h>
+
+#include "../renderer/inc/DummyRenderer.hpp"
+#include "../renderer/base/Renderer.hpp"
+#include "../cascadia/TerminalCore/Terminal.hpp"
+#include "../cascadia/TerminalCore/LatencyTracker.hpp"
+#include "../../inc/TestUtils.h"
+
+using namespace Microsoft::Terminal::Core;
+using namespace Microsoft::Console::Render;
+using namespace std::chrono_literals;
+
+using namespace WEX::Common;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+
+namespace
+{
+    // An engine that paints nothing, so that frames can be painted without a window.
+    class MockLatencyRenderEngine final : public RenderEngineBase
+    {
+    public:
+        size_t PresentCount() const noexcept
+        {
+            return _presentCount;
+        }
+
+        HRESULT StartPaint() noexcept { return S_OK; }
+        HRESULT EndPaint() noexcept { return S_OK; }
+        HRESULT Present() noexcept
+        {
+            _presentCount++;
+            return S_OK;
+        }
+        HRESULT PrepareForTeardown(_Out_ bool* /*pForcePaint*/) noexcept { return S_OK; }
+        HRESULT ScrollFrame() noexcept { return S_OK; }
+        HRESULT Invalidate(const til::rect* /*psrRegion*/) noexcept { return S_OK; }
+        HRESULT InvalidateCursor(const til::rect* /*psrRegion*/) noexcept { return S_OK; }
+        HRESULT InvalidateSystem(const til::rect* /*prcDirtyClient*/) noexcept { return S_OK; }
+        HRESULT InvalidateSelection(const std::vector<til::rect>& /*rectangles*/) noexcept { return S_OK; }
+        HRESULT InvalidateScroll(const til::point* /*pcoordDelta*/) noexcept { return S_OK; }
+        HRESULT InvalidateAll() noexcept { return S_OK; }
+        HRESULT InvalidateCircling(_Out_ bool* /*pForcePaint*/) noexcept { return S_OK; }
+        HRESULT PaintBackground() noexcept { return S_OK; }
+        HRESULT PaintBufferLine(gsl::span<const Cluster> /*clusters*/, til::point /*coord*/, bool /*fTrimLeft*/, bool /*lineWrapped*/) noexcept { return S_OK; }
+        HRESULT PaintBufferGridLines(GridLineSet /*lines*/, COLORREF /*color*/, size_t /*cchLine*/, til::point /*coordTarget*/) noexcept { return S_OK; }
+        HRESULT PaintSelection(const til::rect& /*rect*/) noexcept { return S_OK; }
+        HRESULT PaintCursor(const CursorOptions& /*options*/) noexcept { return S_OK; }
+        HRESULT UpdateDrawingBrushes(const TextAttribute& /*textAttributes*/, const RenderSettings& /*renderSettings*/, gsl::not_null<IRenderData*> /*pData*/, bool /*usingSoftFont*/, bool /*isSettingDefaultBrushes*/) noexcept { return S_OK; }
+        HRESULT UpdateFont(const FontInfoDesired& /*FontInfoDesired*/, _Out_ FontInfo& /*FontInfo*/) noexcept { return S_OK; }
+        HRESULT UpdateDpi(int /*iDpi*/) noexcept { return S_OK; }
+        HRESULT UpdateViewport(const til::inclusive_rect& /*srNewViewport*/) noexcept { return S_OK; }
+        HRESULT GetProposedFont(const FontInfoDesired& /*FontInfoDesired*/, _Out_ FontInfo& /*FontInfo*/, int /*iDpi*/) noexcept { return S_OK; }
+        HRESULT GetDirtyArea(gsl::span<const til::rect>& /*area*/) noexcept { return S_OK; }
+        HRESULT GetFontSize(_Out_ til::size* /*pFontSize*/) noexcept { return S_OK; }
+        HRESULT IsGlyphWideByFont(std::wstring_view /*glyph*/, _Out_ bool* /*pResult*/) noexcept { return S_OK; }
+
+    protected:
+        HRESULT _DoUpdateTitle(const std::wstring_view /*newTitle*/) noexcept { return S_OK; }
+
+    private:
+        size_t _presentCount = 0;
+    };
+}
+
+namespace TerminalCoreUnitTests
+{
+    class LatencyTrackerTests;
+};
+using namespace TerminalCoreUnitTests;
+
+class TerminalCoreUnitTests::LatencyTrackerTests final
+{
+    TEST_CLASS(LatencyTrackerTests);
+
+    TEST_METHOD(HistogramStatistics);
+    TEST_METHOD(HistogramPercentileBounds);
+    TEST_METHOD(DisabledTrackerIgnoresEverything);
+    TEST_METHOD(CorrelatesInputWithOutputAndFrame);
+    TEST_METHOD(OnlyFirstInputOfKeyPressIsTracked);
+    TEST_METHOD(DropsInputsWithoutOutput);
+    TEST_METHOD(MeasuresKeyPressThroughTerminal);
+};
+
+void LatencyTrackerTests::HistogramStatistics()
+{
+    LatencyHistogram histogram;
+    VERIFY_ARE_EQUAL(0u, histogram.Count());
+    VERIFY_ARE_EQUAL(0, histogram.Percentile(50).count());
+    VERIFY_ARE_EQUAL(0, histogram.Mean().count());
+
+    for (auto i = 1; i <= 100; ++i)
+    {
+        histogram.Add(std::chrono::microseconds{ i });
+    }
+
+    VERIFY_ARE_EQUAL(100u, histogram.Count());
+    VERIFY_ARE_EQUAL(1, histogram.Min().count());
+    VERIFY_ARE_EQUAL(100, histogram.Max().count());
+    VERIFY_ARE_EQUAL(50, histogram.Mean().count());
+    // The lowest and highest percentiles are exact, because they're clamped to the recorded values.
+    VERIFY_ARE_EQUAL(1, histogram.Percentile(0).count());
+    VERIFY_ARE_EQUAL(100, histogram.Percentile(100).count());
+
+    // Values below zero can't be measured with a steady clock, but shouldn't break anything either.
+    histogram.Add(-5us);
+    VERIFY_ARE_EQUAL(0, histogram.Min().count());
+
+    histogram.Clear();
+    VERIFY_ARE_EQUAL(0u, histogram.Count());
+    VERIFY_ARE_EQUAL(0, histogram.Max().count());
+}
+
+void LatencyTrackerTests::HistogramPercentileBounds()
+{
+    // The median of { value, 1h } is value, which the histogram must
+    // report exactly for small values and within 12.5% for larger ones.
+    for (int64_t value = 0; value < 100'000; value = value * 5 / 4 + 1)
+    {
+        LatencyHistogram histogram;
+        histogram.Add(std::chrono::microseconds{ value });
+        histogram.Add(1h);
+
+        const auto median = histogram.Percentile(50).count();
+        VERIFY_IS_GREATER_THAN_OR_EQUAL(median, value);
+        VERIFY_IS_LESS_THAN_OR_EQUAL(median, value < 8 ? value : value + value / 8);
+    }
+}
+
+void LatencyTrackerTests::DisabledTrackerIgnoresEverything()
+{
+    LatencyTracker tracker;
+    VERIFY_IS_FALSE(tracker.IsEnabled());
+
+    tracker.BeginInput();
+    VERIFY_ARE_EQUAL(0u, tracker.OnInputSent());
+    tracker.EndInput();
+    tracker.OnOutput();
+    tracker.OnFrameStarted();
+    tracker.OnFramePresented();
+
+    const auto statistics = tracker.GetStatistics();
+    VERIFY_ARE_EQUAL(0u, statistics.input.Count());
+    VERIFY_ARE_EQUAL(0u, statistics.output.Count());
+    VERIFY_ARE_EQUAL(0u, statistics.paint.Count());
+}
+
+void LatencyTrackerTests::CorrelatesInputWithOutputAndFrame()
+{
+    LatencyTracker tracker;
+    tracker.SetEnabled(true);
+
+    tracker.BeginInput();
+    VERIFY_ARE_EQUAL(1u, tracker.OnInputSent());
+    tracker.EndInput();
+
+    // A frame without any output since the input doesn't show it.
+    tracker.OnFrameStarted();
+    tracker.OnFramePresented();
+    VERIFY_ARE_EQUAL(0u, tracker.GetStatistics().paint.Count());
+
+    // Neither does a frame that started before the output arrived.
+    tracker.OnFrameStarted();
+    tracker.OnOutput();
+    tracker.OnFramePresented();
+    VERIFY_ARE_EQUAL(0u, tracker.GetStatistics().paint.Count());
+
+    tracker.OnFrameStarted();
+    tracker.OnFramePresented();
+
+    const auto statistics = tracker.GetStatistics();
+    VERIFY_ARE_EQUAL(1u, statistics.input.Count());
+    VERIFY_ARE_EQUAL(1u, statistics.output.Count());
+    VERIFY_ARE_EQUAL(1u, statistics.paint.Count());
+    VERIFY_IS_LESS_THAN_OR_EQUAL(statistics.input.Max().count(), statistics.output.Max().count());
+    VERIFY_IS_LESS_THAN_OR_EQUAL(statistics.output.Max().count(), statistics.paint.Max().count());
+
+    // Later frames don't count the same input again.
+    tracker.OnFrameStarted();
+    tracker.OnFramePresented();
+    VERIFY_ARE_EQUAL(1u, tracker.GetStatistics().paint.Count());
+
+    // Disabling the tracker discards the statistics.
+    tracker.SetEnabled(false);
+    VERIFY_ARE_EQUAL(0u, tracker.GetStatistics().paint.Count());
+}
+
+void LatencyTrackerTests::OnlyFirstInputOfKeyPressIsTracked()
+{
+    LatencyTracker tracker;
+    tracker.SetEnabled(true);
+
+    // Input that wasn't caused by a key press, like the response to a DSR.
+    VERIFY_ARE_EQUAL(0u, tracker.OnInputSent());
+
+    tracker.BeginInput();
+    VERIFY_ARE_EQUAL(1u, tracker.OnInputSent());
+    VERIFY_ARE_EQUAL(0u, tracker.OnInputSent());
+    tracker.EndInput();
+
+    // A key press that didn't produce any input, like a modifier key.
+    tracker.BeginInput();
+    tracker.EndInput();
+    VERIFY_ARE_EQUAL(0u, tracker.OnInputSent());
+
+    // Output completes all inputs that were sent before it.
+    tracker.BeginInput();
+    VERIFY_ARE_EQUAL(2u, tracker.OnInputSent());
+    tracker.EndInput();
+    tracker.OnOutput();
+    tracker.OnFrameStarted();
+    tracker.OnFramePresented();
+    VERIFY_ARE_EQUAL(2u, tracker.GetStatistics().paint.Count());
+}
+
+void LatencyTrackerTests::DropsInputsWithoutOutput()
+{
+    LatencyTracker tracker;
+    tracker.SetEnabled(true);
+
+    constexpr auto extra = 3;
+    for (size_t i = 0; i < LatencyTracker::MaxPendingInputs + extra; ++i)
+    {
+        tracker.BeginInput();
+        tracker.OnInputSent();
+        tracker.EndInput();
+    }
+
+    VERIFY_ARE_EQUAL(static_cast<size_t>(extra), tracker.GetStatistics().dropped);
+
+    tracker.OnOutput();
+    tracker.OnFrameStarted();
+    tracker.OnFramePresented();
+    VERIFY_ARE_EQUAL(LatencyTracker::MaxPendingInputs, tracker.GetStatistics().paint.Count());
+}
+
+void LatencyTrackerTests::MeasuresKeyPressThroughTerminal()
+{
+    // This drives the same hooks as ControlCore does, with a connection that
+    // echoes its input like the EchoConnection and an engine that paints nothing.
+    LatencyTracker tracker;
+    tracker.SetEnabled(true);
+
+    Terminal term;
+    MockLatencyRenderEngine engine;
+    DummyRenderer renderer{ &term };
+    renderer.AddRenderEngine(&engine);
+    renderer.SetFrameStartedCallback([&](IRenderEngine*) { tracker.OnFrameStarted(); });
+    renderer.SetFramePresentedCallback([&](IRenderEngine*) { tracker.OnFramePresented(); });
+    term.Create({ 80, 32 }, 100, renderer);
+
+    term.SetWriteInputCallback([&](std::wstring_view wstr) {
+        tracker.OnInputSent();
+        term.Write(wstr);
+        tracker.OnOutput();
+    });
+
+    tracker.BeginInput();
+    VERIFY_IS_TRUE(term.SendCharEvent(L'a', 0, {}));
+    tracker.EndInput();
+
+    // The echo is in the buffer, but it isn't measured until it was presented.
+    TestUtils::VerifyExpectedString(term.GetTextBuffer(), L"a", { 0, 0 });
+    VERIFY_ARE_EQUAL(0u, tracker.GetStatistics().paint.Count());
+
+    VERIFY_SUCCEEDED(renderer.PaintFrame());
+    VERIFY_ARE_EQUAL(1u, engine.PresentCount());
+
+    const auto statistics = tracker.GetStatistics();
+    VERIFY_ARE_EQUAL(1u, statistics.paint.Count());
+    VERIFY_ARE_EQUAL(0u, statistics.dropped);
+    Log::Comment(NoThrowString().Format(L"Key press to present: %lldus", statistics.paint.Max().count()));
+}
@@ -0,0 +1,88 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "pch.h"
+#include <WexTestClass.h>
+
+#include "../cascadia/TerminalCore/OutputCoalescer.hpp"
+
+using namespace Microsoft::Terminal::Core;
+using namespace std::chrono_literals;
+
+using namespace WEX::Common;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+
+namespace TerminalCoreUnitTests
+{
+    class OutputCoalescerTests;
+};
+using namespace TerminalCoreUnitTests;
+
+class TerminalCoreUnitTests::OutputCoalescerTests final
+{
+    TEST_CLASS(OutputCoalescerTests);
+
+    TEST_METHOD(OutputIsFlushedInOrder);
+    TEST_METHOD(AppendBlocksWhileTooMuchIsPending);
+};
+
+void OutputCoalescerTests::OutputIsFlushedInOrder()
+{
+    OutputCoalescer coalescer;
+    std::wstring expected;
+    std::wstring actual;
+    std::thread flush;
+
+    // Like ControlCore: a flush is started on another thread whenever Append asks for one.
+    for (auto i = 0; i < 100000; ++i)
+    {
+        const auto text = fmt::format(L"{}\r\n", i);
+        expected += text;
+        if (coalescer.Append(text))
+        {
+            if (flush.joinable())
+            {
+                flush.join();
+            }
+            flush = std::thread{ [&]() {
+                std::wstring batch;
+                while (coalescer.Take(batch))
+                {
+                    actual += batch;
+                    std::this_thread::sleep_for(100us);
+                }
+            } };
+        }
+    }
+    flush.join();
+
+    VERIFY_IS_FALSE(coalescer.IsFlushing());
+    VERIFY_ARE_EQUAL(expected, actual);
+}
+
+void OutputCoalescerTests::AppendBlocksWhileTooMuchIsPending()
+{
+    OutputCoalescer coalescer;
+    const std::wstring large(OutputCoalescer::MaxPendingSize, L'a');
+    VERIFY_IS_TRUE(coalescer.Append(large));
+
+    std::atomic<bool> appended{ false };
+    std::thread producer{ [&]() {
+        coalescer.Append(L"b");
+        appended.store(true);
+    } };
+
+    std::this_thread::sleep_for(100ms);
+    VERIFY_IS_FALSE(appended.load());
+
+    std::wstring batch;
+    VERIFY_IS_TRUE(coalescer.Take(batch));
+    VERIFY_ARE_EQUAL(large.size(), batch.size());
+    producer.join();
+    VERIFY_IS_TRUE(appended.load());
+
+    VERIFY_IS_TRUE(coalescer.Take(batch));
+    VERIFY_ARE_EQUAL(L"b", batch);
+    VERIFY_IS_FALSE(coalescer.Take(batch));
+}
@@ -0,0 +1,193 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "pch.h"
+#include <WexTestClass.h>
+
+#include "../renderer/inc/DummyRenderer.hpp"
+#include "../cascadia/TerminalCore/Terminal.hpp"
+#include "../cascadia/TerminalCore/SessionRecording.hpp"
+#include "../../inc/TestUtils.h"
+
+using namespace Microsoft::Terminal::Core;
+
+using namespace WEX::Common;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+
+namespace TerminalCoreUnitTests
+{
+    class SessionRecordingTests;
+};
+using namespace TerminalCoreUnitTests;
+
+class TerminalCoreUnitTests::SessionRecordingTests final
+{
+    TEST_CLASS(SessionRecordingTests);
+
+    TEST_METHOD(RoundTrip);
+    TEST_METHOD(SplitSurrogatePair);
+    TEST_METHOD(RejectsTruncatedRecording);
+    TEST_METHOD(ReplayIntoTerminal);
+    TEST_METHOD(ReplayCorpus);
+
+    TEST_METHOD_SETUP(MethodSetup)
+    {
+        term = std::make_unique<Terminal>();
+        emptyRenderer = std::make_unique<DummyRenderer>(term.get());
+        term->Create({ 80, 32 }, 100, *emptyRenderer);
+        return true;
+    }
+
+    TEST_METHOD_CLEANUP(MethodCleanup)
+    {
+        emptyRenderer = nullptr;
+        term = nullptr;
+        return true;
+    }
+
+private:
+    static std::string _record(const std::function<void(SessionRecorder&)>& func)
+    {
+        std::string bytes;
+        {
+            SessionRecorder recorder{ [&](std::string_view chunk) { bytes.append(chunk); } };
+            func(recorder);
+        }
+        return bytes;
+    }
+
+    static void _logStatistics(const ReplayStatistics& stats)
+    {
+        Log::Comment(NoThrowString().Format(
+            L"chunks: %zu, characters: %zu, resizes: %zu, frames: %zu, elapsed: %lldus, chars/s: %.0f, p50: %lldns, p99: %lldns",
+            stats.chunks,
+            stats.characters,
+            stats.resizes,
+            stats.frames,
+            std::chrono::duration_cast<std::chrono::microseconds>(stats.elapsed).count(),
+            stats.CharactersPerSecond(),
+            stats.LatencyPercentile(50).count(),
+            stats.LatencyPercentile(99).count()));
+    }
+
+    std::unique_ptr<DummyRenderer> emptyRenderer;
+    std::unique_ptr<Terminal> term;
+};
+
+void SessionRecordingTests::RoundTrip()
+{
+    const auto bytes = _record([](SessionRecorder& recorder) {
+        recorder.RecordResize({ 120, 30 });
+        recorder.RecordOutput(L"\x1b[31mHello\x1b[m");
+        recorder.RecordInput(L"dir\r");
+        recorder.RecordOutput(L"Wörld 世界");
+    });
+
+    const auto recording = SessionRecording::Parse(bytes);
+    const auto& events = recording.Events();
+    VERIFY_ARE_EQUAL(4u, events.size());
+
+    VERIFY_IS_TRUE(RecordedEventKind::Resize == events[0].kind);
+    VERIFY_ARE_EQUAL(til::size(120, 30), events[0].size);
+    VERIFY_IS_TRUE(RecordedEventKind::Output == events[1].kind);
+    VERIFY_ARE_EQUAL(L"\x1b[31mHello\x1b[m", events[1].text);
+    VERIFY_IS_TRUE(RecordedEventKind::Input == events[2].kind);
+    VERIFY_ARE_EQUAL(L"dir\r", events[2].text);
+    VERIFY_IS_TRUE(RecordedEventKind::Output == events[3].kind);
+    VERIFY_ARE_EQUAL(L"Wörld 世界", events[3].text);
+
+    // Timestamps are relative to the start of the recording and never decrease.
+    VERIFY_ARE_EQUAL(0, events[0].timestamp.count());
+    for (size_t i = 1; i < events.size(); ++i)
+    {
+        VERIFY_IS_TRUE(events[i - 1].timestamp <= events[i].timestamp);
+    }
+    VERIFY_ARE_EQUAL(events.back().timestamp.count(), recording.Duration().count());
+}
+
+void SessionRecordingTests::SplitSurrogatePair()
+{
+    // U+1F600 split across two output chunks must be stored as a single code point.
+    const auto bytes = _record([](SessionRecorder& recorder) {
+        recorder.RecordOutput(L"a\xD83D");
+        recorder.RecordOutput(L"\xDE00z");
+    });
+
+    const auto recording = SessionRecording::Parse(bytes);
+    std::wstring text;
+    for (const auto& event : recording.Events())
+    {
+        text += event.text;
+    }
+    VERIFY_ARE_EQUAL(L"a\xD83D\xDE00z", text);
+}
+
+void SessionRecordingTests::RejectsTruncatedRecording()
+{
+    auto bytes = _record([](SessionRecorder& recorder) {
+        recorder.RecordOutput(L"Hello World");
+    });
+    bytes.pop_back();
+
+    VERIFY_THROWS(SessionRecording::Parse(bytes), wil::ResultException);
+    VERIFY_THROWS(SessionRecording::Parse("XXXX"), wil::ResultException);
+}
+
+void SessionRecordingTests::ReplayIntoTerminal()
+{
+    const auto bytes = _record([](SessionRecorder& recorder) {
+        recorder.RecordResize({ 40, 10 });
+        recorder.RecordOutput(L"Hello ");
+        recorder.RecordInput(L"ignored");
+        recorder.RecordOutput(L"World");
+    });
+    const auto recording = SessionRecording::Parse(bytes);
+
+    size_t paints = 0;
+    SessionReplay replay{ *term };
+    replay.SetPacing(SessionReplay::Pacing::AsFastAsPossible);
+    replay.SetPaintCallback([&]() { paints++; });
+    const auto stats = replay.Run(recording);
+    _logStatistics(stats);
+
+    VERIFY_ARE_EQUAL(2u, stats.chunks);
+    VERIFY_ARE_EQUAL(11u, stats.characters);
+    VERIFY_ARE_EQUAL(1u, stats.resizes);
+    VERIFY_ARE_EQUAL(2u, stats.chunkLatencies.size());
+    VERIFY_IS_GREATER_THAN_OR_EQUAL(stats.frames, 1u);
+    VERIFY_ARE_EQUAL(stats.frames, paints);
+
+    VERIFY_ARE_EQUAL(40, term->GetViewport().Width());
+    VERIFY_ARE_EQUAL(10, term->GetViewport().Height());
+    TestUtils::VerifyExpectedString(term->GetTextBuffer(), L"Hello World", { 0, 0 });
+}
+
+void SessionRecordingTests::ReplayCorpus()
+{
+    // Replays every recording in the directory given by the "SessionRecordingCorpus"
+    // runtime parameter and logs its statistics. This is meant to be used for
+    // performance comparisons between builds and does nothing by default.
+    String corpus;
+    if (FAILED(RuntimeParameters::TryGetValue(L"SessionRecordingCorpus", corpus)) || corpus.IsEmpty())
+    {
+        Log::Result(TestResults::Skipped);
+        return;
+    }
+
+    for (const auto& entry : std::filesystem::directory_iterator{ static_cast<const wchar_t*>(corpus) })
+    {
+        if (!entry.is_regular_file())
+        {
+            continue;
+        }
+
+        MethodCleanup();
+        MethodSetup();
+
+        Log::Comment(NoThrowString().Format(L"Replaying %s", entry.path().c_str()));
+        const auto recording = SessionRecording::Load(entry.path().native());
+        SessionReplay replay{ *term };
+        _logStatistics(replay.Run(recording));
+    }
+}
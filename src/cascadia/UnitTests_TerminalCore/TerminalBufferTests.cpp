@@ -6,6 +6,7 @@
 
 #include "../renderer/inc/DummyRenderer.hpp"
 #include "../cascadia/TerminalCore/Terminal.hpp"
+#include "../cascadia/TerminalCore/OutputCoalescer.hpp"
 #include "MockTermSettings.h"
 #include "consoletaeftemplates.hpp"
 #include "../../inc/TestUtils.h"
@@ -53,6 +54,9 @@ class TerminalCoreUnitTests::TerminalBufferTests final
 
     TEST_METHOD(TestCursorNotifications);
 
+    TEST_METHOD(SkipUnseenOutputKeepsEndState);
+    TEST_METHOD(SkipUnseenOutputOfCoalescedChunks);
+
     TEST_METHOD_SETUP(MethodSetup)
     {
         // STEP 1: Set up the Terminal
@@ -72,6 +76,7 @@ class TerminalCoreUnitTests::TerminalBufferTests final
 private:
     void _SetTabStops(std::list<til::CoordType> columns, bool replace);
     std::list<til::CoordType> _GetTabStops();
+    static void _VerifySameEndState(Terminal& expected, Terminal& actual);
 
     std::unique_ptr<DummyRenderer> emptyRenderer;
     std::unique_ptr<Terminal> term;
@@ -636,3 +641,129 @@ void TerminalBufferTests::TestCursorNotifications()
     VERIFY_ARE_EQUAL(0, expectedCallbacks);
     VERIFY_IS_TRUE(callbackWasCalled);
 }
+
+void TerminalBufferTests::SkipUnseenOutputKeepsEndState()
+{
+    // Writes the same output to `term`, which writes every line, and to
+    // a terminal that skips the lines that scroll out unseen.
+    auto settings = winrt::make<MockTermSettings>(TerminalHistoryLength, TerminalViewHeight, TerminalViewWidth);
+    settings.SkipUnseenOutput(true);
+    Terminal skipping;
+    DummyRenderer skippingRenderer{ &skipping };
+    skipping.CreateFromSettings(settings, skippingRenderer);
+
+    const auto rows = TerminalViewHeight + TerminalHistoryLength;
+
+    // Lines are only skipped while the cursor is on the last row of the buffer.
+    const std::wstring fill(rows, L'\n');
+
+    // Some lines wrap and the attributes carry over from line to line,
+    // except where an SGR sequence resets them.
+    std::wstring flood;
+    for (auto i = 0; i < rows * 3; ++i)
+    {
+        flood += fmt::format(L"\x1b[{}m{}{}\x1b[{}m\r\n",
+                             i % 5 == 0 ? L";4" : L"1",
+                             std::wstring(i % 4 == 0 ? TerminalViewWidth + 10 : 10, L'a' + i % 26),
+                             i,
+                             31 + i % 7);
+    }
+    flood += L"\x1b[7mtail";
+
+    // Output that moves the cursor around can't be skipped.
+    std::wstring positioned{ flood };
+    positioned.insert(100, L"\x1b[5;5H");
+
+    for (const auto& output : { fill, flood, fill, positioned })
+    {
+        term->Write(output);
+        skipping.Write(output);
+        _VerifySameEndState(*term, skipping);
+    }
+}
+
+void TerminalBufferTests::SkipUnseenOutputOfCoalescedChunks()
+{
+    // The default history, which has more rows than a chunk of output from ConPTY has lines.
+    constexpr til::CoordType historySize = 9001;
+    constexpr til::CoordType viewHeight = 30;
+    constexpr til::CoordType viewWidth = 120;
+    constexpr size_t chunkSize = 16 * 1024;
+
+    auto settings = winrt::make<MockTermSettings>(historySize, viewHeight, viewWidth);
+    Terminal writing;
+    DummyRenderer writingRenderer{ &writing };
+    writing.CreateFromSettings(settings, writingRenderer);
+
+    settings.SkipUnseenOutput(true);
+    Terminal skipping;
+    DummyRenderer skippingRenderer{ &skipping };
+    skipping.CreateFromSettings(settings, skippingRenderer);
+
+    const auto rows = viewHeight + historySize;
+    const std::wstring fill(rows, L'\n');
+    writing.Write(fill);
+    skipping.Write(fill);
+
+    // Short lines, so that a chunk has as many of them as possible,
+    // and chunks that end in the middle of lines and SGR sequences.
+    std::wstring flood;
+    for (auto i = 0; i < rows * 2; ++i)
+    {
+        flood += i % 3 == 0 ? fmt::format(L"\x1b[3{}m{}\x1b[m\r\n", i % 8, i) : fmt::format(L"{}\r\n", i);
+    }
+    std::vector<std::wstring_view> chunks;
+    for (size_t i = 0; i < flood.size(); i += chunkSize)
+    {
+        chunks.emplace_back(std::wstring_view{ flood }.substr(i, chunkSize));
+    }
+
+    Log::Comment(L"A single chunk doesn't have enough lines to skip any of them...");
+    VERIFY_IS_GREATER_THAN(chunks.size(), 2u);
+    VERIFY_ARE_EQUAL(chunks.front().size(), skipping._SkipUnseenOutput(chunks.front()).size());
+
+    Log::Comment(L"...but the chunks that arrive while the terminal is busy are written in one go.");
+    Microsoft::Terminal::Core::OutputCoalescer coalescer;
+    VERIFY_IS_TRUE(coalescer.Append(chunks.front()));
+    for (size_t i = 1; i < chunks.size(); ++i)
+    {
+        VERIFY_IS_FALSE(coalescer.Append(chunks[i]));
+    }
+
+    std::wstring batch;
+    VERIFY_IS_TRUE(coalescer.Take(batch));
+    VERIFY_ARE_EQUAL(flood, batch);
+    {
+        // The same as Terminal::Write, which doesn't tell whether it skipped anything.
+        auto lock = skipping.LockForWriting();
+        const auto remaining = skipping._SkipUnseenOutput(batch);
+        VERIFY_IS_LESS_THAN(remaining.size(), batch.size() - chunkSize);
+        skipping._stateMachine->ProcessString(remaining);
+    }
+    VERIFY_IS_FALSE(coalescer.Take(batch));
+    VERIFY_IS_FALSE(coalescer.IsFlushing());
+
+    for (const auto& chunk : chunks)
+    {
+        writing.Write(chunk);
+    }
+    _VerifySameEndState(writing, skipping);
+}
+
+void TerminalBufferTests::_VerifySameEndState(Terminal& expected, Terminal& actual)
+{
+    const auto& expectedBuffer = expected.GetTextBuffer();
+    const auto& actualBuffer = actual.GetTextBuffer();
+    VERIFY_ARE_EQUAL(expectedBuffer.GetCursor().GetPosition(), actualBuffer.GetCursor().GetPosition());
+    VERIFY_ARE_EQUAL(expectedBuffer.GetCurrentAttributes(), actualBuffer.GetCurrentAttributes());
+    VERIFY_ARE_EQUAL(expected.GetViewport().Top(), actual.GetViewport().Top());
+    VERIFY_ARE_EQUAL(expected.GetScrollOffset(), actual.GetScrollOffset());
+    for (auto y = 0; y < expectedBuffer.GetSize().Height(); ++y)
+    {
+        const auto& expectedRow = expectedBuffer.GetRowByOffset(y);
+        const auto& actualRow = actualBuffer.GetRowByOffset(y);
+        VERIFY_ARE_EQUAL(expectedRow.GetText(), actualRow.GetText());
+        VERIFY_IS_TRUE(expectedRow.GetAttrRow() == actualRow.GetAttrRow());
+        VERIFY_ARE_EQUAL(expectedRow.WasWrapForced(), actualRow.WasWrapForced());
+    }
+}
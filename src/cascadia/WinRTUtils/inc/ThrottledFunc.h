@@ -23,21 +23,21 @@ public:
     //   be started. After the timer has expired `func` will be invoked just once.
     //
     // After `func` was invoked the state is reset and this cycle is repeated again.
+    //
+    // All instances share the timers of til::timer_wheel::shared().
     ThrottledFunc(
         winrt::Windows::System::DispatcherQueue dispatcher,
         filetime_duration delay,
         function func) :
+        _delay{ std::chrono::duration_cast<til::timer_wheel::clock::duration>(delay) },
         _dispatcher{ std::move(dispatcher) },
         _func{ std::move(func) },
-        _timer{ _create_timer() }
+        _timer{ til::timer_wheel::shared(), [this]() { _trailing_edge(); } }
     {
-        const auto d = -delay.count();
-        if (d >= 0)
+        if (delay <= filetime_duration::zero())
         {
             throw std::invalid_argument("non-positive delay specified");
         }
-
-        memcpy(&_delay, &d, sizeof(d));
     }
 
     // ThrottledFunc uses its `this` pointer when creating _timer.
@@ -72,11 +72,6 @@ public:
     }
 
 private:
-    static void __stdcall _timer_callback(PTP_CALLBACK_INSTANCE /*instance*/, PVOID context, PTP_TIMER /*timer*/) noexcept
-    {
-        static_cast<ThrottledFunc*>(context)->_trailing_edge();
-    }
-
     void _leading_edge()
     {
         if constexpr (leading)
@@ -90,13 +85,13 @@ private:
                     }
                     CATCH_LOG();
 
-                    SetThreadpoolTimerEx(self->_timer.get(), &self->_delay, 0, 0);
+                    self->_timer.arm(self->_delay);
                 }
             });
         }
         else
         {
-            SetThreadpoolTimerEx(_timer.get(), &_delay, 0, 0);
+            _timer.arm(_delay);
         }
     }
 
@@ -121,18 +116,11 @@ private:
         }
     }
 
-    inline wil::unique_threadpool_timer _create_timer()
-    {
-        wil::unique_threadpool_timer timer{ CreateThreadpoolTimer(&_timer_callback, this, nullptr) };
-        THROW_LAST_ERROR_IF(!timer);
-        return timer;
-    }
-
-    FILETIME _delay;
+    til::timer_wheel::clock::duration _delay;
     winrt::Windows::System::DispatcherQueue _dispatcher;
     function _func;
 
-    wil::unique_threadpool_timer _timer;
+    til::timer_wheel::timer _timer;
     til::details::throttled_func_storage<Args...> _storage;
 };
 
@@ -27,6 +27,8 @@ public:
     _Out_ SCREEN_INFORMATION** const ppOutputObject);
     */
 
+    void ClientDisconnectedImpl() noexcept override;
+
 #pragma endregion
 
 #pragma region L1
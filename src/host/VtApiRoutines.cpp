@@ -39,8 +39,32 @@ VtApiRoutines::VtApiRoutines() :
     m_outputMode(),
     m_pUsualRoutines(),
     m_pVtEngine(),
-    m_listeningForDSR(false)
+    m_listeningForDSR(false),
+    m_coalescing(false)
 {
+    // CREATE_WAITABLE_TIMER_HIGH_RESOLUTION is only supported since Windows 10 1803.
+    // Older versions get a regular timer, which is as coarse as the threadpool's.
+    m_coalesceTimer.reset(CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS));
+    if (!m_coalesceTimer)
+    {
+        m_coalesceTimer.reset(CreateWaitableTimerExW(nullptr, nullptr, 0, TIMER_ALL_ACCESS));
+        THROW_LAST_ERROR_IF(!m_coalesceTimer);
+    }
+
+    m_coalesceWait.reset(CreateThreadpoolWait(
+        [](PTP_CALLBACK_INSTANCE /*callbackInstance*/, PVOID context, PTP_WAIT /*wait*/, TP_WAIT_RESULT /*waitResult*/) noexcept {
+            static_cast<VtApiRoutines*>(context)->_CoalesceTimerExpired();
+        },
+        this,
+        nullptr));
+    THROW_LAST_ERROR_IF_NULL(m_coalesceWait.get());
+}
+
+void VtApiRoutines::ClientDisconnectedImpl() noexcept
+{
+    // The client may have been the last one, in which case nothing would come along to
+    // flush its remaining output before the terminal learns that the console went away.
+    _FlushOutputNow();
 }
 
 #pragma warning(push)
@@ -105,6 +129,74 @@ void VtApiRoutines::_SynchronizeCursor(std::unique_ptr<IWaitRoutine>& waiter) no
     }
 }
 
+// Routine Description:
+// - Called after output was appended to the VT engine's buffer. Decides whether
+//   to write it to the terminal now or to coalesce it with the writes that follow.
+void VtApiRoutines::_FlushOutputSoon() noexcept
+{
+    if (!m_coalescing)
+    {
+        // Leading edge: open a coalescing window.
+        _FlushOutputNow();
+        try
+        {
+            _ArmCoalesceTimer();
+            m_coalescing = true;
+        }
+        CATCH_LOG();
+    }
+    else if (m_pVtEngine->_buffer.size() >= CoalesceThreshold)
+    {
+        _FlushOutputNow();
+    }
+}
+
+void VtApiRoutines::_FlushOutputNow() noexcept
+{
+    if (!m_pVtEngine->_buffer.empty())
+    {
+        (void)m_pVtEngine->_Flush();
+    }
+}
+
+void VtApiRoutines::_ArmCoalesceTimer()
+{
+    using filetime_duration = std::chrono::duration<int64_t, std::ratio<1, 10000000>>;
+
+    // Negative due times are relative. The FILETIME struct measures time in 100ns steps.
+    LARGE_INTEGER dueTime;
+    dueTime.QuadPart = -std::chrono::duration_cast<filetime_duration>(CoalesceDelay).count();
+    THROW_IF_WIN32_BOOL_FALSE(SetWaitableTimer(m_coalesceTimer.get(), &dueTime, 0, nullptr, nullptr, FALSE));
+    SetThreadpoolWait(m_coalesceWait.get(), m_coalesceTimer.get(), nullptr);
+}
+
+// Routine Description:
+// - Runs on the threadpool at the end of each coalescing window.
+//   The window stays open for as long as output keeps arriving.
+void VtApiRoutines::_CoalesceTimerExpired() noexcept
+{
+    auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+    gci.LockConsole();
+    auto Unlock = wil::scope_exit([&] { gci.UnlockConsole(); });
+
+    if (m_pVtEngine->_buffer.empty())
+    {
+        m_coalescing = false;
+        return;
+    }
+
+    _FlushOutputNow();
+    try
+    {
+        _ArmCoalesceTimer();
+    }
+    catch (...)
+    {
+        LOG_CAUGHT_EXCEPTION();
+        m_coalescing = false;
+    }
+}
+
 [[nodiscard]] HRESULT VtApiRoutines::PeekConsoleInputAImpl(IConsoleInputObject& context,
                                                            std::deque<std::unique_ptr<IInputEvent>>& outEvents,
                                                            const size_t eventsToRead,
@@ -212,7 +304,7 @@ void VtApiRoutines::_SynchronizeCursor(std::unique_ptr<IWaitRoutine>& waiter) no
         (void)m_pVtEngine->WriteTerminalW(ConvertToW(m_outputCodepage, buffer));
     }
 
-    (void)m_pVtEngine->_Flush();
+    _FlushOutputSoon();
     read = buffer.size();
     return S_OK;
 }
@@ -224,7 +316,7 @@ void VtApiRoutines::_SynchronizeCursor(std::unique_ptr<IWaitRoutine>& waiter) no
                                                        std::unique_ptr<IWaitRoutine>& waiter) noexcept
 {
     (void)m_pVtEngine->WriteTerminalW(buffer);
-    (void)m_pVtEngine->_Flush();
+    _FlushOutputSoon();
     read = buffer.size();
     return S_OK;
 }
@@ -244,7 +336,7 @@ void VtApiRoutines::_SynchronizeCursor(std::unique_ptr<IWaitRoutine>& waiter) no
     (void)m_pVtEngine->_SetGraphicsRendition16Color(static_cast<BYTE>(attribute), true);
     (void)m_pVtEngine->_SetGraphicsRendition16Color(static_cast<BYTE>(attribute >> 4), false);
     (void)m_pVtEngine->_WriteFill(lengthToWrite, s_readBackAscii.Char.AsciiChar);
-    (void)m_pVtEngine->_Flush();
+    _FlushOutputSoon();
     cellsModified = lengthToWrite;
     return S_OK;
 }
@@ -261,7 +353,7 @@ void VtApiRoutines::_SynchronizeCursor(std::unique_ptr<IWaitRoutine>& waiter) no
     {
         (void)m_pVtEngine->_CursorPosition(startingCoordinate);
         (void)m_pVtEngine->_WriteFill(lengthToWrite, character);
-        (void)m_pVtEngine->_Flush();
+        _FlushOutputSoon();
         cellsModified = lengthToWrite;
         return S_OK;
     }
@@ -289,7 +381,7 @@ void VtApiRoutines::_SynchronizeCursor(std::unique_ptr<IWaitRoutine>& waiter) no
         (void)m_pVtEngine->WriteTerminalW(sv);
     }
 
-    (void)m_pVtEngine->_Flush();
+    _FlushOutputSoon();
     cellsModified = lengthToWrite;
     return S_OK;
 }
@@ -334,7 +426,7 @@ void VtApiRoutines::GetConsoleCursorInfoImpl(const SCREEN_INFORMATION& context,
                                                               const bool isVisible) noexcept
 {
     isVisible ? (void)m_pVtEngine->_ShowCursor() : (void)m_pVtEngine->_HideCursor();
-    (void)m_pVtEngine->_Flush();
+    _FlushOutputSoon();
     return S_OK;
 }
 
@@ -356,7 +448,7 @@ void VtApiRoutines::GetConsoleScreenBufferInfoExImpl(const SCREEN_INFORMATION& c
     //color table?
     // popup attributes... hold internally?
     // TODO GH10001: popups are gonna erase the stuff behind them... deal with that somehow.
-    (void)m_pVtEngine->_Flush();
+    _FlushOutputSoon();
     return S_OK;
 }
 
@@ -378,7 +470,7 @@ void VtApiRoutines::GetConsoleScreenBufferInfoExImpl(const SCREEN_INFORMATION& c
     else
     {
         (void)m_pVtEngine->_CursorPosition(position);
-        (void)m_pVtEngine->_Flush();
+        _FlushOutputSoon();
     }
     return S_OK;
 }
@@ -418,7 +510,7 @@ void VtApiRoutines::GetLargestConsoleWindowSizeImpl(const SCREEN_INFORMATION& co
 {
     (void)m_pVtEngine->_SetGraphicsRendition16Color(static_cast<BYTE>(attribute), true);
     (void)m_pVtEngine->_SetGraphicsRendition16Color(static_cast<BYTE>(attribute >> 4), false);
-    (void)m_pVtEngine->_Flush();
+    _FlushOutputSoon();
     return S_OK;
 }
 
@@ -427,7 +519,7 @@ void VtApiRoutines::GetLargestConsoleWindowSizeImpl(const SCREEN_INFORMATION& co
                                                               const til::inclusive_rect& windowRect) noexcept
 {
     (void)m_pVtEngine->_ResizeWindow(windowRect.Right - windowRect.Left + 1, windowRect.Bottom - windowRect.Top + 1);
-    (void)m_pVtEngine->_Flush();
+    _FlushOutputSoon();
     return S_OK;
 }
 
@@ -520,7 +612,7 @@ extern HRESULT _ConvertCellsToWInplace(const UINT codepage,
         pos += width;
     }
 
-    (void)m_pVtEngine->_Flush();
+    _FlushOutputSoon();
 
     //TODO GH10001: trim to buffer size?
     writtenRectangle = requestRectangle;
@@ -541,7 +633,7 @@ extern HRESULT _ConvertCellsToWInplace(const UINT codepage,
         (void)m_pVtEngine->WriteTerminalUtf8(std::string_view{ &s_readBackAscii.Char.AsciiChar, 1 });
     }
 
-    (void)m_pVtEngine->_Flush();
+    _FlushOutputSoon();
 
     used = attrs.size();
     return S_OK;
@@ -556,7 +648,7 @@ extern HRESULT _ConvertCellsToWInplace(const UINT codepage,
     {
         (void)m_pVtEngine->_CursorPosition(target);
         (void)m_pVtEngine->WriteTerminalUtf8(text);
-        (void)m_pVtEngine->_Flush();
+        _FlushOutputSoon();
         return S_OK;
     }
     else
@@ -572,7 +664,7 @@ extern HRESULT _ConvertCellsToWInplace(const UINT codepage,
 {
     (void)m_pVtEngine->_CursorPosition(target);
     (void)m_pVtEngine->WriteTerminalW(text);
-    (void)m_pVtEngine->_Flush();
+    _FlushOutputSoon();
     return S_OK;
 }
 
@@ -664,7 +756,7 @@ extern HRESULT _ConvertCellsToWInplace(const UINT codepage,
 [[nodiscard]] HRESULT VtApiRoutines::SetConsoleTitleWImpl(const std::wstring_view title) noexcept
 {
     (void)m_pVtEngine->UpdateTitle(title);
-    (void)m_pVtEngine->_Flush();
+    _FlushOutputSoon();
     return S_OK;
 }
 
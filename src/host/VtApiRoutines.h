@@ -30,6 +30,8 @@ public:
     _Out_ SCREEN_INFORMATION** const ppOutputObject);
     */
 
+    void ClientDisconnectedImpl() noexcept override;
+
 #pragma endregion
 
 #pragma region L1
@@ -388,5 +390,24 @@ public:
     Microsoft::Console::Render::Xterm256Engine* m_pVtEngine;
 
 private:
+    // Writes are coalesced into fewer, larger writes to the terminal. The first write after a quiet
+    // period is flushed right away, so that interactive echo isn't delayed. Any write that follows
+    // within CoalesceDelay is buffered, until either CoalesceThreshold bytes are pending or the
+    // timer expires. Round trips (RequestCursor) and client disconnects flush immediately.
+    // The timer is a high resolution waitable timer, because the regular threadpool timers
+    // only fire on the system's timer tick, which stretches the window to ~16ms.
+    static constexpr size_t CoalesceThreshold = 16 * 1024;
+    static constexpr auto CoalesceDelay = std::chrono::milliseconds{ 1 };
+
     void _SynchronizeCursor(std::unique_ptr<IWaitRoutine>& waiter) noexcept;
+    void _FlushOutputSoon() noexcept;
+    void _FlushOutputNow() noexcept;
+    void _ArmCoalesceTimer();
+    void _CoalesceTimerExpired() noexcept;
+
+    // Guarded by the console lock.
+    bool m_coalescing;
+    wil::unique_handle m_coalesceTimer;
+    // Declared last, so that it's destroyed (which waits for its callback) before anything it uses.
+    wil::unique_threadpool_wait m_coalesceWait;
 };
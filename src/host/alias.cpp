@@ -19,35 +19,100 @@
 
 using Microsoft::Console::Interactivity::ServiceLocator;
 
+static size_t case_insensitive_hash_of(const std::wstring_view text) noexcept
+{
+    til::hasher h;
+    for (const auto& ch : text)
+    {
+        h.write(::towlower(ch));
+    }
+    return h.finalize();
+}
+
+// Exe and alias names are stored together with their case-insensitive hash,
+// so that it doesn't need to be computed again whenever the maps grow.
+struct case_insensitive_key
+{
+    explicit case_insensitive_key(std::wstring text) noexcept :
+        text{ std::move(text) },
+        hash{ case_insensitive_hash_of(this->text) }
+    {
+    }
+
+    std::wstring text;
+    size_t hash;
+};
+
+// The hash and equality functions are transparent, which allows looking up
+// a wstring_view without constructing a key for it.
 struct case_insensitive_hash
 {
-    std::size_t operator()(const std::wstring& key) const
+    using is_transparent = void;
+
+    std::size_t operator()(const case_insensitive_key& key) const noexcept
     {
-        til::hasher h;
-        for (const auto& ch : key)
-        {
-            h.write(::towlower(ch));
-        }
-        return h.finalize();
+        return key.hash;
+    }
+
+    std::size_t operator()(const std::wstring_view key) const noexcept
+    {
+        return case_insensitive_hash_of(key);
     }
 };
 
 struct case_insensitive_equality
 {
-    bool operator()(const std::wstring& lhs, const std::wstring& rhs) const
+    using is_transparent = void;
+
+    bool operator()(const case_insensitive_key& lhs, const case_insensitive_key& rhs) const noexcept
     {
-        return 0 == _wcsicmp(lhs.data(), rhs.data());
+        return lhs.hash == rhs.hash && _equals(lhs.text, rhs.text);
+    }
+
+    bool operator()(const case_insensitive_key& lhs, const std::wstring_view rhs) const noexcept
+    {
+        return _equals(lhs.text, rhs);
+    }
+
+    bool operator()(const std::wstring_view lhs, const case_insensitive_key& rhs) const noexcept
+    {
+        return _equals(lhs, rhs.text);
+    }
+
+private:
+    static bool _equals(const std::wstring_view lhs, const std::wstring_view rhs) noexcept
+    {
+        return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), [](const wchar_t a, const wchar_t b) {
+            return ::towlower(a) == ::towlower(b);
+        });
     }
 };
 
-std::unordered_map<std::wstring,
-                   std::unordered_map<std::wstring,
-                                      std::wstring,
-                                      case_insensitive_hash,
-                                      case_insensitive_equality>,
-                   case_insensitive_hash,
-                   case_insensitive_equality>
-    g_aliasData;
+using AliasList = std::unordered_map<case_insensitive_key, Alias::Target, case_insensitive_hash, case_insensitive_equality>;
+
+std::unordered_map<case_insensitive_key, AliasList, case_insensitive_hash, case_insensitive_equality> g_aliasData;
+
+// Routine Description:
+// - Adds an alias to the set of the given exe, or replaces its target if it already exists.
+static void setAlias(const std::wstring_view exeName, const std::wstring_view source, const std::wstring_view target)
+{
+    auto exeIter = g_aliasData.find(exeName);
+    if (exeIter == g_aliasData.end())
+    {
+        exeIter = g_aliasData.emplace(case_insensitive_key{ std::wstring{ exeName } }, AliasList{}).first;
+    }
+
+    auto& aliases = exeIter->second;
+    auto compiled = Alias::s_CompileTarget(target);
+    if (const auto aliasIter = aliases.find(source); aliasIter != aliases.end())
+    {
+        aliasIter->second = std::move(compiled);
+    }
+    else
+    {
+        aliases.emplace(case_insensitive_key{ std::wstring{ source } }, std::move(compiled));
+    }
+}
 
 // Routine Description:
 // - Adds a command line alias to the global set.
@@ -95,26 +160,29 @@ std::unordered_map<std::wstring,
 
     try
     {
-        std::wstring exeNameString(exeName);
-        std::wstring sourceString(source);
-        std::wstring targetString(target);
-
-        std::transform(exeNameString.begin(), exeNameString.end(), exeNameString.begin(), towlower);
-        std::transform(sourceString.begin(), sourceString.end(), sourceString.begin(), towlower);
-
-        if (targetString.size() == 0)
+        if (target.size() == 0)
         {
             // Only try to dig in and erase if the exeName exists.
-            auto exeData = g_aliasData.find(exeNameString);
+            const auto exeData = g_aliasData.find(exeName);
             if (exeData != g_aliasData.end())
             {
-                g_aliasData[exeNameString].erase(sourceString);
+                auto& aliases = exeData->second;
+                if (const auto aliasIter = aliases.find(source); aliasIter != aliases.end())
+                {
+                    aliases.erase(aliasIter);
+                }
             }
         }
         else
         {
-            // Map will auto-create each level as necessary
-            g_aliasData[exeNameString][sourceString] = targetString;
+            // New names are stored in lowercase.
+            std::wstring exeNameString(exeName);
+            std::wstring sourceString(source);
+
+            std::transform(exeNameString.begin(), exeNameString.end(), exeNameString.begin(), towlower);
+            std::transform(sourceString.begin(), sourceString.end(), sourceString.begin(), towlower);
+
+            setAlias(exeNameString, sourceString, target);
         }
     }
     CATCH_RETURN();
@@ -149,17 +217,14 @@ std::unordered_map<std::wstring,
         til::at(*target, 0) = UNICODE_NULL;
     }
 
-    std::wstring exeNameString(exeName);
-    std::wstring sourceString(source);
-
     // For compatibility, return ERROR_GEN_FAILURE for any result where the alias can't be found.
     // We use .find for the iterators then dereference to search without creating entries.
-    const auto exeIter = g_aliasData.find(exeNameString);
+    const auto exeIter = g_aliasData.find(exeName);
     RETURN_HR_IF(HRESULT_FROM_WIN32(ERROR_GEN_FAILURE), exeIter == g_aliasData.end());
-    const auto exeData = exeIter->second;
-    const auto sourceIter = exeData.find(sourceString);
+    const auto& exeData = exeIter->second;
+    const auto sourceIter = exeData.find(source);
     RETURN_HR_IF(HRESULT_FROM_WIN32(ERROR_GEN_FAILURE), sourceIter == exeData.end());
-    const auto targetString = sourceIter->second;
+    const auto& targetString = sourceIter->second.text;
     RETURN_HR_IF(HRESULT_FROM_WIN32(ERROR_GEN_FAILURE), targetString.size() == 0);
 
     // TargetLength is a byte count, convert to characters.
@@ -315,8 +380,6 @@ static std::wstring aliasesSeparator(L"=");
 
     try
     {
-        const std::wstring exeNameString(exeName);
-
         size_t cchNeeded = 0;
 
         // Each of the aliases will be made up of the source, a separator, the target, then a null character.
@@ -330,21 +393,21 @@ static std::wstring aliasesSeparator(L"=");
         }
 
         // Find without creating.
-        auto exeIter = g_aliasData.find(exeNameString);
+        const auto exeIter = g_aliasData.find(exeName);
         if (exeIter != g_aliasData.end())
         {
-            auto list = exeIter->second;
+            const auto& list = exeIter->second;
             for (auto& pair : list)
             {
                 // Alias stores lengths in bytes.
-                auto cchSource = pair.first.size();
-                auto cchTarget = pair.second.size();
+                auto cchSource = pair.first.text.size();
+                auto cchTarget = pair.second.text.size();
 
                 // If we're counting how much multibyte space will be needed, trial convert the source and target strings before we add.
                 if (!countInUnicode)
                 {
-                    cchSource = GetALengthFromW(codepage, pair.first);
-                    cchTarget = GetALengthFromW(codepage, pair.second);
+                    cchSource = GetALengthFromW(codepage, pair.first.text);
+                    cchTarget = GetALengthFromW(codepage, pair.second.text);
                 }
 
                 // Accumulate all sizes to the final string count.
@@ -418,7 +481,7 @@ static std::wstring aliasesSeparator(L"=");
 void Alias::s_ClearCmdExeAliases()
 {
     // find without creating.
-    auto exeIter = g_aliasData.find(L"cmd.exe");
+    const auto exeIter = g_aliasData.find(std::wstring_view{ L"cmd.exe" });
     if (exeIter != g_aliasData.end())
     {
         exeIter->second.clear();
@@ -451,8 +514,6 @@ void Alias::s_ClearCmdExeAliases()
         til::at(*aliasBuffer, 0) = UNICODE_NULL;
     }
 
-    std::wstring exeNameString(exeName);
-
     auto AliasesBufferPtrW = aliasBuffer.has_value() ? aliasBuffer->data() : nullptr;
     size_t cchTotalLength = 0; // accumulate the characters we need/have copied as we walk the list
 
@@ -461,15 +522,15 @@ void Alias::s_ClearCmdExeAliases()
     const size_t cchNull = 1;
 
     // Find without creating.
-    auto exeIter = g_aliasData.find(exeNameString);
+    const auto exeIter = g_aliasData.find(exeName);
     if (exeIter != g_aliasData.end())
     {
-        auto list = exeIter->second;
+        const auto& list = exeIter->second;
         for (auto& pair : list)
         {
             // Alias stores lengths in bytes.
-            const auto cchSource = pair.first.size();
-            const auto cchTarget = pair.second.size();
+            const auto cchSource = pair.first.text.size();
+            const auto cchTarget = pair.second.text.size();
 
             // Add up how many characters we will need for the full alias data.
             size_t cchNeeded = 0;
@@ -491,7 +552,7 @@ void Alias::s_ClearCmdExeAliases()
                 size_t cchAliasBufferRemaining;
                 RETURN_IF_FAILED(SizeTSub(aliasBuffer->size(), cchTotalLength, &cchAliasBufferRemaining));
 
-                RETURN_IF_FAILED(StringCchCopyNW(AliasesBufferPtrW, cchAliasBufferRemaining, pair.first.data(), cchSource));
+                RETURN_IF_FAILED(StringCchCopyNW(AliasesBufferPtrW, cchAliasBufferRemaining, pair.first.text.data(), cchSource));
                 RETURN_IF_FAILED(SizeTSub(cchAliasBufferRemaining, cchSource, &cchAliasBufferRemaining));
                 AliasesBufferPtrW += cchSource;
 
@@ -499,7 +560,7 @@ void Alias::s_ClearCmdExeAliases()
                 RETURN_IF_FAILED(SizeTSub(cchAliasBufferRemaining, aliasesSeparator.size(), &cchAliasBufferRemaining));
                 AliasesBufferPtrW += aliasesSeparator.size();
 
-                RETURN_IF_FAILED(StringCchCopyNW(AliasesBufferPtrW, cchAliasBufferRemaining, pair.second.data(), cchTarget));
+                RETURN_IF_FAILED(StringCchCopyNW(AliasesBufferPtrW, cchAliasBufferRemaining, pair.second.text.data(), cchTarget));
                 RETURN_IF_FAILED(SizeTSub(cchAliasBufferRemaining, cchTarget, &cchAliasBufferRemaining));
                 AliasesBufferPtrW += cchTarget;
 
@@ -627,12 +688,12 @@ void Alias::s_ClearCmdExeAliases()
 
     for (auto& pair : g_aliasData)
     {
-        auto cchExe = pair.first.size();
+        auto cchExe = pair.first.text.size();
 
         // If we're counting how much multibyte space will be needed, trial convert the exe string before we add.
         if (!countInUnicode)
         {
-            cchExe = GetALengthFromW(codepage, pair.first);
+            cchExe = GetALengthFromW(codepage, pair.first.text);
         }
 
         // Accumulate to total
@@ -706,7 +767,7 @@ void Alias::s_ClearCmdExeAliases()
     for (auto& pair : g_aliasData)
     {
         // AliasList stores length in bytes. Add 1 for null terminator.
-        const auto cchExe = pair.first.size();
+        const auto cchExe = pair.first.text.size();
 
         size_t cchNeeded;
         RETURN_IF_FAILED(SizeTAdd(cchExe, cchNull, &cchNeeded));
@@ -724,7 +785,7 @@ void Alias::s_ClearCmdExeAliases()
             size_t cchRemaining;
             RETURN_IF_FAILED(SizeTSub(aliasExesBuffer->size(), cchTotalLength, &cchRemaining));
 
-            RETURN_IF_FAILED(StringCchCopyNW(AliasExesBufferPtrW, cchRemaining, pair.first.data(), cchExe));
+            RETURN_IF_FAILED(StringCchCopyNW(AliasExesBufferPtrW, cchRemaining, pair.first.text.data(), cchExe));
             AliasExesBufferPtrW += cchNeeded;
         }
 
@@ -821,42 +882,42 @@ void Alias::s_ClearCmdExeAliases()
 // - Trims trailing \r\n off of a string
 // Arguments:
 // - str - String to trim
-void Alias::s_TrimTrailingCrLf(std::wstring& str)
+// Return Value:
+// - The string without the trailing \r\n
+std::wstring_view Alias::s_TrimTrailingCrLf(const std::wstring_view str)
 {
     const auto trailingCrLfPos = str.find_last_of(UNICODE_CARRIAGERETURN);
-    if (std::wstring::npos != trailingCrLfPos)
+    if (std::wstring_view::npos != trailingCrLfPos)
     {
-        str.erase(trailingCrLfPos);
+        return str.substr(0, trailingCrLfPos);
     }
+    return str;
 }
 
 // Routine Description:
-// - Tokenizes a string into a collection using space as a separator
+// - Tokenizes a string using space as a separator
 // Arguments:
 // - str - String to tokenize
 // Return Value:
-// - Collection of tokenized strings
-std::deque<std::wstring> Alias::s_Tokenize(const std::wstring& str)
+// - The first tokens of the string, as many as macros can refer to.
+//   The remaining ones are empty if there are fewer tokens.
+Alias::Tokens Alias::s_Tokenize(const std::wstring_view str)
 {
-    std::deque<std::wstring> result;
+    Tokens result;
 
     size_t prevIndex = 0;
-    auto spaceIndex = str.find(L' ');
-    while (std::wstring::npos != spaceIndex)
+    for (auto& token : result)
     {
-        const auto length = spaceIndex - prevIndex;
-
-        result.emplace_back(str.substr(prevIndex, length));
+        const auto spaceIndex = str.find(L' ', prevIndex);
+        token = str.substr(prevIndex, spaceIndex - prevIndex);
 
-        spaceIndex++;
-        prevIndex = spaceIndex;
-
-        spaceIndex = str.find(L' ', spaceIndex);
+        if (std::wstring_view::npos == spaceIndex)
+        {
+            break;
+        }
+        prevIndex = spaceIndex + 1;
     }
 
-    // Place the final one into the set.
-    result.emplace_back(str.substr(prevIndex));
-
     return result;
 }
 
@@ -867,74 +928,19 @@ std::deque<std::wstring> Alias::s_Tokenize(const std::wstring& str)
 // - str - String to split into just args
 // Return Value:
 // - Only the arguments part of the string or empty if there are no arguments.
-std::wstring Alias::s_GetArgString(const std::wstring& str)
+std::wstring_view Alias::s_GetArgString(const std::wstring_view str)
 {
-    std::wstring result;
     auto firstSpace = str.find_first_of(L' ');
-    if (std::wstring::npos != firstSpace)
+    if (std::wstring_view::npos != firstSpace)
     {
         firstSpace++;
         if (firstSpace < str.size())
         {
-            result = str.substr(firstSpace);
+            return str.substr(firstSpace);
         }
     }
 
-    return result;
-}
-
-// Routine Description:
-// - Checks the given character to see if it is a numbered arg replacement macro
-//   and replaces it with the counted argument if there is a match
-// Arguments:
-// - ch - Character to test as a macro
-// - appendToStr - Append the macro result here if it matched
-// - tokens - Tokens of the original command string. 0 is alias. 1-N are arguments.
-// Return Value:
-// - True if we found the macro and appended to the string.
-// - False if the given character doesn't match this macro.
-bool Alias::s_TryReplaceNumberedArgMacro(const wchar_t ch,
-                                         std::wstring& appendToStr,
-                                         const std::deque<std::wstring>& tokens)
-{
-    if (ch >= L'1' && ch <= L'9')
-    {
-        // Numerical macros substitute that numbered argument
-        const size_t index = ch - L'0';
-
-        if (index < tokens.size() && index > 0)
-        {
-            appendToStr.append(tokens[index]);
-        }
-
-        return true;
-    }
-
-    return false;
-}
-
-// Routine Description:
-// - Checks the given character to see if it is a wildcard arg replacement macro
-//   and replaces it with the entire argument string if there is a match
-// Arguments:
-// - ch - Character to test as a macro
-// - appendToStr - Append the macro result here if it matched
-// - fullArgString - All of the arguments as one big string.
-// Return Value:
-// - True if we found the macro and appended to the string.
-// - False if the given character doesn't match this macro.
-bool Alias::s_TryReplaceWildcardArgMacro(const wchar_t ch,
-                                         std::wstring& appendToStr,
-                                         const std::wstring fullArgString)
-{
-    if (L'*' == ch)
-    {
-        // Wildcard substitutes all arguments
-        appendToStr.append(fullArgString);
-        return true;
-    }
-
-    return false;
+    return {};
 }
 
 // Routine Description:
@@ -1037,164 +1043,133 @@ void Alias::s_AppendCrLf(std::wstring& appendToStr,
 }
 
 // Routine Description:
-// - Searches through the given string for macros and replaces them
-//   with the matching action
+// - Compiles the target of an alias. The macros that don't depend on the
+//   command line are replaced, and the argument macros $1-$9 and $* are
+//   turned into operations that refer to the respective argument.
 // Arguments:
-// - str - On input, the string to search. On output, the string is replaced.
-// - tokens - The tokenized command line input. 0 is the alias, 1-N are arguments.
-// - fullArgString - Shorthand to 1-N argument string in case of wildcard match.
+// - text - The target of the alias
 // Return Value:
-// - The number of commands in the final string (line feeds, CRLFs)
-size_t Alias::s_ReplaceMacros(std::wstring& str,
-                              const std::deque<std::wstring>& tokens,
-                              const std::wstring& fullArgString)
+// - The compiled target
+Alias::Target Alias::s_CompileTarget(const std::wstring_view text)
 {
-    size_t lineCount = 0;
-    std::wstring finalText;
+    Target target;
+    target.text = text;
+
+    size_t literalsBegin = 0;
+    const auto flushLiterals = [&]() {
+        if (target.literals.size() > literalsBegin)
+        {
+            target.operations.push_back({ Target::Literal, literalsBegin, target.literals.size() - literalsBegin });
+            literalsBegin = target.literals.size();
+        }
+    };
 
     // The target text may contain substitution macros indicated by $.
-    // Walk through and substitute them as appropriate.
-    for (auto ch = str.cbegin(); ch < str.cend(); ch++)
+    for (size_t i = 0; i < text.size(); i++)
     {
-        if (L'$' == *ch)
+        const auto ch = text[i];
+
+        // If it isn't the macro specifier $ or there's no read-ahead, push the character.
+        if (L'$' != ch || i + 1 == text.size())
         {
-            // Attempt to read ahead by one character.
-            const auto chNext = ch + 1;
+            target.literals.push_back(ch);
+            continue;
+        }
 
-            if (chNext < str.cend())
-            {
-                auto isProcessed = s_TryReplaceNumberedArgMacro(*chNext, finalText, tokens);
-                if (!isProcessed)
-                {
-                    isProcessed = s_TryReplaceWildcardArgMacro(*chNext, finalText, fullArgString);
-                }
-                if (!isProcessed)
-                {
-                    isProcessed = s_TryReplaceInputRedirMacro(*chNext, finalText);
-                }
-                if (!isProcessed)
-                {
-                    isProcessed = s_TryReplaceOutputRedirMacro(*chNext, finalText);
-                }
-                if (!isProcessed)
-                {
-                    isProcessed = s_TryReplacePipeRedirMacro(*chNext, finalText);
-                }
-                if (!isProcessed)
-                {
-                    isProcessed = s_TryReplaceNextCommandMacro(*chNext, finalText, lineCount);
-                }
-                if (!isProcessed)
-                {
-                    // If nothing matches, just push these two characters in.
-                    finalText.push_back(*ch);
-                    finalText.push_back(*chNext);
-                }
+        // Since we read ahead and use that character, advance one extra.
+        const auto chNext = text[++i];
 
-                // Since we read ahead and used that character,
-                // advance the iterator one extra to compensate.
-                ch++;
-            }
-            else
-            {
-                // If no read-ahead, just push this character and be done.
-                finalText.push_back(*ch);
-            }
+        if (chNext >= L'1' && chNext <= L'9')
+        {
+            // Numerical macros substitute that numbered argument
+            flushLiterals();
+            target.operations.push_back({ gsl::narrow_cast<uint8_t>(chNext - L'0'), 0, 0 });
         }
-        else
+        else if (L'*' == chNext)
         {
-            // If it didn't match the macro specifier $, push the character.
-            finalText.push_back(*ch);
+            // Wildcard substitutes all arguments
+            flushLiterals();
+            target.operations.push_back({ Target::AllArguments, 0, 0 });
+        }
+        else if (!s_TryReplaceInputRedirMacro(chNext, target.literals) &&
+                 !s_TryReplaceOutputRedirMacro(chNext, target.literals) &&
+                 !s_TryReplacePipeRedirMacro(chNext, target.literals) &&
+                 !s_TryReplaceNextCommandMacro(chNext, target.literals, target.lineCount))
+        {
+            // If nothing matches, just push these two characters in.
+            target.literals.push_back(ch);
+            target.literals.push_back(chNext);
         }
     }
 
     // We always terminate with a CRLF to symbolize end of command.
-    s_AppendCrLf(finalText, lineCount);
+    s_AppendCrLf(target.literals, target.lineCount);
+    flushLiterals();
 
-    // Give back the final text and count.
-    str.swap(finalText);
-    return lineCount;
+    return target;
 }
 
 // Routine Description:
-// - Takes the source text and searches it for an alias belonging to exe name's list.
+// - Expands a compiled alias target into the given buffer.
 // Arguments:
-// - sourceText - The string to search for an alias
-// - exeName - The name of the EXE that has aliases associated
-// - lineCount - Number of lines worth of text processed.
+// - target - The compiled target
+// - tokens - The tokenized command line input. 0 is the alias, 1-9 are arguments.
+// - fullArgString - Shorthand to 1-N argument string in case of wildcard match.
+// - output - The buffer to write the expansion to. It must not overlap with the tokens.
+// - written - On success, receives the number of characters written.
 // Return Value:
-// - If we found a matching alias, this will be the processed data
-//   and lineCount is updated to the new number of lines.
-// - If we didn't match and process an alias, return an empty string.
-std::wstring Alias::s_MatchAndCopyAlias(const std::wstring& sourceText,
-                                        const std::wstring& exeName,
-                                        size_t& lineCount)
+// - False if the expansion doesn't fit into the buffer, in which case nothing is written.
+bool Alias::s_ExpandTarget(const Target& target,
+                           const Tokens& tokens,
+                           const std::wstring_view fullArgString,
+                           const gsl::span<wchar_t> output,
+                           size_t& written) noexcept
 {
-    // Copy source text into a local for manipulation.
-    auto sourceCopy = sourceText;
-
-    // Trim trailing \r\n off of sourceCopy if it has one.
-    s_TrimTrailingCrLf(sourceCopy);
-
-    // Check if we have an EXE in the list that matches the request first.
-    auto exeIter = g_aliasData.find(exeName);
-    if (exeIter == g_aliasData.end())
-    {
-        // We found no data for this exe. Give back an empty string.
-        return std::wstring();
-    }
-
-    auto exeList = exeIter->second;
-    if (exeList.size() == 0)
-    {
-        // If there's no match, give back an empty string.
-        return std::wstring();
-    }
-
-    // Tokenize the text by spaces
-    const auto tokens = s_Tokenize(sourceCopy);
+    const auto piece = [&](const Target::Operation& operation) noexcept -> std::wstring_view {
+        switch (operation.argument)
+        {
+        case Target::Literal:
+            return { target.literals.data() + operation.offset, operation.length };
+        case Target::AllArguments:
+            return fullArgString;
+        default:
+            return til::at(tokens, operation.argument);
+        }
+    };
 
-    // If there are no tokens, return an empty string
-    if (tokens.size() == 0)
+    size_t length = 0;
+    for (const auto& operation : target.operations)
     {
-        return std::wstring();
+        length += piece(operation).size();
     }
 
-    // Find alias. If there isn't one, return an empty string
-    const auto alias = tokens.front();
-    const auto aliasIter = exeList.find(alias);
-    if (aliasIter == exeList.end())
+    if (length > output.size())
     {
-        // We found no alias pair with this name. Give back an empty string.
-        return std::wstring();
+        return false;
     }
 
-    const auto target = aliasIter->second;
-    if (target.size() == 0)
+    auto it = output.begin();
+    for (const auto& operation : target.operations)
     {
-        return std::wstring();
+        const auto text = piece(operation);
+        it = std::copy(text.begin(), text.end(), it);
     }
 
-    // Get the string of all parameters as a shorthand for $* later.
-    const auto allParams = s_GetArgString(sourceCopy);
-
-    // The final text will be the target but with macros replaced.
-    auto finalText = target;
-    lineCount = s_ReplaceMacros(finalText, tokens, allParams);
-
-    return finalText;
+    written = length;
+    return true;
 }
 
 // Routine Description:
 // - This routine matches the input string with an alias and copies the alias to the input buffer.
+// - The alias is looked up with the first token of the input as the key and its
+//   target is expanded straight into pwchTarget, without allocating any memory.
 // Arguments:
 // - pwchSource - string to match
 // - cbSource - length of pwchSource in bytes
 // - pwchTarget - where to store matched string
 // - cbTargetSize - on input, contains size of pwchTarget.
 // - cbTargetWritten - On output, contains length of alias stored in pwchTarget.
-// - pwchExe - Name of exe that command is associated with to find related aliases
-// - cbExe - Length in bytes of exe name
+// - exeName - Name of exe that command is associated with to find related aliases
 // - LineCount - aliases can contain multiple commands.  $T is the command separator
 // Return Value:
 // - None. It will just maintain the source as the target if we can't match an alias.
@@ -1208,28 +1183,44 @@ void Alias::s_MatchAndCopyAliasLegacy(_In_reads_bytes_(cbSource) PCWCH pwchSourc
 {
     try
     {
-        std::wstring sourceText(pwchSource, cbSource / sizeof(WCHAR));
-        size_t lineCount = lines;
+        // Check if we have an EXE in the list that matches the request first.
+        const auto exeIter = g_aliasData.find(exeName);
+        if (exeIter == g_aliasData.end() || exeIter->second.empty())
+        {
+            return;
+        }
+
+        // COOKED_READ_DATA::ProcessAliases passes the same buffer as source and target,
+        // so the source is copied aside before the expansion overwrites it. This buffer
+        // is only used under the console lock and keeps its capacity across calls.
+        static std::wstring sourceBuffer;
+        sourceBuffer.assign(pwchSource, cbSource / sizeof(WCHAR));
 
-        const auto targetText = s_MatchAndCopyAlias(sourceText, exeName, lineCount);
+        // Trim trailing \r\n off of the source if it has one.
+        const auto source = s_TrimTrailingCrLf(sourceBuffer);
 
-        // Only return data if the reply was non-empty (we had a match).
-        if (!targetText.empty())
+        // Tokenize the text by spaces. The first token is the alias.
+        const auto tokens = s_Tokenize(source);
+        const auto& aliases = exeIter->second;
+        const auto aliasIter = aliases.find(til::at(tokens, 0));
+        if (aliasIter == aliases.end() || aliasIter->second.text.empty())
         {
-            const auto cchTargetSize = cbTargetSize / sizeof(wchar_t);
+            // We found no alias pair with this name.
+            return;
+        }
 
-            // If the target text will fit in the result buffer, fill out the results.
-            if (targetText.size() <= cchTargetSize)
-            {
-                // Non-null terminated copy into memory space
-                std::copy_n(targetText.data(), targetText.size(), pwchTarget);
+        const auto& target = aliasIter->second;
+        const gsl::span<wchar_t> output{ pwchTarget, cbTargetSize / sizeof(wchar_t) };
 
-                // Return bytes copied.
-                cbTargetWritten = gsl::narrow<ULONG>(targetText.size() * sizeof(wchar_t));
+        // Only return data if the target text fits into the result buffer.
+        size_t written;
+        if (s_ExpandTarget(target, tokens, s_GetArgString(source), output, written))
+        {
+            // Return bytes copied.
+            cbTargetWritten = gsl::narrow<ULONG>(written * sizeof(wchar_t));
 
-                // Return lines info.
-                lines = gsl::narrow<DWORD>(lineCount);
-            }
+            // Return lines info.
+            lines = gsl::narrow<DWORD>(target.lineCount);
         }
     }
     catch (...)
@@ -1243,7 +1234,7 @@ void Alias::s_TestAddAlias(std::wstring& exe,
                            std::wstring& alias,
                            std::wstring& target)
 {
-    g_aliasData[exe][alias] = target;
+    setAlias(exe, alias, target);
 }
 
 void Alias::s_TestClearAliases()
@@ -14,6 +14,34 @@ Abstract:
 class Alias
 {
 public:
+    // An alias target, compiled when the alias is added. All macros other than the
+    // argument references $1-$9 and $* are replaced in advance, so that the target
+    // can be expanded by concatenating the pieces its operations refer to.
+    struct Target
+    {
+        static constexpr uint8_t Literal = 0;
+        static constexpr uint8_t AllArguments = 10;
+
+        struct Operation
+        {
+            // Literal, the number of the argument, or AllArguments.
+            uint8_t argument;
+            // The range of literals used if argument is Literal.
+            size_t offset;
+            size_t length;
+        };
+
+        // The target as it was given when the alias was added.
+        std::wstring text;
+        std::wstring literals;
+        std::vector<Operation> operations;
+        // The number of commands (CRLFs) in the expanded target.
+        size_t lineCount = 0;
+    };
+
+    // The alias name followed by the arguments $1 to $9 refer to.
+    using Tokens = std::array<std::wstring_view, 10>;
+
     static void s_ClearCmdExeAliases();
 
     static void s_MatchAndCopyAliasLegacy(_In_reads_bytes_(cbSource) PCWCH pwchSource,
@@ -24,24 +52,17 @@ public:
                                           const std::wstring& exeName,
                                           DWORD& lines);
 
-    static std::wstring s_MatchAndCopyAlias(const std::wstring& sourceText,
-                                            const std::wstring& exeName,
-                                            size_t& lineCount);
+    static Target s_CompileTarget(const std::wstring_view text);
 
 private:
-    static void s_TrimTrailingCrLf(std::wstring& str);
-    static std::deque<std::wstring> s_Tokenize(const std::wstring& str);
-    static std::wstring s_GetArgString(const std::wstring& str);
-    static size_t s_ReplaceMacros(std::wstring& str,
-                                  const std::deque<std::wstring>& tokens,
-                                  const std::wstring& fullArgString);
-
-    static bool s_TryReplaceNumberedArgMacro(const wchar_t ch,
-                                             std::wstring& appendToStr,
-                                             const std::deque<std::wstring>& tokens);
-    static bool s_TryReplaceWildcardArgMacro(const wchar_t ch,
-                                             std::wstring& appendToStr,
-                                             const std::wstring fullArgString);
+    static std::wstring_view s_TrimTrailingCrLf(const std::wstring_view str);
+    static Tokens s_Tokenize(const std::wstring_view str);
+    static std::wstring_view s_GetArgString(const std::wstring_view str);
+    static bool s_ExpandTarget(const Target& target,
+                               const Tokens& tokens,
+                               const std::wstring_view fullArgString,
+                               const gsl::span<wchar_t> output,
+                               size_t& written) noexcept;
 
     static bool s_TryReplaceInputRedirMacro(const wchar_t ch,
                                             std::wstring& appendToStr);
@@ -10,8 +10,7 @@
 #include "dbcs.h"
 
 #include "../interactivity/inc/ServiceLocator.hpp"
-#include "../types/inc/GlyphWidth.hpp"
-#include "../types/inc/Utf16Parser.hpp"
+#include "../types/inc/GraphemeClusterIterator.hpp"
 
 // Attributes flags:
 #define COMMON_LVB_GRID_SINGLEFLAG 0x2000 // DBCS: Grid attribute: use for ime cursor.
@@ -223,19 +222,18 @@ std::vector<OutputCell> ConsoleImeInfo::s_ConvertToCells(const std::wstring_view
 {
     std::vector<OutputCell> cells;
 
-    // - Convert incoming wchar_t stream into UTF-16 units.
-    const auto glyphs = Utf16Parser::Parse(text);
-
-    // - Walk through all of the grouped up text, match up the correct attribute to it, and make a new cell.
+    // - Walk through the text one grapheme cluster at a time, match up the correct attribute to it, and make a new cell.
+    //   Combining marks and the like thus end up in the same cell as the character they belong to.
     size_t attributesUsed = 0;
-    for (const auto& parsedGlyph : glyphs)
+    const GraphemeClusters clusters{ text };
+    for (auto it = clusters.begin(); it != clusters.end(); ++it)
     {
-        const std::wstring_view glyph{ parsedGlyph.data(), parsedGlyph.size() };
+        const auto glyph = *it;
         // Collect up attributes that apply to this glyph range.
         auto drawingAttr = s_RetrieveAttributeAt(attributesUsed, attributes, colorArray);
         attributesUsed++;
 
-        // The IME gave us an attribute for every glyph position in a surrogate pair.
+        // The IME gave us an attribute for every code unit of the cluster.
         // But the only important information will be the cursor position.
         // Check all additional attributes to see if the cursor resides on top of them.
         for (size_t i = 1; i < glyph.size(); i++)
@@ -257,7 +255,7 @@ std::vector<OutputCell> ConsoleImeInfo::s_ConvertToCells(const std::wstring_view
         // right down the middle of the character.
         // Otherwise it's one column and we'll push it in with the default empty DbcsAttribute.
         DbcsAttribute dbcsAttr;
-        if (IsGlyphFullWidth(glyph))
+        if (it.Columns() == 2)
         {
             auto leftHalfAttr = drawingAttr;
             auto rightHalfAttr = drawingAttr;
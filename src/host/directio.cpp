@@ -958,9 +958,10 @@ void EventsToUnicode(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents,
             // Convert to a CHAR_INFO view to fit into the iterator
             const auto charInfos = gsl::span<const CHAR_INFO>(subspan.data(), subspan.size());
 
-            // Make the iterator and write to the target position.
+            // Make the iterator and write to the target position. Applications tend to rewrite
+            // mostly unchanged contents, so only the cells that changed are written and invalidated.
             OutputCellIterator it(charInfos);
-            storageBuffer.Write(it, target);
+            storageBuffer.GetTextBuffer().WriteIfChanged(it, target);
         }
 
         // Since we've managed to write part of the request, return the clamped part that we actually used.
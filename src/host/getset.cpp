@@ -1111,6 +1111,13 @@ void ApiRoutines::GetConsoleOutputCodePageImpl(ULONG& codepage) noexcept
     CATCH_LOG();
 }
 
+// Routine Description:
+// - Notifies the routines that a client process is disconnecting.
+// - The console host doesn't hold back any state for its clients, so there's nothing to do.
+void ApiRoutines::ClientDisconnectedImpl() noexcept
+{
+}
+
 // Routine Description:
 // - Gets the window handle ID for the console
 // Arguments:
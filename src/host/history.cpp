@@ -32,6 +32,18 @@ using Microsoft::Console::Interactivity::ServiceLocator;
 // for maintaining LRU, then this datatype can be changed.
 std::list<CommandHistory> CommandHistory::s_historyLists;
 
+// Overrides the directory that journal files are stored in. Only set by tests.
+static std::wstring s_journalDirectory;
+
+// Each journal record is the length of the command in UTF-16 code units,
+// as a 32-bit integer, followed by the command itself.
+static void appendJournalRecord(std::string& buffer, const std::wstring_view command)
+{
+    const auto length = gsl::narrow<uint32_t>(command.size());
+    buffer.append(reinterpret_cast<const char*>(&length), sizeof(length));
+    buffer.append(reinterpret_cast<const char*>(command.data()), command.size() * sizeof(wchar_t));
+}
+
 CommandHistory* CommandHistory::s_Find(const HANDLE processHandle)
 {
     for (auto& historyList : s_historyLists)
@@ -85,6 +97,63 @@ void CommandHistory::_Reset()
     WI_SetFlag(Flags, CLE_RESET);
 }
 
+// Routine Description:
+// - Returns the command at the given index, where 0 is the oldest command.
+const std::wstring& CommandHistory::_At(const SHORT index) const
+{
+    THROW_HR_IF(E_BOUNDS, index < 0 || static_cast<size_t>(index) >= _commands.size());
+    return _commands[(_first + index) % _commands.size()];
+}
+
+std::wstring& CommandHistory::_At(const SHORT index)
+{
+    THROW_HR_IF(E_BOUNDS, index < 0 || static_cast<size_t>(index) >= _commands.size());
+    return _commands[(_first + index) % _commands.size()];
+}
+
+// Routine Description:
+// - Rotates the ring buffer so that the oldest command is stored in the first slot,
+//   for operations that insert or remove commands anywhere but at the end.
+void CommandHistory::_Linearize()
+{
+    std::rotate(_commands.begin(), _commands.begin() + _first, _commands.end());
+    _first = 0;
+}
+
+void CommandHistory::_IndexAdd(const std::wstring& command)
+{
+    if (const auto it = _index.find(command); it != _index.end())
+    {
+        it->second++;
+    }
+    else
+    {
+        _index.emplace(command, 1);
+    }
+}
+
+void CommandHistory::_IndexRemove(const std::wstring& command)
+{
+    if (const auto it = _index.find(command); it != _index.end() && --it->second == 0)
+    {
+        _index.erase(it);
+    }
+}
+
+// Routine Description:
+// - Returns false if no command in the history can match the given one.
+//   Since the index is sorted, all commands that start with the given one directly follow it.
+bool CommandHistory::_HasPotentialMatch(const std::wstring_view command, const MatchOptions options) const
+{
+    if (WI_IsFlagSet(options, MatchOptions::ExactMatch))
+    {
+        return _index.find(command) != _index.end();
+    }
+
+    const auto it = _index.lower_bound(command);
+    return it != _index.end() && til::starts_with(it->first, command);
+}
+
 [[nodiscard]] HRESULT CommandHistory::Add(const std::wstring_view newCommand,
                                           const bool suppressDuplicates)
 {
@@ -99,11 +168,7 @@ void CommandHistory::_Reset()
     try
     {
         if (_commands.size() == 0 ||
-            _commands.back().size() != newCommand.size() ||
-            !std::equal(_commands.back().cbegin(),
-                        _commands.back().cbegin() + newCommand.size(),
-                        newCommand.cbegin(),
-                        newCommand.cend()))
+            _At(gsl::narrow<SHORT>(_commands.size() - 1)) != newCommand)
         {
             std::wstring reuse{};
 
@@ -112,38 +177,38 @@ void CommandHistory::_Reset()
                 SHORT index;
                 if (FindMatchingCommand(newCommand, LastDisplayed, index, CommandHistory::MatchOptions::ExactMatch))
                 {
-                    reuse = Remove(index);
+                    reuse = _Remove(index);
                 }
             }
 
-            // find free record.  if all records are used, free the lru one.
+            auto command = reuse.empty() ? std::wstring{ newCommand } : std::move(reuse);
+            _IndexAdd(command);
+
+            // find free record.  if all records are used, overwrite the lru one.
             if ((SHORT)_commands.size() == _maxCommands)
             {
-                _commands.erase(_commands.cbegin());
+                // The lru command is in the slot at _first,
+                // which makes the one after it the new lru one.
+                auto& slot = _commands[_first];
+                _IndexRemove(slot);
+                slot = std::move(command);
+                _first = (_first + 1) % _commands.size();
                 // move LastDisplayed back one in order to stay synced with the
-                // command it referred to before erasing the lru one
+                // command it referred to before overwriting the lru one
                 --LastDisplayed;
             }
-
-            // add newCommand to array
-            if (!reuse.empty())
-            {
-                _commands.emplace_back(reuse);
-            }
             else
             {
-                _commands.emplace_back(newCommand);
+                _commands.emplace_back(std::move(command));
             }
 
             if (LastDisplayed == -1 ||
-                _commands.at(LastDisplayed).size() != newCommand.size() ||
-                !std::equal(_commands.at(LastDisplayed).cbegin(),
-                            _commands.at(LastDisplayed).cbegin() + newCommand.size(),
-                            newCommand.cbegin(),
-                            newCommand.cend()))
+                _At(LastDisplayed) != newCommand)
             {
                 _Reset();
             }
+
+            _AppendToJournal(newCommand);
         }
     }
     CATCH_RETURN();
@@ -156,7 +221,7 @@ std::wstring_view CommandHistory::GetNth(const SHORT index) const
 {
     try
     {
-        return _commands.at(index);
+        return _At(index);
     }
     CATCH_LOG();
 
@@ -171,7 +236,7 @@ std::wstring_view CommandHistory::GetNth(const SHORT index) const
 
     try
     {
-        const auto& cmd = _commands.at(index);
+        const auto& cmd = _At(index);
         if (cmd.size() > (size_t)buffer.size())
         {
             commandSize = buffer.size(); // room for CRLF?
@@ -233,7 +298,7 @@ std::wstring_view CommandHistory::GetLastCommand() const
     {
         try
         {
-            return _commands.at(LastDisplayed);
+            return _At(LastDisplayed);
         }
         CATCH_LOG();
     }
@@ -244,8 +309,12 @@ std::wstring_view CommandHistory::GetLastCommand() const
 void CommandHistory::Empty()
 {
     _commands.clear();
+    _first = 0;
+    _index.clear();
     LastDisplayed = -1;
     WI_SetFlag(Flags, CLE_RESET);
+    // Expunging the history of an exe also drops what other consoles added to its journal.
+    _RewriteJournal(false);
 }
 
 bool CommandHistory::AtFirstCommand() const
@@ -277,14 +346,14 @@ void CommandHistory::Realloc(const size_t commands)
         return;
     }
 
-    const auto oldCommands = _commands;
-    const auto newNumberOfCommands = gsl::narrow<SHORT>(std::min(_commands.size(), commands));
+    _Linearize();
+    const auto newNumberOfCommands = std::min(_commands.size(), commands);
 
-    _commands.clear();
-    for (SHORT i = 0; i < newNumberOfCommands; i++)
+    for (auto i = newNumberOfCommands; i < _commands.size(); i++)
     {
-        _commands.emplace_back(oldCommands[i]);
+        _IndexRemove(_commands[i]);
     }
+    _commands.resize(newNumberOfCommands);
 
     WI_SetFlag(Flags, CLE_RESET);
     LastDisplayed = gsl::narrow<SHORT>(_commands.size()) - 1;
@@ -365,6 +434,7 @@ CommandHistory* CommandHistory::s_Allocate(const std::wstring_view appName, cons
         History.LastDisplayed = -1;
         History._maxCommands = gsl::narrow<SHORT>(gci.GetHistoryBufferSize());
         History._processHandle = processHandle;
+        History._RestoreFromJournal();
         return &s_historyLists.emplace_front(History);
     }
     else if (!BestCandidate.has_value() && s_historyLists.size() > 0)
@@ -384,16 +454,19 @@ CommandHistory* CommandHistory::s_Allocate(const std::wstring_view appName, cons
     // If the app name doesn't match, copy in the new app name and free the old commands.
     if (BestCandidate.has_value())
     {
+        BestCandidate->_processHandle = processHandle;
+        WI_SetFlag(BestCandidate->Flags, CLE_ALLOCATED);
+
         if (!SameApp)
         {
             BestCandidate->_commands.clear();
+            BestCandidate->_first = 0;
+            BestCandidate->_index.clear();
             BestCandidate->LastDisplayed = -1;
             BestCandidate->_appName = appName;
+            BestCandidate->_RestoreFromJournal();
         }
 
-        BestCandidate->_processHandle = processHandle;
-        WI_SetFlag(BestCandidate->Flags, CLE_ALLOCATED);
-
         return &s_historyLists.emplace_front(BestCandidate.value());
     }
 
@@ -442,6 +515,16 @@ void CommandHistory::_Inc(SHORT& ind) const
 }
 
 std::wstring CommandHistory::Remove(const SHORT iDel)
+{
+    auto str = _Remove(iDel);
+    if (!str.empty())
+    {
+        _RewriteJournal(true);
+    }
+    return str;
+}
+
+std::wstring CommandHistory::_Remove(const SHORT iDel)
 {
     SHORT iFirst = 0;
     auto iLast = gsl::narrow<SHORT>(_commands.size() - 1);
@@ -465,7 +548,9 @@ std::wstring CommandHistory::Remove(const SHORT iDel)
 
     try
     {
+        _Linearize();
         const auto str = _commands.at(iDel);
+        _IndexRemove(str);
 
         if (iDel < iLast)
         {
@@ -522,11 +607,18 @@ std::wstring CommandHistory::Remove(const SHORT iDel)
         return true;
     }
 
+    // The index answers whether any command matches without a scan.
+    // Otherwise the scan below stops at the nearest match.
+    if (!_HasPotentialMatch(givenCommand, options))
+    {
+        return false;
+    }
+
     try
     {
         for (size_t i = 0; i < _commands.size(); i++)
         {
-            const auto& storedCommand = _commands.at(indexFound);
+            const auto& storedCommand = _At(indexFound);
             if ((WI_IsFlagClear(options, MatchOptions::ExactMatch) && (givenCommand.size() <= storedCommand.size())) || (givenCommand.size() == storedCommand.size()))
             {
                 if (til::starts_with(storedCommand, givenCommand))
@@ -548,8 +640,320 @@ void CommandHistory::s_ClearHistoryListStorage()
 {
     s_historyLists.clear();
 }
+
+void CommandHistory::s_SetJournalDirectory(const std::wstring_view directory)
+{
+    s_journalDirectory = directory;
+}
 #endif
 
+// Routine Description:
+// - Returns the path of the journal file for the given exe name,
+//   or an empty string if journaling is disabled.
+std::wstring CommandHistory::s_JournalPath(const std::wstring_view appName)
+{
+    const auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+    if (!gci.GetHistoryJournal() || appName.empty())
+    {
+        return {};
+    }
+
+    auto path = s_journalDirectory.empty() ? wil::ExpandEnvironmentStringsW<std::wstring>(LR"(%LOCALAPPDATA%\Microsoft\Console\History)") : s_journalDirectory;
+    path.push_back(L'\\');
+    // Exe names are matched case-insensitively, so they share a lowercase file name.
+    for (const auto ch : appName)
+    {
+        const auto isSafe = (ch >= L'a' && ch <= L'z') || (ch >= L'0' && ch <= L'9') || ch == L'.' || ch == L'-' || ch == L'_';
+        const auto isUpper = ch >= L'A' && ch <= L'Z';
+        path.push_back(isUpper ? static_cast<wchar_t>(ch - L'A' + L'a') : isSafe ? ch : L'_');
+    }
+    path.append(L".history");
+    return path;
+}
+
+// Routine Description:
+// - Deletes the journal file for the given exe name, if journaling is enabled.
+void CommandHistory::s_DeleteJournal(const std::wstring_view appName)
+{
+    const auto path = s_JournalPath(appName);
+    if (!path.empty() && !DeleteFileW(path.c_str()))
+    {
+        LOG_LAST_ERROR_IF(GetLastError() != ERROR_FILE_NOT_FOUND && GetLastError() != ERROR_PATH_NOT_FOUND);
+    }
+}
+
+// Journals are shared by all consoles that run the same exe. A named mutex serializes
+// the changes to a journal, so that a console that rewrites it can pick up the
+// records other consoles appended in the meantime, instead of overwriting them.
+static auto lockJournal(const std::wstring_view path)
+{
+    std::wstring name{ L"Local\\ConsoleHistoryJournal-" };
+    name.append(path.substr(path.find_last_of(L'\\') + 1));
+
+    wil::unique_handle mutex{ CreateMutexW(nullptr, FALSE, name.c_str()) };
+    THROW_LAST_ERROR_IF(!mutex);
+    // An abandoned mutex is fine: Every change to a journal is a single WriteFile() or MoveFileExW().
+    const auto wait = WaitForSingleObject(mutex.get(), INFINITE);
+    THROW_LAST_ERROR_IF(wait != WAIT_OBJECT_0 && wait != WAIT_ABANDONED);
+
+    return wil::scope_exit([mutex = std::move(mutex)]() noexcept {
+        ReleaseMutex(mutex.get());
+    });
+}
+
+static FILE_ID_INFO getJournalFileId(const HANDLE file)
+{
+    FILE_ID_INFO id{};
+    THROW_IF_WIN32_BOOL_FALSE(GetFileInformationByHandleEx(file, FileIdInfo, &id, sizeof(id)));
+    return id;
+}
+
+// Calls func(offset, command) for each complete record in the journal, starting at the
+// given offset, and returns the size of the journal. The journal is mapped instead of
+// read, so that restoring a long history doesn't need to allocate a buffer for the whole file.
+template<typename Func>
+static uint64_t forEachJournalRecord(const HANDLE file, const uint64_t from, Func&& func)
+{
+    LARGE_INTEGER fileSize{};
+    if (!file || !GetFileSizeEx(file, &fileSize) || gsl::narrow<uint64_t>(fileSize.QuadPart) <= from)
+    {
+        return gsl::narrow_cast<uint64_t>(std::max<LONGLONG>(fileSize.QuadPart, 0));
+    }
+
+    const wil::unique_handle mapping{ CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr) };
+    THROW_LAST_ERROR_IF_NULL(mapping);
+    const wil::unique_mapview_ptr<void> view{ MapViewOfFile(mapping.get(), FILE_MAP_READ, 0, 0, 0) };
+    THROW_LAST_ERROR_IF_NULL(view);
+
+    const auto data = static_cast<const char*>(view.get());
+    const auto size = gsl::narrow<size_t>(fileSize.QuadPart);
+    std::wstring command;
+
+    // A record that's cut short was being written when the console exited and is ignored.
+    for (auto offset = gsl::narrow<size_t>(from); size - offset >= sizeof(uint32_t);)
+    {
+        const auto start = offset;
+        uint32_t length;
+        memcpy(&length, data + offset, sizeof(length));
+        offset += sizeof(length);
+
+        const auto bytes = size_t{ length } * sizeof(wchar_t);
+        if (size - offset < bytes)
+        {
+            break;
+        }
+
+        command.resize(length);
+        memcpy(command.data(), data + offset, bytes);
+        offset += bytes;
+
+        func(uint64_t{ start }, command);
+    }
+
+    return size;
+}
+
+// Routine Description:
+// - Restores the history from the journal file of its exe, if journaling is enabled.
+//   The journaled commands are added again in order, which results in the
+//   same history the exe had when it was last attached.
+// - The journal is rewritten if it holds many more commands than the history,
+//   so that it doesn't grow without bounds.
+void CommandHistory::_RestoreFromJournal()
+try
+{
+    _journalPath.clear();
+    _journalOwnRecords.clear();
+    _journalSyncedSize = 0;
+    _journalRecords = 0;
+    _journalFileId = {};
+    _journalReplaced = false;
+
+    auto path = s_JournalPath(_appName);
+    if (path.empty())
+    {
+        return;
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(std::filesystem::path{ path }.parent_path(), ec);
+
+    const auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+    const auto suppressDuplicates = WI_IsFlagSet(gci.Flags, CONSOLE_HISTORY_NODUP);
+
+    const auto lock = lockJournal(path);
+    {
+        const wil::unique_hfile file{ CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr) };
+        _journalSyncedSize = forEachJournalRecord(file.get(), 0, [&](uint64_t, const std::wstring& command) {
+            _journalRecords++;
+            LOG_IF_FAILED(Add(command, suppressDuplicates));
+        });
+        if (file)
+        {
+            _journalFileId = getJournalFileId(file.get());
+        }
+    }
+
+    _journalPath = std::move(path);
+    _CompactJournalIfNeeded();
+}
+CATCH_LOG()
+
+// Routine Description:
+// - Appends a command to the journal file, if this history has one.
+void CommandHistory::_AppendToJournal(const std::wstring_view command)
+try
+{
+    if (_journalPath.empty())
+    {
+        return;
+    }
+
+    std::string record;
+    appendJournalRecord(record, command);
+
+    {
+        const auto lock = lockJournal(_journalPath);
+        const wil::unique_hfile file{ CreateFileW(_journalPath.c_str(), GENERIC_READ | FILE_APPEND_DATA, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr) };
+        THROW_LAST_ERROR_IF(!file);
+        _SyncJournalFile(file.get());
+
+        // Remember where the record went, so that a rewrite can tell it apart from those of other consoles.
+        LARGE_INTEGER offset{};
+        THROW_IF_WIN32_BOOL_FALSE(GetFileSizeEx(file.get(), &offset));
+
+        DWORD written = 0;
+        THROW_IF_WIN32_BOOL_FALSE(WriteFile(file.get(), record.data(), gsl::narrow<DWORD>(record.size()), &written, nullptr));
+
+        const auto start = gsl::narrow<uint64_t>(offset.QuadPart);
+        if (start == _journalSyncedSize)
+        {
+            // Nobody else appended anything since, so the journal is still in sync with this history.
+            _journalSyncedSize += record.size();
+        }
+        else
+        {
+            _journalOwnRecords.emplace_back(start);
+        }
+        _journalRecords++;
+    }
+
+    _CompactJournalIfNeeded();
+}
+CATCH_LOG()
+
+// Routine Description:
+// - Rewrites the journal once it holds many more commands than the history,
+//   so that it doesn't grow without bounds during long sessions.
+void CommandHistory::_CompactJournalIfNeeded()
+{
+    if (_journalRecords > 2 * gsl::narrow_cast<size_t>(_maxCommands))
+    {
+        _RewriteJournal(true);
+    }
+}
+
+// Routine Description:
+// - Replaces the contents of the journal file with the commands that are currently in the history.
+//   This is necessary whenever commands are removed or reordered instead of added.
+// - If keepOtherConsoles is set, records that other consoles appended since this history was
+//   last in sync with the journal are kept after its commands, so that they're still restored.
+void CommandHistory::_RewriteJournal(const bool keepOtherConsoles)
+try
+{
+    if (_journalPath.empty())
+    {
+        return;
+    }
+
+    std::string buffer;
+    for (SHORT i = 0; i < gsl::narrow<SHORT>(_commands.size()); i++)
+    {
+        appendJournalRecord(buffer, _At(i));
+    }
+
+    const auto lock = lockJournal(_journalPath);
+
+    // Only the most recent ones of the other consoles' records are kept,
+    // since restoring the journal wouldn't keep any more than that either.
+    std::deque<std::wstring> foreign;
+    if (keepOtherConsoles)
+    {
+        const wil::unique_hfile file{ CreateFileW(_journalPath.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr) };
+        if (file)
+        {
+            _SyncJournalFile(file.get());
+        }
+        forEachJournalRecord(file.get(), _journalSyncedSize, [&](const uint64_t offset, const std::wstring& command) {
+            if (std::find(_journalOwnRecords.begin(), _journalOwnRecords.end(), offset) != _journalOwnRecords.end() ||
+                (_journalReplaced && _index.find(command) != _index.end()))
+            {
+                return;
+            }
+            if (foreign.size() == gsl::narrow_cast<size_t>(_maxCommands))
+            {
+                foreign.pop_front();
+            }
+            foreign.emplace_back(command);
+        });
+    }
+    for (const auto& command : foreign)
+    {
+        appendJournalRecord(buffer, command);
+    }
+
+    // The new journal is written to a temporary file first, so that
+    // the existing one remains intact if writing the new one fails.
+    const auto temporaryPath = _journalPath + L".tmp";
+    FILE_ID_INFO fileId{};
+    {
+        const wil::unique_hfile file{ CreateFileW(temporaryPath.c_str(), GENERIC_WRITE | FILE_READ_ATTRIBUTES, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr) };
+        THROW_LAST_ERROR_IF(!file);
+
+        DWORD written = 0;
+        THROW_IF_WIN32_BOOL_FALSE(WriteFile(file.get(), buffer.data(), gsl::narrow<DWORD>(buffer.size()), &written, nullptr));
+        // Renaming the file keeps its id.
+        fileId = getJournalFileId(file.get());
+    }
+    THROW_IF_WIN32_BOOL_FALSE(MoveFileExW(temporaryPath.c_str(), _journalPath.c_str(), MOVEFILE_REPLACE_EXISTING));
+
+    _journalSyncedSize = buffer.size();
+    _journalOwnRecords.clear();
+    _journalRecords = _commands.size() + foreign.size();
+    _journalFileId = fileId;
+    _journalReplaced = false;
+}
+CATCH_LOG()
+
+// Routine Description:
+// - Checks whether the given journal file is still the one this history last synced with.
+//   Another console replaces the journal whenever it rewrites it, and the file may also have
+//   been deleted and created anew. The remembered offsets then point into the middle of
+//   arbitrary records, so they're discarded and the whole journal is parsed from the start.
+// - Must be called while the journal is locked.
+// Arguments:
+// - file - The journal file, opened with read access.
+void CommandHistory::_SyncJournalFile(const HANDLE file)
+{
+    const auto fileId = getJournalFileId(file);
+    LARGE_INTEGER size{};
+    THROW_IF_WIN32_BOOL_FALSE(GetFileSizeEx(file, &size));
+
+    if (memcmp(&fileId, &_journalFileId, sizeof(fileId)) == 0 && gsl::narrow<uint64_t>(size.QuadPart) >= _journalSyncedSize)
+    {
+        return;
+    }
+
+    _journalFileId = fileId;
+    _journalSyncedSize = 0;
+    _journalOwnRecords.clear();
+    _journalRecords = 0;
+    forEachJournalRecord(file, 0, [&](uint64_t, const std::wstring&) {
+        _journalRecords++;
+    });
+    _journalReplaced = _journalRecords != 0;
+}
+
 // Routine Description:
 // - swaps the locations of two history items
 // Arguments:
@@ -557,7 +961,8 @@ void CommandHistory::s_ClearHistoryListStorage()
 // - indexB - index of one history item to swap
 void CommandHistory::Swap(const short indexA, const short indexB)
 {
-    std::swap(_commands.at(indexA), _commands.at(indexB));
+    std::swap(_At(indexA), _At(indexB));
+    _RewriteJournal(true);
 }
 
 // Routine Description:
@@ -598,6 +1003,11 @@ HRESULT ApiRoutines::ExpungeConsoleCommandHistoryWImpl(const std::wstring_view e
         {
             history->Empty();
         }
+        else
+        {
+            // The exe may still have a journal from a previous session.
+            CommandHistory::s_DeleteJournal(exeName);
+        }
 
         return S_OK;
     }
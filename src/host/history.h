@@ -8,6 +8,12 @@ Module Name:
 Abstract:
 - Encapsulates the cmdline functions and structures specifically related to
         command history functionality.
+- The commands are stored in a ring buffer, so that adding a command to a full
+  history doesn't need to move all the others. A sorted index of the distinct
+  commands answers duplicate and prefix lookups without scanning the history.
+- If enabled via the HistoryJournal setting, each history is backed by a journal
+  file per exe name, from which it's restored when the exe is attached again.
+  The journal is shared by all consoles running that exe.
 --*/
 
 #pragma once
@@ -26,6 +32,7 @@ public:
     static void s_Free(const HANDLE processHandle);
     static void s_ResizeAll(const size_t commands);
     static size_t s_CountOfHistories();
+    static void s_DeleteJournal(const std::wstring_view appName);
 
     enum class MatchOptions
     {
@@ -75,6 +82,21 @@ public:
 private:
     void _Reset();
 
+    const std::wstring& _At(const SHORT index) const;
+    std::wstring& _At(const SHORT index);
+    std::wstring _Remove(const SHORT iDel);
+    void _Linearize();
+    void _IndexAdd(const std::wstring& command);
+    void _IndexRemove(const std::wstring& command);
+    bool _HasPotentialMatch(const std::wstring_view command, const MatchOptions options) const;
+
+    static std::wstring s_JournalPath(const std::wstring_view appName);
+    void _RestoreFromJournal();
+    void _AppendToJournal(const std::wstring_view command);
+    void _CompactJournalIfNeeded();
+    void _RewriteJournal(const bool keepOtherConsoles);
+    void _SyncJournalFile(const HANDLE file);
+
     // _Next and _Prev go to the next and prev command
     // _Inc  and _Dec go to the next and prev slots
     // Don't get the two confused - it matters when the cmd history is not full!
@@ -83,9 +105,30 @@ private:
     void _Dec(SHORT& ind) const;
     void _Inc(SHORT& ind) const;
 
+    // A ring buffer of up to _maxCommands commands. Once it's full,
+    // _first is the slot of the oldest command, which is overwritten next.
     std::vector<std::wstring> _commands;
+    size_t _first = 0;
     SHORT _maxCommands;
 
+    // The number of occurrences of each command in _commands.
+    std::map<std::wstring, size_t, std::less<>> _index;
+
+    // The journal file this history is written to, or empty if journaling is disabled.
+    std::wstring _journalPath;
+    // The journal's size when it last matched this history, and the offsets of the records
+    // this history appended after others did. Anything else past that size is another console's.
+    uint64_t _journalSyncedSize = 0;
+    std::vector<uint64_t> _journalOwnRecords;
+    // The number of records in the journal, as far as this history knows.
+    size_t _journalRecords = 0;
+    // The file that the offsets above refer to. Another console replaces it whenever it
+    // rewrites the journal, after which the offsets are meaningless. See _SyncJournalFile.
+    FILE_ID_INFO _journalFileId{};
+    // Set if the journal was replaced by another console's. Its records can't be told apart
+    // anymore, so a rewrite keeps only those whose command isn't in this history.
+    bool _journalReplaced = false;
+
     std::wstring _appName;
     HANDLE _processHandle;
 
@@ -97,6 +140,7 @@ public:
 
 #ifdef UNIT_TESTING
     static void s_ClearHistoryListStorage();
+    static void s_SetJournalDirectory(const std::wstring_view directory);
     friend class HistoryTests;
 #endif
 };
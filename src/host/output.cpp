@@ -92,24 +92,10 @@ static void _CopyRectangle(SCREEN_INFORMATION& screenInfo,
         }
     }
 
-    // 2. We can move any other scenario in-place without copying. We just have to carefully
-    //    choose which direction we walk through filling up the target so it doesn't accidentally
+    // 2. Any other scenario is moved in-place one span of cells per row. The buffer takes
+    //    care of the order in which the rows are copied, so that overlapping regions don't
     //    erase the source material before it can be copied/moved to the new location.
-    {
-        const auto target = Viewport::FromDimensions(targetOrigin, source.Dimensions());
-        const auto walkDirection = Viewport::DetermineWalkDirection(source, target);
-
-        auto sourcePos = source.GetWalkOrigin(walkDirection);
-        auto targetPos = target.GetWalkOrigin(walkDirection);
-
-        do
-        {
-            const auto data = OutputCell(*screenInfo.GetCellDataAt(sourcePos));
-            screenInfo.Write(OutputCellIterator({ &data, 1 }), targetPos);
-
-            source.WalkInBounds(sourcePos, walkDirection);
-        } while (target.WalkInBounds(targetPos, walkDirection));
-    }
+    screenInfo.GetTextBuffer().CopyRectangle(source, targetOrigin);
 }
 
 // Routine Description:
@@ -17,6 +17,7 @@ Author(s):
 #include "../renderer/inc/IRenderData.hpp"
 #include "../types/inc/colorTable.hpp"
 #include "../types/IUiaData.h"
+#include "../types/UiaTextSnapshot.hpp"
 
 class RenderData final :
     public Microsoft::Console::Render::IRenderData,
@@ -66,5 +67,9 @@ public:
     const til::point GetSelectionEnd() const noexcept;
     void ColorSelection(const til::point coordSelectionStart, const til::point coordSelectionEnd, const TextAttribute attr);
     const bool IsUiaDataInitialized() const noexcept override { return true; }
+    Microsoft::Console::Types::UiaTextSnapshotCache& GetUiaTextSnapshotCache() noexcept override { return _uiaTextSnapshotCache; }
 #pragma endregion
+
+private:
+    Microsoft::Console::Types::UiaTextSnapshotCache _uiaTextSnapshotCache;
 };
@@ -56,7 +56,8 @@ Settings::Settings() :
     // window size pixels initialized below
     _fInterceptCopyPaste(0),
     _fUseDx(UseDx::Disabled),
-    _fCopyColor(false)
+    _fCopyColor(false),
+    _fHistoryJournal(false)
 {
     _dwScreenBufferSize.X = 80;
     _dwScreenBufferSize.Y = 25;
@@ -805,3 +806,15 @@ bool Settings::GetCopyColor() const noexcept
 {
     return _fCopyColor;
 }
+
+// Determines whether command histories are written to a journal file per exe name,
+// from which they're restored the next time the exe is attached.
+bool Settings::GetHistoryJournal() const noexcept
+{
+    return _fHistoryJournal;
+}
+
+void Settings::SetHistoryJournal(const bool historyJournal) noexcept
+{
+    _fHistoryJournal = historyJournal;
+}
@@ -185,6 +185,9 @@ public:
     UseDx GetUseDx() const noexcept;
     bool GetCopyColor() const noexcept;
 
+    bool GetHistoryJournal() const noexcept;
+    void SetHistoryJournal(const bool historyJournal) noexcept;
+
 private:
     RenderSettings _renderSettings;
 
@@ -229,6 +232,7 @@ private:
     bool _fRenderGridWorldwide;
     UseDx _fUseDx;
     bool _fCopyColor;
+    bool _fHistoryJournal;
 
     // this is used for the special STARTF_USESIZE mode.
     bool _fUseWindowSizePixels;
@@ -58,6 +58,26 @@ class AliasTests
         expected = targetExpectedPair.Mid(sepIndex + 1);
     }
 
+    void _VerifyTokens(const std::deque<std::wstring>& expected, const Alias::Tokens& actual)
+    {
+        for (size_t i = 0; i < actual.size(); i++)
+        {
+            // Tokens beyond the end of the string are empty.
+            const auto expectedToken = i < expected.size() ? std::wstring_view{ expected[i] } : std::wstring_view{};
+            VERIFY_ARE_EQUAL(String(expectedToken.data(), gsl::narrow<int>(expectedToken.size())),
+                             String(actual[i].data(), gsl::narrow<int>(actual[i].size())));
+        }
+    }
+
+    std::wstring _Expand(const Alias::Target& target, const Alias::Tokens& tokens, const std::wstring_view fullArgString)
+    {
+        std::wstring output(64, L'\0');
+        size_t written = 0;
+        VERIFY_IS_TRUE(Alias::s_ExpandTarget(target, tokens, fullArgString, output, written));
+        output.resize(written);
+        return output;
+    }
+
     TEST_METHOD(TestMatchAndCopy)
     {
         BEGIN_TEST_METHOD_PROPERTIES()
@@ -365,6 +385,39 @@ class AliasTests
         VERIFY_ARE_EQUAL(dwLinesBefore, dwLines, L"Line count should pass through.");
     }
 
+    TEST_METHOD(TestMatchAndCopyIgnoresCase)
+    {
+        std::wstring exe(L"Exe.exe");
+        std::wstring source(L"Source");
+        std::wstring target(L"someTarget $1");
+        Alias::s_TestAddAlias(exe, source, target);
+
+        // Replacing an alias with a differently cased name keeps a single alias.
+        std::wstring sourceUpper(L"SOURCE");
+        target = L"otherTarget $1";
+        Alias::s_TestAddAlias(exe, sourceUpper, target);
+
+        const auto pwszSource = L"sOuRcE arg\r\n";
+        const auto cbSource = wcslen(pwszSource) * sizeof(wchar_t);
+
+        const size_t cchTarget = 60;
+        auto rgwchTarget = std::make_unique<wchar_t[]>(cchTarget);
+        size_t cbTargetUsed = 0;
+        DWORD dwLines = 0;
+
+        Alias::s_MatchAndCopyAliasLegacy(pwszSource,
+                                         cbSource,
+                                         rgwchTarget.get(),
+                                         cchTarget * sizeof(wchar_t),
+                                         cbTargetUsed,
+                                         L"EXE.EXE",
+                                         dwLines);
+
+        const std::wstring_view expected{ L"otherTarget arg\r\n" };
+        VERIFY_ARE_EQUAL(String(expected.data()), String(rgwchTarget.get(), gsl::narrow<int>(cbTargetUsed / sizeof(wchar_t))));
+        VERIFY_ARE_EQUAL(1u, dwLines);
+    }
+
     TEST_METHOD(TrimTrailing)
     {
         BEGIN_TEST_METHOD_PROPERTIES()
@@ -383,9 +436,9 @@ class AliasTests
         _ReplacePercentWithCRLF(target);
         _ReplacePercentWithCRLF(expected);
 
-        Alias::s_TrimTrailingCrLf(target);
+        const auto actual = Alias::s_TrimTrailingCrLf(target);
 
-        VERIFY_ARE_EQUAL(String(expected.data()), String(target.data()));
+        VERIFY_ARE_EQUAL(String(expected.data()), String(actual.data(), gsl::narrow<int>(actual.size())));
     }
 
     TEST_METHOD(Tokenize)
@@ -396,14 +449,9 @@ class AliasTests
         tokensExpected.emplace_back(L"two");
         tokensExpected.emplace_back(L"three");
 
-        auto tokensActual = Alias::s_Tokenize(tokenStr);
-
-        VERIFY_ARE_EQUAL(tokensExpected.size(), tokensActual.size());
+        const auto tokensActual = Alias::s_Tokenize(tokenStr);
 
-        for (size_t i = 0; i < tokensExpected.size(); i++)
-        {
-            VERIFY_ARE_EQUAL(String(tokensExpected[i].data()), String(tokensActual[i].data()));
-        }
+        _VerifyTokens(tokensExpected, tokensActual);
     }
 
     TEST_METHOD(TokenizeNothing)
@@ -412,14 +460,19 @@ class AliasTests
         std::deque<std::wstring> tokensExpected;
         tokensExpected.emplace_back(tokenStr);
 
-        auto tokensActual = Alias::s_Tokenize(tokenStr);
+        const auto tokensActual = Alias::s_Tokenize(tokenStr);
 
-        VERIFY_ARE_EQUAL(tokensExpected.size(), tokensActual.size());
+        _VerifyTokens(tokensExpected, tokensActual);
+    }
 
-        for (size_t i = 0; i < tokensExpected.size(); i++)
-        {
-            VERIFY_ARE_EQUAL(String(tokensExpected[i].data()), String(tokensActual[i].data()));
-        }
+    TEST_METHOD(TokenizeStopsAtLastMacroArgument)
+    {
+        std::wstring tokenStr(L"alias 1 2 3 4 5 6 7 8 9 10 11");
+        std::deque<std::wstring> tokensExpected{ L"alias", L"1", L"2", L"3", L"4", L"5", L"6", L"7", L"8", L"9" };
+
+        const auto tokensActual = Alias::s_Tokenize(tokenStr);
+
+        _VerifyTokens(tokensExpected, tokensActual);
     }
 
     TEST_METHOD(GetArgString)
@@ -436,9 +489,9 @@ class AliasTests
         std::wstring expected;
         _RetrieveTargetExpectedPair(target, expected);
 
-        auto actual = Alias::s_GetArgString(target);
+        const auto actual = Alias::s_GetArgString(target);
 
-        VERIFY_ARE_EQUAL(String(expected.data()), String(actual.data()));
+        VERIFY_ARE_EQUAL(String(expected.data()), String(actual.data(), gsl::narrow<int>(actual.size())));
     }
 
     TEST_METHOD(NumberedArgMacro)
@@ -464,27 +517,15 @@ class AliasTests
         std::wstring expected;
         _RetrieveTargetExpectedPair(target, expected);
 
-        std::deque<std::wstring> tokens;
-        tokens.emplace_back(L"alias");
-        tokens.emplace_back(L"one");
-        tokens.emplace_back(L"two");
-        tokens.emplace_back(L"three");
-        tokens.emplace_back(L"four");
-        tokens.emplace_back(L"five");
-        tokens.emplace_back(L"six");
-        tokens.emplace_back(L"seven");
-        tokens.emplace_back(L"eight");
-        tokens.emplace_back(L"nine");
-        tokens.emplace_back(L"ten");
+        const auto tokens = Alias::s_Tokenize(L"alias one two three four five six seven eight nine ten");
 
-        // if we expect non-empty results, then we should get a bool back saying it was processed
-        const auto returnExpected = !expected.empty();
+        // if we expect non-empty results, the macro was replaced. Otherwise it's kept as is.
+        const auto expectedText = (expected.empty() ? L"$" + target : expected) + L"\r\n";
 
-        std::wstring actual;
-        const auto returnActual = Alias::s_TryReplaceNumberedArgMacro(target[0], actual, tokens);
+        const auto compiled = Alias::s_CompileTarget(L"$" + target);
+        const auto actual = _Expand(compiled, tokens, L"one two three four five six seven eight nine ten");
 
-        VERIFY_ARE_EQUAL(returnExpected, returnActual);
-        VERIFY_ARE_EQUAL(String(expected.data()), String(actual.data()));
+        VERIFY_ARE_EQUAL(String(expectedText.data()), String(actual.data()));
     }
 
     TEST_METHOD(WildcardArgMacro)
@@ -503,15 +544,17 @@ class AliasTests
         _RetrieveTargetExpectedPair(target, expected);
 
         std::wstring fullArgString(L"one two three");
+        // The tokens are views into the source, which therefore has to outlive them.
+        const auto source = L"alias " + fullArgString;
+        const auto tokens = Alias::s_Tokenize(source);
 
-        // if we expect non-empty results, then we should get a bool back saying it was processed
-        const auto returnExpected = !expected.empty();
+        // if we expect non-empty results, the macro was replaced. Otherwise it's kept as is.
+        const auto expectedText = (expected.empty() ? L"$" + target : expected) + L"\r\n";
 
-        std::wstring actual;
-        const auto returnActual = Alias::s_TryReplaceWildcardArgMacro(target[0], actual, fullArgString);
+        const auto compiled = Alias::s_CompileTarget(L"$" + target);
+        const auto actual = _Expand(compiled, tokens, fullArgString);
 
-        VERIFY_ARE_EQUAL(returnExpected, returnActual);
-        VERIFY_ARE_EQUAL(String(expected.data()), String(actual.data()));
+        VERIFY_ARE_EQUAL(String(expectedText.data()), String(actual.data()));
     }
 
     TEST_METHOD(InputRedirMacro)
@@ -242,7 +242,205 @@ class HistoryTests
         VERIFY_ARE_EQUAL(2ul, history->GetNumberOfCommands());
     }
 
+    TEST_METHOD(AddWrapsAroundFullHistory)
+    {
+        auto history = CommandHistory::s_Allocate(_manyApps[0], _MakeHandle(0));
+        VERIFY_IS_NOT_NULL(history);
+
+        for (size_t i = 0; i < _manyHistoryItems.size(); i++)
+        {
+            VERIFY_SUCCEEDED(history->Add(_manyHistoryItems[i], false));
+        }
+
+        // The two oldest commands were replaced, but the history is still ordered from oldest to newest.
+        VERIFY_ARE_EQUAL(s_BufferSize, history->GetNumberOfCommands());
+        for (SHORT i = 0; i < gsl::narrow<SHORT>(s_BufferSize); i++)
+        {
+            VERIFY_ARE_EQUAL(String(_manyHistoryItems[i + 2].data()), String(history->GetNth(i).data()));
+        }
+        VERIFY_ARE_EQUAL(String(L"git push"), String(history->GetLastCommand().data()));
+
+        // Removing a command after wrapping around keeps the remaining ones in order.
+        VERIFY_ARE_EQUAL(String(L"ipconfig"), String(history->Remove(2).data()));
+        VERIFY_SUCCEEDED(history->Add(L"exit", false));
+        VERIFY_ARE_EQUAL(String(L"telnet 127.0.0.1"), String(history->GetNth(1).data()));
+        VERIFY_ARE_EQUAL(String(L"ipconfig /all"), String(history->GetNth(2).data()));
+        VERIFY_ARE_EQUAL(String(L"exit"), String(history->GetNth(9).data()));
+
+        // Commands that were replaced can't be found anymore.
+        SHORT index;
+        VERIFY_IS_FALSE(history->FindMatchingCommand(L"dir /w", history->LastDisplayed, index, CommandHistory::MatchOptions::ExactMatch));
+        VERIFY_IS_TRUE(history->FindMatchingCommand(L"dir /p /w", history->LastDisplayed, index, CommandHistory::MatchOptions::ExactMatch));
+        VERIFY_ARE_EQUAL(0, index);
+    }
+
+    TEST_METHOD(FindMatchingCommandByPrefix)
+    {
+        auto history = CommandHistory::s_Allocate(_manyApps[0], _MakeHandle(0));
+        VERIFY_IS_NOT_NULL(history);
+
+        VERIFY_SUCCEEDED(history->Add(L"dir", false));
+        VERIFY_SUCCEEDED(history->Add(L"cd ..", false));
+        VERIFY_SUCCEEDED(history->Add(L"dir /w", false));
+        VERIFY_SUCCEEDED(history->Add(L"ping", false));
+
+        // Searches start before the given index and find the most recent match first.
+        SHORT index;
+        VERIFY_IS_TRUE(history->FindMatchingCommand(L"dir", history->LastDisplayed, index, CommandHistory::MatchOptions::JustLooking));
+        VERIFY_ARE_EQUAL(2, index);
+        VERIFY_IS_TRUE(history->FindMatchingCommand(L"dir", index, index, CommandHistory::MatchOptions::JustLooking));
+        VERIFY_ARE_EQUAL(0, index);
+
+        VERIFY_IS_TRUE(history->FindMatchingCommand(L"dir", history->LastDisplayed, index, CommandHistory::MatchOptions::JustLooking | CommandHistory::MatchOptions::ExactMatch));
+        VERIFY_ARE_EQUAL(0, index);
+
+        VERIFY_IS_FALSE(history->FindMatchingCommand(L"dir /p", history->LastDisplayed, index, CommandHistory::MatchOptions::JustLooking));
+        VERIFY_IS_FALSE(history->FindMatchingCommand(L"c", history->LastDisplayed, index, CommandHistory::MatchOptions::JustLooking | CommandHistory::MatchOptions::ExactMatch));
+    }
+
+    TEST_METHOD(JournalRestoresHistory)
+    {
+        auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+        const auto directory = std::filesystem::temp_directory_path() / L"HistoryTests.Journal";
+        std::filesystem::remove_all(directory);
+        std::filesystem::create_directories(directory);
+
+        gci.SetHistoryJournal(true);
+        CommandHistory::s_SetJournalDirectory(directory.native());
+        auto restoreSettings = wil::scope_exit([&] {
+            gci.SetHistoryJournal(false);
+            CommandHistory::s_SetJournalDirectory({});
+            std::filesystem::remove_all(directory);
+        });
+
+        auto history = CommandHistory::s_Allocate(L"Journaled.exe", _MakeHandle(0));
+        VERIFY_IS_NOT_NULL(history);
+        for (auto i = 0; i < 2; i++)
+        {
+            for (const auto& item : _manyHistoryItems)
+            {
+                VERIFY_SUCCEEDED(history->Add(item, false));
+            }
+        }
+        VERIFY_SUCCEEDED(history->Add(_manyHistoryItems[0], false));
+        Log::Comment(L"The 21st record compacted the journal to the 10 commands in the history, 4 more were appended since.");
+        VERIFY_ARE_EQUAL(14u, _countJournalRecords(directory / L"journaled.exe.history"));
+
+        Log::Comment(L"A new session restores the commands from the journal.");
+        CommandHistory::s_ClearHistoryListStorage();
+        history = CommandHistory::s_Allocate(L"JOURNALED.EXE", _MakeHandle(1));
+        VERIFY_IS_NOT_NULL(history);
+        VERIFY_ARE_EQUAL(s_BufferSize, history->GetNumberOfCommands());
+        VERIFY_ARE_EQUAL(String(_manyHistoryItems[3].data()), String(history->GetNth(0).data()));
+        VERIFY_ARE_EQUAL(String(_manyHistoryItems[0].data()), String(history->GetNth(9).data()));
+        VERIFY_ARE_EQUAL(14u, _countJournalRecords(directory / L"journaled.exe.history"));
+
+        Log::Comment(L"Removed commands stay removed.");
+        history->Remove(0);
+        CommandHistory::s_ClearHistoryListStorage();
+        history = CommandHistory::s_Allocate(L"journaled.exe", _MakeHandle(2));
+        VERIFY_ARE_EQUAL(s_BufferSize - 1, history->GetNumberOfCommands());
+        VERIFY_ARE_EQUAL(String(_manyHistoryItems[4].data()), String(history->GetNth(0).data()));
+
+        Log::Comment(L"Emptying the history empties the journal.");
+        history->Empty();
+        CommandHistory::s_ClearHistoryListStorage();
+        history = CommandHistory::s_Allocate(L"journaled.exe", _MakeHandle(3));
+        VERIFY_ARE_EQUAL(0u, history->GetNumberOfCommands());
+    }
+
+    TEST_METHOD(JournalKeepsOtherConsolesCommands)
+    {
+        auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+        const auto directory = std::filesystem::temp_directory_path() / L"HistoryTests.SharedJournal";
+        std::filesystem::remove_all(directory);
+        std::filesystem::create_directories(directory);
+
+        gci.SetHistoryJournal(true);
+        CommandHistory::s_SetJournalDirectory(directory.native());
+        auto restoreSettings = wil::scope_exit([&] {
+            gci.SetHistoryJournal(false);
+            CommandHistory::s_SetJournalDirectory({});
+            std::filesystem::remove_all(directory);
+        });
+
+        // Two attached histories for the same exe stand in for two consoles sharing its journal.
+        const auto first = CommandHistory::s_Allocate(L"shared.exe", _MakeHandle(0));
+        VERIFY_SUCCEEDED(first->Add(L"first", false));
+        const auto second = CommandHistory::s_Allocate(L"shared.exe", _MakeHandle(1));
+        VERIFY_ARE_NOT_EQUAL(first, second);
+        VERIFY_SUCCEEDED(second->Add(L"second", false));
+
+        Log::Comment(L"Rewriting the journal for a removal keeps the command the other console appended.");
+        first->Remove(0);
+        VERIFY_ARE_EQUAL(1u, _countJournalRecords(directory / L"shared.exe.history"));
+
+        CommandHistory::s_ClearHistoryListStorage();
+        auto history = CommandHistory::s_Allocate(L"shared.exe", _MakeHandle(2));
+        VERIFY_ARE_EQUAL(1u, history->GetNumberOfCommands());
+        VERIFY_ARE_EQUAL(String(L"second"), String(history->GetNth(0).data()));
+
+        Log::Comment(L"Expunging the history drops the commands of all consoles.");
+        const auto other = CommandHistory::s_Allocate(L"shared.exe", _MakeHandle(3));
+        VERIFY_SUCCEEDED(other->Add(L"third", false));
+        history->Empty();
+        VERIFY_ARE_EQUAL(0u, _countJournalRecords(directory / L"shared.exe.history"));
+    }
+
+    TEST_METHOD(JournalRewrittenByOtherConsole)
+    {
+        auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+        const auto directory = std::filesystem::temp_directory_path() / L"HistoryTests.RewrittenJournal";
+        std::filesystem::remove_all(directory);
+        std::filesystem::create_directories(directory);
+
+        gci.SetHistoryJournal(true);
+        CommandHistory::s_SetJournalDirectory(directory.native());
+        auto restoreSettings = wil::scope_exit([&] {
+            gci.SetHistoryJournal(false);
+            CommandHistory::s_SetJournalDirectory({});
+            std::filesystem::remove_all(directory);
+        });
+
+        const auto first = CommandHistory::s_Allocate(L"rewritten.exe", _MakeHandle(0));
+        VERIFY_SUCCEEDED(first->Add(L"a", false));
+        const auto second = CommandHistory::s_Allocate(L"rewritten.exe", _MakeHandle(1));
+        VERIFY_ARE_EQUAL(1u, second->GetNumberOfCommands());
+        VERIFY_SUCCEEDED(second->Add(L"b", false));
+
+        Log::Comment(L"The second console rewrites the journal while the first one is out of sync with it.");
+        second->Remove(0);
+        VERIFY_ARE_EQUAL(1u, _countJournalRecords(directory / L"rewritten.exe.history"));
+
+        // The rewritten journal is exactly as large as the one the first console last synced with,
+        // so the size alone doesn't tell that it's a different file.
+        Log::Comment(L"The first console appends to and then rewrites the replaced journal.");
+        VERIFY_SUCCEEDED(first->Add(L"a2", false));
+        first->Swap(0, 1);
+        VERIFY_ARE_EQUAL(3u, _countJournalRecords(directory / L"rewritten.exe.history"));
+
+        Log::Comment(L"The other console's command is kept, and none of them are restored twice.");
+        CommandHistory::s_ClearHistoryListStorage();
+        const auto history = CommandHistory::s_Allocate(L"rewritten.exe", _MakeHandle(2));
+        VERIFY_ARE_EQUAL(3u, history->GetNumberOfCommands());
+        VERIFY_ARE_EQUAL(String(L"a2"), String(history->GetNth(0).data()));
+        VERIFY_ARE_EQUAL(String(L"a"), String(history->GetNth(1).data()));
+        VERIFY_ARE_EQUAL(String(L"b"), String(history->GetNth(2).data()));
+    }
+
 private:
+    static size_t _countJournalRecords(const std::filesystem::path& path)
+    {
+        std::ifstream file{ path, std::ios::binary };
+        size_t records = 0;
+        for (uint32_t length; file.read(reinterpret_cast<char*>(&length), sizeof(length));)
+        {
+            file.seekg(length * sizeof(wchar_t), std::ios::cur);
+            records++;
+        }
+        return records;
+    }
+
     const std::array<std::wstring, 5> _manyApps = {
         L"foo.exe",
         L"bar.exe",
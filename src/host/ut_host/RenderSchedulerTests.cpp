@@ -0,0 +1,256 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "WexTestClass.h"
+#include "../../inc/consoletaeftemplates.hpp"
+
+#include "../../renderer/base/scheduler.hpp"
+
+using namespace WEX::Logging;
+using namespace Microsoft::Console::Render;
+using namespace std::chrono_literals;
+
+// Stands in for a renderer. Its paints can be held up to simulate a slow frame.
+class FakeRenderClient
+{
+public:
+    explicit FakeRenderClient(RenderScheduler& scheduler, const PaintPriority priority) :
+        client{ std::make_unique<RenderScheduler::Client>(scheduler, [this]() { _paint(); }) }
+    {
+        client->SetPriority(priority);
+        client->SetEnabled(true);
+    }
+
+    // Paints that start from now on wait until Release() is called.
+    void Hold()
+    {
+        const std::scoped_lock lock{ _mutex };
+        _held = true;
+    }
+
+    void Release()
+    {
+        {
+            const std::scoped_lock lock{ _mutex };
+            _held = false;
+        }
+        _cv.notify_all();
+    }
+
+    // Every paint requests the next one, like a pane that receives output continuously.
+    void SetRepaintContinuously(const bool repaint)
+    {
+        const std::scoped_lock lock{ _mutex };
+        _repaint = repaint;
+    }
+
+    bool WaitForPaintStarted(const std::chrono::milliseconds timeout)
+    {
+        std::unique_lock lock{ _mutex };
+        return _cv.wait_for(lock, timeout, [&]() { return _painting; });
+    }
+
+    bool WaitForPaints(const size_t count, const std::chrono::milliseconds timeout)
+    {
+        std::unique_lock lock{ _mutex };
+        return _cv.wait_for(lock, timeout, [&]() { return _paints >= count; });
+    }
+
+    bool IsPainting()
+    {
+        const std::scoped_lock lock{ _mutex };
+        return _painting;
+    }
+
+    size_t Paints()
+    {
+        const std::scoped_lock lock{ _mutex };
+        return _paints;
+    }
+
+    std::vector<std::chrono::steady_clock::time_point> PaintStarts()
+    {
+        const std::scoped_lock lock{ _mutex };
+        return _starts;
+    }
+
+private:
+    void _paint()
+    {
+        bool repaint;
+        {
+            std::unique_lock lock{ _mutex };
+            _starts.emplace_back(std::chrono::steady_clock::now());
+            _painting = true;
+            _cv.notify_all();
+
+            _cv.wait(lock, [&]() { return !_held; });
+
+            _painting = false;
+            _paints++;
+            repaint = _repaint;
+            _cv.notify_all();
+        }
+
+        if (repaint)
+        {
+            client->RequestPaint();
+        }
+    }
+
+    std::mutex _mutex;
+    std::condition_variable _cv;
+    std::vector<std::chrono::steady_clock::time_point> _starts;
+    size_t _paints = 0;
+    bool _painting = false;
+    bool _held = false;
+    bool _repaint = false;
+
+public:
+    // Declared last, so that it's destroyed first, which waits for a paint that's in progress.
+    // It can be destroyed on its own, to test just that.
+    std::unique_ptr<RenderScheduler::Client> client;
+};
+
+class RenderSchedulerTests
+{
+    TEST_CLASS(RenderSchedulerTests);
+
+    TEST_METHOD(FocusedClientAlwaysGetsAWorker)
+    {
+        RenderScheduler scheduler{ 2 };
+
+        Log::Comment(L"Busy background panes whose paints take a long time...");
+        std::vector<std::unique_ptr<FakeRenderClient>> background;
+        for (auto i = 0; i < 3; ++i)
+        {
+            auto& fake = *background.emplace_back(std::make_unique<FakeRenderClient>(scheduler, PaintPriority::Unfocused));
+            fake.Hold();
+            fake.client->RequestPaint();
+        }
+        VERIFY_IS_TRUE(background.front()->WaitForPaintStarted(1s) || background[1]->WaitForPaintStarted(1s));
+        std::this_thread::sleep_for(100ms);
+
+        const auto painting = std::count_if(background.begin(), background.end(), [](const auto& fake) { return fake->IsPainting(); });
+        VERIFY_ARE_EQUAL(1, painting, L"...may only occupy all but one of the workers.");
+
+        Log::Comment(L"The focused pane is painted while they're still busy.");
+        FakeRenderClient focused{ scheduler, PaintPriority::Focused };
+        focused.client->RequestPaint();
+        VERIFY_IS_TRUE(focused.WaitForPaints(1, 1s));
+        focused.client->RequestPaint();
+        VERIFY_IS_TRUE(focused.WaitForPaints(2, 1s));
+
+        for (const auto& fake : background)
+        {
+            fake->Release();
+        }
+        for (const auto& fake : background)
+        {
+            VERIFY_IS_TRUE(fake->WaitForPaints(1, 1s));
+        }
+    }
+
+    TEST_METHOD(UnfocusedClientsAreThrottled)
+    {
+        RenderScheduler scheduler{ 2 };
+        FakeRenderClient unfocused{ scheduler, PaintPriority::Unfocused };
+        FakeRenderClient focused{ scheduler, PaintPriority::Focused };
+
+        unfocused.SetRepaintContinuously(true);
+        focused.SetRepaintContinuously(true);
+        unfocused.client->RequestPaint();
+        focused.client->RequestPaint();
+        std::this_thread::sleep_for(500ms);
+        unfocused.SetRepaintContinuously(false);
+        focused.SetRepaintContinuously(false);
+        unfocused.client->SetEnabled(false);
+        focused.client->SetEnabled(false);
+        VERIFY_IS_TRUE(unfocused.client->WaitForPaintCompletion(1000ms));
+        VERIFY_IS_TRUE(focused.client->WaitForPaintCompletion(1000ms));
+
+        const auto starts = unfocused.PaintStarts();
+        VERIFY_IS_GREATER_THAN(starts.size(), 1u);
+        // A paint is due UnfocusedFrameInterval after the previous one ended, so the starts are at least that far apart.
+        for (size_t i = 1; i < starts.size(); ++i)
+        {
+            const auto gap = std::chrono::duration_cast<std::chrono::milliseconds>(starts[i] - starts[i - 1]);
+            VERIFY_IS_GREATER_THAN_OR_EQUAL(gap.count(), RenderScheduler::UnfocusedFrameInterval.count());
+        }
+
+        Log::Comment(L"The focused client isn't throttled.");
+        VERIFY_IS_GREATER_THAN(focused.Paints(), starts.size() * 2);
+    }
+
+    TEST_METHOD(HiddenClientsArePaintedWhenShown)
+    {
+        RenderScheduler scheduler{ 2 };
+        FakeRenderClient hidden{ scheduler, PaintPriority::Hidden };
+
+        hidden.client->RequestPaint();
+        hidden.client->RequestPaint();
+        std::this_thread::sleep_for(200ms);
+        VERIFY_ARE_EQUAL(0u, hidden.Paints(), L"Hidden clients are skipped.");
+
+        Log::Comment(L"The paint requested while hidden happens once the client is shown.");
+        hidden.client->SetPriority(PaintPriority::Unfocused);
+        VERIFY_IS_TRUE(hidden.WaitForPaints(1, 1s));
+        std::this_thread::sleep_for(2 * RenderScheduler::UnfocusedFrameInterval);
+        VERIFY_ARE_EQUAL(1u, hidden.Paints(), L"Both requests were coalesced into one paint.");
+
+        Log::Comment(L"Hiding it again stops painting, showing it focused paints immediately.");
+        hidden.client->SetPriority(PaintPriority::Hidden);
+        hidden.client->RequestPaint();
+        std::this_thread::sleep_for(200ms);
+        VERIFY_ARE_EQUAL(1u, hidden.Paints());
+        hidden.client->SetPriority(PaintPriority::Focused);
+        VERIFY_IS_TRUE(hidden.WaitForPaints(2, 1s));
+    }
+
+    TEST_METHOD(WaitForPaintCompletionDuringTeardown)
+    {
+        RenderScheduler scheduler{ 2 };
+        auto fake = std::make_unique<FakeRenderClient>(scheduler, PaintPriority::Focused);
+
+        fake->Hold();
+        fake->client->RequestPaint();
+        VERIFY_IS_TRUE(fake->WaitForPaintStarted(1s));
+
+        Log::Comment(L"A paint in progress makes a wait with a timeout fail...");
+        VERIFY_IS_FALSE(fake->client->WaitForPaintCompletion(20ms));
+
+        Log::Comment(L"...and a wait without one block until the paint has finished.");
+        std::thread releaser{ [&]() {
+            std::this_thread::sleep_for(50ms);
+            fake->Release();
+        } };
+        fake->client->SetEnabled(false);
+        VERIFY_IS_TRUE(fake->client->WaitForPaintCompletion(std::nullopt));
+        VERIFY_IS_FALSE(fake->IsPainting());
+        VERIFY_ARE_EQUAL(1u, fake->Paints());
+        releaser.join();
+
+        Log::Comment(L"Disabled clients aren't painted anymore.");
+        fake->client->RequestPaint();
+        std::this_thread::sleep_for(100ms);
+        VERIFY_ARE_EQUAL(1u, fake->Paints());
+        VERIFY_IS_TRUE(fake->client->WaitForPaintCompletion(0ms));
+
+        Log::Comment(L"Destroying a client waits for its paint to finish.");
+        // The request from while it was disabled is still pending, so enabling it starts a paint.
+        fake->Hold();
+        fake->client->SetEnabled(true);
+        VERIFY_IS_TRUE(fake->WaitForPaintStarted(1s));
+        std::atomic<bool> released{ false };
+        releaser = std::thread{ [&]() {
+            std::this_thread::sleep_for(50ms);
+            released.store(true);
+            fake->Release();
+        } };
+        fake->client.reset();
+        VERIFY_IS_TRUE(released.load());
+        VERIFY_ARE_EQUAL(2u, fake->Paints());
+        releaser.join();
+    }
+};
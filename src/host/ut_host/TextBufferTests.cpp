@@ -16,14 +16,60 @@
 
 #include "../interactivity/inc/ServiceLocator.hpp"
 #include "../renderer/inc/DummyRenderer.hpp"
+#include "../renderer/inc/RenderEngineBase.hpp"
 
 using namespace Microsoft::Console::Types;
 using namespace Microsoft::Console::Interactivity;
+using namespace Microsoft::Console::Render;
 using namespace Microsoft::Console::VirtualTerminal;
 using namespace WEX::Common;
 using namespace WEX::Logging;
 using namespace WEX::TestExecution;
 
+namespace
+{
+    // Records the rectangles that the renderer invalidates.
+    class MockInvalidateRenderEngine final : public RenderEngineBase
+    {
+    public:
+        std::vector<til::rect> invalidated;
+
+        HRESULT StartPaint() noexcept { return S_OK; }
+        HRESULT EndPaint() noexcept { return S_OK; }
+        HRESULT Present() noexcept { return S_OK; }
+        HRESULT PrepareForTeardown(_Out_ bool* /*pForcePaint*/) noexcept { return S_OK; }
+        HRESULT ScrollFrame() noexcept { return S_OK; }
+        HRESULT Invalidate(const til::rect* psrRegion) noexcept
+        try
+        {
+            invalidated.emplace_back(*psrRegion);
+            return S_OK;
+        }
+        CATCH_RETURN();
+        HRESULT InvalidateCursor(const til::rect* /*psrRegion*/) noexcept { return S_OK; }
+        HRESULT InvalidateSystem(const til::rect* /*prcDirtyClient*/) noexcept { return S_OK; }
+        HRESULT InvalidateSelection(const std::vector<til::rect>& /*rectangles*/) noexcept { return S_OK; }
+        HRESULT InvalidateScroll(const til::point* /*pcoordDelta*/) noexcept { return S_OK; }
+        HRESULT InvalidateAll() noexcept { return S_OK; }
+        HRESULT PaintBackground() noexcept { return S_OK; }
+        HRESULT PaintBufferLine(gsl::span<const Cluster> /*clusters*/, til::point /*coord*/, bool /*fTrimLeft*/, bool /*lineWrapped*/) noexcept { return S_OK; }
+        HRESULT PaintBufferGridLines(GridLineSet /*lines*/, COLORREF /*color*/, size_t /*cchLine*/, til::point /*coordTarget*/) noexcept { return S_OK; }
+        HRESULT PaintSelection(const til::rect& /*rect*/) noexcept { return S_OK; }
+        HRESULT PaintCursor(const CursorOptions& /*options*/) noexcept { return S_OK; }
+        HRESULT UpdateDrawingBrushes(const TextAttribute& /*textAttributes*/, const RenderSettings& /*renderSettings*/, gsl::not_null<IRenderData*> /*pData*/, bool /*usingSoftFont*/, bool /*isSettingDefaultBrushes*/) noexcept { return S_OK; }
+        HRESULT UpdateFont(const FontInfoDesired& /*FontInfoDesired*/, _Out_ FontInfo& /*FontInfo*/) noexcept { return S_OK; }
+        HRESULT UpdateDpi(int /*iDpi*/) noexcept { return S_OK; }
+        HRESULT UpdateViewport(const til::inclusive_rect& /*srNewViewport*/) noexcept { return S_OK; }
+        HRESULT GetProposedFont(const FontInfoDesired& /*FontInfoDesired*/, _Out_ FontInfo& /*FontInfo*/, int /*iDpi*/) noexcept { return S_OK; }
+        HRESULT GetDirtyArea(gsl::span<const til::rect>& /*area*/) noexcept { return S_OK; }
+        HRESULT GetFontSize(_Out_ til::size* /*pFontSize*/) noexcept { return S_OK; }
+        HRESULT IsGlyphWideByFont(std::wstring_view /*glyph*/, _Out_ bool* /*pResult*/) noexcept { return S_OK; }
+
+    protected:
+        HRESULT _DoUpdateTitle(const std::wstring_view /*newTitle*/) noexcept { return S_OK; }
+    };
+}
+
 class TextBufferTests
 {
     DummyRenderer _renderer;
@@ -140,6 +186,8 @@ class TextBufferTests
 
     TEST_METHOD(ResizeTraditionalRotationPreservesHighUnicode);
     TEST_METHOD(ScrollBufferRotationPreservesHighUnicode);
+    TEST_METHOD(CopyRectangle);
+    TEST_METHOD(CopyRectangleSplitsWideGlyphs);
 
     TEST_METHOD(ResizeTraditionalHighUnicodeRowRemoval);
     TEST_METHOD(ResizeTraditionalHighUnicodeColumnRemoval);
@@ -155,9 +203,14 @@ class TextBufferTests
 
     TEST_METHOD(GetTextRects);
     TEST_METHOD(GetText);
+    TEST_METHOD(GetTextColorRuns);
 
     TEST_METHOD(HyperlinkTrim);
     TEST_METHOD(NoHyperlinkTrim);
+
+    TEST_METHOD(GetMemoryStats);
+
+    TEST_METHOD(WriteIfChangedSkipsUnchangedCells);
 };
 
 void TextBufferTests::TestBufferCreate()
@@ -1923,6 +1976,77 @@ void TextBufferTests::ScrollBufferRotationPreservesHighUnicode()
     VERIFY_ARE_EQUAL(String(fire), String(shouldBeFireText.data(), gsl::narrow<int>(shouldBeFireText.size())));
 }
 
+void TextBufferTests::CopyRectangle()
+{
+    const auto white = RGB(0xff, 0xff, 0xff);
+    const auto black = RGB(0x00, 0x00, 0x00);
+    const auto red = RGB(0xff, 0x00, 0x00);
+
+    const til::size bufferSize{ 10, 4 };
+    const UINT cursorSize = 12;
+    const TextAttribute plain{ white, black };
+    const TextAttribute redAttr{ red, black };
+    TextBuffer buffer{ bufferSize, plain, cursorSize, false, _renderer };
+
+    buffer.Write(OutputCellIterator{ L"abcdefghij", plain }, { 0, 0 }, false);
+    buffer.Write(OutputCellIterator{ L"cd", redAttr }, { 2, 0 }, false);
+    buffer.Write(OutputCellIterator{ L"0123456789", plain }, { 0, 1 }, false);
+    buffer.Write(OutputCellIterator{ L"ABCDEFGHIJ", plain }, { 0, 2 }, false);
+
+    Log::Comment(L"Overlapping spans within the same row are moved like memmove() would.");
+    buffer.CopyRectangle(Viewport::FromDimensions({ 0, 0 }, { 4, 1 }), { 2, 0 });
+    VERIFY_ARE_EQUAL(L"ababcdghij", buffer.GetRowByOffset(0).GetText());
+    VERIFY_ARE_EQUAL(plain, buffer.GetRowByOffset(0).GetAttrRow().GetAttrByColumn(2));
+    VERIFY_ARE_EQUAL(plain, buffer.GetRowByOffset(0).GetAttrRow().GetAttrByColumn(3));
+    VERIFY_ARE_EQUAL(redAttr, buffer.GetRowByOffset(0).GetAttrRow().GetAttrByColumn(4));
+    VERIFY_ARE_EQUAL(redAttr, buffer.GetRowByOffset(0).GetAttrRow().GetAttrByColumn(5));
+    VERIFY_ARE_EQUAL(plain, buffer.GetRowByOffset(0).GetAttrRow().GetAttrByColumn(6));
+
+    Log::Comment(L"When moving down, rows are copied bottom to top, so that the source isn't overwritten.");
+    buffer.CopyRectangle(Viewport::FromDimensions({ 0, 1 }, { 3, 2 }), { 1, 2 });
+    VERIFY_ARE_EQUAL(L"0123456789", buffer.GetRowByOffset(1).GetText());
+    VERIFY_ARE_EQUAL(L"A012EFGHIJ", buffer.GetRowByOffset(2).GetText());
+    VERIFY_ARE_EQUAL(L" ABC      ", buffer.GetRowByOffset(3).GetText());
+
+    Log::Comment(L"When moving up, rows are copied top to bottom.");
+    buffer.CopyRectangle(Viewport::FromDimensions({ 1, 2 }, { 3, 2 }), { 1, 1 });
+    VERIFY_ARE_EQUAL(L"0012456789", buffer.GetRowByOffset(1).GetText());
+    VERIFY_ARE_EQUAL(L"AABCEFGHIJ", buffer.GetRowByOffset(2).GetText());
+}
+
+void TextBufferTests::CopyRectangleSplitsWideGlyphs()
+{
+    const til::size bufferSize{ 10, 3 };
+    const UINT cursorSize = 12;
+    const TextAttribute attr{ 0x7f };
+    TextBuffer buffer{ bufferSize, attr, cursorSize, false, _renderer };
+
+    // "a", a wide CJK character, the fire emoji (stored in the UnicodeStorage) and "b".
+    const auto fire = L"\xD83D\xDD25";
+    buffer.Write(OutputCellIterator{ L"a\x4E16\xD83D\xDD25"
+                                     L"b" },
+                 { 0, 0 },
+                 false);
+    buffer.Write(OutputCellIterator{ L"\x4E16\x4E16" }, { 0, 1 }, false);
+
+    Log::Comment(L"The trailing half of the CJK character is copied without its leading half and becomes a space.");
+    buffer.CopyRectangle(Viewport::FromDimensions({ 2, 0 }, { 3, 1 }), { 0, 2 });
+    const auto& row = buffer.GetRowByOffset(2);
+    VERIFY_IS_TRUE(row.GetCharRow().DbcsAttrAt(0).IsSingle());
+
+    Log::Comment(L"The emoji is stored at its new position.");
+    VERIFY_IS_TRUE(row.GetCharRow().DbcsAttrAt(1).IsLeading());
+    VERIFY_IS_TRUE(row.GetCharRow().DbcsAttrAt(2).IsTrailing());
+    const auto text = *buffer.GetTextDataAt({ 1, 2 });
+    VERIFY_ARE_EQUAL(String(fire), String(text.data(), gsl::narrow<int>(text.size())));
+    VERIFY_ARE_EQUAL(L" " + std::wstring{ fire } + L"       ", row.GetText());
+
+    Log::Comment(L"Overwriting the trailing half of a wide character clears its leading half.");
+    buffer.CopyRectangle(Viewport::FromDimensions({ 0, 0 }, { 1, 1 }), { 1, 1 });
+    VERIFY_ARE_EQUAL(L" a\x4E16      ", buffer.GetRowByOffset(1).GetText());
+    VERIFY_IS_TRUE(buffer.GetRowByOffset(1).GetCharRow().DbcsAttrAt(0).IsSingle());
+}
+
 // This tests that rows removed from the buffer while resizing traditionally will also drop the high unicode
 // characters from the Unicode Storage buffer
 void TextBufferTests::ResizeTraditionalHighUnicodeRowRemoval()
@@ -2624,6 +2748,67 @@ void TextBufferTests::GetText()
     }
 }
 
+void TextBufferTests::GetTextColorRuns()
+{
+    const auto white = RGB(0xff, 0xff, 0xff);
+    const auto black = RGB(0x00, 0x00, 0x00);
+    const auto red = RGB(0xff, 0x00, 0x00);
+    const auto green = RGB(0x00, 0xff, 0x00);
+
+    til::size bufferSize{ 10, 3 };
+    UINT cursorSize = 12;
+    const TextAttribute plain{ white, black };
+    TextBuffer buffer{ bufferSize, plain, cursorSize, false, _renderer };
+
+    // Row 0: "ab" in red, "cd" in green, followed by plain spaces.
+    // Row 1: "e" in plain, "fg" in red.
+    buffer.Write(OutputCellIterator{ plain, 10 }, { 0, 0 }, false);
+    buffer.Write(OutputCellIterator{ plain, 10 }, { 0, 1 }, false);
+    buffer.Write(OutputCellIterator{ L"ab", TextAttribute{ red, black } }, { 0, 0 }, false);
+    buffer.Write(OutputCellIterator{ L"cd", TextAttribute{ green, black } }, { 2, 0 }, false);
+    buffer.Write(OutputCellIterator{ L"e", plain }, { 0, 1 }, false);
+    buffer.Write(OutputCellIterator{ L"fg", TextAttribute{ red, black } }, { 1, 1 }, false);
+
+    const auto getColors = [](const TextAttribute& attr) {
+        return std::pair{ attr.GetForeground().GetRGB(), attr.GetBackground().GetRGB() };
+    };
+
+    const auto textRects = buffer.GetTextRects({ 0, 0 }, { 9, 1 }, false, false);
+    const auto data = buffer.GetText(true, true, textRects, getColors);
+
+    VERIFY_ARE_EQUAL(2u, data.text.size());
+    VERIFY_ARE_EQUAL(L"abcd\r\n", data.text[0]);
+    VERIFY_ARE_EQUAL(L"efg", data.text[1]);
+    VERIFY_ARE_EQUAL(2u, data.colorRuns.size());
+
+    // The trailing spaces of row 0 were trimmed, which removes their run entirely.
+    const auto& row0 = data.colorRuns[0];
+    VERIFY_ARE_EQUAL(3u, row0.size());
+    VERIFY_ARE_EQUAL(red, row0[0].foreground);
+    VERIFY_ARE_EQUAL(2u, row0[0].length);
+    VERIFY_ARE_EQUAL(green, row0[1].foreground);
+    VERIFY_ARE_EQUAL(2u, row0[1].length);
+    VERIFY_ARE_EQUAL(black, row0[2].foreground);
+    VERIFY_ARE_EQUAL(black, row0[2].background);
+    VERIFY_ARE_EQUAL(2u, row0[2].length);
+
+    const auto& row1 = data.colorRuns[1];
+    VERIFY_ARE_EQUAL(2u, row1.size());
+    VERIFY_ARE_EQUAL(white, row1[0].foreground);
+    VERIFY_ARE_EQUAL(1u, row1[0].length);
+    VERIFY_ARE_EQUAL(red, row1[1].foreground);
+    VERIFY_ARE_EQUAL(2u, row1[1].length);
+
+    // Each run becomes exactly one span in the HTML output.
+    const auto html = TextBuffer::GenHTML(data, 12, L"Consolas", black);
+    const std::string_view expectedFragment = "<SPAN STYLE=\"color:#FF0000;background-color:#000000;\">ab</SPAN>"
+                                              "<SPAN STYLE=\"color:#00FF00;background-color:#000000;\">cd</SPAN>"
+                                              "<BR>"
+                                              "<SPAN STYLE=\"color:#FFFFFF;background-color:#000000;\">e</SPAN>"
+                                              "<SPAN STYLE=\"color:#FF0000;background-color:#000000;\">fg</SPAN>";
+    VERIFY_ARE_NOT_EQUAL(std::string::npos, html.find(expectedFragment));
+}
+
 // This tests that when we increment the circular buffer, obsolete hyperlink references
 // are removed from the hyperlink map
 void TextBufferTests::HyperlinkTrim()
@@ -2704,3 +2889,123 @@ void TextBufferTests::NoHyperlinkTrim()
     VERIFY_ARE_EQUAL(_buffer->GetHyperlinkUriFromId(id), url);
     VERIFY_ARE_EQUAL(_buffer->_hyperlinkCustomIdMap[finalCustomId], id);
 }
+
+void TextBufferTests::GetMemoryStats()
+{
+    const UINT cursorSize = 12;
+    const TextAttribute plain{ 0x7f };
+    const TextAttribute red{ 0x4f };
+
+    Log::Comment(L"Narrow rows with a single attribute don't allocate.");
+    TextBuffer narrow{ { 80, 10 }, plain, cursorSize, false, _renderer };
+    auto stats = narrow.GetMemoryStats();
+    VERIFY_IS_GREATER_THAN_OR_EQUAL(stats.rows, 10 * sizeof(ROW));
+    VERIFY_ARE_EQUAL(0u, stats.cells);
+    VERIFY_ARE_EQUAL(0u, stats.attributes);
+    VERIFY_ARE_EQUAL(sizeof(ROW), stats.largestRow);
+
+    Log::Comment(L"A second attribute in a row allocates its runs.");
+    narrow.Write(OutputCellIterator{ L"cd", red }, { 2, 3 }, false);
+    stats = narrow.GetMemoryStats();
+    VERIFY_IS_GREATER_THAN(stats.attributes, 0u);
+    VERIFY_ARE_EQUAL(sizeof(ROW) + stats.attributes, stats.largestRow);
+
+    Log::Comment(L"Hyperlinks are accounted for.");
+    const auto hyperlinksBefore = stats.hyperlinks;
+    const auto id = narrow.GetHyperlinkId(L"https://example.com/a/fairly/long/link/to/some/resource", L"");
+    narrow.AddHyperlinkToMap(L"https://example.com/a/fairly/long/link/to/some/resource", id);
+    stats = narrow.GetMemoryStats();
+    VERIFY_IS_GREATER_THAN(stats.hyperlinks, hyperlinksBefore);
+    VERIFY_ARE_EQUAL(stats.rows + stats.cells + stats.attributes + stats.attributeTable + stats.unicodeStorage + stats.hyperlinks + stats.patterns, stats.Total());
+
+    Log::Comment(L"Rows that are too wide to be stored inline allocate their cells.");
+    TextBuffer wide{ { 1000, 10 }, plain, cursorSize, false, _renderer };
+    stats = wide.GetMemoryStats();
+    VERIFY_IS_GREATER_THAN_OR_EQUAL(stats.cells, 10 * 1000 * sizeof(CharRow::value_type));
+    VERIFY_ARE_EQUAL(0u, stats.attributes);
+    VERIFY_ARE_EQUAL(sizeof(ROW) + stats.cells / 10, stats.largestRow);
+}
+
+void TextBufferTests::WriteIfChangedSkipsUnchangedCells()
+{
+    // Renderer::TriggerRedraw() clips and translates the rectangles by the active screen buffer's viewport.
+    auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+    VERIFY_SUCCEEDED(gci.GetActiveOutputBuffer().SetViewportOrigin(true, { 0, 0 }, true));
+
+    MockInvalidateRenderEngine engine;
+    DummyRenderer renderer{ &gci.renderData };
+    renderer.AddRenderEngine(&engine);
+    renderer.EnablePainting();
+
+    TextBuffer buffer{ { 10, 3 }, TextAttribute{ 0x07 }, 12, true, renderer };
+    const auto verifyInvalidated = [&](const std::vector<til::rect>& expected) {
+        VERIFY_ARE_EQUAL(expected.size(), engine.invalidated.size());
+        for (size_t i = 0; i < expected.size(); ++i)
+        {
+            VERIFY_ARE_EQUAL(expected[i], engine.invalidated[i]);
+        }
+        engine.invalidated.clear();
+    };
+
+    std::vector<CHAR_INFO> cells(10, CHAR_INFO{ { L'a' }, 0x07 });
+    const auto write = [&](const til::CoordType y) {
+        buffer.WriteIfChanged(OutputCellIterator{ gsl::span<const CHAR_INFO>{ cells } }, { 0, y });
+    };
+
+    write(0);
+    VERIFY_IS_TRUE(buffer.GetRowByOffset(0).WasWrapForced());
+    verifyInvalidated({ til::rect{ 0, 0, 10, 1 } });
+
+    Log::Comment(L"Rewriting identical cells doesn't touch the row and invalidates nothing.");
+    buffer.GetRowByOffset(0).SetWrapForced(false);
+    write(0);
+    VERIFY_IS_TRUE(buffer.GetRowByOffset(0).WasWrapForced());
+    const auto revision = buffer.GetRowByOffset(0).GetRevision();
+    write(0);
+    VERIFY_ARE_EQUAL(revision, buffer.GetRowByOffset(0).GetRevision());
+    verifyInvalidated({});
+
+    Log::Comment(L"Changed glyphs and attributes are written.");
+    cells[2].Char.UnicodeChar = L'b';
+    cells[6].Attributes = 0x4f;
+    write(0);
+    VERIFY_ARE_NOT_EQUAL(revision, buffer.GetRowByOffset(0).GetRevision());
+    verifyInvalidated({ til::rect{ 2, 0, 3, 1 }, til::rect{ 6, 0, 7, 1 } });
+    {
+        auto iter = buffer.GetCellDataAt({ 0, 0 });
+        for (til::CoordType x = 0; x < 10; ++x, ++iter)
+        {
+            VERIFY_ARE_EQUAL(x == 2 ? L"b" : L"a", iter->Chars());
+            VERIFY_ARE_EQUAL(TextAttribute{ gsl::narrow_cast<WORD>(x == 6 ? 0x4f : 0x07) }, iter->TextAttr());
+        }
+    }
+
+    Log::Comment(L"Wide glyphs are written and invalidated with both of their halves.");
+    write(1);
+    verifyInvalidated({ til::rect{ 0, 1, 10, 2 } });
+    cells[4] = CHAR_INFO{ { L'\x3042' }, 0x07 | COMMON_LVB_LEADING_BYTE };
+    cells[5] = CHAR_INFO{ { L'\x3042' }, 0x07 | COMMON_LVB_TRAILING_BYTE };
+    write(1);
+    verifyInvalidated({ til::rect{ 4, 1, 6, 2 } });
+    {
+        auto iter = buffer.GetCellDataAt({ 4, 1 });
+        VERIFY_ARE_EQUAL(L"\x3042", iter->Chars());
+        VERIFY_IS_TRUE(iter->DbcsAttr().IsLeading());
+        ++iter;
+        VERIFY_ARE_EQUAL(L"\x3042", iter->Chars());
+        VERIFY_IS_TRUE(iter->DbcsAttr().IsTrailing());
+    }
+
+    Log::Comment(L"A change to only the trailing half still invalidates the whole glyph.");
+    cells[5].Attributes = 0x4f | COMMON_LVB_TRAILING_BYTE;
+    write(1);
+    verifyInvalidated({ til::rect{ 4, 1, 6, 2 } });
+    VERIFY_ARE_EQUAL(TextAttribute{ 0x4f }, buffer.GetCellDataAt({ 5, 1 })->TextAttr());
+
+    Log::Comment(L"A leading half in the last column is padded out like Write() does.");
+    cells[8] = CHAR_INFO{ { L'\x3042' }, 0x07 | COMMON_LVB_LEADING_BYTE };
+    cells[9] = CHAR_INFO{ { L'\x3042' }, 0x07 | COMMON_LVB_TRAILING_BYTE };
+    buffer.WriteIfChanged(OutputCellIterator{ gsl::span<const CHAR_INFO>{ cells } }, { 1, 2 }, false);
+    VERIFY_IS_TRUE(buffer.GetRowByOffset(2).WasDoubleBytePadded());
+    VERIFY_ARE_EQUAL(L" ", buffer.GetCellDataAt({ 9, 2 })->Chars());
+}
@@ -5,12 +5,15 @@
 #include <wextestclass.h>
 #include "../../inc/consoletaeftemplates.hpp"
 #include "../../types/inc/Viewport.hpp"
+#include "../../types/UiaTextSnapshot.hpp"
 
 #include "../../renderer/vt/Xterm256Engine.hpp"
 #include "../../renderer/vt/XtermEngine.hpp"
 #include "../../renderer/base/Renderer.hpp"
 #include "../Settings.hpp"
+#include "../VtApiRoutines.h"
 #include "../VtIo.hpp"
+#include "CommonState.hpp"
 
 #if TIL_FEATURE_CONHOSTDXENGINE_ENABLED
 #include "../../renderer/dx/DxRenderer.hpp"
@@ -43,6 +46,8 @@ class Microsoft::Console::VirtualTerminal::VtIoTests
 #endif
 
     TEST_METHOD(BasicAnonymousPipeOpeningWithSignalChannelTest);
+
+    TEST_METHOD(PassthroughEchoIsNotHeldBack);
 };
 
 using namespace Microsoft::Console;
@@ -382,6 +387,11 @@ public:
         return true;
     }
 
+    UiaTextSnapshotCache& GetUiaTextSnapshotCache() noexcept override
+    {
+        return _uiaTextSnapshotCache;
+    }
+
     const std::wstring GetHyperlinkUri(uint16_t /*id*/) const noexcept
     {
         return {};
@@ -396,6 +406,9 @@ public:
     {
         return {};
     }
+
+private:
+    UiaTextSnapshotCache _uiaTextSnapshotCache;
 };
 
 void VtIoTests::RendererDtorAndThread()
@@ -482,3 +495,82 @@ void VtIoTests::BasicAnonymousPipeOpeningWithSignalChannelTest()
     VERIFY_IS_TRUE(vtio.IsUsingVt());
     VERIFY_ARE_NOT_EQUAL(nullptr, vtio._pPtySignalInputThread);
 }
+
+void VtIoTests::PassthroughEchoIsNotHeldBack()
+{
+    Log::Comment(L"An echo that takes several API calls must reach the terminal right after the coalescing window, "
+                 L"not on the next tick of the system timer.");
+
+    CommonState state;
+    state.PrepareGlobalFont();
+    state.PrepareGlobalScreenBuffer();
+    auto cleanup = wil::scope_exit([&] {
+        state.CleanupGlobalScreenBuffer();
+        state.CleanupGlobalFont();
+    });
+
+    auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+    const auto previousOutputCP = gci.OutputCP;
+    gci.OutputCP = CP_UTF8;
+    auto restoreOutputCP = wil::scope_exit([&] { gci.OutputCP = previousOutputCP; });
+
+    wil::unique_handle readSide;
+    wil::unique_handle writeSide;
+    VERIFY_WIN32_BOOL_SUCCEEDED(CreatePipe(&readSide, &writeSide, nullptr, 64 * 1024));
+
+    Xterm256Engine engine{ wil::unique_hfile{ writeSide.release() }, SetUpViewport() };
+    VtApiRoutines routines;
+    routines.m_pVtEngine = &engine;
+
+    auto& screenInfo = gci.GetActiveOutputBuffer();
+    std::unique_ptr<IWaitRoutine> waiter;
+    size_t read = 0;
+
+    std::vector<std::chrono::steady_clock::duration> latencies;
+    for (til::CoordType i = 0; i < 10; ++i)
+    {
+        // Give the previous coalescing window time to close, like a user would between key presses.
+        Sleep(50);
+
+        // The echo of a key press in a shell that moves the cursor by itself: the leading write
+        // opens a coalescing window and the calls that follow are buffered until it ends.
+        gci.LockConsole();
+        VERIFY_SUCCEEDED(routines.WriteConsoleAImpl(screenInfo, "a", read, false, waiter));
+        VERIFY_SUCCEEDED(routines.SetConsoleCursorPositionImpl(screenInfo, { i + 1, 0 }));
+        VERIFY_SUCCEEDED(routines.WriteConsoleAImpl(screenInfo, "b", read, false, waiter));
+        gci.UnlockConsole();
+        const auto written = std::chrono::steady_clock::now();
+
+        // Poll instead of blocking in ReadFile, so that a regression fails instead of hanging.
+        std::string received;
+        for (;;)
+        {
+            DWORD available = 0;
+            THROW_IF_WIN32_BOOL_FALSE(PeekNamedPipe(readSide.get(), nullptr, 0, nullptr, &available, nullptr));
+            if (available)
+            {
+                std::string chunk(available, '\0');
+                THROW_IF_WIN32_BOOL_FALSE(ReadFile(readSide.get(), chunk.data(), available, &available, nullptr));
+                received.append(chunk, 0, available);
+                if (received.back() == 'b')
+                {
+                    break;
+                }
+            }
+            if (std::chrono::steady_clock::now() - written > std::chrono::seconds{ 1 })
+            {
+                VERIFY_FAIL(L"The echo didn't arrive within a second.");
+                return;
+            }
+            SwitchToThread();
+        }
+        latencies.emplace_back(std::chrono::steady_clock::now() - written);
+    }
+
+    // The median is robust against a test machine that is busy for a moment. With a window of
+    // 1ms it's well below the ~16ms that a window stretched to the system timer's tick takes.
+    std::sort(latencies.begin(), latencies.end());
+    const auto median = std::chrono::duration_cast<std::chrono::microseconds>(latencies[latencies.size() / 2]);
+    Log::Comment(NoThrowString().Format(L"Median echo latency: %lldus", median.count()));
+    VERIFY_IS_LESS_THAN(median.count(), 5000ll);
+}
@@ -270,9 +270,9 @@ void VtRendererTest::Xterm256TestInvalidate()
         invalid = view.ToExclusive();
         invalid.Bottom = 3;
 
-        // we should have 3 runs and build a rectangle out of them
+        // the 3 full lines are merged into a single run
         const auto runs = engine->_invalidMap.runs();
-        VERIFY_ARE_EQUAL(3u, runs.size());
+        VERIFY_ARE_EQUAL(1u, runs.size());
         auto invalidRect = runs.front();
         for (size_t i = 1; i < runs.size(); ++i)
         {
@@ -311,9 +311,9 @@ void VtRendererTest::Xterm256TestInvalidate()
         invalid = view.ToExclusive();
         invalid.Top = invalid.Bottom - 3;
 
-        // we should have 3 runs and build a rectangle out of them
+        // the 3 full lines are merged into a single run
         const auto runs = engine->_invalidMap.runs();
-        VERIFY_ARE_EQUAL(3u, runs.size());
+        VERIFY_ARE_EQUAL(1u, runs.size());
         auto invalidRect = runs.front();
         for (size_t i = 1; i < runs.size(); ++i)
         {
@@ -341,9 +341,9 @@ void VtRendererTest::Xterm256TestInvalidate()
         invalid = view.ToExclusive();
         invalid.Bottom = 3;
 
-        // we should have 3 runs and build a rectangle out of them
+        // the 3 full lines are merged into a single run
         const auto runs = engine->_invalidMap.runs();
-        VERIFY_ARE_EQUAL(3u, runs.size());
+        VERIFY_ARE_EQUAL(1u, runs.size());
         auto invalidRect = runs.front();
         for (size_t i = 1; i < runs.size(); ++i)
         {
@@ -944,9 +944,9 @@ void VtRendererTest::XtermTestInvalidate()
         invalid = view.ToExclusive();
         invalid.Bottom = 3;
 
-        // we should have 3 runs and build a rectangle out of them
+        // the 3 full lines are merged into a single run
         const auto runs = engine->_invalidMap.runs();
-        VERIFY_ARE_EQUAL(3u, runs.size());
+        VERIFY_ARE_EQUAL(1u, runs.size());
         auto invalidRect = runs.front();
         for (size_t i = 1; i < runs.size(); ++i)
         {
@@ -985,9 +985,9 @@ void VtRendererTest::XtermTestInvalidate()
         invalid = view.ToExclusive();
         invalid.Top = invalid.Bottom - 3;
 
-        // we should have 3 runs and build a rectangle out of them
+        // the 3 full lines are merged into a single run
         const auto runs = engine->_invalidMap.runs();
-        VERIFY_ARE_EQUAL(3u, runs.size());
+        VERIFY_ARE_EQUAL(1u, runs.size());
         auto invalidRect = runs.front();
         for (size_t i = 1; i < runs.size(); ++i)
         {
@@ -1015,9 +1015,9 @@ void VtRendererTest::XtermTestInvalidate()
         invalid = view.ToExclusive();
         invalid.Bottom = 3;
 
-        // we should have 3 runs and build a rectangle out of them
+        // the 3 full lines are merged into a single run
         const auto runs = engine->_invalidMap.runs();
-        VERIFY_ARE_EQUAL(3u, runs.size());
+        VERIFY_ARE_EQUAL(1u, runs.size());
         auto invalidRect = runs.front();
         for (size_t i = 1; i < runs.size(); ++i)
         {
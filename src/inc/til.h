@@ -8,6 +8,7 @@
 #include "til/at.h"
 #include "til/bitmap.h"
 #include "til/coalesce.h"
+#include "til/dirty_region.h"
 #include "til/color.h"
 #include "til/enumset.h"
 #include "til/pmr.h"
@@ -0,0 +1,496 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#pragma once
+
+#include "at.h"
+#include "rect.h"
+
+#ifdef UNIT_TESTING
+class DirtyRegionTests;
+#endif
+
+namespace til // Terminal Implementation Library. Also: "Today I Learned"
+{
+    // dirty_region tracks the invalidated cells of a grid as a list of merged
+    // [begin, end) column spans per row. Compared to til::bitmap it:
+    // * invalidates full rows in O(1) and arbitrary spans in O(spans of that row)
+    // * scrolls vertically in O(rows) by rotating a ring offset instead of shifting bits
+    // * keeps the rectangles returned by runs() in a buffer that's reused across frames
+    class dirty_region
+    {
+    public:
+        using const_iterator = const til::rect*;
+
+        dirty_region() = default;
+
+        explicit dirty_region(til::size sz, bool fill = false) :
+            _sz{ sz },
+            _rows(_rowCount(sz))
+        {
+            if (fill)
+            {
+                set_all();
+            }
+        }
+
+        bool operator==(const dirty_region& other) const noexcept
+        {
+            if (_sz != other._sz)
+            {
+                return false;
+            }
+
+            for (CoordType y = 0; y < _sz.height; ++y)
+            {
+                const auto& a = _row(y);
+                const auto& b = other._row(y);
+                if (!std::equal(a.begin(), a.end(), b.begin(), b.end()))
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        bool operator!=(const dirty_region& other) const noexcept
+        {
+            return !(*this == other);
+        }
+
+        const_iterator begin() const
+        {
+            return runs().data();
+        }
+
+        const_iterator end() const
+        {
+            const auto r = runs();
+            return r.data() + r.size();
+        }
+
+        // Returns the dirty area as a list of rectangles in row-major order.
+        // Consecutive rows consisting of the same, single span are merged into one
+        // rectangle. Rows with multiple spans are returned as one rectangle per span,
+        // which preserves the painting order of the rows relative to each other.
+        gsl::span<const til::rect> runs() const
+        {
+            if (!_runsValid)
+            {
+                _buildRuns();
+            }
+            return _runs;
+        }
+
+        void translate(const til::point delta, bool fill = false)
+        {
+            if (delta.x != 0)
+            {
+                _translate_x(delta.x, fill);
+            }
+            if (delta.y != 0)
+            {
+                _translate_y(delta.y, fill);
+            }
+        }
+
+        void set(const til::point pt)
+        {
+            THROW_HR_IF(E_INVALIDARG, !til::rect{ _sz }.contains(pt));
+            _set(pt.y, pt.x, pt.x + 1);
+        }
+
+        void set(const til::rect& rc)
+        {
+            THROW_HR_IF(E_INVALIDARG, !til::rect{ _sz }.contains(rc));
+            if (rc.empty())
+            {
+                return;
+            }
+
+            for (auto y = rc.top; y < rc.bottom; ++y)
+            {
+                _set(y, rc.left, rc.right);
+            }
+        }
+
+        void set_all() noexcept
+        {
+            for (auto& row : _rows)
+            {
+                _fillRow(row);
+            }
+        }
+
+        void reset_all() noexcept
+        {
+            if (_cells == 0)
+            {
+                return;
+            }
+
+            for (auto& row : _rows)
+            {
+                row.clear();
+            }
+            _cells = 0;
+            _runsValid = false;
+        }
+
+        // True if we resized. False if it was the same size as before.
+        // Set fill if you want the new region (on growing) to be marked dirty.
+        bool resize(til::size size, bool fill = false)
+        {
+            if (_sz == size)
+            {
+                return false;
+            }
+
+            dirty_region newRegion{ size };
+            const til::rect newRect{ size };
+
+            for (CoordType y = 0; y < std::min(_sz.height, size.height); ++y)
+            {
+                for (const auto& s : _row(y))
+                {
+                    const auto begin = std::min(s.begin, size.width);
+                    const auto end = std::min(s.end, size.width);
+                    if (begin < end)
+                    {
+                        newRegion._set(y, begin, end);
+                    }
+                }
+            }
+
+            if (fill)
+            {
+                for (const auto& area : newRect - til::rect{ _sz })
+                {
+                    newRegion.set(area);
+                }
+            }
+
+            *this = std::move(newRegion);
+            return true;
+        }
+
+        constexpr bool one() const noexcept
+        {
+            return _cells == 1;
+        }
+
+        constexpr bool any() const noexcept
+        {
+            return !none();
+        }
+
+        constexpr bool none() const noexcept
+        {
+            return _cells == 0;
+        }
+
+        constexpr bool all() const noexcept
+        {
+            return _cells == _area();
+        }
+
+        constexpr til::size size() const noexcept
+        {
+            return _sz;
+        }
+
+        std::wstring to_string() const
+        {
+            std::wstringstream wss;
+            wss << std::endl
+                << L"Dirty region of size " << _sz.to_string() << " contains the following dirty regions:" << std::endl;
+            wss << L"Runs:" << std::endl;
+
+            for (auto& item : runs())
+            {
+                wss << L"\t- " << item.to_string() << std::endl;
+            }
+
+            return wss.str();
+        }
+
+    private:
+        struct span
+        {
+            CoordType begin;
+            CoordType end;
+
+            constexpr bool operator==(const span& other) const noexcept
+            {
+                return begin == other.begin && end == other.end;
+            }
+        };
+
+        // Almost all rows are either clean, fully dirty or have a single dirty span.
+        using row = boost::container::small_vector<span, 2>;
+
+        static constexpr size_t _rowCount(til::size sz) noexcept
+        {
+            return gsl::narrow_cast<size_t>(std::max(0, sz.height));
+        }
+
+        constexpr size_t _area() const noexcept
+        {
+            return gsl::narrow_cast<size_t>(std::max(0, _sz.width)) * _rowCount(_sz);
+        }
+
+        // Maps a logical row index to the physical one in the ring of _rows.
+        size_t _physical(CoordType y) const noexcept
+        {
+            const auto i = _offset + gsl::narrow_cast<size_t>(y);
+            return i >= _rows.size() ? i - _rows.size() : i;
+        }
+
+        row& _row(CoordType y) noexcept
+        {
+            return til::at(_rows, _physical(y));
+        }
+
+        const row& _row(CoordType y) const noexcept
+        {
+            return til::at(_rows, _physical(y));
+        }
+
+        static size_t _countCells(const row& r) noexcept
+        {
+            size_t count = 0;
+            for (const auto& s : r)
+            {
+                count += gsl::narrow_cast<size_t>(s.end - s.begin);
+            }
+            return count;
+        }
+
+        void _clearRow(row& r) noexcept
+        {
+            _cells -= _countCells(r);
+            r.clear();
+            _runsValid = false;
+        }
+
+        void _fillRow(row& r) noexcept
+        {
+            if (_sz.width <= 0)
+            {
+                return;
+            }
+
+            _cells -= _countCells(r);
+            r.clear();
+            // A cleared small_vector always has room for at least one element.
+            r.push_back({ 0, _sz.width });
+            _cells += gsl::narrow_cast<size_t>(_sz.width);
+            _runsValid = false;
+        }
+
+        // Marks [begin, end) of the given row as dirty, merging it with any overlapping or adjacent spans.
+        void _set(CoordType y, CoordType begin, CoordType end)
+        {
+            auto& r = _row(y);
+
+            if (begin == 0 && end == _sz.width)
+            {
+                _fillRow(r);
+                return;
+            }
+
+            // Find the first span that ends at or after our beginning. Anything before it is unaffected.
+            const auto first = std::lower_bound(r.begin(), r.end(), begin, [](const span& s, CoordType value) {
+                return s.end < value;
+            });
+
+            // Swallow all spans that start at or before our end.
+            auto last = first;
+            size_t swallowed = 0;
+            for (; last != r.end() && last->begin <= end; ++last)
+            {
+                begin = std::min(begin, last->begin);
+                end = std::max(end, last->end);
+                swallowed += gsl::narrow_cast<size_t>(last->end - last->begin);
+            }
+
+            _cells += gsl::narrow_cast<size_t>(end - begin) - swallowed;
+            _runsValid = false;
+
+            if (first == last)
+            {
+                r.insert(first, span{ begin, end });
+            }
+            else
+            {
+                *first = span{ begin, end };
+                r.erase(first + 1, last);
+            }
+        }
+
+        void _translate_y(CoordType dy, bool fill)
+        {
+            const auto height = _sz.height;
+            if (std::abs(dy) >= height)
+            {
+                if (fill)
+                {
+                    set_all();
+                }
+                else
+                {
+                    reset_all();
+                }
+                return;
+            }
+
+            // Moving all contents down by dy is the same as moving the ring's origin
+            // up by dy. The rows that wrapped around are the ones revealed by the scroll.
+            const auto n = _rows.size();
+            const auto shift = gsl::narrow_cast<size_t>(std::abs(dy));
+            _offset = dy > 0 ? (_offset + n - shift) % n : (_offset + shift) % n;
+
+            const auto revealedBegin = dy > 0 ? 0 : height + dy;
+            const auto revealedEnd = dy > 0 ? dy : height;
+            for (auto y = revealedBegin; y < revealedEnd; ++y)
+            {
+                auto& r = _row(y);
+                if (fill)
+                {
+                    _fillRow(r);
+                }
+                else
+                {
+                    _clearRow(r);
+                }
+            }
+
+            _runsValid = false;
+        }
+
+        void _translate_x(CoordType dx, bool fill)
+        {
+            const auto width = _sz.width;
+
+            for (auto& r : _rows)
+            {
+                const auto before = _countCells(r);
+
+                auto out = r.begin();
+                for (auto s : r)
+                {
+                    s.begin = std::clamp(s.begin + dx, 0, width);
+                    s.end = std::clamp(s.end + dx, 0, width);
+                    if (s.begin < s.end)
+                    {
+                        *out++ = s;
+                    }
+                }
+                r.erase(out, r.end());
+
+                _cells += _countCells(r);
+                _cells -= before;
+            }
+
+            if (fill)
+            {
+                const auto revealedBegin = dx > 0 ? 0 : std::max(0, width + dx);
+                const auto revealedEnd = dx > 0 ? std::min(dx, width) : width;
+                for (CoordType y = 0; y < _sz.height; ++y)
+                {
+                    _set(y, revealedBegin, revealedEnd);
+                }
+            }
+
+            _runsValid = false;
+        }
+
+        void _buildRuns() const
+        {
+            // clear() retains the capacity, so after the first few frames this doesn't allocate anymore.
+            _runs.clear();
+
+            // The index into _runs of the rectangle that can be extended
+            // downwards by the next row, if that row has the same single span.
+            auto extendable = std::numeric_limits<size_t>::max();
+
+            for (CoordType y = 0; y < _sz.height; ++y)
+            {
+                const auto& r = _row(y);
+
+                if (r.size() == 1 && extendable < _runs.size())
+                {
+                    auto& last = til::at(_runs, extendable);
+                    if (last.left == r.front().begin && last.right == r.front().end)
+                    {
+                        last.bottom = y + 1;
+                        continue;
+                    }
+                }
+
+                for (const auto& s : r)
+                {
+                    _runs.emplace_back(s.begin, y, s.end, y + 1);
+                }
+
+                extendable = r.size() == 1 ? _runs.size() - 1 : std::numeric_limits<size_t>::max();
+            }
+
+            _runsValid = true;
+        }
+
+        til::size _sz;
+        std::vector<row> _rows;
+        // The physical index of logical row 0 in _rows.
+        size_t _offset = 0;
+        // The total number of dirty cells.
+        size_t _cells = 0;
+
+        mutable std::vector<til::rect> _runs;
+        mutable bool _runsValid = false;
+
+#ifdef UNIT_TESTING
+        friend class ::DirtyRegionTests;
+#endif
+    };
+}
+
+#ifdef __WEX_COMMON_H__
+namespace WEX::TestExecution
+{
+    template<>
+    class VerifyOutputTraits<::til::dirty_region>
+    {
+    public:
+        static WEX::Common::NoThrowString ToString(const ::til::dirty_region& region)
+        {
+            return WEX::Common::NoThrowString(region.to_string().c_str());
+        }
+    };
+
+    template<>
+    class VerifyCompareTraits<::til::dirty_region, ::til::dirty_region>
+    {
+    public:
+        static bool AreEqual(const ::til::dirty_region& expected, const ::til::dirty_region& actual) noexcept
+        {
+            return expected == actual;
+        }
+
+        static bool AreSame(const ::til::dirty_region& expected, const ::til::dirty_region& actual) noexcept
+        {
+            return &expected == &actual;
+        }
+
+        static bool IsLessThan(const ::til::dirty_region& expectedLess, const ::til::dirty_region& expectedGreater) = delete;
+
+        static bool IsGreaterThan(const ::til::dirty_region& expectedGreater, const ::til::dirty_region& expectedLess) = delete;
+
+        static bool IsNull(const ::til::dirty_region& object) noexcept
+        {
+            return object == ::til::dirty_region{};
+        }
+    };
+};
+#endif
@@ -0,0 +1,102 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#pragma once
+
+namespace til // Terminal Implementation Library. Also: "Today I Learned"
+{
+    // heap_usage() estimates the number of bytes a value allocated on the heap, excluding its own sizeof().
+    // Allocator bookkeeping isn't observable and the node layout of std::unordered_map is modeled after
+    // MSVC's STL, so the results are approximations. They're meant to compare the memory usage of
+    // different parts of the application, not to account for every byte.
+    //
+    // All overloads are declared upfront, so that they can find each other for nested containers.
+    template<typename T>
+    constexpr size_t heap_usage(const T&) noexcept
+        requires std::is_trivially_copyable_v<T>;
+    template<typename T, typename Traits, typename Allocator>
+    size_t heap_usage(const std::basic_string<T, Traits, Allocator>& str) noexcept;
+    template<typename T>
+    size_t heap_usage(const std::optional<T>& opt) noexcept;
+    template<typename T, typename U>
+    size_t heap_usage(const std::pair<T, U>& pair) noexcept;
+    template<typename T, typename Allocator>
+    size_t heap_usage(const std::vector<T, Allocator>& vec) noexcept;
+    template<typename T, size_t N, typename Allocator, typename Options>
+    size_t heap_usage(const boost::container::small_vector<T, N, Allocator, Options>& vec) noexcept;
+    template<typename K, typename V, typename Hash, typename Eq, typename Allocator>
+    size_t heap_usage(const std::unordered_map<K, V, Hash, Eq, Allocator>& map) noexcept;
+
+    template<typename T>
+    constexpr size_t heap_usage(const T&) noexcept
+        requires std::is_trivially_copyable_v<T>
+    {
+        return 0;
+    }
+
+    template<typename T, typename Traits, typename Allocator>
+    size_t heap_usage(const std::basic_string<T, Traits, Allocator>& str) noexcept
+    {
+        // Strings that fit into the small string buffer don't allocate.
+        const auto inlineCapacity = std::basic_string<T, Traits, Allocator>{}.capacity();
+        return str.capacity() > inlineCapacity ? (str.capacity() + 1) * sizeof(T) : 0;
+    }
+
+    template<typename T>
+    size_t heap_usage(const std::optional<T>& opt) noexcept
+    {
+        return opt ? heap_usage(*opt) : 0;
+    }
+
+    template<typename T, typename U>
+    size_t heap_usage(const std::pair<T, U>& pair) noexcept
+    {
+        return heap_usage(pair.first) + heap_usage(pair.second);
+    }
+
+    template<typename T, typename Allocator>
+    size_t heap_usage(const std::vector<T, Allocator>& vec) noexcept
+    {
+        auto bytes = vec.capacity() * sizeof(T);
+        if constexpr (!std::is_trivially_copyable_v<T>)
+        {
+            for (const auto& v : vec)
+            {
+                bytes += heap_usage(v);
+            }
+        }
+        return bytes;
+    }
+
+    template<typename T, size_t N, typename Allocator, typename Options>
+    size_t heap_usage(const boost::container::small_vector<T, N, Allocator, Options>& vec) noexcept
+    {
+        // The elements are stored inline until the vector grows beyond its static capacity.
+        auto bytes = vec.capacity() > N ? vec.capacity() * sizeof(T) : 0;
+        if constexpr (!std::is_trivially_copyable_v<T>)
+        {
+            for (const auto& v : vec)
+            {
+                bytes += heap_usage(v);
+            }
+        }
+        return bytes;
+    }
+
+    template<typename K, typename V, typename Hash, typename Eq, typename Allocator>
+    size_t heap_usage(const std::unordered_map<K, V, Hash, Eq, Allocator>& map) noexcept
+    {
+        // Each bucket stores the first and last node of its range and each
+        // element is stored in a node of a doubly linked list.
+        using value_type = typename std::unordered_map<K, V, Hash, Eq, Allocator>::value_type;
+        auto bytes = map.bucket_count() * 2 * sizeof(void*) + map.size() * (sizeof(value_type) + 2 * sizeof(void*));
+        if constexpr (!std::is_trivially_copyable_v<K> || !std::is_trivially_copyable_v<V>)
+        {
+            for (const auto& [key, value] : map)
+            {
+                bytes += heap_usage(key) + heap_usage(value);
+            }
+        }
+        return bytes;
+    }
+}
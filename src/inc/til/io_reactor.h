@@ -0,0 +1,401 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#pragma once
+
+#include <condition_variable>
+
+namespace til // Terminal Implementation Library. Also: "Today I Learned"
+{
+    struct io_reactor_options
+    {
+        // The number of threads that consume the data. With 0 threads,
+        // data is only consumed by calling io_reactor::run_one().
+        size_t workers = 2;
+        // The size of each buffer a read is performed into.
+        size_t buffer_size = 16 * 1024;
+        // The maximum number of buffers a single source may hold at a time.
+        // Every buffer beyond the first one is taken from the shared budget.
+        size_t buffers_per_source = 4;
+        // The number of buffers that all sources together may hold beyond the first one each.
+        size_t shared_buffers = 32;
+    };
+
+    // io_reactor multiplexes the output of many readers (like the pipes of all ConPTY
+    // connections) onto a small, fixed set of worker threads.
+    // * It doesn't perform any I/O itself. A source starts an asynchronous read into a buffer
+    //   the reactor hands out and reports its completion with complete(). This allows the
+    //   platform to use overlapped I/O and tests to use in-process pipe stand-ins.
+    // * Buffers come from a shared pool. Each source may always hold one buffer, so that it can
+    //   always read, and up to buffers_per_source if the shared budget allows it. A source
+    //   that holds its limit isn't read from until its data was consumed, which pushes back on
+    //   its producer. Sources waiting for the shared budget get it in the order of the fewest
+    //   buffers held, so that a flooding source can't hog it either.
+    // * The data of each source is consumed in the order it was read, by one worker at a time.
+    //   A worker consumes a single buffer of a source and then moves on to the next source
+    //   that has data, so that a source that floods the reactor can't starve the others.
+    class io_reactor
+    {
+    public:
+        class source
+        {
+        public:
+            virtual ~source() = default;
+
+            // Starts reading into the given buffer. The read must be finished by calling
+            // io_reactor::complete(), which is allowed to happen before this function returns.
+            virtual void begin_read(io_reactor& reactor, gsl::span<char> buffer) noexcept = 0;
+            // Consumes the data of a finished read. Never called concurrently for the same source.
+            virtual void consume(std::string_view data) = 0;
+            // Called once after all data was consumed. error is the value the last read
+            // was completed with, which is 0 if it simply didn't return any data.
+            virtual void end(uint32_t error) = 0;
+
+        private:
+            friend class io_reactor;
+
+            struct chunk
+            {
+                std::unique_ptr<char[]> buffer;
+                size_t length = 0;
+            };
+
+            // The reactor keeps its sources alive until end() was called.
+            std::shared_ptr<source> _self;
+            std::deque<chunk> _chunks;
+            std::unique_ptr<char[]> _readBuffer;
+            size_t _held = 0;
+            uint32_t _error = 0;
+            bool _reading = false;
+            bool _ended = false;
+            bool _scheduled = false;
+            bool _waiting = false;
+        };
+
+        explicit io_reactor(const io_reactor_options& options = {}) :
+            _options{ options }
+        {
+            _options.buffer_size = std::max<size_t>(_options.buffer_size, 1);
+            _options.buffers_per_source = std::max<size_t>(_options.buffers_per_source, 1);
+
+            _workers.reserve(_options.workers);
+            try
+            {
+                for (size_t i = 0; i < _options.workers; ++i)
+                {
+                    _workers.emplace_back([this]() { _run(); });
+                }
+            }
+            catch (...)
+            {
+                _stop();
+                throw;
+            }
+        }
+
+        // All sources must have ended before the reactor is destroyed.
+        ~io_reactor()
+        {
+            _stop();
+        }
+
+        io_reactor(const io_reactor&) = delete;
+        io_reactor& operator=(const io_reactor&) = delete;
+        io_reactor(io_reactor&&) = delete;
+        io_reactor& operator=(io_reactor&&) = delete;
+
+        // Starts reading from the given source until a read returns no data or fails.
+        void add(std::shared_ptr<source> s)
+        {
+            auto& ref = *s;
+            std::unique_lock lock{ _mutex };
+            // Every source may hold one buffer, so the first read never waits.
+            _acquire(ref);
+            ref._self = std::move(s);
+            ref._reading = true;
+            _sources++;
+            lock.unlock();
+
+            ref.begin_read(*this, { ref._readBuffer.get(), _options.buffer_size });
+        }
+
+        // Finishes the current read of the given source. Reads that return
+        // no data or an error end the source once all its data was consumed.
+        void complete(source& s, size_t length, uint32_t error = 0)
+        {
+            std::unique_lock lock{ _mutex };
+            assert(s._reading);
+            s._reading = false;
+
+            if (length != 0)
+            {
+                s._chunks.push_back({ std::move(s._readBuffer), std::min(length, _options.buffer_size) });
+            }
+            else
+            {
+                _release(s, std::move(s._readBuffer));
+            }
+
+            if (length == 0 || error != 0)
+            {
+                s._ended = true;
+                s._error = error;
+            }
+
+            _schedule(s);
+            _read(lock, s);
+        }
+
+        // Consumes a single buffer (or the end) of the next source that has data on the calling thread.
+        // Returns false if there was nothing to consume. This is meant for reactors without workers.
+        bool run_one()
+        {
+            std::unique_lock lock{ _mutex };
+            if (_ready.empty())
+            {
+                return false;
+            }
+            _step(lock);
+            return true;
+        }
+
+        // The number of sources that haven't ended yet.
+        size_t size() const
+        {
+            std::scoped_lock lock{ _mutex };
+            return _sources;
+        }
+
+        // The number of buffers that are in use.
+        size_t buffers_in_use() const
+        {
+            std::scoped_lock lock{ _mutex };
+            return _buffersInUse;
+        }
+
+    private:
+        void _acquire(source& s)
+        {
+            std::unique_ptr<char[]> buffer;
+            if (_free.empty())
+            {
+                // Reserving room for every buffer ever allocated ensures that _release() can't fail.
+                _free.reserve(_buffersInUse + 1);
+                buffer = std::make_unique_for_overwrite<char[]>(_options.buffer_size);
+            }
+            else
+            {
+                buffer = std::move(_free.back());
+                _free.pop_back();
+            }
+
+            if (s._held != 0)
+            {
+                _sharedInUse++;
+            }
+            s._held++;
+            _buffersInUse++;
+            s._readBuffer = std::move(buffer);
+        }
+
+        void _release(source& s, std::unique_ptr<char[]> buffer) noexcept
+        {
+            s._held--;
+            if (s._held != 0)
+            {
+                _sharedInUse--;
+            }
+            _buffersInUse--;
+
+            // Buffers are kept for reuse, so that a steady stream of output doesn't allocate.
+            // The pool never holds more buffers than were in use at the same time.
+            _free.emplace_back(std::move(buffer));
+        }
+
+        // A source may read if it doesn't hold a buffer yet or if it may take
+        // another one from the shared budget without cutting in front of others.
+        bool _mayRead(const source& s) const noexcept
+        {
+            if (s._reading || s._ended || s._held >= _options.buffers_per_source)
+            {
+                return false;
+            }
+            return s._held == 0 || (_sharedInUse < _options.shared_buffers && (_waiting.empty() || _nextWaiting() == &s));
+        }
+
+        // The waiting source that holds the fewest buffers gets the shared budget
+        // next, and among those the one that has been waiting the longest.
+        source* _nextWaiting() const noexcept
+        {
+            source* next = nullptr;
+            for (const auto s : _waiting)
+            {
+                if (!next || s->_held < next->_held)
+                {
+                    next = s;
+                }
+            }
+            return next;
+        }
+
+        void _schedule(source& s)
+        {
+            if (!s._scheduled)
+            {
+                s._scheduled = true;
+                _ready.push_back(&s);
+                _cv.notify_one();
+            }
+        }
+
+        // Starts the next read of the given source if it may read and then hands any freed up
+        // shared budget to the sources waiting for it. The lock is released during begin_read().
+        void _read(std::unique_lock<std::mutex>& lock, source& s)
+        {
+            auto next = &s;
+            while (next)
+            {
+                if (_mayRead(*next))
+                {
+                    if (next->_waiting)
+                    {
+                        next->_waiting = false;
+                        _waiting.erase(std::find(_waiting.begin(), _waiting.end(), next));
+                    }
+
+                    _acquire(*next);
+                    next->_reading = true;
+                    const gsl::span<char> buffer{ next->_readBuffer.get(), _options.buffer_size };
+
+                    lock.unlock();
+                    next->begin_read(*this, buffer);
+                    lock.lock();
+                }
+                else if (!next->_reading && !next->_ended && !next->_waiting && next->_held < _options.buffers_per_source)
+                {
+                    // The source is only held back by the shared budget.
+                    next->_waiting = true;
+                    _waiting.push_back(next);
+                }
+
+                next = nullptr;
+                if (!_waiting.empty() && _sharedInUse < _options.shared_buffers)
+                {
+                    const auto candidate = _nextWaiting();
+                    if (_mayRead(*candidate))
+                    {
+                        next = candidate;
+                    }
+                }
+            }
+        }
+
+        // Consumes one buffer of the first ready source or ends it, if
+        // all of its data was consumed. The lock is held on entry and exit.
+        void _step(std::unique_lock<std::mutex>& lock)
+        {
+            const auto s = _ready.front();
+            _ready.pop_front();
+
+            if (!s->_chunks.empty())
+            {
+                auto chunk = std::move(s->_chunks.front());
+                s->_chunks.pop_front();
+                lock.unlock();
+
+                try
+                {
+                    s->consume({ chunk.buffer.get(), chunk.length });
+                }
+                catch (...)
+                {
+                    LOG_CAUGHT_EXCEPTION();
+                }
+
+                lock.lock();
+                _release(*s, std::move(chunk.buffer));
+
+                // Move to the back of the queue, so that other sources get their turn first.
+                s->_scheduled = false;
+                if (!s->_chunks.empty() || (s->_ended && !s->_reading))
+                {
+                    _schedule(*s);
+                }
+                _read(lock, *s);
+                return;
+            }
+
+            if (!s->_ended || s->_reading)
+            {
+                // The source's next read is still in progress.
+                s->_scheduled = false;
+                return;
+            }
+
+            // Ended sources aren't scheduled again, because they neither read nor hold any data.
+            if (s->_waiting)
+            {
+                _waiting.erase(std::find(_waiting.begin(), _waiting.end(), s));
+                s->_waiting = false;
+            }
+            auto self = std::move(s->_self);
+            _sources--;
+            lock.unlock();
+
+            try
+            {
+                s->end(s->_error);
+            }
+            catch (...)
+            {
+                LOG_CAUGHT_EXCEPTION();
+            }
+
+            self.reset();
+            lock.lock();
+        }
+
+        void _run()
+        {
+            std::unique_lock lock{ _mutex };
+            for (;;)
+            {
+                _cv.wait(lock, [&]() { return _stopping || !_ready.empty(); });
+                if (_stopping)
+                {
+                    return;
+                }
+                _step(lock);
+            }
+        }
+
+        void _stop() noexcept
+        {
+            {
+                std::scoped_lock lock{ _mutex };
+                _stopping = true;
+            }
+            _cv.notify_all();
+
+            for (auto& worker : _workers)
+            {
+                worker.join();
+            }
+            _workers.clear();
+        }
+
+        io_reactor_options _options;
+        mutable std::mutex _mutex;
+        std::condition_variable _cv;
+        std::vector<std::thread> _workers;
+        // The sources with data to consume (or that ended), in the order they get their turn.
+        std::deque<source*> _ready;
+        // The sources waiting for the shared budget to start their next read.
+        std::deque<source*> _waiting;
+        std::vector<std::unique_ptr<char[]>> _free;
+        size_t _sources = 0;
+        size_t _buffersInUse = 0;
+        size_t _sharedInUse = 0;
+        bool _stopping = false;
+    };
+}
@@ -0,0 +1,467 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#pragma once
+
+#ifdef UNIT_TESTING
+class LruMapTests;
+#endif
+
+namespace til // Terminal Implementation Library. Also: "Today I Learned"
+{
+    // lru_map is a hash map that keeps its entries in least-recently-used order.
+    // * The hash table uses open addressing with linear probing and backward shift
+    //   deletion. Each slot holds 32 bits of the hash and the index of its node,
+    //   so a probe only compares keys if those 32 bits match.
+    // * The nodes are linked into the LRU list with intrusive prev/next indices.
+    //   find() and insert() move an entry to the front, back() is the oldest entry.
+    // * Nodes are allocated in pages of fixed size and are never moved, so references to
+    //   keys and values stay valid until the entry is removed. Removed nodes are reused.
+    // Hash and KeyEqual may be transparent, in which case find() accepts any key type they support.
+    template<typename Key, typename T, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+    class lru_map
+    {
+    public:
+        using key_type = Key;
+        using mapped_type = T;
+        using value_type = std::pair<const Key, T>;
+        using size_type = size_t;
+        using hasher = Hash;
+        using key_equal = KeyEqual;
+
+    private:
+        static constexpr uint32_t npos = UINT32_MAX;
+        static constexpr uint32_t pageShift = 8;
+        static constexpr uint32_t pageSize = 1 << pageShift;
+        static constexpr uint32_t minimumSlotShift = 3;
+
+        struct node
+        {
+            uint32_t prev;
+            // The next node in the LRU list or in the list of free nodes.
+            uint32_t next;
+            uint32_t hash;
+            alignas(value_type) std::byte storage[sizeof(value_type)];
+
+            value_type& value() noexcept
+            {
+#pragma warning(suppress : 26490) // Don't use reinterpret_cast (type.1).
+                return *std::launder(reinterpret_cast<value_type*>(&storage[0]));
+            }
+
+            const value_type& value() const noexcept
+            {
+#pragma warning(suppress : 26490) // Don't use reinterpret_cast (type.1).
+                return *std::launder(reinterpret_cast<const value_type*>(&storage[0]));
+            }
+        };
+
+        struct slot
+        {
+            uint32_t hash;
+            // The index of the node + 1, or 0 if the slot is empty.
+            uint32_t node;
+        };
+
+    public:
+        // Iterates over the entries from the most to the least recently used one.
+        template<typename MapType, typename ValueType>
+        class iterator_base
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = ValueType;
+            using difference_type = ptrdiff_t;
+            using pointer = ValueType*;
+            using reference = ValueType&;
+
+            iterator_base() = default;
+
+            iterator_base(MapType* map, uint32_t index) noexcept :
+                _map{ map },
+                _index{ index }
+            {
+            }
+
+            reference operator*() const noexcept
+            {
+                return _map->_node(_index).value();
+            }
+
+            pointer operator->() const noexcept
+            {
+                return &**this;
+            }
+
+            iterator_base& operator++() noexcept
+            {
+                _index = _map->_node(_index).next;
+                return *this;
+            }
+
+            iterator_base operator++(int) noexcept
+            {
+                auto tmp = *this;
+                ++*this;
+                return tmp;
+            }
+
+            bool operator==(const iterator_base& rhs) const noexcept
+            {
+                return _index == rhs._index;
+            }
+
+            bool operator!=(const iterator_base& rhs) const noexcept
+            {
+                return _index != rhs._index;
+            }
+
+        private:
+            MapType* _map = nullptr;
+            uint32_t _index = npos;
+        };
+
+        using iterator = iterator_base<lru_map, value_type>;
+        using const_iterator = iterator_base<const lru_map, const value_type>;
+
+        lru_map() = default;
+
+        ~lru_map()
+        {
+            clear();
+        }
+
+        lru_map(const lru_map&) = delete;
+        lru_map& operator=(const lru_map&) = delete;
+
+        lru_map(lru_map&& other) noexcept
+        {
+            _take(other);
+        }
+
+        lru_map& operator=(lru_map&& other) noexcept
+        {
+            if (this != &other)
+            {
+                clear();
+                _take(other);
+            }
+            return *this;
+        }
+
+        iterator begin() noexcept
+        {
+            return { this, _head };
+        }
+
+        const_iterator begin() const noexcept
+        {
+            return { this, _head };
+        }
+
+        iterator end() noexcept
+        {
+            return { this, npos };
+        }
+
+        const_iterator end() const noexcept
+        {
+            return { this, npos };
+        }
+
+        size_type size() const noexcept
+        {
+            return _size;
+        }
+
+        bool empty() const noexcept
+        {
+            return _size == 0;
+        }
+
+        // The most recently used entry.
+        value_type& front() noexcept
+        {
+            assert(_size != 0);
+            return _node(_head).value();
+        }
+
+        // The least recently used entry.
+        value_type& back() noexcept
+        {
+            assert(_size != 0);
+            return _node(_tail).value();
+        }
+
+        // Returns the value for the given key and marks it as the most recently used entry.
+        template<typename K>
+        T* find(const K& key)
+        {
+            const auto index = _find(key, _hash(key));
+            if (index == npos)
+            {
+                return nullptr;
+            }
+
+            _unlink(index);
+            _pushFront(index);
+            return &_node(index).value().second;
+        }
+
+        // Returns the value for the given key without changing the order of the entries.
+        template<typename K>
+        const T* peek(const K& key) const
+        {
+            const auto index = _find(key, _hash(key));
+            return index == npos ? nullptr : &_node(index).value().second;
+        }
+
+        // Inserts a key that isn't part of the map yet as the most recently used entry.
+        value_type& insert(Key&& key, T&& value)
+        {
+            const auto hash = _hash(key);
+            assert(_find(key, hash) == npos);
+
+            if ((_size + 1) * 2 > _slots.size())
+            {
+                _rehash(_slots.empty() ? minimumSlotShift : _slotShift + 1);
+            }
+
+            const auto index = _allocateNode();
+            auto& n = _node(index);
+            try
+            {
+                new (&n.storage[0]) value_type(std::move(key), std::move(value));
+            }
+            catch (...)
+            {
+                _freeNode(index);
+                throw;
+            }
+
+            n.hash = hash;
+            _insertSlot(hash, index);
+            _pushFront(index);
+            _size++;
+            return n.value();
+        }
+
+        // Removes the least recently used entry.
+        void pop_back() noexcept
+        {
+            assert(_size != 0);
+            _erase(_tail);
+        }
+
+        // Removes the entry for the given key. Returns false if there was none.
+        template<typename K>
+        bool erase(const K& key) noexcept
+        {
+            const auto index = _find(key, _hash(key));
+            if (index == npos)
+            {
+                return false;
+            }
+            _erase(index);
+            return true;
+        }
+
+        void clear() noexcept
+        {
+            for (auto index = _head; index != npos;)
+            {
+                auto& n = _node(index);
+                index = n.next;
+                std::destroy_at(&n.value());
+            }
+
+            _pages.clear();
+            _slots.clear();
+            _nodeCount = 0;
+            _free = npos;
+            _head = npos;
+            _tail = npos;
+            _size = 0;
+            _slotShift = 0;
+        }
+
+    private:
+        template<typename K>
+        uint32_t _hash(const K& key) const noexcept
+        {
+            // Fibonacci hashing spreads the bits of weak hash functions (like FNV-1a or the identity
+            // function std::hash uses for integers) across the upper 32 bits that we keep.
+            const auto h = static_cast<uint64_t>(Hash{}(key)) * UINT64_C(0x9E3779B97F4A7C15);
+            return static_cast<uint32_t>(h >> 32);
+        }
+
+        // The ideal slot for a hash are its upper bits.
+        size_t _home(uint32_t hash) const noexcept
+        {
+            return static_cast<size_t>(hash >> (32 - _slotShift));
+        }
+
+        size_t _mask() const noexcept
+        {
+            return _slots.size() - 1;
+        }
+
+        node& _node(uint32_t index) noexcept
+        {
+            return _pages[index >> pageShift][index & (pageSize - 1)];
+        }
+
+        const node& _node(uint32_t index) const noexcept
+        {
+            return _pages[index >> pageShift][index & (pageSize - 1)];
+        }
+
+        template<typename K>
+        uint32_t _find(const K& key, uint32_t hash) const noexcept
+        {
+            if (_slots.empty())
+            {
+                return npos;
+            }
+
+            const auto mask = _mask();
+            for (auto i = _home(hash);; i = (i + 1) & mask)
+            {
+                const auto& s = _slots[i];
+                if (s.node == 0)
+                {
+                    return npos;
+                }
+
+                if (s.hash == hash)
+                {
+                    const auto index = s.node - 1;
+                    if (KeyEqual{}(_node(index).value().first, key))
+                    {
+                        return index;
+                    }
+                }
+            }
+        }
+
+        void _insertSlot(uint32_t hash, uint32_t index) noexcept
+        {
+            const auto mask = _mask();
+            auto i = _home(hash);
+            while (_slots[i].node != 0)
+            {
+                i = (i + 1) & mask;
+            }
+            _slots[i] = { hash, index + 1 };
+        }
+
+        void _rehash(uint32_t slotShift)
+        {
+            std::vector<slot> slots(size_t{ 1 } << slotShift);
+            _slots.swap(slots);
+            _slotShift = slotShift;
+
+            for (auto index = _head; index != npos; index = _node(index).next)
+            {
+                _insertSlot(_node(index).hash, index);
+            }
+        }
+
+        void _erase(uint32_t index) noexcept
+        {
+            auto& n = _node(index);
+            const auto mask = _mask();
+
+            // Find the slot that refers to the node...
+            auto i = _home(n.hash);
+            while (_slots[i].node != index + 1)
+            {
+                i = (i + 1) & mask;
+            }
+
+            // ...and close the gap it leaves behind by shifting back all following
+            // entries of the probe sequence that are allowed to move into it.
+            for (auto j = (i + 1) & mask; _slots[j].node != 0; j = (j + 1) & mask)
+            {
+                const auto home = _home(_slots[j].hash);
+                // The entry at j may move to i, if its home isn't cyclically within (i, j].
+                const auto distanceToJ = (j - home) & mask;
+                const auto distanceToI = (i - home) & mask;
+                if (distanceToI < distanceToJ)
+                {
+                    _slots[i] = _slots[j];
+                    i = j;
+                }
+            }
+            _slots[i] = {};
+
+            _unlink(index);
+            std::destroy_at(&n.value());
+            _freeNode(index);
+            _size--;
+        }
+
+        uint32_t _allocateNode()
+        {
+            if (_free != npos)
+            {
+                return std::exchange(_free, _node(_free).next);
+            }
+
+            if ((_nodeCount & (pageSize - 1)) == 0)
+            {
+                _pages.emplace_back(std::make_unique<node[]>(pageSize));
+            }
+            return _nodeCount++;
+        }
+
+        void _freeNode(uint32_t index) noexcept
+        {
+            _node(index).next = _free;
+            _free = index;
+        }
+
+        void _unlink(uint32_t index) noexcept
+        {
+            auto& n = _node(index);
+            (n.prev != npos ? _node(n.prev).next : _head) = n.next;
+            (n.next != npos ? _node(n.next).prev : _tail) = n.prev;
+        }
+
+        void _pushFront(uint32_t index) noexcept
+        {
+            auto& n = _node(index);
+            n.prev = npos;
+            n.next = _head;
+            (_head != npos ? _node(_head).prev : _tail) = index;
+            _head = index;
+        }
+
+        void _take(lru_map& other) noexcept
+        {
+            _pages = std::move(other._pages);
+            _slots = std::move(other._slots);
+            _nodeCount = std::exchange(other._nodeCount, 0);
+            _free = std::exchange(other._free, npos);
+            _head = std::exchange(other._head, npos);
+            _tail = std::exchange(other._tail, npos);
+            _size = std::exchange(other._size, 0);
+            _slotShift = std::exchange(other._slotShift, 0);
+            other._pages.clear();
+            other._slots.clear();
+        }
+
+        std::vector<std::unique_ptr<node[]>> _pages;
+        std::vector<slot> _slots;
+        uint32_t _nodeCount = 0;
+        uint32_t _free = npos;
+        uint32_t _head = npos;
+        uint32_t _tail = npos;
+        size_t _size = 0;
+        uint32_t _slotShift = 0;
+
+#ifdef UNIT_TESTING
+        friend class ::LruMapTests;
+#endif
+    };
+}
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include "timer_wheel.h"
+
 namespace til
 {
     namespace details
@@ -97,17 +99,17 @@ namespace til
         //   be started. After the timer has expired `func` will be invoked just once.
         //
         // After `func` was invoked the state is reset and this cycle is repeated again.
+        //
+        // All instances share the timers of til::timer_wheel::shared().
         throttled_func(filetime_duration delay, function func) :
+            _delay{ std::chrono::duration_cast<timer_wheel::clock::duration>(delay) },
             _func{ std::move(func) },
-            _timer{ _createTimer() }
+            _timer{ timer_wheel::shared(), [this]() { _trailing_edge(); } }
         {
-            const auto d = -delay.count();
-            if (d >= 0)
+            if (delay <= filetime_duration::zero())
             {
                 throw std::invalid_argument("non-positive delay specified");
             }
-
-            memcpy(&_delay, &d, sizeof(d));
         }
 
         // throttled_func uses its `this` pointer when creating _timer.
@@ -150,7 +152,7 @@ namespace til
         //       could still be called concurrently.
         void flush()
         {
-            WaitForThreadpoolTimerCallbacks(_timer.get(), true);
+            _timer.cancel();
             if (_storage)
             {
                 _trailing_edge();
@@ -158,13 +160,6 @@ namespace til
         }
 
     private:
-        static void __stdcall _timer_callback(PTP_CALLBACK_INSTANCE /*instance*/, PVOID context, PTP_TIMER /*timer*/) noexcept
-        try
-        {
-            static_cast<throttled_func*>(context)->_trailing_edge();
-        }
-        CATCH_LOG()
-
         void _leading_edge()
         {
             if constexpr (leading)
@@ -172,7 +167,7 @@ namespace til
                 _func();
             }
 
-            SetThreadpoolTimerEx(_timer.get(), &_delay, 0, 0);
+            _timer.arm(_delay);
         }
 
         void _trailing_edge()
@@ -187,16 +182,9 @@ namespace til
             }
         }
 
-        inline wil::unique_threadpool_timer _createTimer()
-        {
-            wil::unique_threadpool_timer timer{ CreateThreadpoolTimer(&_timer_callback, this, nullptr) };
-            THROW_LAST_ERROR_IF(!timer);
-            return timer;
-        }
-
-        FILETIME _delay;
+        timer_wheel::clock::duration _delay;
         function _func;
-        wil::unique_threadpool_timer _timer;
+        timer_wheel::timer _timer;
         details::throttled_func_storage<Args...> _storage;
     };
 
@@ -0,0 +1,542 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#pragma once
+
+#include <bit>
+#include <condition_variable>
+
+namespace til // Terminal Implementation Library. Also: "Today I Learned"
+{
+    enum class timer_wheel_driver
+    {
+        // Timers only expire when advance() is called. This is meant for tests.
+        manual,
+        // A dedicated thread sleeps until the next timer expires. It's available on all platforms.
+        thread,
+#ifdef _WIN32
+        // A single threadpool timer is set to the time the next timer expires.
+        // Expired callbacks are submitted to the threadpool, so they run in parallel.
+        threadpool,
+#endif
+    };
+
+    // timer_wheel hosts any number of one-shot timers on a single OS timer or thread.
+    // * It's a hierarchical timer wheel with 4 levels of 64 slots each. A slot spans 1ms on the
+    //   lowest level and 64 times as much on each level above it, up to about 4.6 hours in total.
+    //   Timers are linked into the slot of the level that fits their delay, which makes arming
+    //   and canceling them O(1). Timers on the upper levels are moved down once their slot comes up.
+    // * Timers whose delays end within the same millisecond expire together.
+    //   The driver only wakes up when a timer expires or has to move down a level,
+    //   and it doesn't wake up at all while no timer is armed.
+    // * The threadpool driver submits the callbacks of expired timers to the threadpool, so that
+    //   a slow callback doesn't hold up the others. The other drivers invoke them on their own
+    //   thread, one after another. No locks are held while a callback runs.
+    // * A timer's callback never runs concurrently with itself. If the timer expires again while
+    //   it's running, it's invoked once more afterwards. Canceling a timer waits for its callback
+    //   to return, unless it's called from that callback, which must not destroy the timer.
+    class timer_wheel
+    {
+    public:
+        using clock = std::chrono::steady_clock;
+        using tick = std::chrono::milliseconds;
+
+        class timer
+        {
+        public:
+            timer(timer_wheel& wheel, std::function<void()> callback) :
+                _wheel{ wheel },
+                _callback{ std::move(callback) }
+            {
+            }
+
+            ~timer()
+            {
+                cancel();
+            }
+
+            // The wheel refers to timers by their address.
+            timer(const timer&) = delete;
+            timer& operator=(const timer&) = delete;
+            timer(timer&&) = delete;
+            timer& operator=(timer&&) = delete;
+
+            // Arms the timer to expire once after the given delay.
+            // If it's armed already, the previous delay is replaced.
+            void arm(clock::duration delay)
+            {
+                _wheel.arm(*this, delay);
+            }
+
+            // Disarms the timer and waits for its callback to return if it's running.
+            // Returns true if the timer was armed.
+            bool cancel() noexcept
+            {
+                return _wheel.cancel(*this);
+            }
+
+            bool armed() const noexcept
+            {
+                return _wheel.armed(*this);
+            }
+
+        private:
+            friend class timer_wheel;
+
+            timer_wheel& _wheel;
+            std::function<void()> _callback;
+            // The thread that's invoking the callback right now, if any.
+            std::thread::id _callingThread;
+            // Set while a worker owns the timer to invoke its callback and until it's done with it.
+            bool _dispatched = false;
+            // Whether the worker should invoke the callback (once more).
+            bool _due = false;
+            timer* _next = nullptr;
+            // Points to the _next member of the previous timer or to the head of the list.
+            timer** _prev = nullptr;
+            uint64_t _expires = 0;
+            // The index of the list in timer_wheel::_lists, or UINT16_MAX if it isn't linked into any.
+            uint16_t _list = UINT16_MAX;
+        };
+
+        explicit timer_wheel(timer_wheel_driver driver = timer_wheel_driver::manual, clock::time_point origin = clock::now()) :
+            _driver{ driver },
+            _origin{ origin }
+        {
+            if (_driver == timer_wheel_driver::thread)
+            {
+                _thread = std::thread{ [this]() { _run(); } };
+            }
+#ifdef _WIN32
+            else if (_driver == timer_wheel_driver::threadpool)
+            {
+                _threadpoolTimer.reset(CreateThreadpoolTimer(&_threadpoolCallback, this, nullptr));
+                THROW_LAST_ERROR_IF(!_threadpoolTimer);
+            }
+#endif
+        }
+
+        // All timers must have been destroyed before the wheel is destroyed.
+        ~timer_wheel()
+        {
+            if (_thread.joinable())
+            {
+                {
+                    std::scoped_lock lock{ _mutex };
+                    _stopping = true;
+                }
+                _driverCV.notify_one();
+                _thread.join();
+            }
+#ifdef _WIN32
+            _threadpoolTimer.reset();
+#endif
+        }
+
+        timer_wheel(const timer_wheel&) = delete;
+        timer_wheel& operator=(const timer_wheel&) = delete;
+        timer_wheel(timer_wheel&&) = delete;
+        timer_wheel& operator=(timer_wheel&&) = delete;
+
+        // The wheel that's shared by the entire process. It's intentionally leaked,
+        // because its driver must not be stopped while the module is being unloaded.
+        static timer_wheel& shared()
+        {
+#ifdef _WIN32
+            static const auto wheel = new timer_wheel{ timer_wheel_driver::threadpool };
+#else
+            static const auto wheel = new timer_wheel{ timer_wheel_driver::thread };
+#endif
+            return *wheel;
+        }
+
+        void arm(timer& t, clock::duration delay)
+        {
+            std::scoped_lock lock{ _mutex };
+            _unlink(t);
+
+            // Delays are rounded up to whole ticks, so that a timer never expires early.
+            const auto now = _currentTick();
+            const auto ticks = std::chrono::ceil<tick>(std::max(delay, clock::duration::zero())).count();
+            t._expires = now + std::max<uint64_t>(gsl::narrow_cast<uint64_t>(ticks), 1);
+            _insert(t);
+
+            if (t._expires < _wakeup)
+            {
+                _reschedule();
+            }
+        }
+
+        bool cancel(timer& t) noexcept
+        {
+            std::unique_lock lock{ _mutex };
+            const auto wasArmed = t._list != unlinked;
+            _unlink(t);
+            t._due = false;
+
+            // A worker may still have the timer, even if it doesn't invoke the callback anymore.
+            while (t._dispatched && t._callingThread != std::this_thread::get_id())
+            {
+                _idleCV.wait(lock);
+            }
+            return wasArmed;
+        }
+
+        bool armed(const timer& t) const noexcept
+        {
+            std::scoped_lock lock{ _mutex };
+            return t._list != unlinked;
+        }
+
+        // The time at which the wheel needs to be advanced next, if any timer is armed.
+        std::optional<clock::time_point> next_wakeup() const
+        {
+            std::scoped_lock lock{ _mutex };
+            const auto next = _nextEvent();
+            if (next == never)
+            {
+                return std::nullopt;
+            }
+            return _origin + tick{ next };
+        }
+
+        // Invokes the callbacks of all timers that expired up to the given time, in the order they expired,
+        // or submits them to the threadpool, depending on the driver. Returns the number of expired timers.
+        // Drivers call this on their own.
+        size_t advance(clock::time_point time)
+        {
+            const auto target = _toTick(time);
+            size_t invoked = 0;
+
+            std::unique_lock lock{ _mutex };
+            if (_advancing)
+            {
+                // Another thread is already advancing the wheel and will catch up with this time.
+                return 0;
+            }
+            _advancing = true;
+
+            while (_now < target)
+            {
+                const auto next = _nextEvent();
+                if (next > target)
+                {
+                    _now = target;
+                    break;
+                }
+
+                _now = next;
+                _expire();
+
+                while (auto t = _lists[pending])
+                {
+                    _unlink(*t);
+                    t->_due = true;
+                    invoked++;
+
+                    // If the callback is still running, its worker invokes it again once it returns.
+                    if (t->_dispatched)
+                    {
+                        continue;
+                    }
+                    t->_dispatched = true;
+
+#ifdef _WIN32
+                    if (_driver == timer_wheel_driver::threadpool && TrySubmitThreadpoolCallback(&_submittedCallback, t, nullptr))
+                    {
+                        continue;
+                    }
+#endif
+
+                    lock.unlock();
+                    _invoke(*t);
+                    lock.lock();
+                }
+            }
+
+            _advancing = false;
+            _wakeup = never;
+            _reschedule();
+            return invoked;
+        }
+
+    private:
+        static constexpr uint64_t never = UINT64_MAX;
+        static constexpr size_t levels = 4;
+        static constexpr size_t slotBits = 6;
+        static constexpr size_t slots = size_t{ 1 } << slotBits;
+        static constexpr uint64_t slotMask = slots - 1;
+        // The lists of all slots of all levels, followed by the list of
+        // expired timers whose callbacks are about to be invoked.
+        static constexpr uint16_t pending = levels * slots;
+        static constexpr uint16_t unlinked = UINT16_MAX;
+        static_assert(pending < unlinked);
+
+        // Invokes the timer's callback for as long as it's due. The timer must have been dispatched.
+        void _invoke(timer& t) noexcept
+        {
+            std::unique_lock lock{ _mutex };
+            while (t._due)
+            {
+                t._due = false;
+                t._callingThread = std::this_thread::get_id();
+                lock.unlock();
+
+                try
+                {
+                    t._callback();
+                }
+                catch (...)
+                {
+                    LOG_CAUGHT_EXCEPTION();
+                }
+
+                lock.lock();
+                t._callingThread = {};
+            }
+
+            // Once this is cleared, the timer may be destroyed at any moment.
+            t._dispatched = false;
+            _idleCV.notify_all();
+        }
+
+        uint64_t _toTick(clock::time_point time) const noexcept
+        {
+            return time <= _origin ? 0 : gsl::narrow_cast<uint64_t>(std::chrono::floor<tick>(time - _origin).count());
+        }
+
+        // Delays are measured from the current time, unless the wheel is driven manually.
+        // In that case the current time is the one it was last advanced to.
+        uint64_t _currentTick() noexcept
+        {
+            if (_driver == timer_wheel_driver::manual)
+            {
+                return _now;
+            }
+
+            // The wheel's time is only moved forward if that doesn't skip over any timers.
+            // Otherwise the driver is late and will catch up with the timers soon.
+            const auto now = _toTick(clock::now());
+            if (!_advancing && now > _now && _nextEvent() > now)
+            {
+                _now = now;
+            }
+            return std::max(now, _now);
+        }
+
+        void _insert(timer& t) noexcept
+        {
+            // Timers are put into the lowest level whose range covers their delay.
+            // Delays that exceed the range of the highest level are moved down
+            // from its farthest slot and then put back up again.
+            const auto delta = t._expires - _now;
+            size_t level = 0;
+            while (level + 1 < levels && delta >= (uint64_t{ 1 } << (slotBits * (level + 1))))
+            {
+                level++;
+            }
+
+            const auto maximum = _now + (uint64_t{ 1 } << (slotBits * levels)) - 1;
+            const auto expires = std::min(t._expires, maximum);
+            const auto slot = (expires >> (slotBits * level)) & slotMask;
+            _link(t, gsl::narrow_cast<uint16_t>(level * slots + slot));
+        }
+
+        void _link(timer& t, uint16_t list) noexcept
+        {
+            auto& head = _lists[list];
+            t._next = head;
+            t._prev = &head;
+            if (head)
+            {
+                head->_prev = &t._next;
+            }
+            head = &t;
+            t._list = list;
+
+            if (list < pending)
+            {
+                _occupied[list / slots] |= uint64_t{ 1 } << (list % slots);
+            }
+        }
+
+        void _unlink(timer& t) noexcept
+        {
+            if (t._list == unlinked)
+            {
+                return;
+            }
+
+            *t._prev = t._next;
+            if (t._next)
+            {
+                t._next->_prev = t._prev;
+            }
+
+            if (t._list < pending && !_lists[t._list])
+            {
+                _occupied[t._list / slots] &= ~(uint64_t{ 1 } << (t._list % slots));
+            }
+
+            t._next = nullptr;
+            t._prev = nullptr;
+            t._list = unlinked;
+        }
+
+        // Returns the next tick after _now at which a timer expires or
+        // needs to be moved down a level, or never if no timer is armed.
+        uint64_t _nextEvent() const noexcept
+        {
+            if (_lists[pending])
+            {
+                return _now;
+            }
+
+            auto next = never;
+            for (size_t level = 0; level < levels; ++level)
+            {
+                const auto occupied = _occupied[level];
+                if (!occupied)
+                {
+                    continue;
+                }
+
+                // The slots of a level come up in a cycle, starting with the one after the current one.
+                const auto shift = slotBits * level;
+                const auto current = _now >> shift;
+                const auto rotated = std::rotr(occupied, gsl::narrow_cast<int>((current + 1) & slotMask));
+                const auto distance = gsl::narrow_cast<uint64_t>(std::countr_zero(rotated)) + 1;
+                next = std::min(next, (current + distance) << shift);
+            }
+            return next;
+        }
+
+        // Moves the timers whose slots came up at _now down a level, from the highest level
+        // to the lowest one, and then the timers that expire at _now into the pending list.
+        void _expire() noexcept
+        {
+            for (auto level = levels - 1; level > 0; --level)
+            {
+                const auto shift = slotBits * level;
+                if (_now & ((uint64_t{ 1 } << shift) - 1))
+                {
+                    continue;
+                }
+
+                const auto list = gsl::narrow_cast<uint16_t>(level * slots + ((_now >> shift) & slotMask));
+                while (auto t = _lists[list])
+                {
+                    _unlink(*t);
+                    if (t->_expires <= _now)
+                    {
+                        _link(*t, pending);
+                    }
+                    else
+                    {
+                        _insert(*t);
+                    }
+                }
+            }
+
+            const auto list = gsl::narrow_cast<uint16_t>(_now & slotMask);
+            while (auto t = _lists[list])
+            {
+                _unlink(*t);
+                _link(*t, pending);
+            }
+        }
+
+        // Makes sure that the driver wakes up for the next event.
+        void _reschedule() noexcept
+        {
+            const auto next = _nextEvent();
+            if (next == _wakeup || _advancing)
+            {
+                return;
+            }
+            _wakeup = next;
+
+            if (_driver == timer_wheel_driver::thread)
+            {
+                _driverCV.notify_one();
+            }
+#ifdef _WIN32
+            else if (_driver == timer_wheel_driver::threadpool)
+            {
+                if (next == never)
+                {
+                    SetThreadpoolTimerEx(_threadpoolTimer.get(), nullptr, 0, 0);
+                    return;
+                }
+
+                // Negative due times are relative to the current time, in units of 100ns.
+                const auto due = _origin + tick{ next } - clock::now();
+                auto relative = -std::max<int64_t>(std::chrono::duration_cast<std::chrono::duration<int64_t, std::ratio<1, 10000000>>>(due).count(), 1);
+                FILETIME dueTime;
+                memcpy(&dueTime, &relative, sizeof(dueTime));
+                // The window allows the OS to coalesce our wakeup with other timers that expire within a tick.
+                SetThreadpoolTimerEx(_threadpoolTimer.get(), &dueTime, 0, gsl::narrow_cast<DWORD>(tick{ 1 }.count()));
+            }
+#endif
+        }
+
+        void _run()
+        {
+            std::unique_lock lock{ _mutex };
+            while (!_stopping)
+            {
+                if (_wakeup == never)
+                {
+                    _driverCV.wait(lock);
+                    continue;
+                }
+
+                const auto deadline = _origin + tick{ _wakeup };
+                if (clock::now() < deadline)
+                {
+                    _driverCV.wait_until(lock, deadline);
+                    continue;
+                }
+
+                lock.unlock();
+                advance(clock::now());
+                lock.lock();
+            }
+        }
+
+#ifdef _WIN32
+        static void __stdcall _threadpoolCallback(PTP_CALLBACK_INSTANCE /*instance*/, PVOID context, PTP_TIMER /*timer*/) noexcept
+        try
+        {
+            const auto self = static_cast<timer_wheel*>(context);
+            self->advance(clock::now());
+        }
+        CATCH_LOG()
+
+        static void __stdcall _submittedCallback(PTP_CALLBACK_INSTANCE /*instance*/, PVOID context) noexcept
+        {
+            const auto t = static_cast<timer*>(context);
+            t->_wheel._invoke(*t);
+        }
+
+        wil::unique_threadpool_timer _threadpoolTimer;
+#endif
+
+        timer_wheel_driver _driver;
+        clock::time_point _origin;
+        mutable std::mutex _mutex;
+        std::condition_variable _driverCV;
+        std::condition_variable _idleCV;
+        std::thread _thread;
+
+        std::array<timer*, levels * slots + 1> _lists{};
+        // A bitmap of the non-empty slots of each level.
+        std::array<uint64_t, levels> _occupied{};
+        // The tick the wheel was advanced to.
+        uint64_t _now = 0;
+        // The tick the driver wakes up at next.
+        uint64_t _wakeup = never;
+        bool _advancing = false;
+        bool _stopping = false;
+    };
+}
@@ -0,0 +1,303 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#pragma once
+
+// TIL_TRACE_SPAN(category, name) records the time from its declaration until the end of
+// the enclosing scope as a span, if tracing was enabled with til::trace::enable().
+// Both arguments must be string literals. Unless TIL_TRACING is defined, it compiles to nothing.
+#ifdef TIL_TRACING
+#define TIL_TRACE_SPAN_CONCAT_INNER(a, b) a##b
+#define TIL_TRACE_SPAN_CONCAT(a, b) TIL_TRACE_SPAN_CONCAT_INNER(a, b)
+#define TIL_TRACE_SPAN(category, name) const til::trace::span TIL_TRACE_SPAN_CONCAT(_tilTraceSpan, __LINE__)(category, name)
+#else
+#define TIL_TRACE_SPAN(category, name) (void)0
+#endif
+
+// til::trace is an in-process tracing facility for profiling the hot paths without
+// an external collector, including in headless runs on other platforms.
+// * Every thread records its spans into its own fixed-size ring buffer. The owning thread
+//   is the only writer, so recording a span only takes a few relaxed stores and never locks.
+//   Once a ring buffer is full, the oldest spans of that thread are overwritten.
+// * snapshot() can be called at any time from any thread. It copies the spans out of the ring
+//   buffers and discards those that were overwritten while being copied.
+// * to_chrome_json() turns a snapshot into the Chrome trace event format, which can be
+//   loaded into about://tracing, Perfetto or speedscope.
+namespace til::trace // Terminal Implementation Library. Also: "Today I Learned"
+{
+    using clock = std::chrono::steady_clock;
+
+    struct span_record
+    {
+        const char* category = nullptr;
+        const char* name = nullptr;
+        clock::time_point begin;
+        clock::time_point end;
+        // Identifies the ring buffer the span was recorded into. The ring buffers
+        // of exited threads are reused, but by at most one thread at a time.
+        uint32_t thread = 0;
+    };
+
+    namespace details
+    {
+        class ring
+        {
+        public:
+            static constexpr size_t capacity = 4096;
+
+            explicit ring(uint32_t id) :
+                _id{ id },
+                _slots{ std::make_unique<slot[]>(capacity) }
+            {
+            }
+
+            // Must only be called by the thread that owns the ring.
+            void push(const char* category, const char* name, clock::time_point begin, clock::time_point end) noexcept
+            {
+                const auto index = _committed.load(std::memory_order_relaxed);
+                auto& slot = _slots[index % capacity];
+
+                // Announce that the slot's previous span is being overwritten, before doing so.
+                // The fence ensures that a reader who sees any of the following stores also sees this one.
+                _begun.store(index + 1, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_release);
+
+                slot.category.store(category, std::memory_order_relaxed);
+                slot.name.store(name, std::memory_order_relaxed);
+                slot.begin.store(begin.time_since_epoch().count(), std::memory_order_relaxed);
+                slot.end.store(end.time_since_epoch().count(), std::memory_order_relaxed);
+                _committed.store(index + 1, std::memory_order_release);
+            }
+
+            // Appends the spans that were recorded since the last clear() to `out`. Safe to call concurrently with push().
+            // Calls to clear() and copy_to() must be serialized.
+            void copy_to(std::vector<span_record>& out) const
+            {
+                const auto committed = _committed.load(std::memory_order_acquire);
+                const auto first = std::max(committed > capacity ? committed - capacity : 0, _cleared);
+                const auto offset = out.size();
+
+                for (auto index = first; index < committed; ++index)
+                {
+                    const auto& slot = _slots[index % capacity];
+                    auto& record = out.emplace_back();
+                    record.category = slot.category.load(std::memory_order_relaxed);
+                    record.name = slot.name.load(std::memory_order_relaxed);
+                    record.begin = clock::time_point{ clock::duration{ slot.begin.load(std::memory_order_relaxed) } };
+                    record.end = clock::time_point{ clock::duration{ slot.end.load(std::memory_order_relaxed) } };
+                    record.thread = _id;
+                }
+
+                // Any span whose slot the writer started to overwrite in the meantime may be torn.
+                std::atomic_thread_fence(std::memory_order_acquire);
+                const auto begun = _begun.load(std::memory_order_relaxed);
+                const auto validFirst = std::clamp(begun > capacity ? begun - capacity : 0, first, committed);
+                const auto begin = out.begin() + offset;
+                out.erase(begin, begin + (validFirst - first));
+            }
+
+            void clear() noexcept
+            {
+                _cleared = _committed.load(std::memory_order_acquire);
+            }
+
+        private:
+            struct slot
+            {
+                std::atomic<const char*> category{ nullptr };
+                std::atomic<const char*> name{ nullptr };
+                std::atomic<clock::rep> begin{ 0 };
+                std::atomic<clock::rep> end{ 0 };
+            };
+
+            uint32_t _id;
+            std::unique_ptr<slot[]> _slots;
+            // The number of spans that were started to be written and that were completely written.
+            std::atomic<size_t> _begun{ 0 };
+            std::atomic<size_t> _committed{ 0 };
+            // The number of spans that were committed when clear() was last called.
+            size_t _cleared = 0;
+        };
+
+        struct registry
+        {
+            std::mutex mutex;
+            std::vector<std::unique_ptr<ring>> rings;
+            // The rings of threads that exited.
+            std::vector<ring*> unused;
+            std::atomic<bool> enabled{ false };
+        };
+
+        // The registry is intentionally leaked, because threads may still exit and
+        // release their ring after the static destructors ran during process exit.
+        inline registry& get_registry()
+        {
+            static const auto r = new registry;
+            return *r;
+        }
+
+        // Rings are only allocated once a thread records its first span.
+        class thread_ring
+        {
+        public:
+            thread_ring() = default;
+            thread_ring(const thread_ring&) = delete;
+            thread_ring& operator=(const thread_ring&) = delete;
+
+            ~thread_ring()
+            {
+                if (_ring)
+                {
+                    auto& r = get_registry();
+                    const std::scoped_lock lock{ r.mutex };
+                    // The vector has room for every ring, so this can't throw.
+                    r.unused.push_back(_ring);
+                }
+            }
+
+            ring* get() noexcept
+            try
+            {
+                if (!_ring)
+                {
+                    auto& r = get_registry();
+                    const std::scoped_lock lock{ r.mutex };
+                    if (r.unused.empty())
+                    {
+                        r.unused.reserve(r.rings.size() + 1);
+                        _ring = r.rings.emplace_back(std::make_unique<ring>(gsl::narrow_cast<uint32_t>(r.rings.size() + 1))).get();
+                    }
+                    else
+                    {
+                        _ring = r.unused.back();
+                        r.unused.pop_back();
+                    }
+                }
+                return _ring;
+            }
+            catch (...)
+            {
+                // Tracing is best effort. Running out of memory only loses this span.
+                return nullptr;
+            }
+
+        private:
+            ring* _ring = nullptr;
+        };
+
+        inline thread_local thread_ring t_ring;
+
+        inline void append_escaped(std::string& out, const char* str)
+        {
+            for (; str && *str; ++str)
+            {
+                const auto ch = *str;
+                if (ch == '"' || ch == '\\')
+                {
+                    out.push_back('\\');
+                }
+                out.push_back(ch);
+            }
+        }
+    }
+
+    inline void enable(bool enabled) noexcept
+    {
+        details::get_registry().enabled.store(enabled, std::memory_order_relaxed);
+    }
+
+    inline bool enabled() noexcept
+    {
+        return details::get_registry().enabled.load(std::memory_order_relaxed);
+    }
+
+    // Records a span directly. Prefer TIL_TRACE_SPAN, which can be compiled out.
+    inline void record(const char* category, const char* name, clock::time_point begin, clock::time_point end) noexcept
+    {
+        if (const auto ring = details::t_ring.get())
+        {
+            ring->push(category, name, begin, end);
+        }
+    }
+
+    class span
+    {
+    public:
+        span(const char* category, const char* name) noexcept :
+            _category{ category },
+            _name{ enabled() ? name : nullptr }
+        {
+            if (_name)
+            {
+                _begin = clock::now();
+            }
+        }
+
+        ~span()
+        {
+            if (_name)
+            {
+                record(_category, _name, _begin, clock::now());
+            }
+        }
+
+        span(const span&) = delete;
+        span& operator=(const span&) = delete;
+
+    private:
+        const char* _category;
+        const char* _name;
+        clock::time_point _begin;
+    };
+
+    // Discards all spans that were recorded so far.
+    inline void clear()
+    {
+        auto& r = details::get_registry();
+        const std::scoped_lock lock{ r.mutex };
+        for (const auto& ring : r.rings)
+        {
+            ring->clear();
+        }
+    }
+
+    // Returns the recorded spans of all threads, ordered by the time they began.
+    inline std::vector<span_record> snapshot()
+    {
+        std::vector<span_record> records;
+        auto& r = details::get_registry();
+        const std::scoped_lock lock{ r.mutex };
+        records.reserve(r.rings.size() * details::ring::capacity);
+        for (const auto& ring : r.rings)
+        {
+            ring->copy_to(records);
+        }
+        std::stable_sort(records.begin(), records.end(), [](const span_record& a, const span_record& b) { return a.begin < b.begin; });
+        return records;
+    }
+
+    // Serializes the given spans as "complete" events in the Chrome trace event format.
+    // The timestamps are in microseconds, relative to the first span.
+    inline std::string to_chrome_json(const std::vector<span_record>& records)
+    {
+        std::string out{ R"({"displayTimeUnit":"ns","traceEvents":[)" };
+        const auto origin = records.empty() ? clock::time_point{} : records.front().begin;
+        for (const auto& record : records)
+        {
+            const std::chrono::duration<double, std::micro> ts = record.begin - origin;
+            const std::chrono::duration<double, std::micro> dur = record.end - record.begin;
+
+            if (&record != records.data())
+            {
+                out.push_back(',');
+            }
+            out.append(R"({"name":")");
+            details::append_escaped(out, record.name);
+            out.append(R"(","cat":")");
+            details::append_escaped(out, record.category);
+            fmt::format_to(std::back_inserter(out), R"(","ph":"X","pid":1,"tid":{},"ts":{:.3f},"dur":{:.3f}}})", record.thread, ts.count(), dur.count());
+        }
+        out.append("]}");
+        return out;
+    }
+}
@@ -1498,6 +1498,75 @@ class UiaTextRangeTests
         VERIFY_ARE_EQUAL(L"M", std::wstring_view{ text });
     }
 
+    TEST_METHOD(SnapshotReusesUnchangedRows)
+    {
+        auto& cache{ _pUiaData->GetUiaTextSnapshotCache() };
+        const auto textBufferEnd{ _pUiaData->GetTextBufferEndPosition() };
+
+        const auto first{ cache.Update(*_pTextBuffer, textBufferEnd, UiaTextRangeBase::DefaultWordDelimiter) };
+        const auto second{ cache.Update(*_pTextBuffer, textBufferEnd, UiaTextRangeBase::DefaultWordDelimiter) };
+        // Nothing changed, so we should get the exact same snapshot.
+        VERIFY_ARE_EQUAL(first.get(), second.get());
+
+        _pTextBuffer->Write({ L"Hello" }, origin);
+
+        const auto third{ cache.Update(*_pTextBuffer, textBufferEnd, UiaTextRangeBase::DefaultWordDelimiter) };
+        VERIFY_ARE_NOT_EQUAL(first.get(), third.get());
+        // Only the row we wrote to should have been copied again.
+        VERIFY_ARE_NOT_EQUAL(first->_rows[0].get(), third->_rows[0].get());
+        for (size_t i = 1; i < first->_rows.size(); ++i)
+        {
+            VERIFY_ARE_EQUAL(first->_rows[i].get(), third->_rows[i].get());
+        }
+
+        VERIFY_ARE_EQUAL(L"Hello", third->GetText(origin, { 4, 0 }, false));
+        // The old snapshot is immutable.
+        VERIFY_ARE_NOT_EQUAL(L"Hello", first->GetText(origin, { 4, 0 }, false));
+    }
+
+    TEST_METHOD(SnapshotMatchesTextBuffer)
+    {
+        _pTextBuffer->Write({ L"My name is  Carlos.  This-is a \t test" }, origin);
+        _pTextBuffer->Write({ L"wrapped words" }, { bufferSize.right - 3, 2 });
+
+        auto& cache{ _pUiaData->GetUiaTextSnapshotCache() };
+        const auto snapshot{ cache.Update(*_pTextBuffer, _pUiaData->GetTextBufferEndPosition(), L" -") };
+        const auto documentEnd{ snapshot->GetDocumentEnd() };
+
+        // This test spews out a lot of verify logging by default because of
+        // the loops, so suppress that to only show the failures.
+        SetVerifyOutput settings(VerifyOutputSettings::LogOnlyFailures);
+
+        for (til::CoordType y = 0; y < 4; ++y)
+        {
+            for (auto x = bufferSize.left; x < bufferSize.right; ++x)
+            {
+                const til::point pos{ x, y };
+                VERIFY_ARE_EQUAL(_pTextBuffer->GetWordStart(pos, L" -", true, documentEnd), snapshot->GetWordStart(pos, documentEnd));
+                VERIFY_ARE_EQUAL(_pTextBuffer->GetWordEnd(pos, L" -", true, documentEnd), snapshot->GetWordEnd(pos, documentEnd));
+
+                auto expectedPos{ pos };
+                auto actualPos{ pos };
+                VERIFY_ARE_EQUAL(_pTextBuffer->MoveToNextWord(expectedPos, L" -", documentEnd), snapshot->MoveToNextWord(actualPos, documentEnd));
+                VERIFY_ARE_EQUAL(expectedPos, actualPos);
+
+                expectedPos = pos;
+                actualPos = pos;
+                VERIFY_ARE_EQUAL(_pTextBuffer->MoveToPreviousWord(expectedPos, L" -"), snapshot->MoveToPreviousWord(actualPos));
+                VERIFY_ARE_EQUAL(expectedPos, actualPos);
+            }
+        }
+
+        const til::point inclusiveEnd{ bufferSize.right - 1, 3 };
+        const auto textRects{ _pTextBuffer->GetTextRects(origin, inclusiveEnd, false, true) };
+        std::wstring expectedText;
+        for (const auto& text : _pTextBuffer->GetText(true, false, textRects).text)
+        {
+            expectedText += text;
+        }
+        VERIFY_ARE_EQUAL(expectedText, snapshot->GetText(origin, inclusiveEnd, false));
+    }
+
     TEST_METHOD(ScrollIntoView)
     {
         const auto viewportSize{ _pUiaData->GetViewport() };
@@ -288,6 +288,9 @@ try
     }
 #endif
 
+    // The glyphs of this frame are queued up until Present() and mustn't be evicted until then.
+    _r.glyphs.beginFrame();
+
     if (_api.invalidatedRows == invalidatedRowsAll)
     {
         // Skip all the partial updates, since we redraw everything anyways.
@@ -1440,9 +1443,9 @@ void AtlasEngine::_emplaceGlyph(IDWriteFontFace* fontFace, size_t bufferPos1, si
             coords[i] = _r.tileAllocator.allocate(_r.glyphs);
         }
 
-        const auto it = _r.glyphs.insert(std::move(key), std::move(value));
-        valueRef = &it->second;
-        _r.glyphQueue.emplace_back(&it->first, &it->second);
+        const auto& entry = _r.glyphs.insert(std::move(key), std::move(value));
+        valueRef = &entry.second;
+        _r.glyphQueue.emplace_back(&entry.first, &entry.second);
     }
 
     // For some reason MSVC doesn't understand that valueRef is overwritten in the branch above, resulting in:
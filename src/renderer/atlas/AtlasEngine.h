@@ -7,6 +7,8 @@
 #include <d3d11_1.h>
 #include <dwrite_3.h>
 
+#include <til/lru_map.h>
+
 #include "../../renderer/inc/IRenderEngine.hpp"
 
 namespace Microsoft::Console::Render
@@ -506,6 +508,9 @@ namespace Microsoft::Console::Render
                 return _data.data();
             }
 
+            // The TileHashMap frame this value was last used in.
+            u32 generation = 0;
+
         private:
             SmallObjectOptimizer<AtlasValueData> _data;
 
@@ -523,86 +528,85 @@ namespace Microsoft::Console::Render
 
         struct AtlasKeyHasher
         {
-            using is_transparent = int;
-
             size_t operator()(const AtlasKey& v) const noexcept
             {
                 return v.hash();
             }
-
-            size_t operator()(const std::list<std::pair<AtlasKey, AtlasValue>>::iterator& v) const noexcept
-            {
-                return operator()(v->first);
-            }
         };
 
         struct AtlasKeyEq
         {
-            using is_transparent = int;
-
-            bool operator()(const AtlasKey& a, const std::list<std::pair<AtlasKey, AtlasValue>>::iterator& b) const noexcept
-            {
-                return a == b->first;
-            }
-
-            bool operator()(const std::list<std::pair<AtlasKey, AtlasValue>>::iterator& a, const std::list<std::pair<AtlasKey, AtlasValue>>::iterator& b) const noexcept
+            bool operator()(const AtlasKey& a, const AtlasKey& b) const noexcept
             {
-                return operator()(a->first, b);
+                return a == b;
             }
         };
 
+        // TileHashMap maps glyphs to the tiles they occupy in the atlas texture.
+        // The least recently used glyphs are evicted in batches once TileAllocator
+        // runs out of space. Apart from the very first glyph of a batch, glyphs that
+        // were used in the current frame are never evicted, since they might still
+        // be waiting in the glyphQueue to be drawn into the atlas.
         struct TileHashMap
         {
+            using map_type = til::lru_map<AtlasKey, AtlasValue, AtlasKeyHasher, AtlasKeyEq>;
+
             TileHashMap() noexcept = default;
 
+            // Starts a new frame. Glyphs that are looked up or inserted
+            // from now on are protected from eviction until the next call.
+            void beginFrame() noexcept
+            {
+                _generation++;
+            }
+
             AtlasValue* find(const AtlasKey& key)
             {
-                const auto it = _map.find(key);
-                if (it != _map.end())
+                const auto value = _map.find(key);
+                if (value)
                 {
-                    // Move the key to the head of the LRU queue.
-                    _lru.splice(_lru.begin(), _lru, *it);
-                    return &(*it)->second;
+                    _touch(*value);
                 }
-                return nullptr;
+                return value;
             }
 
-            std::list<std::pair<AtlasKey, AtlasValue>>::iterator insert(AtlasKey&& key, AtlasValue&& value)
+            map_type::value_type& insert(AtlasKey&& key, AtlasValue&& value)
             {
-                // Insert the key/value right at the head of the LRU queue, just like find().
-                //
-                // && decays to & if the argument is named, because C++ is a simple language
-                // and so you have to std::move it again, because C++ is a simple language.
-                _lru.emplace_front(std::move(key), std::move(value));
-                auto it = _lru.begin();
-                _map.emplace(it);
-                return it;
+                auto& entry = _map.insert(std::move(key), std::move(value));
+                _touch(entry.second);
+                return entry;
             }
 
             void popOldestTiles(std::vector<u16x2>& out) noexcept
             {
-                Expects(!_lru.empty());
-                const auto it = --_lru.end();
+                Expects(!_map.empty());
 
-                const auto key = it->first.data();
-                const auto value = it->second.data();
-                const auto beg = &value->coords[0];
-                const auto cellCount = key->attributes.cellCount;
+                // Evicting a batch of glyphs at once means that the following calls to
+                // TileAllocator::allocate() can be served from its cache. The first glyph
+                // is evicted unconditionally, just like TileAllocator has always expected.
+                do
+                {
+                    auto& [key, value] = _map.back();
+                    const auto beg = &value.data()->coords[0];
+                    const auto cellCount = key.data()->attributes.cellCount;
+                    std::copy_n(beg, cellCount, std::back_inserter(out));
+                    _map.pop_back();
+                } while (out.size() < evictionBatchSize && !_map.empty() && _map.back().second.generation != _generation);
+            }
 
-                const auto offset = out.size();
-                out.resize(offset + cellCount);
-                std::copy_n(beg, cellCount, out.begin() + offset);
+        private:
+            static constexpr size_t evictionBatchSize = 32;
 
-                _map.erase(it);
-                _lru.pop_back();
+            // The LRU order already tells us which glyphs were used most recently.
+            // In order to know where the current frame starts we additionally
+            // remember the generation in which each value was last used.
+            void _touch(AtlasValue& value) noexcept
+            {
+                value.generation = _generation;
             }
 
-        private:
-            // Please don't copy this code. It's a proof-of-concept.
-            // If you need a LRU hash-map, write a custom one with an intrusive
-            // prev/next linked list (it's easier than you might think!).
-            std::list<std::pair<AtlasKey, AtlasValue>> _lru;
-            std::unordered_set<std::list<std::pair<AtlasKey, AtlasValue>>::iterator, AtlasKeyHasher, AtlasKeyEq> _map;
+            map_type _map;
+            u32 _generation = 1;
         };
 
         // TileAllocator yields `tileSize`-sized tiles for our texture atlas.
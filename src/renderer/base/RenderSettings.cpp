@@ -191,11 +191,13 @@ std::pair<COLORREF, COLORREF> RenderSettings::GetAttributeColors(const TextAttri
     const auto dimFg = attr.IsFaint() || (_blinkShouldBeFaint && attr.IsBlinking());
     const auto swapFgAndBg = attr.IsReverseVideo() ^ GetRenderMode(Mode::ScreenReversed);
 
-    // We want to nudge the foreground color to make it more perceivable only for the
-    // default color pairs within the color table
-    if (Feature_AdjustIndistinguishableText::IsEnabled() &&
-        GetRenderMode(Mode::DistinguishableColors) &&
-        !dimFg &&
+    const auto adjustFg = Feature_AdjustIndistinguishableText::IsEnabled() &&
+                          GetRenderMode(Mode::DistinguishableColors) &&
+                          !dimFg;
+
+    // We want to nudge the foreground color to make it more perceivable. For the
+    // default color pairs within the color table, the result has been precomputed.
+    if (adjustFg &&
         (fgTextColor.IsDefault() || fgTextColor.IsLegacy()) &&
         (bgTextColor.IsDefault() || bgTextColor.IsLegacy()))
     {
@@ -238,11 +240,54 @@ std::pair<COLORREF, COLORREF> RenderSettings::GetAttributeColors(const TextAttri
         {
             fg = bg;
         }
+        else if (adjustFg && fg != bg)
+        {
+            // Any other combination (for instance RGB or 256-color attributes) is adjusted on
+            // demand. Identical colors are left alone, like they are in the precomputed table.
+            fg = _GetPerceivableColor(fg, bg);
+        }
 
         return { fg, bg };
     }
 }
 
+// Routine Description:
+// - Returns the foreground color adjusted to be perceivable on the background color.
+// - ColorFix::GetPerceivableColor is far too expensive to call for every run of text,
+//   so the results are kept in a direct-mapped cache. Each entry is a single 64-bit
+//   atomic, which makes the cache safe to use from any thread without locking. It holds
+//   a valid flag, the upper 15 bits of the background, the foreground and the adjusted
+//   color. The lower 9 bits of the background don't need to be stored, because they're
+//   implied by the index of the entry, which is derived from both colors.
+// Arguments:
+// - fg - The foreground color.
+// - bg - The background color.
+// Return Value:
+// - The adjusted foreground color.
+COLORREF RenderSettings::_GetPerceivableColor(const COLORREF fg, const COLORREF bg) const noexcept
+{
+    static constexpr uint64_t validFlag = uint64_t{ 1 } << 63;
+    static constexpr uint64_t colorMask = 0xffffff;
+
+    const auto fgRGB = static_cast<uint32_t>(fg & colorMask);
+    const auto bgRGB = static_cast<uint32_t>(bg & colorMask);
+
+    // Mix the foreground into the index, so that different foregrounds on the same background don't collide.
+    const auto fgHash = (fgRGB * 0x9E3779B1u) >> (32 - PerceivableColorCacheIndexBits);
+    const auto index = (bgRGB ^ fgHash) & (PerceivableColorCacheSize - 1);
+    const auto key = validFlag | (uint64_t{ bgRGB >> PerceivableColorCacheIndexBits } << 48) | (uint64_t{ fgRGB } << 24);
+
+    auto& entry = til::at(_perceivableColorCache, index);
+    if (const auto value = entry.load(std::memory_order_relaxed); (value & ~colorMask) == key)
+    {
+        return static_cast<COLORREF>(value & colorMask);
+    }
+
+    const auto adjusted = ColorFix::GetPerceivableColor(fgRGB, bgRGB) & colorMask;
+    entry.store(key | adjusted, std::memory_order_relaxed);
+    return static_cast<COLORREF>(adjusted);
+}
+
 // Routine Description:
 // - Calculates the RGBA colors of a given text attribute, using the current
 //   color table configuration and active render settings. This differs from
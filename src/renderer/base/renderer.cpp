@@ -4,6 +4,8 @@
 #include "precomp.h"
 #include "renderer.hpp"
 
+#include <til/trace.h>
+
 #pragma hdrstop
 
 using namespace Microsoft::Console::Render;
@@ -64,6 +66,7 @@ Renderer::~Renderer()
 // - HRESULT S_OK, GDI error, Safe Math error, or state/argument errors.
 [[nodiscard]] HRESULT Renderer::PaintFrame()
 {
+    TIL_TRACE_SPAN("paint", "Renderer::PaintFrame");
     FOREACH_ENGINE(pEngine)
     {
         auto tries = maxRetriesForRenderEngine;
@@ -129,6 +132,11 @@ try
         return S_OK;
     }
 
+    if (_pfnFrameStarted)
+    {
+        _pfnFrameStarted(pEngine);
+    }
+
     auto endPaint = wil::scope_exit([&]() {
         LOG_IF_FAILED(pEngine->EndPaint());
 
@@ -177,6 +185,11 @@ try
     // Trigger out-of-lock presentation for renderers that can support it
     RETURN_IF_FAILED(pEngine->Present());
 
+    if (_pfnFramePresented)
+    {
+        _pfnFramePresented(pEngine);
+    }
+
     // As we leave the scope, EndPaint will be called (declared above)
     return S_OK;
 }
@@ -657,6 +670,20 @@ void Renderer::WaitForPaintCompletionAndDisable(const DWORD dwTimeoutMs)
     _pThread->WaitForPaintCompletionAndDisable(dwTimeoutMs);
 }
 
+// Routine Description:
+// - Tells the render thread how urgently frames should be painted (see RenderScheduler).
+// Arguments:
+// - priority - Focused, Unfocused, or Hidden if the frames aren't visible at all.
+// Return Value:
+// - <none>
+void Renderer::SetPaintPriority(const PaintPriority priority) noexcept
+{
+    if (_pThread)
+    {
+        _pThread->SetPaintPriority(priority);
+    }
+}
+
 // Routine Description:
 // - Paint helper to fill in the background color of the invalid area within the frame.
 // Arguments:
@@ -1338,6 +1365,30 @@ void Renderer::SetRendererEnteredErrorStateCallback(std::function<void()> pfn)
     _pfnRendererEnteredErrorState = std::move(pfn);
 }
 
+// Method Description:
+// - Registers a callback for when an engine starts painting a frame. It's called
+//   while the console is locked, so it observes the state the frame is painted from.
+// Arguments:
+// - pfn: the callback, which is given the engine that paints the frame
+// Return Value:
+// - <none>
+void Renderer::SetFrameStartedCallback(std::function<void(IRenderEngine*)> pfn)
+{
+    _pfnFrameStarted = std::move(pfn);
+}
+
+// Method Description:
+// - Registers a callback for when an engine has presented a frame.
+//   It's called after the console was unlocked.
+// Arguments:
+// - pfn: the callback, which is given the engine that presented the frame
+// Return Value:
+// - <none>
+void Renderer::SetFramePresentedCallback(std::function<void(IRenderEngine*)> pfn)
+{
+    _pfnFramePresented = std::move(pfn);
+}
+
 // Method Description:
 // - Attempts to restart the renderer.
 void Renderer::ResetErrorStateAndResume()
@@ -80,6 +80,7 @@ namespace Microsoft::Console::Render
 
         void EnablePainting();
         void WaitForPaintCompletionAndDisable(const DWORD dwTimeoutMs);
+        void SetPaintPriority(const PaintPriority priority) noexcept;
         void WaitUntilCanRender();
 
         void AddRenderEngine(_In_ IRenderEngine* const pEngine);
@@ -87,6 +88,8 @@ namespace Microsoft::Console::Render
         void SetBackgroundColorChangedCallback(std::function<void()> pfn);
         void SetFrameColorChangedCallback(std::function<void()> pfn);
         void SetRendererEnteredErrorStateCallback(std::function<void()> pfn);
+        void SetFrameStartedCallback(std::function<void(IRenderEngine*)> pfn);
+        void SetFramePresentedCallback(std::function<void(IRenderEngine*)> pfn);
         void ResetErrorStateAndResume();
 
         void UpdateLastHoveredInterval(const std::optional<interval_tree::IntervalTree<til::point, size_t>::interval>& newInterval);
@@ -126,6 +129,8 @@ namespace Microsoft::Console::Render
         std::function<void()> _pfnBackgroundColorChanged;
         std::function<void()> _pfnFrameColorChanged;
         std::function<void()> _pfnRendererEnteredErrorState;
+        std::function<void(IRenderEngine*)> _pfnFrameStarted;
+        std::function<void(IRenderEngine*)> _pfnFramePresented;
         bool _destructing = false;
         bool _forceUpdateViewport = true;
 
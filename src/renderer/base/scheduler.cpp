@@ -0,0 +1,205 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "scheduler.hpp"
+
+#pragma hdrstop
+
+using namespace Microsoft::Console::Render;
+
+RenderScheduler& RenderScheduler::Shared()
+{
+    // The scheduler is intentionally leaked, because joining its workers
+    // from a static destructor can deadlock during process exit.
+    static const auto scheduler = new RenderScheduler{};
+    return *scheduler;
+}
+
+RenderScheduler::RenderScheduler(const size_t workerCount)
+{
+    const auto count = std::max<size_t>(workerCount, 1);
+    _workers.reserve(count);
+
+    // SetThreadDescription only works on 1607 and higher. If we cannot find it,
+    // then it's no big deal. Just skip setting the description.
+    const auto setThreadDescription = GetProcAddressByFunctionDeclaration(GetModuleHandleW(L"kernel32.dll"), SetThreadDescription);
+
+    // The workers read _workers.size() under the mutex, so they must not run before it's final.
+    const std::scoped_lock lock{ _mutex };
+    for (size_t i = 0; i < count; ++i)
+    {
+        auto& worker = _workers.emplace_back([this]() { _workerLoop(); });
+        if (setThreadDescription)
+        {
+            LOG_IF_FAILED(setThreadDescription(worker.native_handle(), L"Rendering Output Thread"));
+        }
+    }
+}
+
+RenderScheduler::~RenderScheduler()
+{
+    {
+        const std::scoped_lock lock{ _mutex };
+        _stop = true;
+    }
+    _cv.notify_all();
+
+    for (auto& worker : _workers)
+    {
+        worker.join();
+    }
+}
+
+// Routine Description:
+// - Picks the client that should be painted next, if any.
+// - Focused clients go first. Unfocused ones are only painted once UnfocusedFrameInterval
+//   has passed since their last paint and only while at least one worker is left
+//   for the focused ones, so that a busy background pane can't delay the focused pane.
+//   Among clients of the same priority the one that waited the longest goes first.
+// Arguments:
+// - now - The current time.
+// - wakeup - Set to the earliest time at which an unfocused client becomes due, if it's earlier.
+// Return Value:
+// - The client to paint or nullptr.
+RenderScheduler::Client* RenderScheduler::_pickClient(const std::chrono::steady_clock::time_point now, std::chrono::steady_clock::time_point& wakeup) const noexcept
+{
+    const auto unfocusedAllowed = _workers.size() == 1 || _unfocusedPainting + 1 < _workers.size();
+    Client* best = nullptr;
+
+    for (const auto client : _clients)
+    {
+        if (!client->_enabled || client->_painting || client->_priority == PaintPriority::Hidden || !client->_requested.load(std::memory_order_relaxed))
+        {
+            continue;
+        }
+
+        if (client->_priority == PaintPriority::Unfocused)
+        {
+            if (!unfocusedAllowed || (best && best->_priority == PaintPriority::Focused))
+            {
+                continue;
+            }
+
+            const auto due = client->_lastPaint + UnfocusedFrameInterval;
+            if (due > now)
+            {
+                wakeup = std::min(wakeup, due);
+                continue;
+            }
+        }
+
+        if (!best || client->_priority > best->_priority || (client->_priority == best->_priority && client->_lastPaint < best->_lastPaint))
+        {
+            best = client;
+        }
+    }
+
+    return best;
+}
+
+void RenderScheduler::_workerLoop() noexcept
+{
+    std::unique_lock lock{ _mutex };
+
+    while (!_stop)
+    {
+        auto wakeup = std::chrono::steady_clock::time_point::max();
+        const auto client = _pickClient(std::chrono::steady_clock::now(), wakeup);
+
+        if (!client)
+        {
+            if (wakeup == std::chrono::steady_clock::time_point::max())
+            {
+                _cv.wait(lock);
+            }
+            else
+            {
+                _cv.wait_until(lock, wakeup);
+            }
+            continue;
+        }
+
+        // Requests that arrive from here on are for the next frame.
+        client->_requested.store(false, std::memory_order_relaxed);
+        client->_painting = true;
+        const auto unfocused = client->_priority != PaintPriority::Focused;
+        _unfocusedPainting += unfocused;
+
+        lock.unlock();
+        try
+        {
+            client->_paint();
+        }
+        CATCH_LOG();
+        lock.lock();
+
+        _unfocusedPainting -= unfocused;
+        client->_painting = false;
+        client->_lastPaint = std::chrono::steady_clock::now();
+        // Wakes up both the other workers, which may now pick an unfocused
+        // client, and anyone waiting for this paint to complete.
+        _cv.notify_all();
+    }
+}
+
+RenderScheduler::Client::Client(RenderScheduler& scheduler, std::function<void()> paint) :
+    _scheduler{ scheduler },
+    _paint{ std::move(paint) }
+{
+    const std::scoped_lock lock{ _scheduler._mutex };
+    _scheduler._clients.emplace_back(this);
+}
+
+RenderScheduler::Client::~Client()
+{
+    std::unique_lock lock{ _scheduler._mutex };
+    _scheduler._cv.wait(lock, [&]() { return !_painting; });
+    std::erase(_scheduler._clients, this);
+}
+
+void RenderScheduler::Client::RequestPaint() noexcept
+{
+    // A worker clears the flag before it starts painting, so if it's still set,
+    // a paint is pending already and the workers don't need to be woken up.
+    if (!_requested.exchange(true, std::memory_order_relaxed))
+    {
+        // Taking the mutex ensures that no worker is in between checking
+        // for work and going to sleep, which would miss this notification.
+        {
+            const std::scoped_lock lock{ _scheduler._mutex };
+        }
+        _scheduler._cv.notify_all();
+    }
+}
+
+void RenderScheduler::Client::SetEnabled(const bool enabled) noexcept
+{
+    {
+        const std::scoped_lock lock{ _scheduler._mutex };
+        _enabled = enabled;
+    }
+    _scheduler._cv.notify_all();
+}
+
+void RenderScheduler::Client::SetPriority(const PaintPriority priority) noexcept
+{
+    {
+        const std::scoped_lock lock{ _scheduler._mutex };
+        _priority = priority;
+    }
+    _scheduler._cv.notify_all();
+}
+
+bool RenderScheduler::Client::WaitForPaintCompletion(const std::optional<std::chrono::milliseconds> timeout) noexcept
+{
+    std::unique_lock lock{ _scheduler._mutex };
+    const auto done = [&]() { return !_painting; };
+
+    if (!timeout)
+    {
+        _scheduler._cv.wait(lock, done);
+        return true;
+    }
+    return _scheduler._cv.wait_for(lock, *timeout, done);
+}
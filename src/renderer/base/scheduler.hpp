@@ -0,0 +1,95 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- scheduler.hpp
+
+Abstract:
+- Shares a small pool of rendering threads between all renderers of a process,
+  instead of giving each of them a dedicated thread (see RenderThread).
+- Every renderer has a paint priority. The focused one is painted as soon as it
+  asks for it, unfocused ones are painted at most every UnfocusedFrameInterval
+  and hidden ones aren't painted at all. Paint requests of hidden renderers
+  are remembered, so that they're painted once as soon as they're shown again.
+--*/
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+
+namespace Microsoft::Console::Render
+{
+    enum class PaintPriority
+    {
+        Hidden,
+        Unfocused,
+        Focused,
+    };
+
+    class RenderScheduler
+    {
+    public:
+        class Client;
+
+        static constexpr size_t DefaultWorkerCount = 2;
+        static constexpr std::chrono::milliseconds UnfocusedFrameInterval{ 50 };
+
+        // The shared scheduler is created on first use and never destroyed (see Shared()).
+        static RenderScheduler& Shared();
+
+        explicit RenderScheduler(const size_t workerCount = DefaultWorkerCount);
+        ~RenderScheduler();
+
+        RenderScheduler(const RenderScheduler&) = delete;
+        RenderScheduler& operator=(const RenderScheduler&) = delete;
+
+        // A Client represents one renderer. Its paint callback is called by one of the
+        // workers whenever it's the client's turn, but never concurrently with itself.
+        // Clients start out disabled with a priority of PaintPriority::Unfocused.
+        class Client
+        {
+        public:
+            Client(RenderScheduler& scheduler, std::function<void()> paint);
+            // Blocks until a paint that's in progress has finished.
+            ~Client();
+
+            Client(const Client&) = delete;
+            Client& operator=(const Client&) = delete;
+
+            void RequestPaint() noexcept;
+            void SetEnabled(const bool enabled) noexcept;
+            void SetPriority(const PaintPriority priority) noexcept;
+            // Returns false if a paint that's in progress didn't finish in time.
+            bool WaitForPaintCompletion(const std::optional<std::chrono::milliseconds> timeout) noexcept;
+
+        private:
+            friend class RenderScheduler;
+
+            RenderScheduler& _scheduler;
+            std::function<void()> _paint;
+
+            // _requested is set without holding the scheduler's mutex, so that requesting
+            // a paint that's already pending doesn't contend with the workers.
+            // Everything else is guarded by the mutex.
+            std::atomic<bool> _requested{ false };
+            bool _enabled = false;
+            bool _painting = false;
+            PaintPriority _priority = PaintPriority::Unfocused;
+            std::chrono::steady_clock::time_point _lastPaint{};
+        };
+
+    private:
+        void _workerLoop() noexcept;
+        Client* _pickClient(const std::chrono::steady_clock::time_point now, std::chrono::steady_clock::time_point& wakeup) const noexcept;
+
+        std::mutex _mutex;
+        std::condition_variable _cv;
+        std::vector<Client*> _clients;
+        std::vector<std::thread> _workers;
+        // The number of workers currently painting an unfocused client.
+        size_t _unfocusedPainting = 0;
+        bool _stop = false;
+    };
+}
@@ -22,8 +22,20 @@ RenderThread::RenderThread() :
 {
 }
 
+// Routine Description:
+// - Creates a render thread that doesn't own a thread, but paints on the
+//   shared threads of the given scheduler instead.
+RenderThread::RenderThread(RenderScheduler& scheduler) noexcept :
+    RenderThread()
+{
+    _pScheduler = &scheduler;
+}
+
 RenderThread::~RenderThread()
 {
+    // Blocks until a paint that's in progress has finished.
+    _client.reset();
+
     if (_hThread)
     {
         _fKeepRunning = false; // stop loop after final run
@@ -66,6 +78,19 @@ RenderThread::~RenderThread()
 {
     _pRenderer = pRendererParent;
 
+    if (_pScheduler)
+    {
+        try
+        {
+            _client.emplace(*_pScheduler, [this]() {
+                _pRenderer->WaitUntilCanRender();
+                LOG_IF_FAILED(_pRenderer->PaintFrame());
+            });
+            return S_OK;
+        }
+        CATCH_RETURN();
+    }
+
     auto hr = S_OK;
     // Create event before thread as thread will start immediately.
     if (SUCCEEDED(hr))
@@ -221,7 +246,11 @@ DWORD WINAPI RenderThread::_ThreadProc()
 
 void RenderThread::NotifyPaint() noexcept
 {
-    if (_fWaiting.load(std::memory_order_acquire))
+    if (_client)
+    {
+        _client->RequestPaint();
+    }
+    else if (_fWaiting.load(std::memory_order_acquire))
     {
         SetEvent(_hEvent);
     }
@@ -233,14 +262,38 @@ void RenderThread::NotifyPaint() noexcept
 
 void RenderThread::EnablePainting() noexcept
 {
+    if (_client)
+    {
+        _client->SetEnabled(true);
+        return;
+    }
+
     SetEvent(_hPaintEnabledEvent);
 }
 
 void RenderThread::DisablePainting() noexcept
 {
+    if (_client)
+    {
+        _client->SetEnabled(false);
+        return;
+    }
+
     ResetEvent(_hPaintEnabledEvent);
 }
 
+// Routine Description:
+// - Sets how urgently the scheduler paints this thread's frames. Panes that
+//   aren't focused are throttled and those that aren't visible aren't painted
+//   until they're visible again. It has no effect without a scheduler.
+void RenderThread::SetPaintPriority(const PaintPriority priority) noexcept
+{
+    if (_client)
+    {
+        _client->SetPriority(priority);
+    }
+}
+
 void RenderThread::WaitForPaintCompletionAndDisable(const DWORD dwTimeoutMs) noexcept
 {
     // When rendering takes place via DirectX, and a console application
@@ -294,6 +347,18 @@ void RenderThread::WaitForPaintCompletionAndDisable(const DWORD dwTimeoutMs) noe
     //       DirectX on OneCoreUAP times out while switching console
     //       applications.
 
+    if (_client)
+    {
+        _client->SetEnabled(false);
+        std::optional<std::chrono::milliseconds> timeout;
+        if (dwTimeoutMs != INFINITE)
+        {
+            timeout.emplace(dwTimeoutMs);
+        }
+        _client->WaitForPaintCompletion(timeout);
+        return;
+    }
+
     ResetEvent(_hPaintEnabledEvent);
     WaitForSingleObject(_hPaintCompletedEvent, dwTimeoutMs);
 }
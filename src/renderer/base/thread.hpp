@@ -14,6 +14,8 @@ Author(s):
 
 #pragma once
 
+#include "scheduler.hpp"
+
 namespace Microsoft::Console::Render
 {
     class Renderer;
@@ -22,6 +24,7 @@ namespace Microsoft::Console::Render
     {
     public:
         RenderThread();
+        explicit RenderThread(RenderScheduler& scheduler) noexcept;
         ~RenderThread();
 
         [[nodiscard]] HRESULT Initialize(Renderer* const pRendererParent) noexcept;
@@ -30,6 +33,7 @@ namespace Microsoft::Console::Render
         void EnablePainting() noexcept;
         void DisablePainting() noexcept;
         void WaitForPaintCompletionAndDisable(const DWORD dwTimeoutMs) noexcept;
+        void SetPaintPriority(const PaintPriority priority) noexcept;
 
     private:
         static DWORD WINAPI s_ThreadProc(_In_ LPVOID lpParameter);
@@ -46,5 +50,9 @@ namespace Microsoft::Console::Render
         bool _fKeepRunning;
         std::atomic<bool> _fNextFrameRequested;
         std::atomic<bool> _fWaiting;
+
+        // If a scheduler is given, it paints on one of its shared threads instead of _hThread.
+        RenderScheduler* _pScheduler = nullptr;
+        std::optional<RenderScheduler::Client> _client;
     };
 }
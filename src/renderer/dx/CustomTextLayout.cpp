@@ -162,14 +162,40 @@ try
     _formatInUse = _fontRenderData->TextFormatWithAttribute(weight, style, stretch).Get();
     _fontInUse = _fontRenderData->FontFaceWithAttribute(weight, style, stretch).Get();
 
-    RETURN_IF_FAILED(_AnalyzeTextComplexity());
-    RETURN_IF_FAILED(_AnalyzeRuns());
-    RETURN_IF_FAILED(_ShapeGlyphRuns());
-    RETURN_IF_FAILED(_CorrectGlyphRuns());
-    // Correcting box drawing has to come after both font fallback and
-    // the glyph run advance correction (which will apply a font size scaling factor).
-    // We need to know all the proposed X and Y dimension metrics to get this right.
-    RETURN_IF_FAILED(_CorrectBoxDrawing());
+    // The same text tends to be drawn over and over again, be it the lines that
+    // didn't change since the last frame or those that are scrolled back into view.
+    // The key is a member, so that its buffers are reused from one call to the next.
+    _shapingKey.text.assign(_text);
+    _shapingKey.columns.assign(_textClusterColumns.begin(), _textClusterColumns.end());
+    _shapingKey.fontFace = _fontInUse;
+    _shapingKey.weight = gsl::narrow_cast<uint32_t>(weight);
+    _shapingKey.style = gsl::narrow_cast<uint32_t>(style);
+    _shapingKey.cellWidth = gsl::narrow_cast<float>(_width);
+
+    const auto& shaped = _shapingCache.GetOrShape(_shapingKey, [&](const ShapingKey&, ShapedText& result) {
+        THROW_IF_FAILED(_AnalyzeTextComplexity());
+        THROW_IF_FAILED(_AnalyzeRuns());
+        THROW_IF_FAILED(_ShapeGlyphRuns());
+        THROW_IF_FAILED(_CorrectGlyphRuns());
+        // Correcting box drawing has to come after both font fallback and
+        // the glyph run advance correction (which will apply a font size scaling factor).
+        // We need to know all the proposed X and Y dimension metrics to get this right.
+        THROW_IF_FAILED(_CorrectBoxDrawing());
+
+        result.runs = _runs;
+        result.glyphClusters = _glyphClusters;
+        result.glyphIndices = _glyphIndices;
+        result.glyphAdvances = _glyphAdvances;
+        result.glyphOffsets = _glyphOffsets;
+    });
+
+    // On a miss this copies the results right back, but it keeps the
+    // drawing code oblivious of whether they came from the cache.
+    _runs.assign(shaped.runs.begin(), shaped.runs.end());
+    _glyphClusters.assign(shaped.glyphClusters.begin(), shaped.glyphClusters.end());
+    _glyphIndices.assign(shaped.glyphIndices.begin(), shaped.glyphIndices.end());
+    _glyphAdvances.assign(shaped.glyphAdvances.begin(), shaped.glyphAdvances.end());
+    _glyphOffsets.assign(shaped.glyphOffsets.begin(), shaped.glyphOffsets.end());
 
     RETURN_IF_FAILED(_DrawGlyphRuns(clientDrawingContext, renderer, { originX, originY }));
 
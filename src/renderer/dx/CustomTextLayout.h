@@ -12,6 +12,7 @@
 
 #include "BoxDrawingEffect.h"
 #include "DxFontRenderData.h"
+#include "ShapedRunCache.h"
 #include "../inc/Cluster.hpp"
 
 namespace Microsoft::Console::Render
@@ -148,6 +149,16 @@ namespace Microsoft::Console::Render
 
         [[nodiscard]] static constexpr UINT32 _EstimateGlyphCount(const UINT32 textLength) noexcept;
 
+        // The results of analyzing, shaping and correcting a piece of text that drawing it requires.
+        struct ShapedText
+        {
+            std::vector<LinkedRun> runs;
+            std::vector<UINT16> glyphClusters;
+            std::vector<UINT16> glyphIndices;
+            std::vector<float> glyphAdvances;
+            std::vector<DWRITE_GLYPH_OFFSET> glyphOffsets;
+        };
+
     private:
         // DirectWrite font render data
         DxFontRenderData* _fontRenderData;
@@ -206,6 +217,10 @@ namespace Microsoft::Console::Render
         // These are used to further break the runs apart and adjust the font size so glyphs fit inside the cells.
         std::vector<ScaleCorrection> _glyphScaleCorrections;
 
+        // Draw() skips the layout process for text it has drawn before.
+        ShapingKey _shapingKey;
+        ShapedRunCache<ShapedText> _shapingCache;
+
 #ifdef UNIT_TESTING
     public:
         CustomTextLayout() = default;
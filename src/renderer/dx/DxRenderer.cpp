@@ -69,8 +69,7 @@ using namespace Microsoft::Console::Types;
 // TODO GH 2683: The default constructor should not throw.
 DxEngine::DxEngine() :
     RenderEngineBase(),
-    _pool{ til::pmr::get_default_resource() },
-    _invalidMap{ &_pool },
+    _invalidMap{},
     _invalidScroll{},
     _allInvalid{ false },
     _firstFrame{ true },
@@ -0,0 +1,121 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#pragma once
+
+#include <til/hash.h>
+#include <til/lru_map.h>
+
+namespace Microsoft::Console::Render
+{
+    // Identifies a piece of text together with everything that influences how it's shaped.
+    // The font features and axes aren't part of it, because a cache only ever lives as long as
+    // the CustomTextLayout that owns it, which is recreated whenever they change.
+    struct ShapingKey
+    {
+        std::wstring text;
+        // The number of columns each code unit of the text occupies (see CustomTextLayout::_textClusterColumns).
+        std::vector<uint16_t> columns;
+        // The identity of the font face the text is drawn with.
+        const void* fontFace = nullptr;
+        uint32_t weight = 0;
+        uint32_t style = 0;
+        float cellWidth = 0;
+
+        bool operator==(const ShapingKey& other) const noexcept
+        {
+            return text == other.text &&
+                   columns == other.columns &&
+                   fontFace == other.fontFace &&
+                   weight == other.weight &&
+                   style == other.style &&
+                   cellWidth == other.cellWidth;
+        }
+    };
+
+    struct ShapingKeyHash
+    {
+        size_t operator()(const ShapingKey& key) const noexcept
+        {
+            til::hasher h;
+            h.write(key.text);
+            h.write(key.columns.data(), key.columns.size());
+            h.write(key.fontFace);
+            h.write(key.weight);
+            h.write(key.style);
+            h.write(key.cellWidth);
+            return h.finalize();
+        }
+    };
+
+    // ShapedRunCache remembers the results of shaping text, so that text that is drawn again,
+    // like the unchanged lines of the previous frame or lines scrolled back into view, doesn't
+    // have to be analyzed and shaped from scratch. The least recently used results are evicted
+    // once the cache holds Capacity of them.
+    // The cache doesn't know how text is shaped: Shaped is whatever the shaper produces and
+    // GetOrShape() calls the given shaper on misses. This keeps it testable with a fake shaper.
+    template<typename Shaped>
+    class ShapedRunCache
+    {
+    public:
+        static constexpr size_t DefaultCapacity = 1024;
+
+        explicit ShapedRunCache(size_t capacity = DefaultCapacity) noexcept :
+            _capacity{ std::max<size_t>(capacity, 1) }
+        {
+        }
+
+        // Returns the cached result for the key or calls shape(key, result) to produce it.
+        // If the shaper throws, nothing is cached and the exception is passed on.
+        template<typename Shaper>
+        const Shaped& GetOrShape(const ShapingKey& key, Shaper&& shape)
+        {
+            if (const auto cached = _map.find(key))
+            {
+                _hits++;
+                return *cached;
+            }
+
+            _misses++;
+            Shaped shaped{};
+            shape(key, shaped);
+
+            if (_map.size() >= _capacity)
+            {
+                _map.pop_back();
+            }
+            return _map.insert(ShapingKey{ key }, std::move(shaped)).second;
+        }
+
+        void Clear() noexcept
+        {
+            _map.clear();
+        }
+
+        size_t Size() const noexcept
+        {
+            return _map.size();
+        }
+
+        size_t Capacity() const noexcept
+        {
+            return _capacity;
+        }
+
+        size_t Hits() const noexcept
+        {
+            return _hits;
+        }
+
+        size_t Misses() const noexcept
+        {
+            return _misses;
+        }
+
+    private:
+        til::lru_map<ShapingKey, Shaped, ShapingKeyHash> _map;
+        size_t _capacity;
+        size_t _hits = 0;
+        size_t _misses = 0;
+    };
+}
@@ -0,0 +1,122 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "WexTestClass.h"
+#include "../../inc/consoletaeftemplates.hpp"
+
+#include "../ShapedRunCache.h"
+
+using namespace WEX::Common;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+
+using namespace Microsoft::Console::Render;
+
+class ShapedRunCacheTests
+{
+    TEST_CLASS(ShapedRunCacheTests);
+
+    // Stands in for DirectWrite: "shapes" text into one glyph per code unit and counts how often it's called.
+    struct FakeShaper
+    {
+        size_t calls = 0;
+
+        void operator()(const ShapingKey& key, std::vector<uint16_t>& glyphs)
+        {
+            calls++;
+            glyphs.assign(key.text.begin(), key.text.end());
+        }
+    };
+
+    static ShapingKey _key(const std::wstring_view text, const void* fontFace = nullptr)
+    {
+        ShapingKey key;
+        key.text = text;
+        key.columns.assign(text.size(), 1);
+        key.fontFace = fontFace;
+        key.weight = 400;
+        key.cellWidth = 8.0f;
+        return key;
+    }
+
+    TEST_METHOD(ShapesEachKeyOnce)
+    {
+        ShapedRunCache<std::vector<uint16_t>> cache;
+        FakeShaper shaper;
+
+        const auto& glyphs = cache.GetOrShape(_key(L"abc"), shaper);
+        VERIFY_ARE_EQUAL(3u, glyphs.size());
+        VERIFY_ARE_EQUAL(uint16_t{ L'b' }, glyphs[1]);
+
+        cache.GetOrShape(_key(L"abc"), shaper);
+        VERIFY_ARE_EQUAL(1u, shaper.calls);
+        VERIFY_ARE_EQUAL(1u, cache.Hits());
+        VERIFY_ARE_EQUAL(1u, cache.Misses());
+    }
+
+    TEST_METHOD(EveryPartOfTheKeyMatters)
+    {
+        ShapedRunCache<std::vector<uint16_t>> cache;
+        FakeShaper shaper;
+        const int fontFaces[2]{};
+
+        const auto base = _key(L"abc", &fontFaces[0]);
+        cache.GetOrShape(base, shaper);
+
+        auto key = base;
+        key.fontFace = &fontFaces[1];
+        cache.GetOrShape(key, shaper);
+
+        key = base;
+        key.weight = 700;
+        cache.GetOrShape(key, shaper);
+
+        key = base;
+        key.style = 2;
+        cache.GetOrShape(key, shaper);
+
+        key = base;
+        key.cellWidth = 9.0f;
+        cache.GetOrShape(key, shaper);
+
+        key = base;
+        key.columns[2] = 2;
+        cache.GetOrShape(key, shaper);
+
+        VERIFY_ARE_EQUAL(6u, shaper.calls);
+        VERIFY_ARE_EQUAL(6u, cache.Size());
+    }
+
+    TEST_METHOD(EvictsLeastRecentlyUsed)
+    {
+        ShapedRunCache<std::vector<uint16_t>> cache{ 2 };
+        FakeShaper shaper;
+
+        cache.GetOrShape(_key(L"a"), shaper);
+        cache.GetOrShape(_key(L"b"), shaper);
+        // "a" is now more recently used than "b".
+        cache.GetOrShape(_key(L"a"), shaper);
+        cache.GetOrShape(_key(L"c"), shaper);
+        VERIFY_ARE_EQUAL(2u, cache.Size());
+        VERIFY_ARE_EQUAL(3u, shaper.calls);
+
+        cache.GetOrShape(_key(L"a"), shaper);
+        VERIFY_ARE_EQUAL(3u, shaper.calls);
+        cache.GetOrShape(_key(L"b"), shaper);
+        VERIFY_ARE_EQUAL(4u, shaper.calls);
+    }
+
+    TEST_METHOD(FailedShapingIsNotCached)
+    {
+        ShapedRunCache<std::vector<uint16_t>> cache;
+        FakeShaper shaper;
+
+        VERIFY_THROWS(cache.GetOrShape(_key(L"abc"), [](const ShapingKey&, std::vector<uint16_t>&) { throw std::runtime_error{ "shaping failed" }; }),
+                      std::runtime_error);
+        VERIFY_ARE_EQUAL(0u, cache.Size());
+
+        cache.GetOrShape(_key(L"abc"), shaper);
+        VERIFY_ARE_EQUAL(1u, shaper.calls);
+    }
+};
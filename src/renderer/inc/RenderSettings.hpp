@@ -44,10 +44,17 @@ namespace Microsoft::Console::Render
         void ToggleBlinkRendition(class Renderer& renderer) noexcept;
 
     private:
+        // The number of entries in the _perceivableColorCache (2^9). See _GetPerceivableColor.
+        static constexpr size_t PerceivableColorCacheIndexBits = 9;
+        static constexpr size_t PerceivableColorCacheSize = size_t{ 1 } << PerceivableColorCacheIndexBits;
+
+        COLORREF _GetPerceivableColor(const COLORREF fg, const COLORREF bg) const noexcept;
+
         til::enumset<Mode> _renderMode{ Mode::BlinkAllowed, Mode::IntenseIsBright };
         std::array<COLORREF, TextColor::TABLE_SIZE> _colorTable;
         std::array<size_t, static_cast<size_t>(ColorAlias::ENUM_COUNT)> _colorAliasIndices;
         std::array<std::array<COLORREF, 18>, 18> _adjustedForegroundColors;
+        mutable std::array<std::atomic<uint64_t>, PerceivableColorCacheSize> _perceivableColorCache{};
         size_t _blinkCycle = 0;
         mutable bool _blinkIsInUse = false;
         bool _blinkShouldBeFaint = false;
@@ -10,6 +10,8 @@
 #include <conio.h>
 #include <cstdarg>
 
+#include <til/trace.h>
+
 #pragma hdrstop
 
 using namespace Microsoft::Console;
@@ -31,8 +33,7 @@ VtEngine::VtEngine(_In_ wil::unique_hfile pipe,
     _hFile(std::move(pipe)),
     _lastTextAttributes(INVALID_COLOR, INVALID_COLOR),
     _lastViewport(initialViewport),
-    _pool(til::pmr::get_default_resource()),
-    _invalidMap(initialViewport.Dimensions(), false, &_pool),
+    _invalidMap(initialViewport.Dimensions()),
     _scrollDelta(0, 0),
     _quickReturn(false),
     _clearedAllThisFrame(false),
@@ -136,6 +137,7 @@ CATCH_RETURN();
 
 [[nodiscard]] HRESULT VtEngine::_Flush() noexcept
 {
+    TIL_TRACE_SPAN("flush", "VtEngine::_Flush");
 #ifdef UNIT_TESTING
     if (_hFile.get() == INVALID_HANDLE_VALUE)
     {
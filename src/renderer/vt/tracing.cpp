@@ -167,7 +167,7 @@ void RenderTracing::TraceInvalidateScroll(const til::point scroll) const
 }
 
 void RenderTracing::TraceStartPaint(const bool quickReturn,
-                                    const til::pmr::bitmap& invalidMap,
+                                    const til::dirty_region& invalidMap,
                                     const til::rect& lastViewport,
                                     const til::point scrollDelt,
                                     const bool cursorMoved,
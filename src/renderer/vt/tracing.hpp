@@ -40,7 +40,7 @@ namespace Microsoft::Console::VirtualTerminal
         void TraceTriggerCircling(const bool newFrame) const;
         void TraceInvalidateScroll(const til::point scroll) const;
         void TraceStartPaint(const bool quickReturn,
-                             const til::pmr::bitmap& invalidMap,
+                             const til::dirty_region& invalidMap,
                              const til::rect& lastViewport,
                              const til::point scrollDelta,
                              const bool cursorMoved,
@@ -102,8 +102,7 @@ namespace Microsoft::Console::Render
 
         Microsoft::Console::Types::Viewport _lastViewport;
 
-        std::pmr::unsynchronized_pool_resource _pool;
-        til::pmr::bitmap _invalidMap;
+        til::dirty_region _invalidMap;
 
         til::point _lastText;
         til::point _scrollDelta;
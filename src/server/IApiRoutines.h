@@ -42,6 +42,9 @@ public:
                                           _Out_ IConsoleOutputObject** const ppOutputObject);
 */
 
+    // Called with the console locked when a client process disconnects, before its data is freed.
+    virtual void ClientDisconnectedImpl() noexcept = 0;
+
 #pragma endregion
 
     virtual ~IApiRoutines() = default;
@@ -558,6 +558,10 @@ PCONSOLE_API_MSG IoDispatchers::ConsoleClientDisconnectRoutine(_In_ PCONSOLE_API
 
     Tracing::s_TraceConsoleAttachDetach(pProcessData, false);
 
+    LockConsole();
+    pMessage->_pApiRoutines->ClientDisconnectedImpl();
+    UnlockConsole();
+
     LOG_IF_FAILED(RemoveConsole(pProcessData));
 
     pMessage->SetReplyStatus(STATUS_SUCCESS);
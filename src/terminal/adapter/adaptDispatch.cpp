@@ -10,6 +10,8 @@
 #include "../../inc/unicode.hpp"
 #include "../parser/ascii.hpp"
 
+#include <til/trace.h>
+
 using namespace Microsoft::Console::Types;
 using namespace Microsoft::Console::Render;
 using namespace Microsoft::Console::VirtualTerminal;
@@ -54,6 +56,7 @@ void AdaptDispatch::Print(const wchar_t wchPrintable)
 // - <none>
 void AdaptDispatch::PrintString(const std::wstring_view string)
 {
+    TIL_TRACE_SPAN("write", "AdaptDispatch::PrintString");
     if (_termOutput.NeedToTranslate())
     {
         std::wstring buffer;
@@ -2610,32 +2613,35 @@ ITermDispatch::StringHandler AdaptDispatch::DownloadDRCS(const VTInt fontNumber,
         return nullptr;
     }
 
-    return [=](const auto ch) {
+    return [=](const std::wstring_view string) {
         // We pass the data string straight through to the font buffer class
         // until we receive an ESC, indicating the end of the string. At that
         // point we can finalize the buffer, and if valid, update the renderer
         // with the constructed bit pattern.
-        if (ch != AsciiChars::ESC)
-        {
-            _fontBuffer->AddSixelData(ch);
-        }
-        else if (_fontBuffer->FinalizeSixelData())
+        for (const auto ch : string)
         {
-            // We also need to inform the character set mapper of the ID that
-            // will map to this font (we only support one font buffer so there
-            // will only ever be one active dynamic character set).
-            if (charsetSize == DispatchTypes::DrcsCharsetSize::Size96)
+            if (ch != AsciiChars::ESC)
             {
-                _termOutput.SetDrcs96Designation(_fontBuffer->GetDesignation());
+                _fontBuffer->AddSixelData(ch);
             }
-            else
+            else if (_fontBuffer->FinalizeSixelData())
             {
-                _termOutput.SetDrcs94Designation(_fontBuffer->GetDesignation());
+                // We also need to inform the character set mapper of the ID that
+                // will map to this font (we only support one font buffer so there
+                // will only ever be one active dynamic character set).
+                if (charsetSize == DispatchTypes::DrcsCharsetSize::Size96)
+                {
+                    _termOutput.SetDrcs96Designation(_fontBuffer->GetDesignation());
+                }
+                else
+                {
+                    _termOutput.SetDrcs94Designation(_fontBuffer->GetDesignation());
+                }
+                const auto bitPattern = _fontBuffer->GetBitPattern();
+                const auto cellSize = _fontBuffer->GetCellSize();
+                const auto centeringHint = _fontBuffer->GetTextCenteringHint();
+                _renderer.UpdateSoftFont(bitPattern, cellSize, centeringHint);
             }
-            const auto bitPattern = _fontBuffer->GetBitPattern();
-            const auto cellSize = _fontBuffer->GetCellSize();
-            const auto centeringHint = _fontBuffer->GetTextCenteringHint();
-            _renderer.UpdateSoftFont(bitPattern, cellSize, centeringHint);
         }
         return true;
     };
@@ -2679,45 +2685,52 @@ ITermDispatch::StringHandler AdaptDispatch::_RestoreColorTable()
         return _CreatePassthroughHandler();
     }
 
-    return [this, parameter = VTInt{}, parameters = std::vector<VTParameter>{}](const auto ch) mutable {
-        if (ch >= L'0' && ch <= L'9')
+    return [this, parameter = VTInt{}, parameters = std::vector<VTParameter>{}](const std::wstring_view string) mutable {
+        for (const auto ch : string)
         {
-            parameter *= 10;
-            parameter += (ch - L'0');
-            parameter = std::min(parameter, MAX_PARAMETER_VALUE);
-        }
-        else if (ch == L';')
-        {
-            if (parameters.size() < 5)
+            if (ch >= L'0' && ch <= L'9')
             {
-                parameters.push_back(parameter);
+                parameter *= 10;
+                parameter += (ch - L'0');
+                parameter = std::min(parameter, MAX_PARAMETER_VALUE);
             }
-            parameter = 0;
-        }
-        else if (ch == L'/' || ch == AsciiChars::ESC)
-        {
-            parameters.push_back(parameter);
-            const auto colorParameters = VTParameters{ parameters.data(), parameters.size() };
-            const auto colorNumber = colorParameters.at(0).value_or(0);
-            if (colorNumber < TextColor::TABLE_SIZE)
+            else if (ch == L';')
             {
-                const auto colorModel = DispatchTypes::ColorModel{ colorParameters.at(1) };
-                const auto x = colorParameters.at(2).value_or(0);
-                const auto y = colorParameters.at(3).value_or(0);
-                const auto z = colorParameters.at(4).value_or(0);
-                if (colorModel == DispatchTypes::ColorModel::HLS)
+                if (parameters.size() < 5)
                 {
-                    SetColorTableEntry(colorNumber, Utils::ColorFromHLS(x, y, z));
+                    parameters.push_back(parameter);
                 }
-                else if (colorModel == DispatchTypes::ColorModel::RGB)
+                parameter = 0;
+            }
+            else if (ch == L'/' || ch == AsciiChars::ESC)
+            {
+                parameters.push_back(parameter);
+                const auto colorParameters = VTParameters{ parameters.data(), parameters.size() };
+                const auto colorNumber = colorParameters.at(0).value_or(0);
+                if (colorNumber < TextColor::TABLE_SIZE)
                 {
-                    SetColorTableEntry(colorNumber, Utils::ColorFromRGB100(x, y, z));
+                    const auto colorModel = DispatchTypes::ColorModel{ colorParameters.at(1) };
+                    const auto x = colorParameters.at(2).value_or(0);
+                    const auto y = colorParameters.at(3).value_or(0);
+                    const auto z = colorParameters.at(4).value_or(0);
+                    if (colorModel == DispatchTypes::ColorModel::HLS)
+                    {
+                        SetColorTableEntry(colorNumber, Utils::ColorFromHLS(x, y, z));
+                    }
+                    else if (colorModel == DispatchTypes::ColorModel::RGB)
+                    {
+                        SetColorTableEntry(colorNumber, Utils::ColorFromRGB100(x, y, z));
+                    }
                 }
+                parameters.clear();
+                parameter = 0;
+            }
+            if (ch == AsciiChars::ESC)
+            {
+                return false;
             }
-            parameters.clear();
-            parameter = 0;
         }
-        return (ch != AsciiChars::ESC);
+        return true;
     };
 }
 
@@ -2738,32 +2751,32 @@ ITermDispatch::StringHandler AdaptDispatch::RequestSetting()
     // say that 0 is for a valid response, and 1 is for an error. The correct
     // interpretation is documented in the DEC STD 070 reference.
     const auto idBuilder = std::make_shared<VTIDBuilder>();
-    return [=](const auto ch) {
-        if (ch >= '\x40' && ch <= '\x7e')
+    return [=](const std::wstring_view string) {
+        for (const auto ch : string)
         {
-            const auto id = idBuilder->Finalize(ch);
-            switch (id)
+            if (ch >= '\x40' && ch <= '\x7e')
             {
-            case VTID('m'):
-                _ReportSGRSetting();
-                break;
-            case VTID('r'):
-                _ReportDECSTBMSetting();
-                break;
-            default:
-                _api.ReturnResponse(L"\033P0$r\033\\");
-                break;
+                const auto id = idBuilder->Finalize(ch);
+                switch (id)
+                {
+                case VTID('m'):
+                    _ReportSGRSetting();
+                    break;
+                case VTID('r'):
+                    _ReportDECSTBMSetting();
+                    break;
+                default:
+                    _api.ReturnResponse(L"\033P0$r\033\\");
+                    break;
+                }
+                return false;
             }
-            return false;
-        }
-        else
-        {
-            if (ch >= '\x20' && ch <= '\x2f')
+            else if (ch >= '\x20' && ch <= '\x2f')
             {
                 idBuilder->AddIntermediate(ch);
             }
-            return true;
         }
+        return true;
     };
 }
 
@@ -2912,13 +2925,13 @@ ITermDispatch::StringHandler AdaptDispatch::_CreatePassthroughHandler()
         // And finally we create a StringHandler to receive the rest of the
         // sequence data, and pass it through to the connected terminal.
         auto& engine = stateMachine.Engine();
-        return [&, buffer = std::wstring{}](const auto ch) mutable {
+        return [&, buffer = std::wstring{}](const std::wstring_view string) mutable {
             // To make things more efficient, we buffer the string data before
             // passing it through, only flushing if the buffer gets too large,
             // or we're dealing with the last character in the current output
             // fragment, or we've reached the end of the string.
-            const auto endOfString = ch == AsciiChars::ESC;
-            buffer += ch;
+            const auto endOfString = string == L"\033";
+            buffer += string;
             if (buffer.length() >= 4096 || stateMachine.IsProcessingLastCharacter() || endOfString)
             {
                 // The end of the string is signaled with an escape, but for it
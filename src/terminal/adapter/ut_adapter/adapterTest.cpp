@@ -1517,11 +1517,8 @@ public:
     {
         const auto requestSetting = [=](const std::wstring_view settingId = {}) {
             const auto stringHandler = _pDispatch->RequestSetting();
-            for (auto ch : settingId)
-            {
-                stringHandler(ch);
-            }
-            stringHandler(L'\033'); // String terminator
+            stringHandler(settingId);
+            stringHandler(L"\033"); // String terminator
         };
 
         Log::Comment(L"Requesting DECSTBM margins (5 to 10).");
@@ -20,7 +20,9 @@ namespace Microsoft::Console::VirtualTerminal
     class IStateMachineEngine
     {
     public:
-        using StringHandler = std::function<bool(const wchar_t)>;
+        // Receives the data of a DCS string in one or more contiguous chunks. The end of the string
+        // is signaled with a chunk consisting of a single ESC. Returning false ignores the remainder.
+        using StringHandler = std::function<bool(const std::wstring_view)>;
 
         virtual ~IStateMachineEngine() = 0;
         IStateMachineEngine(const IStateMachineEngine&) = default;
@@ -44,6 +46,10 @@ namespace Microsoft::Console::VirtualTerminal
 
         virtual bool ActionIgnore() = 0;
 
+        // Receives the data of an OSC string with the given parameter as it arrives, in one or more chunks, before
+        // ActionOscDispatch is called. Returning false collects it into the string passed to ActionOscDispatch instead.
+        virtual bool ActionOscPut(const size_t parameter, const std::wstring_view string) = 0;
+
         virtual bool ActionOscDispatch(const wchar_t wch,
                                        const size_t parameter,
                                        const std::wstring_view string) = 0;
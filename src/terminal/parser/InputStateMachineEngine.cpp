@@ -524,6 +524,19 @@ bool InputStateMachineEngine::ActionIgnore() noexcept
     return true;
 }
 
+// Method Description:
+// - Receives the data of an OSC string as it arrives. We don't handle any OSC sequences,
+//   so the data is just collected as usual.
+// Arguments:
+// - parameter - identifier of the OSC action
+// - string - the next chunk of the OSC string
+// Return Value:
+// - false, to collect the data for ActionOscDispatch.
+bool InputStateMachineEngine::ActionOscPut(const size_t /*parameter*/, const std::wstring_view /*string*/) noexcept
+{
+    return false;
+}
+
 // Method Description:
 // - Triggers the OscDispatch action to indicate that the listener should handle a control sequence.
 //   These sequences perform various API-type commands that can include many parameters.
@@ -156,6 +156,8 @@ namespace Microsoft::Console::VirtualTerminal
 
         bool ActionIgnore() noexcept override;
 
+        bool ActionOscPut(const size_t parameter, const std::wstring_view string) noexcept override;
+
         bool ActionOscDispatch(const wchar_t wch,
                                const size_t parameter,
                                const std::wstring_view string) noexcept override;
@@ -5,7 +5,6 @@
 #include "OutputStateMachineEngine.hpp"
 
 #include "ascii.hpp"
-#include "base64.hpp"
 #include "stateMachine.hpp"
 #include "../../types/inc/utils.hpp"
 #include "../renderer/vt/vtrenderer.hpp"
@@ -692,7 +691,7 @@ IStateMachineEngine::StringHandler OutputStateMachineEngine::ActionDcsDispatch(c
 // - <none>
 bool OutputStateMachineEngine::ActionClear() noexcept
 {
-    // do nothing.
+    _ResetOscSetClipboard();
     return true;
 }
 
@@ -709,6 +708,25 @@ bool OutputStateMachineEngine::ActionIgnore() noexcept
     return true;
 }
 
+// Routine Description:
+// - Receives the data of an OSC string as it arrives. Only the payload of OSC 52 is
+//   consumed right away, everything else is collected for ActionOscDispatch.
+// Arguments:
+// - parameter - identifier of the OSC action
+// - string - the next chunk of the OSC string
+// Return Value:
+// - true if we consumed the data.
+bool OutputStateMachineEngine::ActionOscPut(const size_t parameter, const std::wstring_view string) noexcept
+{
+    if (parameter != OscActionCodes::SetClipboard)
+    {
+        return false;
+    }
+
+    _PutOscSetClipboard(string);
+    return true;
+}
+
 // Routine Description:
 // - Triggers the OscDispatch action to indicate that the listener should handle a control sequence.
 //   These sequences perform various API-type commands that can include many parameters.
@@ -803,7 +821,7 @@ bool OutputStateMachineEngine::ActionOscDispatch(const wchar_t /*wch*/,
     {
         std::wstring setClipboardContent;
         auto queryClipboard = false;
-        success = _GetOscSetClipboard(string, setClipboardContent, queryClipboard);
+        success = _GetOscSetClipboard(setClipboardContent, queryClipboard);
         if (success && !queryClipboard)
         {
             success = _dispatch->SetClipboard(setClipboardContent);
@@ -1053,26 +1071,53 @@ void OutputStateMachineEngine::SetTerminalConnection(Render::VtEngine* const pTt
 }
 
 // Routine Description:
-// - Parse OscSetClipboard parameters with the format `Pc;Pd`. Currently the first parameter `Pc` is
-// ignored. The second parameter `Pd` should be a valid base64 string or character `?`.
+// - Parses the next chunk of the OscSetClipboard parameters with the format `Pc;Pd`. Currently the
+//   first parameter `Pc` is ignored. The second parameter `Pd` is decoded as it arrives.
+// Arguments:
+// - string - The next chunk of the Osc String input.
+// Return Value:
+// - <none>
+void OutputStateMachineEngine::_PutOscSetClipboard(std::wstring_view string) noexcept
+{
+    if (!_clipboardSelectionParsed)
+    {
+        const auto pos = string.find(L';');
+        if (pos == std::wstring_view::npos)
+        {
+            return;
+        }
+        string = string.substr(pos + 1);
+        _clipboardSelectionParsed = true;
+    }
+
+    if (!string.empty())
+    {
+        if (_clipboardDataSize == 0)
+        {
+            _clipboardQuery = string.front() == L'?';
+        }
+        _clipboardDataSize += string.size();
+        _clipboardDecoder.Feed(string);
+    }
+}
+
+// Routine Description:
+// - Finishes parsing the OscSetClipboard parameters with the format `Pc;Pd`. Currently the first
+//   parameter `Pc` is ignored. The second parameter `Pd` should be a valid base64 string or character `?`.
 // Arguments:
-// - string - Osc String input.
 // - content - Content to set to clipboard.
 // - queryClipboard - Whether to get clipboard content and return it to terminal with base64 encoded.
 // Return Value:
 // - True if there was a valid base64 string or the passed parameter was `?`.
-bool OutputStateMachineEngine::_GetOscSetClipboard(const std::wstring_view string,
-                                                   std::wstring& content,
-                                                   bool& queryClipboard) const noexcept
+bool OutputStateMachineEngine::_GetOscSetClipboard(std::wstring& content,
+                                                   bool& queryClipboard) noexcept
 {
-    const auto pos = string.find(L';');
-    if (pos == std::wstring_view::npos)
+    if (!_clipboardSelectionParsed)
     {
         return false;
     }
 
-    const auto substr = string.substr(pos + 1);
-    if (substr == L"?")
+    if (_clipboardQuery && _clipboardDataSize == 1)
     {
         queryClipboard = true;
         return true;
@@ -1080,7 +1125,24 @@ bool OutputStateMachineEngine::_GetOscSetClipboard(const std::wstring_view strin
 
 // Log_IfFailed has the following description: "Should be decorated WI_NOEXCEPT, but conflicts with forceinline."
 #pragma warning(suppress : 26447) // The function is declared 'noexcept' but calls function 'Log_IfFailed()' which may throw exceptions (f.6).
-    return SUCCEEDED_LOG(Base64::Decode(substr, content));
+    const auto success = SUCCEEDED_LOG(_clipboardDecoder.Finish(content));
+    // The decoded payload can be large. There's no need to hold on to it until the next sequence.
+    _ResetOscSetClipboard();
+    return success;
+}
+
+// Routine Description:
+// - Discards the OscSetClipboard parameters parsed so far.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void OutputStateMachineEngine::_ResetOscSetClipboard() noexcept
+{
+    _clipboardDecoder.Reset();
+    _clipboardSelectionParsed = false;
+    _clipboardDataSize = 0;
+    _clipboardQuery = false;
 }
 
 // Method Description:
@@ -13,6 +13,7 @@ Abstract:
 #include <functional>
 
 #include "../adapter/termDispatch.hpp"
+#include "base64.hpp"
 #include "telemetry.hpp"
 #include "IStateMachineEngine.hpp"
 
@@ -49,6 +50,8 @@ namespace Microsoft::Console::VirtualTerminal
 
         bool ActionIgnore() noexcept override;
 
+        bool ActionOscPut(const size_t parameter, const std::wstring_view string) noexcept override;
+
         bool ActionOscDispatch(const wchar_t wch,
                                const size_t parameter,
                                const std::wstring_view string) override;
@@ -67,6 +70,15 @@ namespace Microsoft::Console::VirtualTerminal
         std::function<bool()> _pfnFlushToTerminal;
         wchar_t _lastPrintedChar;
 
+        // OSC 52 payloads can be megabytes large, so instead of being collected
+        // they're decoded as they arrive. See ActionOscPut.
+        static constexpr size_t MaxClipboardSize = 32 * 1024 * 1024;
+        Base64Decoder _clipboardDecoder{ MaxClipboardSize };
+        // Whether the `Pc;` prefix of the payload was seen and how much of `Pd` followed it.
+        bool _clipboardSelectionParsed = false;
+        size_t _clipboardDataSize = 0;
+        bool _clipboardQuery = false;
+
         enum EscActionCodes : uint64_t
         {
             DECSC_CursorSave = VTID("7"),
@@ -202,9 +214,10 @@ namespace Microsoft::Console::VirtualTerminal
         bool _GetOscSetColor(const std::wstring_view string,
                              std::vector<DWORD>& rgbs) const;
 
-        bool _GetOscSetClipboard(const std::wstring_view string,
-                                 std::wstring& content,
-                                 bool& queryClipboard) const noexcept;
+        void _PutOscSetClipboard(std::wstring_view string) noexcept;
+        bool _GetOscSetClipboard(std::wstring& content,
+                                 bool& queryClipboard) noexcept;
+        void _ResetOscSetClipboard() noexcept;
 
         static constexpr std::wstring_view hyperlinkIDParameter{ L"id=" };
         bool _ParseHyperlink(const std::wstring_view string,
@@ -10,6 +10,7 @@
 #pragma warning(disable : 26447) // The function is declared 'noexcept' but calls function '...' which may throw exceptions (f.6).
 #pragma warning(disable : 26481) // Don't use pointer arithmetic. Use span instead (bounds.1).
 #pragma warning(disable : 26482) // Only index into arrays using constant expressions (bounds.2).
+#pragma warning(disable : 26490) // Don't use reinterpret_cast (type.1).
 
 using namespace Microsoft::Console::VirtualTerminal;
 
@@ -26,48 +27,107 @@ static constexpr uint8_t decodeTable[128] = {
 };
 // clang-format on
 
-// Decodes an UTF8 string encoded with RFC 4648 (Base64) and returns it as UTF16 in dst.
+Base64Decoder::Base64Decoder(const size_t maxSize) noexcept :
+    _maxSize{ maxSize }
+{
+}
+
+// Decodes the next piece of an UTF8 string encoded with RFC 4648 (Base64) and appends it to the result.
 // It supports both variants of the RFC (base64 and base64url), but
-// throws an error for non-alphabet characters, including newlines.
-// * Throws an exception for all invalid base64 inputs.
-// * Doesn't support whitespace and will throw an exception for such strings.
-// * Doesn't validate the number of trailing "=". Those are basically ignored.
+// fails for non-alphabet characters, including newlines.
+// * Doesn't support whitespace and will fail for such strings.
+// * Once a "=" was seen, only more "=" may follow, but their number isn't validated.
 //   Strings like "YQ===" will be accepted as valid input and simply result in "a".
-HRESULT Base64::Decode(const std::wstring_view& src, std::wstring& dst) noexcept
+// * Fails if the result would grow larger than the maxSize given to the constructor.
+// Returns false once the input turned out to be invalid. Any further input is ignored.
+bool Base64Decoder::Feed(std::wstring_view src) noexcept
+try
 {
-    std::string result;
-    result.resize(((src.size() + 3) / 4) * 3);
+    // Complete the group of 4 characters that the previous piece ended in the middle of.
+    for (; (_ri != 0 || _padding) && !_failed && !src.empty(); src = src.substr(1))
+    {
+        _FeedChar(src.front());
+    }
+    if (_failed)
+    {
+        _Fail();
+        return false;
+    }
+    if (src.empty())
+    {
+        return true;
+    }
+
+    // Every character but the "=" padding carries 6 bits.
+    const auto dataSize = src.find_last_not_of(L'=') + 1;
+    const auto maxDecodedSize = dataSize / 4 * 3 + dataSize % 4 * 3 / 4;
+    if (maxDecodedSize > _maxSize - _buffer.size())
+    {
+        _Fail();
+        return false;
+    }
+
+    const auto offset = _buffer.size();
+    _buffer.resize(offset + maxDecodedSize);
 
-    // in and inEnd may be nullptr if src.empty().
-    // The remaining code in this function ensures not to read from in if src.empty().
-#pragma warning(suppress : 26429) // Symbol 'in' is never tested for nullness, it can be marked as not_null (f.23).
     auto in = src.data();
     const auto inEnd = in + src.size();
-    // Sometimes in programming you have to ask yourself what the right offset for a pointer is.
-    // Is 4 enough? Certainly not. 6 on the other hand is just way too much. Clearly 5 is just right.
-    //
-    // In all seriousness however the offset is 5, because the batched loop reads 4 characters at a time,
-    // a base64 string can end with two "=" and the batched loop doesn't handle any such "=".
-    // Additionally the while() condition of the batched loop would make a lot more sense if it were using <=,
-    // but for reasons outlined below it needs to use < so we need to add 1 back again.
-    // We thus get -4-2+1 which is -5.
-    //
-    // There's a special reason we need to use < and not <= for the loop:
-    // In C++ it's undefined behavior to perform any pointer arithmetic that leads to unallocated memory,
-    // which is why we can't just write `inEnd - 6` as that might be UB if `src.size()` is less than 6.
-    // We thus would need write `inEnd - min(6, src.size())` in combination with `<=` for the batched loop.
-    // But if `src.size()` is actually less than 6 then `inEnd` is equal to the initial `in`, aka: an empty range.
-    // In such cases we'd enter the batched loop and read from `in` despite us not wanting to enter the loop.
-    // We can fix the issue by using < instead and adding +1 to the offset.
-    //
-    // Yes this works.
-    const auto inEndBatched = inEnd - std::min<size_t>(5, src.size());
-
-    // outBeg and out may be nullptr if src.empty().
-    // The remaining code in this function ensures not to write to out if src.empty().
-    const auto outBeg = result.data();
-#pragma warning(suppress : 26429) // Symbol 'out' is never tested for nullness, it can be marked as not_null (f.23).
-    auto out = outBeg;
+    const auto outBeg = _buffer.data();
+    auto out = outBeg + offset;
+
+#if defined(_M_IX86) || defined(_M_AMD64)
+    // Decode 16 characters into 12 bytes at a time, as long as all of them are in the alphabet.
+    // This stops at the first "=" or invalid character, which the loops below then deal with.
+    // Each iteration writes 2 bytes past its 12, which is why it needs at least 4 more characters after its 16.
+    for (const auto inEndBatched = in + std::max<size_t>(dataSize, 20) - 20; in < inEndBatched; in += 16, out += 12)
+    {
+        const auto lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+        const auto hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 8));
+        // Characters from U+0100 to U+7FFF saturate to 0xFF and the ones above to 0x00.
+        // Both are invalid, just like 0x80 to 0xFF, which are negative in the signed comparisons below.
+        const auto chars = _mm_packus_epi16(lo, hi);
+
+        const auto between = [&](const char first, const char last) noexcept {
+            return _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8(first - 1)), _mm_cmplt_epi8(chars, _mm_set1_epi8(last + 1)));
+        };
+        const auto upper = between('A', 'Z');
+        const auto lower = between('a', 'z');
+        const auto digit = between('0', '9');
+        const auto plus = _mm_cmpeq_epi8(chars, _mm_set1_epi8('+'));
+        const auto minus = _mm_cmpeq_epi8(chars, _mm_set1_epi8('-'));
+        const auto slash = _mm_cmpeq_epi8(chars, _mm_set1_epi8('/'));
+        const auto underscore = _mm_cmpeq_epi8(chars, _mm_set1_epi8('_'));
+
+        const auto valid = _mm_or_si128(_mm_or_si128(_mm_or_si128(upper, lower), _mm_or_si128(digit, plus)), _mm_or_si128(_mm_or_si128(minus, slash), underscore));
+        if (_mm_movemask_epi8(valid) != 0xffff)
+        {
+            break;
+        }
+
+        // Translate the characters into their 6-bit values by adding the offset of their range to them.
+        auto offsets = _mm_and_si128(upper, _mm_set1_epi8(-'A'));
+        offsets = _mm_or_si128(offsets, _mm_and_si128(lower, _mm_set1_epi8(26 - 'a')));
+        offsets = _mm_or_si128(offsets, _mm_and_si128(digit, _mm_set1_epi8(52 - '0')));
+        offsets = _mm_or_si128(offsets, _mm_and_si128(plus, _mm_set1_epi8(62 - '+')));
+        offsets = _mm_or_si128(offsets, _mm_and_si128(minus, _mm_set1_epi8(62 - '-')));
+        offsets = _mm_or_si128(offsets, _mm_and_si128(slash, _mm_set1_epi8(63 - '/')));
+        offsets = _mm_or_si128(offsets, _mm_and_si128(underscore, _mm_set1_epi8(63 - '_')));
+        const auto values = _mm_add_epi8(chars, offsets);
+
+        // Each 32-bit lane holds 4 values a, b, c and d, from the lowest byte up. Rearrange their bits into
+        // the 3 output bytes a << 2 | b >> 4, (b & 0xf) << 4 | c >> 2 and (c & 0x3) << 6 | d, again from the lowest byte up.
+        const auto byte0 = _mm_or_si128(_mm_slli_epi32(_mm_and_si128(values, _mm_set1_epi32(0x00003f)), 2), _mm_and_si128(_mm_srli_epi32(values, 12), _mm_set1_epi32(0x000003)));
+        const auto byte1 = _mm_or_si128(_mm_slli_epi32(_mm_and_si128(values, _mm_set1_epi32(0x000f00)), 4), _mm_and_si128(_mm_srli_epi32(values, 10), _mm_set1_epi32(0x000f00)));
+        const auto byte2 = _mm_or_si128(_mm_slli_epi32(_mm_and_si128(values, _mm_set1_epi32(0x030000)), 6), _mm_and_si128(_mm_srli_epi32(values, 8), _mm_set1_epi32(0x3f0000)));
+        const auto groups = _mm_or_si128(_mm_or_si128(byte0, byte1), byte2);
+
+        // Close the gap between the 2 groups in each 64-bit half, which then holds 6 bytes, followed by 2 zeros.
+        // The second half is stored on top of the zeros of the first one.
+        const auto packed = _mm_or_si128(_mm_and_si128(groups, _mm_set1_epi64x(0xffffff)), _mm_and_si128(_mm_srli_epi64(groups, 8), _mm_set1_epi64x(0xffffff000000)));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(out), packed);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(out + 6), _mm_srli_si128(packed, 8));
+    }
+#endif
 
     // r is just a generic "remainder" we use to accumulate 4 base64 chars into 3 output bytes.
     uint_fast32_t r = 0;
@@ -85,14 +145,8 @@ HRESULT Base64::Decode(const std::wstring_view& src, std::wstring& dst) noexcept
         r = r << 6 | n;
     };
 
-    // If src.empty() then `in == inEndBatched == nullptr` and this is skipped.
-    while (in < inEndBatched)
+    while (inEnd - in >= 4)
     {
-        const auto ch0 = *in++;
-        const auto ch1 = *in++;
-        const auto ch2 = *in++;
-        const auto ch3 = *in++;
-
         // Most other base64 libraries do something like this:
         //   const auto n0 = decodeTable[a];
         //   const auto n1 = decodeTable[b];
@@ -105,54 +159,126 @@ HRESULT Base64::Decode(const std::wstring_view& src, std::wstring& dst) noexcept
         // But on all modern CPUs I tested (well even those 10 years old at this point) shifting base64
         // characters into a single register (here: r) is faster than the traditional approach.
         // I believe this is due to reducing the dependency of instructions on prior calculations.
-        accumulate(r, error, ch0);
-        accumulate(r, error, ch1);
-        accumulate(r, error, ch2);
-        accumulate(r, error, ch3);
+        accumulate(r, error, in[0]);
+        accumulate(r, error, in[1]);
+        accumulate(r, error, in[2]);
+        accumulate(r, error, in[3]);
+
+        // A "=" or an invalid character. The loop below will figure out which one it is.
+        if (error)
+        {
+            break;
+        }
 
         *out++ = gsl::narrow_cast<char>(r >> 16);
         *out++ = gsl::narrow_cast<char>(r >> 8);
         *out++ = gsl::narrow_cast<char>(r >> 0);
+        in += 4;
     }
 
-    {
-        uint_fast8_t ri = 0;
+    _buffer.resize(out - outBeg);
 
-        // If src.empty() then `in == inEnd == nullptr` and this is skipped.
-        for (; in < inEnd; ++in)
-        {
-            if (const auto ch = *in; ch != '=')
-            {
-                accumulate(r, error, ch);
-                ri++;
-            }
-        }
+    for (; in < inEnd && !_failed; ++in)
+    {
+        _FeedChar(*in);
+    }
+    if (_failed)
+    {
+        _Fail();
+        return false;
+    }
+    return true;
+}
+catch (...)
+{
+    _Fail();
+    return false;
+}
 
-        switch (ri)
-        {
-        case 2:
-            *out++ = gsl::narrow_cast<char>(r >> 4);
-            break;
-        case 3:
-            *out++ = gsl::narrow_cast<char>(r >> 10);
-            *out++ = gsl::narrow_cast<char>(r >> 2);
-            break;
-        case 4:
-            *out++ = gsl::narrow_cast<char>(r >> 16);
-            *out++ = gsl::narrow_cast<char>(r >> 8);
-            *out++ = gsl::narrow_cast<char>(r >> 0);
-            break;
-        default:
-            error |= ri;
-            break;
-        }
+// Decodes the rest of the input and returns the result as UTF16 in dst.
+// Fails if any of the input was invalid, or if it ended in an incomplete group of characters.
+HRESULT Base64Decoder::Finish(std::wstring& dst) noexcept
+try
+{
+    switch (_ri)
+    {
+    case 0:
+        break;
+    case 2:
+        _buffer.push_back(gsl::narrow_cast<char>(_r >> 4));
+        break;
+    case 3:
+        _buffer.push_back(gsl::narrow_cast<char>(_r >> 10));
+        _buffer.push_back(gsl::narrow_cast<char>(_r >> 2));
+        break;
+    default:
+        _Fail();
+        break;
     }
+    _ri = 0;
 
-    if (error)
+    if (_failed || _buffer.size() > _maxSize)
     {
+        _Fail();
         return HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
     }
 
-    result.resize(out - outBeg);
-    return til::u8u16(result, dst);
+    return til::u8u16(_buffer, dst);
+}
+CATCH_RETURN()
+
+// Discards the input and result so far, so that the decoder can be used again.
+void Base64Decoder::Reset() noexcept
+{
+    _buffer = {};
+    _r = 0;
+    _ri = 0;
+    _padding = false;
+    _failed = false;
+}
+
+void Base64Decoder::_FeedChar(const wchar_t ch)
+{
+    if (ch == L'=')
+    {
+        _padding = true;
+        return;
+    }
+
+    const auto n = ch < 128 ? decodeTable[ch] : uint8_t{ 255 };
+    if (_padding || n > 63)
+    {
+        _failed = true;
+        return;
+    }
+
+    _r = _r << 6 | n;
+    if (++_ri == 4)
+    {
+        if (_buffer.size() + 3 > _maxSize)
+        {
+            _failed = true;
+            return;
+        }
+        _buffer.push_back(gsl::narrow_cast<char>(_r >> 16));
+        _buffer.push_back(gsl::narrow_cast<char>(_r >> 8));
+        _buffer.push_back(gsl::narrow_cast<char>(_r >> 0));
+        _ri = 0;
+    }
+}
+
+// Releases the memory of the result, which can be quite large, as soon as it's known to be useless.
+void Base64Decoder::_Fail() noexcept
+{
+    _buffer = {};
+    _failed = true;
+}
+
+// Decodes an UTF8 string encoded with RFC 4648 (Base64) and returns it as UTF16 in dst.
+// See Base64Decoder::Feed for the details.
+HRESULT Base64::Decode(const std::wstring_view& src, std::wstring& dst) noexcept
+{
+    Base64Decoder decoder;
+    decoder.Feed(src);
+    return decoder.Finish(dst);
 }
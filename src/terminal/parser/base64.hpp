@@ -7,12 +7,36 @@ Module Name:
 
 Abstract:
 - This declares standard base64 encoding and decoding, with paddings when needed.
+- Base64Decoder decodes incrementally, for data that arrives in pieces, like the
+  payload of an OSC 52 sequence that's spread over many writes.
 */
 
 #pragma once
 
 namespace Microsoft::Console::VirtualTerminal
 {
+    class Base64Decoder
+    {
+    public:
+        explicit Base64Decoder(size_t maxSize = SIZE_MAX) noexcept;
+
+        bool Feed(std::wstring_view src) noexcept;
+        HRESULT Finish(std::wstring& dst) noexcept;
+        void Reset() noexcept;
+
+    private:
+        void _FeedChar(const wchar_t ch);
+        void _Fail() noexcept;
+
+        std::string _buffer;
+        size_t _maxSize;
+        // The characters of an incomplete group of 4 are accumulated in _r. _ri counts them.
+        uint_fast32_t _r = 0;
+        uint_fast8_t _ri = 0;
+        bool _padding = false;
+        bool _failed = false;
+    };
+
     class Base64
     {
     public:
@@ -7,6 +7,8 @@
 
 #include "ascii.hpp"
 
+#include <til/trace.h>
+
 using namespace Microsoft::Console::VirtualTerminal;
 
 //Takes ownership of the pEngine.
@@ -329,6 +331,55 @@ static constexpr bool _isDcsPassThroughValid(const wchar_t wch) noexcept
     return wch >= AsciiChars::SPC && wch < AsciiChars::DEL;
 }
 
+// Routine Description:
+// - Finds the end of the printable ASCII characters (0x20 - 0x7E) in the string,
+//      beginning at the given offset. Within OSC and DCS strings, these can be
+//      collected in bulk, since none of them ends the string or has to be ignored.
+//      This covers the contents of OSC 52 (base64), OSC 8 (URIs) and DECDLD (sixels).
+// Arguments:
+// - string - The string to search.
+// - offset - The offset to begin searching at.
+// Return Value:
+// - The offset of the first character that isn't printable ASCII, or string.size().
+static size_t _findEndOfPrintableAscii(const std::wstring_view string, size_t offset) noexcept
+{
+    const auto size = string.size();
+    const auto data = string.data();
+
+#if defined(_M_IX86) || defined(_M_AMD64)
+    // Subtracting 0x20 maps 0x20 - 0x7E to 0 - 0x5E and everything else to larger values (as unsigned).
+    // SSE2 only has signed comparisons, so we add 0x8000 to that to turn the unsigned comparison into
+    // a signed one: The printable characters are now the ones that are less than 0x805F (as signed).
+    const auto bias = _mm_set1_epi16(static_cast<short>(0x8000 - 0x20));
+    const auto limit = _mm_set1_epi16(static_cast<short>(0x8000 + 0x5F));
+    for (; offset + 8 <= size; offset += 8)
+    {
+#pragma warning(suppress : 26481) // Don't use pointer arithmetic. Use span instead (bounds.1).
+#pragma warning(suppress : 26490) // Don't use reinterpret_cast (type.1).
+        const auto chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + offset));
+        const auto printable = _mm_cmplt_epi16(_mm_add_epi16(chars, bias), limit);
+        // The mask has a 1 bit for every byte of a printable character, so invert it
+        // to find the first one that isn't. Each character corresponds to 2 bits.
+        const auto mask = ~static_cast<unsigned long>(_mm_movemask_epi8(printable)) & 0xffff;
+        unsigned long index;
+        if (_BitScanForward(&index, mask))
+        {
+            return offset + index / 2;
+        }
+    }
+#endif
+
+    for (; offset < size; ++offset)
+    {
+#pragma warning(suppress : 26481) // Don't use pointer arithmetic. Use span instead (bounds.1).
+        if (!_isDcsPassThroughValid(data[offset]))
+        {
+            break;
+        }
+    }
+    return offset;
+}
+
 // Routine Description:
 // - Determines if a character is "start of string" beginning
 //      indicator.
@@ -476,6 +527,7 @@ void StateMachine::_ActionVt52EscDispatch(const wchar_t wch)
 // - <none>
 void StateMachine::_ActionCsiDispatch(const wchar_t wch)
 {
+    TIL_TRACE_SPAN("dispatch", "StateMachine::_ActionCsiDispatch");
     _trace.TraceOnAction(L"CsiDispatch");
     _trace.DispatchSequenceTrace(_SafeExecuteWithLog(wch, [=]() {
         return _engine->ActionCsiDispatch(_identifier.Finalize(wch), { _parameters.data(), _parameters.size() });
@@ -594,7 +646,8 @@ void StateMachine::_ActionInterrupt()
     if (_state == VTStates::DcsPassThrough)
     {
         // The ESC signals the end of the data string.
-        _dcsStringHandler(AsciiChars::ESC);
+        static constexpr wchar_t esc = AsciiChars::ESC;
+        _dcsStringHandler({ &esc, 1 });
         _dcsStringHandler = nullptr;
     }
 }
@@ -622,7 +675,26 @@ void StateMachine::_ActionOscPut(const wchar_t wch)
 {
     _trace.TraceOnAction(L"OscPut");
 
-    _oscString.push_back(wch);
+    if (!_engine->ActionOscPut(_oscParameter, { &wch, 1 }))
+    {
+        _oscString.push_back(wch);
+    }
+}
+
+// Routine Description:
+// - Stores a run of characters as part of the OSC string
+// Arguments:
+// - string - Characters to store.
+// Return Value:
+// - <none>
+void StateMachine::_ActionOscPutString(const std::wstring_view string)
+{
+    _trace.TraceOnAction(L"OscPutString");
+
+    if (!_engine->ActionOscPut(_oscParameter, string))
+    {
+        _oscString.append(string);
+    }
 }
 
 // Routine Description:
@@ -687,6 +759,23 @@ void StateMachine::_ActionDcsDispatch(const wchar_t wch)
     }
 }
 
+// Routine Description:
+// - Passes a run of characters of the DCS data string to the string handler.
+//   If the handler doesn't want any more data, the rest of the string is ignored.
+// Arguments:
+// - string - Characters to pass through.
+// Return Value:
+// - <none>
+void StateMachine::_ActionDcsPassThrough(const std::wstring_view string)
+{
+    _trace.TraceOnAction(L"DcsPassThrough");
+
+    if (!_dcsStringHandler(string))
+    {
+        _EnterDcsIgnore();
+    }
+}
+
 // Routine Description:
 // - Moves the state machine into the Ground state.
 //   This state is entered:
@@ -1660,10 +1749,7 @@ void StateMachine::_EventDcsPassThrough(const wchar_t wch)
     _trace.TraceOnEvent(L"DcsPassThrough");
     if (_isC0Code(wch) || _isDcsPassThroughValid(wch))
     {
-        if (!_dcsStringHandler(wch))
-        {
-            _EnterDcsIgnore();
-        }
+        _ActionDcsPassThrough({ &wch, 1 });
     }
     else
     {
@@ -1829,6 +1915,7 @@ bool StateMachine::FlushToTerminal()
 // - <none>
 void StateMachine::ProcessString(const std::wstring_view string)
 {
+    TIL_TRACE_SPAN("parse", "StateMachine::ProcessString");
     size_t start = 0;
     auto current = start;
 
@@ -1844,6 +1931,34 @@ void StateMachine::ProcessString(const std::wstring_view string)
         _runOffset = start;
         _runSize = current - start + 1;
 
+        if (_processingIndividually && (_state == VTStates::OscString || _state == VTStates::DcsPassThrough))
+        {
+            // OSC and DCS strings can be very long (e.g. OSC 52 clipboard contents or DECDLD
+            // soft fonts). Instead of feeding them to the state machine one character at a
+            // time, we look ahead for the next character that may terminate the string or
+            // needs special treatment and pass everything up to it through at once.
+            const auto end = _findEndOfPrintableAscii(string, current);
+            if (end > current)
+            {
+                const auto data = string.substr(current, end - current);
+                _runSize = end - start;
+                _processingLastCharacter = end >= string.size();
+                _trace.TraceStringInput(data);
+
+                if (_state == VTStates::OscString)
+                {
+                    _ActionOscPutString(data);
+                }
+                else
+                {
+                    _ActionDcsPassThrough(data);
+                }
+
+                current = end;
+                continue;
+            }
+        }
+
         if (_processingIndividually)
         {
             // Note whether we're dealing with the last character in the buffer.
@@ -1996,6 +2111,18 @@ bool StateMachine::IsProcessingLastCharacter() const noexcept
     return _processingLastCharacter;
 }
 
+// Routine Description:
+// - Determines whether the state machine is in the ground state, i.e. whether
+//   the output processed so far didn't end in the middle of a sequence.
+// Arguments:
+// - <none>
+// Return Value:
+// - True if we're in the ground state. False if not.
+bool StateMachine::IsInGroundState() const noexcept
+{
+    return _state == VTStates::Ground;
+}
+
 // Routine Description:
 // - Wherever the state machine is, whatever it's going, go back to ground.
 //     This is used by conhost to "jiggle the handle" - when VT support is
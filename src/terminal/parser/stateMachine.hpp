@@ -59,6 +59,7 @@ namespace Microsoft::Console::VirtualTerminal
         void ProcessCharacter(const wchar_t wch);
         void ProcessString(const std::wstring_view string);
         bool IsProcessingLastCharacter() const noexcept;
+        bool IsInGroundState() const noexcept;
 
         void ResetState() noexcept;
 
@@ -86,9 +87,11 @@ namespace Microsoft::Console::VirtualTerminal
         void _ActionCsiDispatch(const wchar_t wch);
         void _ActionOscParam(const wchar_t wch) noexcept;
         void _ActionOscPut(const wchar_t wch);
+        void _ActionOscPutString(const std::wstring_view string);
         void _ActionOscDispatch(const wchar_t wch);
         void _ActionSs3Dispatch(const wchar_t wch);
         void _ActionDcsDispatch(const wchar_t wch);
+        void _ActionDcsPassThrough(const std::wstring_view string);
 
         void _ActionClear();
         void _ActionIgnore() noexcept;
@@ -71,6 +71,23 @@ void ParserTracing::TraceCharInput(const wchar_t wch)
                       TraceLoggingKeyword(TIL_KEYWORD_TRACE));
 }
 
+// Traces a chunk of string data that's processed without going through the state machine character by character.
+void ParserTracing::TraceStringInput(const std::wstring_view& string)
+{
+    if (TraceLoggingProviderEnabled(g_hConsoleVirtTermParserEventTraceProvider, WINEVENT_LEVEL_VERBOSE, TIL_KEYWORD_TRACE))
+    {
+        _sequenceTrace.append(string);
+
+        const auto length = gsl::narrow_cast<ULONG>(string.size());
+        TraceLoggingWrite(g_hConsoleVirtTermParserEventTraceProvider,
+                          "StateMachine_NewString",
+                          TraceLoggingCountedWideString(string.data(), length),
+                          TraceLoggingValue(length),
+                          TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE),
+                          TraceLoggingKeyword(TIL_KEYWORD_TRACE));
+    }
+}
+
 void ParserTracing::AddSequenceTrace(const wchar_t wch)
 {
     // Don't waste time storing this if no one is listening.
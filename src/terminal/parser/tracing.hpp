@@ -40,6 +40,7 @@ namespace Microsoft::Console::VirtualTerminal
         void TraceOnExecuteFromEscape(const wchar_t wch) const noexcept;
         void TraceOnEvent(_In_z_ const wchar_t* name) const noexcept;
         void TraceCharInput(const wchar_t wch);
+        void TraceStringInput(const std::wstring_view& string);
 
         void AddSequenceTrace(const wchar_t wch);
         void DispatchSequenceTrace(const bool fSuccess) noexcept;
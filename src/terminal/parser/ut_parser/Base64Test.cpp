@@ -116,4 +116,69 @@ class Microsoft::Console::VirtualTerminal::Base64Test
         Base64::Decode(L"8J+RjfCfkY3wn4+78J+RjfCfj7zwn5GN8J+PvfCfkY3wn4++8J+RjfCfj78=", result);
         VERIFY_ARE_EQUAL(L"👍👍🏻👍🏼👍🏽👍🏾👍🏿", result);
     }
+
+    TEST_METHOD(DecoderChunks)
+    {
+        // Long enough for the batched loops to run on either side of every split.
+        static constexpr std::wstring_view expected{ L"The quick brown fox jumps over the lazy dog. 0123456789!" };
+        static constexpr std::wstring_view encoded{ L"VGhlIHF1aWNrIGJyb3duIGZveCBqdW1wcyBvdmVyIHRoZSBsYXp5IGRvZy4gMDEyMzQ1Njc4OSE=" };
+
+        Base64Decoder decoder;
+        std::wstring result;
+
+        for (size_t first = 0; first <= encoded.size(); ++first)
+        {
+            for (size_t second = first; second <= encoded.size(); second += 7)
+            {
+                decoder.Reset();
+                VERIFY_IS_TRUE(decoder.Feed(encoded.substr(0, first)));
+                VERIFY_IS_TRUE(decoder.Feed(encoded.substr(first, second - first)));
+                VERIFY_IS_TRUE(decoder.Feed(encoded.substr(second)));
+                VERIFY_SUCCEEDED(decoder.Finish(result));
+                VERIFY_ARE_EQUAL(expected, result);
+            }
+        }
+    }
+
+    TEST_METHOD(DecoderRejectsInvalidInput)
+    {
+        std::wstring result;
+
+        // Anything but more padding after the padding.
+        Base64Decoder decoder;
+        VERIFY_IS_TRUE(decoder.Feed(L"YQ="));
+        VERIFY_IS_FALSE(decoder.Feed(L"=YQ"));
+        VERIFY_FAILED(decoder.Finish(result));
+
+        // Non-ASCII characters, in and outside of the batched loops.
+        for (const auto ch : { L'\x00ff', L'\x0141', L'\x8041', L' ' })
+        {
+            std::wstring encoded(64, L'A');
+            encoded[37] = ch;
+            decoder.Reset();
+            VERIFY_IS_FALSE(decoder.Feed(encoded));
+            VERIFY_FAILED(decoder.Finish(result));
+        }
+
+        // A single character can't encode a byte.
+        decoder.Reset();
+        VERIFY_IS_TRUE(decoder.Feed(L"YWJjZ"));
+        VERIFY_FAILED(decoder.Finish(result));
+    }
+
+    TEST_METHOD(DecoderLimitsSize)
+    {
+        std::wstring result;
+
+        Base64Decoder decoder{ 6 };
+        VERIFY_IS_TRUE(decoder.Feed(L"Zm9v"));
+        VERIFY_IS_TRUE(decoder.Feed(L"YmE="));
+        VERIFY_SUCCEEDED(decoder.Finish(result));
+        VERIFY_ARE_EQUAL(L"fooba", result);
+
+        decoder.Reset();
+        VERIFY_IS_TRUE(decoder.Feed(L"Zm9vYmFy"));
+        VERIFY_IS_FALSE(decoder.Feed(L"Zg"));
+        VERIFY_FAILED(decoder.Finish(result));
+    }
 };
@@ -3253,6 +3253,22 @@ class StateMachineExternalTest final
 
         pDispatch->ClearState();
 
+        // The parameters can be split across several writes, even in the middle of a base64 group.
+        mach.ProcessString(L"\x1b]52;s");
+        mach.ProcessString(L"0;Zm9");
+        mach.ProcessString(L"vYmFy\x07");
+        VERIFY_ARE_EQUAL(L"foobar", pDispatch->_copyContent);
+
+        pDispatch->ClearState();
+
+        pDispatch->_copyContent = L"UNCHANGED";
+        // A sequence that is cancelled midway doesn't leak into the next one.
+        mach.ProcessString(L"\x1b]52;;Zm9\x18");
+        mach.ProcessString(L"\x1b]52;;?\x07");
+        VERIFY_ARE_EQUAL(L"UNCHANGED", pDispatch->_copyContent);
+
+        pDispatch->ClearState();
+
         pDispatch->_copyContent = L"UNCHANGED";
         // Passing only base64 `Pd` param is illegal, won't change the content.
         mach.ProcessString(L"\x1b]52;Zm9v\x07");
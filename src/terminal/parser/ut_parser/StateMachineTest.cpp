@@ -38,6 +38,9 @@ public:
         dcsId = 0;
         dcsParams.clear();
         dcsDataString.clear();
+        dcsDataChunks = 0;
+        oscParameter = 0;
+        oscString.clear();
     }
 
     bool ActionExecute(const wchar_t wch) override
@@ -68,15 +71,19 @@ public:
 
     bool ActionIgnore() override { return true; };
 
+    bool ActionOscPut(const size_t /* parameter */, const std::wstring_view /* string */) override { return false; };
+
     bool ActionOscDispatch(const wchar_t /* wch */,
-                           const size_t /* parameter */,
-                           const std::wstring_view /* string */) override
+                           const size_t parameter,
+                           const std::wstring_view string) override
     {
         if (pfnFlushToTerminal)
         {
             pfnFlushToTerminal();
             return true;
         }
+        oscParameter = parameter;
+        oscString = string;
         return true;
     };
 
@@ -110,7 +117,7 @@ public:
             dcsParams.push_back(parameters.at(i).value_or(0));
         }
         dcsDataString.clear();
-        return [=](const auto ch) { dcsDataString += ch; return true; };
+        return [=](const auto string) { dcsDataString += string; dcsDataChunks++; return true; };
     }
 
     // These will only be populated if ActionCsiDispatch is called.
@@ -133,6 +140,11 @@ public:
     uint64_t dcsId = 0;
     std::vector<size_t> dcsParams;
     std::wstring dcsDataString;
+    size_t dcsDataChunks = 0;
+
+    // These will only be populated if ActionOscDispatch is called.
+    size_t oscParameter = 0;
+    std::wstring oscString;
 };
 
 class Microsoft::Console::VirtualTerminal::StateMachineTest
@@ -157,6 +169,7 @@ class Microsoft::Console::VirtualTerminal::StateMachineTest
     TEST_METHOD(PassThroughUnhandledSplitAcrossWrites);
 
     TEST_METHOD(DcsDataStringsReceivedByHandler);
+    TEST_METHOD(StringDataProcessedInBulk);
 };
 
 void StateMachineTest::TwoStateMachinesDoNotInterfereWithEachOther()
@@ -337,3 +350,33 @@ void StateMachineTest::DcsDataStringsReceivedByHandler()
     // Verify the control characters were executed (if expected).
     VERIFY_ARE_EQUAL(expectedExecuted, engine.executed);
 }
+
+void StateMachineTest::StringDataProcessedInBulk()
+{
+    auto enginePtr{ std::make_unique<TestStateMachineEngine>() };
+    // this dance is required because StateMachine presumes to take ownership of its engine.
+    auto& engine{ *enginePtr.get() };
+    StateMachine machine{ std::move(enginePtr) };
+
+    const std::wstring data(10000, L'x');
+
+    Log::Comment(L"OSC strings may contain characters outside of ASCII, which interrupt the bulk processing.");
+    machine.ProcessString(L"\033]52;" + data + L"\x00e9" + data + L"\033\\");
+    VERIFY_ARE_EQUAL(52u, engine.oscParameter);
+    VERIFY_ARE_EQUAL(data + L"\x00e9" + data, engine.oscString);
+
+    Log::Comment(L"OSC strings can be terminated with BEL and split across writes.");
+    engine.ResetTestState();
+    machine.ProcessString(L"\033]8;;" + data);
+    machine.ProcessString(data + L"\a");
+    VERIFY_ARE_EQUAL(8u, engine.oscParameter);
+    VERIFY_ARE_EQUAL(L";" + data + data, engine.oscString);
+
+    Log::Comment(L"DCS data strings are passed to the handler in contiguous chunks.");
+    engine.ResetTestState();
+    machine.ProcessString(L"\033P1;2;3|" + data + L"\r\n" + data + L"\033\\printed text");
+    VERIFY_ARE_EQUAL(data + L"\r\n" + data + L"\033", engine.dcsDataString);
+    // The data, CR, LF, the data again and the terminating ESC.
+    VERIFY_ARE_EQUAL(5u, engine.dcsDataChunks);
+    VERIFY_ARE_EQUAL(L"printed text", engine.printed);
+}
@@ -0,0 +1,225 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+
+#include "til/bitmap.h"
+#include "til/dirty_region.h"
+
+#include <random>
+
+using namespace WEX::Common;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+
+class DirtyRegionTests
+{
+    TEST_CLASS(DirtyRegionTests);
+
+    // Verifies that the given region covers exactly the same cells as the given bitmap.
+    static void _checkMatches(const til::bitmap& expected, const til::dirty_region& actual)
+    {
+        VERIFY_ARE_EQUAL(expected.size(), actual.size());
+
+        til::bitmap covered{ actual.size() };
+        for (const auto& run : actual.runs())
+        {
+            covered.set(run);
+        }
+
+        VERIFY_ARE_EQUAL(expected, covered);
+        VERIFY_ARE_EQUAL(expected.any(), actual.any());
+        VERIFY_ARE_EQUAL(expected.none(), actual.none());
+        VERIFY_ARE_EQUAL(expected.one(), actual.one());
+        VERIFY_ARE_EQUAL(expected.all(), actual.all());
+    }
+
+    TEST_METHOD(DefaultConstruct)
+    {
+        const til::dirty_region region;
+        VERIFY_ARE_EQUAL(til::size{}, region.size());
+        VERIFY_IS_TRUE(region.none());
+        VERIFY_ARE_EQUAL(0u, region.runs().size());
+        VERIFY_IS_TRUE(region.begin() == region.end());
+    }
+
+    TEST_METHOD(SizeConstruct)
+    {
+        const til::size sz{ 5, 10 };
+
+        const til::dirty_region empty{ sz };
+        VERIFY_ARE_EQUAL(sz, empty.size());
+        VERIFY_IS_TRUE(empty.none());
+
+        const til::dirty_region full{ sz, true };
+        VERIFY_IS_TRUE(full.all());
+        VERIFY_ARE_EQUAL(1u, full.runs().size());
+        VERIFY_ARE_EQUAL(til::rect{ sz }, full.runs().front());
+    }
+
+    TEST_METHOD(SetPointAndOne)
+    {
+        til::dirty_region region{ { 4, 4 } };
+        region.set(til::point{ 2, 1 });
+        VERIFY_IS_TRUE(region.one());
+        VERIFY_ARE_EQUAL((til::rect{ 2, 1, 3, 2 }), *region.begin());
+
+        // Setting the same point again doesn't change anything.
+        region.set(til::point{ 2, 1 });
+        VERIFY_IS_TRUE(region.one());
+
+        region.set(til::point{ 3, 1 });
+        VERIFY_IS_FALSE(region.one());
+
+        VERIFY_THROWS_SPECIFIC(region.set(til::point{ 4, 0 }), wil::ResultException, [](wil::ResultException& e) { return e.GetErrorCode() == E_INVALIDARG; });
+    }
+
+    TEST_METHOD(MergeSpansWithinRow)
+    {
+        til::dirty_region region{ { 20, 1 } };
+        region.set(til::rect{ 2, 0, 4, 1 });
+        region.set(til::rect{ 8, 0, 10, 1 });
+        region.set(til::rect{ 14, 0, 16, 1 });
+        VERIFY_ARE_EQUAL(3u, region.runs().size());
+
+        // Adjacent spans are merged...
+        region.set(til::rect{ 4, 0, 5, 1 });
+        VERIFY_ARE_EQUAL(3u, region.runs().size());
+        VERIFY_ARE_EQUAL((til::rect{ 2, 0, 5, 1 }), region.runs()[0]);
+
+        // ...and so are all spans covered by a larger one.
+        region.set(til::rect{ 3, 0, 15, 1 });
+        VERIFY_ARE_EQUAL(1u, region.runs().size());
+        VERIFY_ARE_EQUAL((til::rect{ 2, 0, 16, 1 }), region.runs()[0]);
+    }
+
+    TEST_METHOD(MergeIdenticalRows)
+    {
+        til::dirty_region region{ { 10, 6 } };
+        region.set(til::rect{ 2, 0, 5, 3 });
+        region.set(til::rect{ 2, 4, 5, 5 });
+
+        // Rows 0-2 merge into a single rectangle, row 3 is clean and breaks the run.
+        const auto runs = region.runs();
+        VERIFY_ARE_EQUAL(2u, runs.size());
+        VERIFY_ARE_EQUAL((til::rect{ 2, 0, 5, 3 }), runs[0]);
+        VERIFY_ARE_EQUAL((til::rect{ 2, 4, 5, 5 }), runs[1]);
+    }
+
+    TEST_METHOD(RunsPreserveRowOrder)
+    {
+        til::dirty_region region{ { 10, 3 } };
+        region.set(til::rect{ 0, 0, 2, 2 });
+        region.set(til::rect{ 5, 0, 6, 1 });
+
+        // Row 0 has two spans, so row 1 can't be merged into row 0's first span,
+        // or it would be painted before row 0's second span.
+        const auto runs = region.runs();
+        VERIFY_ARE_EQUAL(3u, runs.size());
+        VERIFY_ARE_EQUAL((til::rect{ 0, 0, 2, 1 }), runs[0]);
+        VERIFY_ARE_EQUAL((til::rect{ 5, 0, 6, 1 }), runs[1]);
+        VERIFY_ARE_EQUAL((til::rect{ 0, 1, 2, 2 }), runs[2]);
+    }
+
+    TEST_METHOD(TranslateVertical)
+    {
+        til::dirty_region region{ { 4, 4 } };
+        region.set(til::rect{ 0, 1, 4, 2 });
+
+        region.translate({ 0, 2 });
+        VERIFY_ARE_EQUAL(1u, region.runs().size());
+        VERIFY_ARE_EQUAL((til::rect{ 0, 3, 4, 4 }), region.runs().front());
+
+        // Row 3 moves up to row 0 and the revealed rows 1-3 are filled,
+        // which results in a single rectangle covering everything.
+        region.translate({ 0, -3 }, true);
+        VERIFY_ARE_EQUAL(1u, region.runs().size());
+        VERIFY_ARE_EQUAL((til::rect{ 0, 0, 4, 4 }), region.runs().front());
+        VERIFY_IS_TRUE(region.all());
+
+        region.reset_all();
+        region.translate({ 0, 10 }, true);
+        VERIFY_IS_TRUE(region.all());
+        region.translate({ 0, -10 });
+        VERIFY_IS_TRUE(region.none());
+    }
+
+    TEST_METHOD(Resize)
+    {
+        til::dirty_region region{ { 4, 4 } };
+        region.set(til::rect{ 2, 2, 4, 4 });
+
+        VERIFY_IS_FALSE(region.resize({ 4, 4 }));
+        VERIFY_IS_TRUE(region.resize({ 3, 3 }));
+        VERIFY_ARE_EQUAL(1u, region.runs().size());
+        VERIFY_ARE_EQUAL((til::rect{ 2, 2, 3, 3 }), region.runs().front());
+
+        VERIFY_IS_TRUE(region.resize({ 4, 4 }, true));
+        til::bitmap expected{ { 4, 4 } };
+        expected.set(til::rect{ 2, 2, 3, 3 });
+        expected.set(til::rect{ 3, 0, 4, 4 });
+        expected.set(til::rect{ 0, 3, 4, 4 });
+        _checkMatches(expected, region);
+    }
+
+    TEST_METHOD(MatchesBitmap)
+    {
+        // Applies the same random operations to a til::bitmap
+        // and a til::dirty_region and compares the results.
+        const til::size sz{ 23, 17 };
+        til::bitmap expected{ sz };
+        til::dirty_region actual{ sz };
+
+        // A fixed seed keeps failures reproducible.
+        std::mt19937 rng{ 4015 };
+        const auto randomRect = [&]() {
+            const auto left = gsl::narrow_cast<til::CoordType>(rng() % sz.width);
+            const auto top = gsl::narrow_cast<til::CoordType>(rng() % sz.height);
+            const auto right = left + 1 + gsl::narrow_cast<til::CoordType>(rng() % (sz.width - left));
+            const auto bottom = top + 1 + gsl::narrow_cast<til::CoordType>(rng() % (sz.height - top));
+            return til::rect{ left, top, right, bottom };
+        };
+
+        for (auto i = 0; i < 2000; ++i)
+        {
+            switch (rng() % 8)
+            {
+            case 0:
+            {
+                const til::point delta{ 0, gsl::narrow_cast<til::CoordType>(rng() % 9) - 4 };
+                const auto fill = (rng() & 1) != 0;
+                expected.translate(delta, fill);
+                actual.translate(delta, fill);
+                break;
+            }
+            case 1:
+            {
+                const til::point delta{ gsl::narrow_cast<til::CoordType>(rng() % 9) - 4, 0 };
+                const auto fill = (rng() & 1) != 0;
+                expected.translate(delta, fill);
+                actual.translate(delta, fill);
+                break;
+            }
+            case 2:
+                if (rng() % 16 == 0)
+                {
+                    expected.reset_all();
+                    actual.reset_all();
+                }
+                break;
+            default:
+            {
+                const auto rc = randomRect();
+                expected.set(rc);
+                actual.set(rc);
+                break;
+            }
+            }
+
+            // This test spews out a lot of verify logging by default because of
+            // the loops, so suppress that to only show the failures.
+            SetVerifyOutput settings(VerifyOutputSettings::LogOnlyFailures);
+            _checkMatches(expected, actual);
+        }
+    }
+};
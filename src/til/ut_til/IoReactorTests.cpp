@@ -0,0 +1,305 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+
+#include "til/io_reactor.h"
+#include "til/latch.h"
+
+using namespace WEX::Common;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+
+// An in-process stand-in for a pipe. A read completes as soon as data was written
+// to the pipe or it was closed, which may be immediately when the read begins.
+class TestPipe final : public til::io_reactor::source
+{
+public:
+    explicit TestPipe(char name = 0, std::string* log = nullptr) :
+        _name{ name },
+        _log{ log }
+    {
+    }
+
+    void write(std::string_view data)
+    {
+        std::unique_lock lock{ _mutex };
+        _data.append(data);
+        _flush(lock);
+    }
+
+    void close(uint32_t error = 0)
+    {
+        std::unique_lock lock{ _mutex };
+        _closed = true;
+        _error = error;
+        _flush(lock);
+    }
+
+    // The number of bytes that were written, but not read yet.
+    size_t unread() const
+    {
+        std::scoped_lock lock{ _mutex };
+        return _data.size();
+    }
+
+    void begin_read(til::io_reactor& reactor, gsl::span<char> buffer) noexcept override
+    {
+        std::unique_lock lock{ _mutex };
+        _reactor = &reactor;
+        _buffer = buffer;
+        _pending = true;
+        _flush(lock);
+    }
+
+    void consume(std::string_view data) override
+    {
+        consumed.append(data);
+        if (_log)
+        {
+            _log->push_back(_name);
+        }
+    }
+
+    void end(uint32_t error) override
+    {
+        ends++;
+        endError = error;
+        endConsumed = consumed.size();
+        if (latch)
+        {
+            latch->count_down();
+        }
+    }
+
+    std::string consumed;
+    size_t reads = 0;
+    size_t ends = 0;
+    uint32_t endError = 0;
+    size_t endConsumed = 0;
+    til::latch* latch = nullptr;
+
+private:
+    void _flush(std::unique_lock<std::mutex>& lock)
+    {
+        if (!_pending || (_data.empty() && !_closed))
+        {
+            return;
+        }
+
+        const auto length = std::min(_data.size(), _buffer.size());
+        std::copy_n(_data.data(), length, _buffer.data());
+        _data.erase(0, length);
+        _pending = false;
+        if (length)
+        {
+            reads++;
+        }
+
+        const auto reactor = _reactor;
+        const auto error = length ? 0 : _error;
+        lock.unlock();
+        reactor->complete(*this, length, error);
+    }
+
+    mutable std::mutex _mutex;
+    std::string _data;
+    til::io_reactor* _reactor = nullptr;
+    gsl::span<char> _buffer;
+    bool _pending = false;
+    bool _closed = false;
+    uint32_t _error = 0;
+    char _name = 0;
+    std::string* _log = nullptr;
+};
+
+class IoReactorTests
+{
+    BEGIN_TEST_CLASS(IoReactorTests)
+        TEST_CLASS_PROPERTY(L"TestTimeout", L"0:0:10") // 10s timeout
+    END_TEST_CLASS()
+
+    static til::io_reactor_options _options(size_t buffersPerSource, size_t sharedBuffers)
+    {
+        til::io_reactor_options options;
+        options.workers = 0;
+        options.buffer_size = 4;
+        options.buffers_per_source = buffersPerSource;
+        options.shared_buffers = sharedBuffers;
+        return options;
+    }
+
+    static void _runAll(til::io_reactor& reactor)
+    {
+        while (reactor.run_one())
+        {
+        }
+    }
+
+    TEST_METHOD(ConsumesInOrderAndEnds)
+    {
+        til::io_reactor reactor{ _options(2, 8) };
+        const auto pipe = std::make_shared<TestPipe>();
+        reactor.add(pipe);
+        VERIFY_ARE_EQUAL(1u, reactor.size());
+        VERIFY_IS_FALSE(reactor.run_one());
+
+        pipe->write("Hello, ");
+        _runAll(reactor);
+        pipe->write("World!");
+        pipe->close(42);
+        VERIFY_ARE_EQUAL(0u, pipe->ends);
+
+        _runAll(reactor);
+        VERIFY_ARE_EQUAL("Hello, World!", pipe->consumed);
+        VERIFY_ARE_EQUAL(1u, pipe->ends);
+        VERIFY_ARE_EQUAL(42u, pipe->endError);
+        // end() is only called once all the data was consumed.
+        VERIFY_ARE_EQUAL(pipe->consumed.size(), pipe->endConsumed);
+        VERIFY_ARE_EQUAL(0u, reactor.size());
+        VERIFY_ARE_EQUAL(0u, reactor.buffers_in_use());
+    }
+
+    TEST_METHOD(FloodingSourceDoesNotStarveOthers)
+    {
+        std::string log;
+        til::io_reactor reactor{ _options(4, 8) };
+        const auto flood = std::make_shared<TestPipe>('A', &log);
+        const auto quiet = std::make_shared<TestPipe>('B', &log);
+        reactor.add(flood);
+        reactor.add(quiet);
+
+        flood->write(std::string(40, 'a'));
+        quiet->write("bbbbbbbb");
+
+        // The quiet source is consumed in turns with the flooding
+        // one instead of after all of the flood was consumed.
+        for (auto i = 0; i < 4; ++i)
+        {
+            VERIFY_IS_TRUE(reactor.run_one());
+        }
+        VERIFY_ARE_EQUAL("ABAB", log);
+        VERIFY_ARE_EQUAL("bbbbbbbb", quiet->consumed);
+
+        _runAll(reactor);
+        VERIFY_ARE_EQUAL(std::string(40, 'a'), flood->consumed);
+
+        flood->close();
+        quiet->close();
+        _runAll(reactor);
+        VERIFY_ARE_EQUAL(0u, reactor.size());
+    }
+
+    TEST_METHOD(BackpressureLimitsReads)
+    {
+        til::io_reactor reactor{ _options(3, 8) };
+        const auto pipe = std::make_shared<TestPipe>();
+        reactor.add(pipe);
+
+        // Without any data being consumed the source is only
+        // read from until it holds its limit of buffers.
+        pipe->write(std::string(100, 'x'));
+        VERIFY_ARE_EQUAL(3u, pipe->reads);
+        VERIFY_ARE_EQUAL(3u, reactor.buffers_in_use());
+        VERIFY_ARE_EQUAL(88u, pipe->unread());
+
+        // Each consumed buffer allows for exactly one more read.
+        VERIFY_IS_TRUE(reactor.run_one());
+        VERIFY_ARE_EQUAL(4u, pipe->reads);
+        VERIFY_ARE_EQUAL(3u, reactor.buffers_in_use());
+        VERIFY_ARE_EQUAL(84u, pipe->unread());
+
+        _runAll(reactor);
+        VERIFY_ARE_EQUAL(100u, pipe->consumed.size());
+        VERIFY_ARE_EQUAL(0u, pipe->unread());
+
+        pipe->close();
+        _runAll(reactor);
+        VERIFY_ARE_EQUAL(0u, reactor.buffers_in_use());
+    }
+
+    TEST_METHOD(SharedBudgetPrefersSourcesHoldingFewerBuffers)
+    {
+        til::io_reactor reactor{ _options(4, 2) };
+        const auto a = std::make_shared<TestPipe>();
+        const auto b = std::make_shared<TestPipe>();
+        reactor.add(a);
+        reactor.add(b);
+
+        // a takes the entire shared budget, while b may only use the buffer every source may hold.
+        a->write(std::string(100, 'a'));
+        b->write(std::string(100, 'b'));
+        VERIFY_ARE_EQUAL(3u, a->reads);
+        VERIFY_ARE_EQUAL(1u, b->reads);
+        VERIFY_ARE_EQUAL(4u, reactor.buffers_in_use());
+
+        // Both wait for the shared budget, but b holds fewer buffers, so it gets the one a gives back.
+        VERIFY_IS_TRUE(reactor.run_one());
+        VERIFY_ARE_EQUAL(3u, a->reads);
+        VERIFY_ARE_EQUAL(2u, b->reads);
+        VERIFY_ARE_EQUAL(4u, reactor.buffers_in_use());
+
+        _runAll(reactor);
+        VERIFY_ARE_EQUAL(std::string(100, 'a'), a->consumed);
+        VERIFY_ARE_EQUAL(std::string(100, 'b'), b->consumed);
+
+        a->close();
+        b->close();
+        _runAll(reactor);
+        VERIFY_ARE_EQUAL(0u, reactor.size());
+        VERIFY_ARE_EQUAL(0u, reactor.buffers_in_use());
+    }
+
+    TEST_METHOD(WorkersConsumeConcurrentWrites)
+    {
+        static constexpr size_t sourceCount = 16;
+        static constexpr size_t writeCount = 1000;
+
+        // The reactor is declared last, so that its workers are joined before the pipes are destroyed.
+        til::latch latch{ sourceCount };
+        std::vector<std::shared_ptr<TestPipe>> pipes;
+
+        til::io_reactor_options options;
+        options.workers = 3;
+        options.buffer_size = 64;
+        options.buffers_per_source = 2;
+        options.shared_buffers = 4;
+        til::io_reactor reactor{ options };
+
+        for (size_t i = 0; i < sourceCount; ++i)
+        {
+            const auto& pipe = pipes.emplace_back(std::make_shared<TestPipe>());
+            pipe->latch = &latch;
+            reactor.add(pipe);
+        }
+
+        std::vector<std::thread> writers;
+        for (size_t i = 0; i < sourceCount; ++i)
+        {
+            writers.emplace_back([&, i]() {
+                for (size_t j = 0; j < writeCount; ++j)
+                {
+                    pipes[i]->write(std::to_string(j) + ',');
+                }
+                pipes[i]->close();
+            });
+        }
+        for (auto& writer : writers)
+        {
+            writer.join();
+        }
+        latch.wait();
+
+        std::string expected;
+        for (size_t j = 0; j < writeCount; ++j)
+        {
+            expected += std::to_string(j) + ',';
+        }
+        for (const auto& pipe : pipes)
+        {
+            VERIFY_ARE_EQUAL(expected, pipe->consumed);
+            VERIFY_ARE_EQUAL(1u, pipe->ends);
+        }
+        VERIFY_ARE_EQUAL(0u, reactor.size());
+    }
+};
@@ -0,0 +1,298 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+
+#include "til/lru_map.h"
+
+#include <list>
+#include <random>
+
+using namespace WEX::Common;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+
+class LruMapTests
+{
+    TEST_CLASS(LruMapTests);
+
+    // Maps every key to one of 4 hashes, to test
+    // long probe sequences and backward shift deletion.
+    struct CollidingHash
+    {
+        size_t operator()(int v) const noexcept
+        {
+            return static_cast<size_t>(v & 3);
+        }
+    };
+
+    struct TransparentHash
+    {
+        using is_transparent = int;
+
+        size_t operator()(std::wstring_view v) const noexcept
+        {
+            return std::hash<std::wstring_view>{}(v);
+        }
+    };
+
+    template<typename Map>
+    static std::vector<int> _keys(const Map& map)
+    {
+        std::vector<int> keys;
+        for (const auto& [key, value] : map)
+        {
+            keys.emplace_back(key);
+        }
+        return keys;
+    }
+
+    TEST_METHOD(DefaultConstruct)
+    {
+        til::lru_map<int, int> map;
+        VERIFY_IS_TRUE(map.empty());
+        VERIFY_ARE_EQUAL(0u, map.size());
+        VERIFY_IS_NULL(map.find(0));
+        VERIFY_IS_TRUE(map.begin() == map.end());
+    }
+
+    TEST_METHOD(FindMovesToFront)
+    {
+        til::lru_map<int, int> map;
+        map.insert(1, 10);
+        map.insert(2, 20);
+        map.insert(3, 30);
+        VERIFY_ARE_EQUAL((std::vector<int>{ 3, 2, 1 }), _keys(map));
+        VERIFY_ARE_EQUAL(1, map.back().first);
+
+        VERIFY_ARE_EQUAL(10, *map.find(1));
+        VERIFY_ARE_EQUAL((std::vector<int>{ 1, 3, 2 }), _keys(map));
+        VERIFY_ARE_EQUAL(2, map.back().first);
+
+        // peek() doesn't change the order.
+        VERIFY_ARE_EQUAL(20, *map.peek(2));
+        VERIFY_ARE_EQUAL((std::vector<int>{ 1, 3, 2 }), _keys(map));
+
+        VERIFY_IS_NULL(map.find(4));
+        VERIFY_IS_NULL(map.peek(4));
+    }
+
+    TEST_METHOD(PopBack)
+    {
+        til::lru_map<int, int> map;
+        for (auto i = 0; i < 5; ++i)
+        {
+            map.insert(int{ i }, i * 10);
+        }
+        map.find(0);
+
+        map.pop_back();
+        map.pop_back();
+        VERIFY_ARE_EQUAL((std::vector<int>{ 0, 4, 3 }), _keys(map));
+        VERIFY_IS_NULL(map.find(1));
+        VERIFY_IS_NULL(map.find(2));
+        VERIFY_ARE_EQUAL(30, *map.find(3));
+    }
+
+    TEST_METHOD(EraseWithCollisions)
+    {
+        til::lru_map<int, int, CollidingHash> map;
+        for (auto i = 0; i < 64; ++i)
+        {
+            map.insert(int{ i }, int{ i });
+        }
+
+        // Erasing entries in the middle of a probe sequence
+        // must keep all following entries reachable.
+        for (auto i = 0; i < 64; i += 3)
+        {
+            VERIFY_IS_TRUE(map.erase(i));
+            VERIFY_IS_FALSE(map.erase(i));
+        }
+
+        for (auto i = 0; i < 64; ++i)
+        {
+            const auto value = map.peek(i);
+            if (i % 3 == 0)
+            {
+                VERIFY_IS_NULL(value);
+            }
+            else
+            {
+                VERIFY_IS_NOT_NULL(value);
+                VERIFY_ARE_EQUAL(i, *value);
+            }
+        }
+    }
+
+    TEST_METHOD(ReferencesAreStable)
+    {
+        til::lru_map<int, std::wstring> map;
+        auto& first = map.insert(0, L"first");
+
+        // Inserting enough entries to grow the table many times
+        // (and to allocate additional pages of nodes) mustn't move entries.
+        for (auto i = 1; i < 5000; ++i)
+        {
+            map.insert(int{ i }, std::to_wstring(i));
+        }
+
+        VERIFY_ARE_EQUAL(&first.second, map.find(0));
+        VERIFY_ARE_EQUAL(L"first", first.second);
+    }
+
+    TEST_METHOD(ReusesErasedNodes)
+    {
+        til::lru_map<int, int> map;
+        auto& a = map.insert(1, 1);
+        const auto address = &a;
+        map.pop_back();
+        VERIFY_IS_TRUE(map.empty());
+
+        auto& b = map.insert(2, 2);
+        VERIFY_ARE_EQUAL(address, &b);
+    }
+
+    TEST_METHOD(HeterogeneousLookup)
+    {
+        til::lru_map<std::wstring, int, TransparentHash, std::equal_to<>> map;
+        map.insert(L"abc", 1);
+        map.insert(L"def", 2);
+
+        const std::wstring_view key{ L"abc" };
+        VERIFY_ARE_EQUAL(1, *map.find(key));
+        VERIFY_IS_NULL(map.find(std::wstring_view{ L"xyz" }));
+    }
+
+    TEST_METHOD(MoveAndClear)
+    {
+        til::lru_map<int, std::wstring> map;
+        map.insert(1, L"a");
+        map.insert(2, L"b");
+
+        auto other = std::move(map);
+        VERIFY_IS_TRUE(map.empty());
+        VERIFY_ARE_EQUAL(2u, other.size());
+        VERIFY_ARE_EQUAL(L"a", *other.find(1));
+
+        map = std::move(other);
+        VERIFY_ARE_EQUAL((std::vector<int>{ 1, 2 }), _keys(map));
+
+        map.clear();
+        VERIFY_IS_TRUE(map.empty());
+        VERIFY_IS_NULL(map.find(1));
+        map.insert(3, L"c");
+        VERIFY_ARE_EQUAL(L"c", *map.find(3));
+    }
+
+    TEST_METHOD(MatchesReference)
+    {
+        // Applies the same random operations to a til::lru_map and
+        // a std::list in LRU order and compares the results.
+        til::lru_map<int, int, CollidingHash> actual;
+        std::list<std::pair<int, int>> expected;
+
+        // A fixed seed keeps failures reproducible.
+        std::mt19937 rng{ 31415 };
+
+        // This test spews out a lot of verify logging by default because of
+        // the loops, so suppress that to only show the failures.
+        SetVerifyOutput settings(VerifyOutputSettings::LogOnlyFailures);
+
+        for (auto i = 0; i < 5000; ++i)
+        {
+            const auto key = gsl::narrow_cast<int>(rng() % 200);
+            const auto it = std::find_if(expected.begin(), expected.end(), [&](const auto& p) { return p.first == key; });
+
+            switch (rng() % 8)
+            {
+            case 0:
+            case 1:
+            case 2:
+            {
+                const auto value = actual.find(key);
+                VERIFY_ARE_EQUAL(it != expected.end(), value != nullptr);
+                if (value)
+                {
+                    VERIFY_ARE_EQUAL(it->second, *value);
+                    expected.splice(expected.begin(), expected, it);
+                }
+                break;
+            }
+            case 3:
+            case 4:
+            case 5:
+                if (it == expected.end())
+                {
+                    actual.insert(int{ key }, int{ i });
+                    expected.emplace_front(key, i);
+                }
+                break;
+            case 6:
+                VERIFY_ARE_EQUAL(it != expected.end(), actual.erase(key));
+                if (it != expected.end())
+                {
+                    expected.erase(it);
+                }
+                break;
+            default:
+                if (!expected.empty())
+                {
+                    VERIFY_ARE_EQUAL(expected.back().first, actual.back().first);
+                    actual.pop_back();
+                    expected.pop_back();
+                }
+                break;
+            }
+
+            VERIFY_ARE_EQUAL(expected.size(), actual.size());
+            VERIFY_IS_TRUE(std::equal(expected.begin(), expected.end(), actual.begin(), actual.end(), [](const auto& a, const auto& b) {
+                return a.first == b.first && a.second == b.second;
+            }));
+        }
+    }
+
+    TEST_METHOD(Benchmark)
+    {
+        // Measures lookups and evictions with a working set of thousands of keys, similar to
+        // what a CJK-heavy screen causes in AtlasEngine's glyph cache. Enable it with the
+        // "LruMapBenchmark" runtime parameter, since it only logs the results.
+        String enabled;
+        if (FAILED(RuntimeParameters::TryGetValue(L"LruMapBenchmark", enabled)) || enabled.IsEmpty())
+        {
+            Log::Result(TestResults::Skipped);
+            return;
+        }
+
+        static constexpr size_t capacity = 4096;
+        static constexpr auto operations = 10'000'000;
+
+        til::lru_map<uint32_t, uint32_t> map;
+        std::mt19937 rng{ 27182 };
+        std::vector<uint32_t> keys(operations);
+        for (auto& key : keys)
+        {
+            // Most lookups hit a small set of common glyphs, the rest spreads over a much larger range.
+            key = rng() % 4 == 0 ? rng() % 20000 : rng() % 512;
+        }
+
+        size_t misses = 0;
+        const auto beg = std::chrono::steady_clock::now();
+        for (const auto key : keys)
+        {
+            if (!map.find(key))
+            {
+                misses++;
+                if (map.size() >= capacity)
+                {
+                    map.pop_back();
+                }
+                map.insert(uint32_t{ key }, uint32_t{ key });
+            }
+        }
+        const auto end = std::chrono::steady_clock::now();
+
+        const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - beg).count();
+        Log::Comment(NoThrowString().Format(L"%d operations, %zu misses, %.2f ns/op", operations, misses, static_cast<double>(ns) / operations));
+    }
+};
@@ -0,0 +1,275 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+
+#include "til/latch.h"
+#include "til/timer_wheel.h"
+
+#include <future>
+#include <random>
+
+using namespace std::chrono_literals;
+using namespace WEX::Common;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+
+class TimerWheelTests
+{
+    BEGIN_TEST_CLASS(TimerWheelTests)
+        TEST_CLASS_PROPERTY(L"TestTimeout", L"0:0:10") // 10s timeout
+    END_TEST_CLASS()
+
+    using clock = til::timer_wheel::clock;
+    using timer = til::timer_wheel::timer;
+
+    // Advances a manually driven wheel from one wakeup to the next
+    // until no timer is armed anymore, like a driver would.
+    static void _runAll(til::timer_wheel& wheel, clock::time_point& now)
+    {
+        while (const auto next = wheel.next_wakeup())
+        {
+            now = *next;
+            wheel.advance(now);
+        }
+    }
+
+    // Like _runAll(), but stops at the given time.
+    static void _advanceTo(til::timer_wheel& wheel, clock::time_point& now, clock::time_point target)
+    {
+        for (auto next = wheel.next_wakeup(); next && *next <= target; next = wheel.next_wakeup())
+        {
+            now = *next;
+            wheel.advance(now);
+        }
+        now = target;
+        wheel.advance(now);
+    }
+
+    TEST_METHOD(ExpiresAfterDelay)
+    {
+        const auto origin = clock::now();
+        til::timer_wheel wheel{ til::timer_wheel_driver::manual, origin };
+        VERIFY_IS_FALSE(wheel.next_wakeup().has_value());
+
+        auto count = 0;
+        timer t{ wheel, [&]() { count++; } };
+        t.arm(10ms);
+        VERIFY_IS_TRUE(t.armed());
+        VERIFY_ARE_EQUAL(origin + 10ms, wheel.next_wakeup().value());
+
+        VERIFY_ARE_EQUAL(0u, wheel.advance(origin + 9ms));
+        VERIFY_ARE_EQUAL(0, count);
+        VERIFY_ARE_EQUAL(1u, wheel.advance(origin + 10ms));
+        VERIFY_ARE_EQUAL(1, count);
+        VERIFY_IS_FALSE(t.armed());
+        VERIFY_IS_FALSE(wheel.next_wakeup().has_value());
+
+        // Delays are rounded up to whole milliseconds and measured from the time the wheel was advanced to.
+        t.arm(1500us);
+        VERIFY_ARE_EQUAL(0u, wheel.advance(origin + 11ms));
+        VERIFY_ARE_EQUAL(1u, wheel.advance(origin + 12ms));
+        VERIFY_ARE_EQUAL(2, count);
+    }
+
+    TEST_METHOD(CancelAndRearm)
+    {
+        const auto origin = clock::now();
+        til::timer_wheel wheel{ til::timer_wheel_driver::manual, origin };
+
+        auto count = 0;
+        timer t{ wheel, [&]() { count++; } };
+        t.arm(5ms);
+        VERIFY_IS_TRUE(t.cancel());
+        VERIFY_IS_FALSE(t.cancel());
+        VERIFY_ARE_EQUAL(0u, wheel.advance(origin + 10ms));
+
+        // Arming an armed timer replaces its delay.
+        t.arm(5ms);
+        t.arm(20ms);
+        VERIFY_ARE_EQUAL(0u, wheel.advance(origin + 29ms));
+        VERIFY_ARE_EQUAL(1u, wheel.advance(origin + 30ms));
+        VERIFY_ARE_EQUAL(1, count);
+
+        // Destroying a timer cancels it.
+        {
+            timer other{ wheel, [&]() { count++; } };
+            other.arm(1ms);
+        }
+        VERIFY_ARE_EQUAL(0u, wheel.advance(origin + 1s));
+        VERIFY_ARE_EQUAL(1, count);
+    }
+
+    TEST_METHOD(ExpiresOnTimeOnAllLevels)
+    {
+        const auto origin = clock::now();
+        til::timer_wheel wheel{ til::timer_wheel_driver::manual, origin };
+        auto now = origin;
+
+        // These delays hit the boundaries between the levels, as well as
+        // the range of the highest level, which has to be exceeded.
+        const std::vector<clock::duration> delays{ 1ms, 63ms, 64ms, 65ms, 4095ms, 4096ms, 4097ms, 262144ms, 300s, 16777215ms, 16777216ms, 10h };
+        std::vector<clock::time_point> expired(delays.size());
+        std::deque<timer> timers;
+        for (size_t i = 0; i < delays.size(); ++i)
+        {
+            timers.emplace_back(wheel, [&, i]() { expired[i] = now; });
+            timers.back().arm(delays[i]);
+        }
+
+        _runAll(wheel, now);
+
+        for (size_t i = 0; i < delays.size(); ++i)
+        {
+            VERIFY_ARE_EQUAL(origin + delays[i], expired[i]);
+        }
+    }
+
+    TEST_METHOD(CallbacksMayRearmTheirTimer)
+    {
+        const auto origin = clock::now();
+        til::timer_wheel wheel{ til::timer_wheel_driver::manual, origin };
+        auto now = origin;
+
+        std::vector<clock::time_point> expired;
+        std::unique_ptr<timer> t;
+        t = std::make_unique<timer>(wheel, [&]() {
+            expired.emplace_back(now);
+            if (expired.size() < 3)
+            {
+                t->arm(100ms);
+            }
+        });
+        t->arm(100ms);
+
+        _runAll(wheel, now);
+        VERIFY_ARE_EQUAL((std::vector<clock::time_point>{ origin + 100ms, origin + 200ms, origin + 300ms }), expired);
+    }
+
+    TEST_METHOD(MatchesReference)
+    {
+        // Applies the same random operations to a timer_wheel and a list of
+        // expiry times and checks that every timer expires exactly on time.
+        static constexpr size_t timerCount = 64;
+
+        const auto origin = clock::now();
+        til::timer_wheel wheel{ til::timer_wheel_driver::manual, origin };
+        auto now = origin;
+
+        std::array<std::optional<clock::time_point>, timerCount> expected;
+        std::deque<timer> timers;
+        auto failures = 0;
+        for (size_t i = 0; i < timerCount; ++i)
+        {
+            timers.emplace_back(wheel, [&, i]() {
+                if (expected[i] != now)
+                {
+                    failures++;
+                }
+                expected[i].reset();
+            });
+        }
+
+        // A fixed seed keeps failures reproducible.
+        std::mt19937 rng{ 16180 };
+        const auto randomDelay = [&]() -> clock::duration {
+            switch (rng() % 4)
+            {
+            case 0:
+                return std::chrono::milliseconds{ rng() % 64 };
+            case 1:
+                return std::chrono::milliseconds{ rng() % 5000 };
+            case 2:
+                return std::chrono::milliseconds{ rng() % 1'000'000 };
+            default:
+                return std::chrono::milliseconds{ rng() % 40'000'000 };
+            }
+        };
+
+        for (auto i = 0; i < 20000; ++i)
+        {
+            const auto index = rng() % timerCount;
+            switch (rng() % 4)
+            {
+            case 0:
+            case 1:
+            {
+                const auto delay = std::max<clock::duration>(randomDelay(), 1ms);
+                timers[index].arm(delay);
+                expected[index] = now + delay;
+                break;
+            }
+            case 2:
+                VERIFY_ARE_EQUAL(expected[index].has_value(), timers[index].cancel());
+                expected[index].reset();
+                break;
+            default:
+                _advanceTo(wheel, now, now + randomDelay());
+                break;
+            }
+        }
+
+        _runAll(wheel, now);
+        VERIFY_ARE_EQUAL(0, failures);
+        VERIFY_IS_TRUE(std::none_of(expected.begin(), expected.end(), [](const auto& e) { return e.has_value(); }));
+    }
+
+    TEST_METHOD(ThreadDriver)
+    {
+        til::latch latch{ 3 };
+        til::timer_wheel wheel{ til::timer_wheel_driver::thread };
+
+        std::atomic<int> count{ 0 };
+        std::deque<timer> timers;
+        for (auto i = 0; i < 3; ++i)
+        {
+            timers.emplace_back(wheel, [&]() {
+                count++;
+                latch.count_down();
+            });
+            timers.back().arm(10ms);
+        }
+        latch.wait();
+        VERIFY_ARE_EQUAL(3, count.load());
+
+        // Canceling a timer waits for its running callback to return.
+        til::latch started{ 1 };
+        std::atomic<bool> returned{ false };
+        timer slow{ wheel, [&]() {
+                       started.count_down();
+                       std::this_thread::sleep_for(50ms);
+                       returned = true;
+                   } };
+        slow.arm(1ms);
+        started.wait();
+        slow.cancel();
+        VERIFY_IS_TRUE(returned.load());
+    }
+
+    TEST_METHOD(ThreadpoolDriverRunsCallbacksInParallel)
+    {
+        til::timer_wheel wheel{ til::timer_wheel_driver::threadpool };
+
+        // The slow callback blocks until the fast one ran, which
+        // would never happen if the callbacks ran one after another.
+        std::promise<void> fastRan;
+        auto fastRanFuture = fastRan.get_future();
+        std::atomic<bool> sawFast{ false };
+        timer slow{ wheel, [&]() {
+                       sawFast = fastRanFuture.wait_for(5s) == std::future_status::ready;
+                   } };
+        timer fast{ wheel, [&]() { fastRan.set_value(); } };
+
+        slow.arm(1ms);
+        fast.arm(20ms);
+
+        // Canceling waits for the callbacks that were submitted to the threadpool, too.
+        while (!sawFast.load() && (slow.armed() || fast.armed()))
+        {
+            std::this_thread::sleep_for(1ms);
+        }
+        slow.cancel();
+        fast.cancel();
+        VERIFY_IS_TRUE(sawFast.load());
+    }
+};
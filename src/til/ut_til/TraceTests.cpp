@@ -0,0 +1,141 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+
+#include "til/trace.h"
+
+using namespace std::chrono_literals;
+using namespace WEX::Common;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+
+class TraceTests
+{
+    BEGIN_TEST_CLASS(TraceTests)
+        TEST_CLASS_PROPERTY(L"TestTimeout", L"0:0:10") // 10s timeout
+    END_TEST_CLASS()
+
+    TEST_METHOD_SETUP(MethodSetup)
+    {
+        til::trace::clear();
+        til::trace::enable(true);
+        return true;
+    }
+
+    TEST_METHOD_CLEANUP(MethodCleanup)
+    {
+        til::trace::enable(false);
+        til::trace::clear();
+        return true;
+    }
+
+    TEST_METHOD(RecordsNestedSpans)
+    {
+        {
+            const til::trace::span outer{ "test", "outer" };
+            {
+                const til::trace::span inner{ "test", "inner" };
+            }
+        }
+
+        const auto records = til::trace::snapshot();
+        VERIFY_ARE_EQUAL(2u, records.size());
+        VERIFY_ARE_EQUAL(std::string_view{ "outer" }, records[0].name);
+        VERIFY_ARE_EQUAL(std::string_view{ "inner" }, records[1].name);
+        VERIFY_ARE_EQUAL(std::string_view{ "test" }, records[0].category);
+        VERIFY_IS_TRUE(records[0].begin <= records[1].begin);
+        VERIFY_IS_TRUE(records[1].end <= records[0].end);
+        VERIFY_ARE_EQUAL(records[0].thread, records[1].thread);
+    }
+
+    TEST_METHOD(DisabledTracingRecordsNothing)
+    {
+        til::trace::enable(false);
+        {
+            const til::trace::span span{ "test", "disabled" };
+        }
+        VERIFY_ARE_EQUAL(0u, til::trace::snapshot().size());
+
+        til::trace::enable(true);
+        {
+            const til::trace::span span{ "test", "enabled" };
+        }
+        VERIFY_ARE_EQUAL(1u, til::trace::snapshot().size());
+
+        til::trace::clear();
+        VERIFY_ARE_EQUAL(0u, til::trace::snapshot().size());
+    }
+
+    TEST_METHOD(FullRingOverwritesOldestSpans)
+    {
+        static constexpr auto capacity = til::trace::details::ring::capacity;
+
+        const auto origin = til::trace::clock::now() + 1s;
+        for (size_t i = 0; i < capacity + 10; ++i)
+        {
+            const auto begin = origin + std::chrono::microseconds{ i };
+            til::trace::record("test", "span", begin, begin);
+        }
+
+        const auto records = til::trace::snapshot();
+        VERIFY_ARE_EQUAL(capacity, records.size());
+        VERIFY_ARE_EQUAL(origin + 10us, records.front().begin);
+        VERIFY_ARE_EQUAL(origin + std::chrono::microseconds{ capacity + 9 }, records.back().begin);
+    }
+
+    TEST_METHOD(SnapshotWhileRecording)
+    {
+        // Every thread records spans that last exactly as many microseconds as their
+        // index says, so that torn records would show up as mismatched names or durations.
+        static constexpr std::array<const char*, 4> names{ "0", "1", "2", "3" };
+        std::atomic<bool> stop{ false };
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < names.size(); ++i)
+        {
+            threads.emplace_back([&, i]() {
+                while (!stop.load(std::memory_order_relaxed))
+                {
+                    const auto begin = til::trace::clock::now();
+                    til::trace::record("test", names[i], begin, begin + std::chrono::microseconds{ i });
+                }
+            });
+        }
+
+        auto failures = 0;
+        for (auto i = 0; i < 20; ++i)
+        {
+            for (const auto& record : til::trace::snapshot())
+            {
+                const auto index = record.name[0] - '0';
+                if (record.end - record.begin != std::chrono::microseconds{ index })
+                {
+                    failures++;
+                }
+            }
+        }
+
+        stop = true;
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        VERIFY_ARE_EQUAL(0, failures);
+    }
+
+    TEST_METHOD(ChromeJson)
+    {
+        const auto origin = til::trace::clock::now();
+        std::vector<til::trace::span_record> records{
+            { "parse", "ProcessString", origin, origin + 1500ns, 1 },
+            { "paint", R"(Paint "frame")", origin + 2us, origin + 5us, 2 },
+        };
+
+        VERIFY_ARE_EQUAL(
+            std::string{ R"({"displayTimeUnit":"ns","traceEvents":[)"
+                         R"({"name":"ProcessString","cat":"parse","ph":"X","pid":1,"tid":1,"ts":0.000,"dur":1.500},)"
+                         R"({"name":"Paint \"frame\"","cat":"paint","ph":"X","pid":1,"tid":2,"ts":2.000,"dur":3.000}]})" },
+            til::trace::to_chrome_json(records));
+        VERIFY_ARE_EQUAL(std::string{ R"({"displayTimeUnit":"ns","traceEvents":[]})" }, til::trace::to_chrome_json({}));
+    }
+};
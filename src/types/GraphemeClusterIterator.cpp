@@ -0,0 +1,1107 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "inc/GraphemeClusterIterator.hpp"
+
+#include "inc/GlyphWidth.hpp"
+#include "inc/Utf16Parser.hpp"
+
+namespace
+{
+    struct GraphemeBreakRange final
+    {
+        char32_t lowerBound;
+        char32_t upperBound;
+        GraphemeBreak value;
+    };
+
+    static bool operator<(const GraphemeBreakRange& range, const char32_t searchTerm) noexcept
+    {
+        return range.upperBound < searchTerm;
+    }
+
+    // Code points that aren't listed are GraphemeBreak::Other. The Hangul syllables (LV and LVT)
+    // aren't listed either, as they can be told apart arithmetically.
+    // Generated by Generate-GraphemeBreakTableFromUCD.ps1 from Unicode 16.0.0.
+    // 10665 (0x29A9) codepoints covered.
+    static constexpr std::array<GraphemeBreakRange, 683> s_graphemeBreakTable{
+        GraphemeBreakRange{ 0x0, 0x9, GraphemeBreak::Control },
+        GraphemeBreakRange{ 0xa, 0xa, GraphemeBreak::LF },
+        GraphemeBreakRange{ 0xb, 0xc, GraphemeBreak::Control },
+        GraphemeBreakRange{ 0xd, 0xd, GraphemeBreak::CR },
+        GraphemeBreakRange{ 0xe, 0x1f, GraphemeBreak::Control },
+        GraphemeBreakRange{ 0x7f, 0x9f, GraphemeBreak::Control },
+        GraphemeBreakRange{ 0xa9, 0xa9, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0xad, 0xad, GraphemeBreak::Control },
+        GraphemeBreakRange{ 0xae, 0xae, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0x300, 0x36f, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x483, 0x489, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x591, 0x5bd, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x5bf, 0x5bf, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x5c1, 0x5c2, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x5c4, 0x5c5, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x5c7, 0x5c7, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x600, 0x605, GraphemeBreak::Prepend },
+        GraphemeBreakRange{ 0x610, 0x61a, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x61c, 0x61c, GraphemeBreak::Control },
+        GraphemeBreakRange{ 0x64b, 0x65f, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x670, 0x670, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x6d6, 0x6dc, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x6dd, 0x6dd, GraphemeBreak::Prepend },
+        GraphemeBreakRange{ 0x6df, 0x6e4, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x6e7, 0x6e8, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x6ea, 0x6ed, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x70f, 0x70f, GraphemeBreak::Prepend },
+        GraphemeBreakRange{ 0x711, 0x711, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x730, 0x74a, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x7a6, 0x7b0, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x7eb, 0x7f3, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x7fd, 0x7fd, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x816, 0x819, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x81b, 0x823, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x825, 0x827, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x829, 0x82d, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x859, 0x85b, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x890, 0x891, GraphemeBreak::Prepend },
+        GraphemeBreakRange{ 0x897, 0x89f, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x8ca, 0x8e1, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x8e2, 0x8e2, GraphemeBreak::Prepend },
+        GraphemeBreakRange{ 0x8e3, 0x902, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x903, 0x903, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x915, 0x939, GraphemeBreak::ConjunctConsonant },
+        GraphemeBreakRange{ 0x93a, 0x93a, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x93b, 0x93b, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x93c, 0x93c, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x93e, 0x940, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x941, 0x948, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x949, 0x94c, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x94d, 0x94d, GraphemeBreak::ConjunctLinker },
+        GraphemeBreakRange{ 0x94e, 0x94f, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x951, 0x957, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x958, 0x95f, GraphemeBreak::ConjunctConsonant },
+        GraphemeBreakRange{ 0x962, 0x963, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x978, 0x97f, GraphemeBreak::ConjunctConsonant },
+        GraphemeBreakRange{ 0x981, 0x981, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x982, 0x983, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x995, 0x9a8, GraphemeBreak::ConjunctConsonant },
+        GraphemeBreakRange{ 0x9aa, 0x9b0, GraphemeBreak::ConjunctConsonant },
+        GraphemeBreakRange{ 0x9b2, 0x9b2, GraphemeBreak::ConjunctConsonant },
+        GraphemeBreakRange{ 0x9b6, 0x9b9, GraphemeBreak::ConjunctConsonant },
+        GraphemeBreakRange{ 0x9bc, 0x9bc, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x9be, 0x9be, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x9bf, 0x9c0, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x9c1, 0x9c4, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x9c7, 0x9c8, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x9cb, 0x9cc, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x9cd, 0x9cd, GraphemeBreak::ConjunctLinker },
+        GraphemeBreakRange{ 0x9d7, 0x9d7, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x9dc, 0x9dd, GraphemeBreak::ConjunctConsonant },
+        GraphemeBreakRange{ 0x9df, 0x9df, GraphemeBreak::ConjunctConsonant },
+        GraphemeBreakRange{ 0x9e2, 0x9e3, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x9f0, 0x9f1, GraphemeBreak::ConjunctConsonant },
+        GraphemeBreakRange{ 0x9fe, 0x9fe, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xa01, 0xa02, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xa03, 0xa03, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0xa3c, 0xa3c, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xa3e, 0xa40, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0xa41, 0xa42, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xa47, 0xa48, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xa4b, 0xa4d, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xa51, 0xa51, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xa70, 0xa71, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xa75, 0xa75, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xa81, 0xa82, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xa83, 0xa83, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0xa95, 0xaa8, GraphemeBreak::ConjunctConsonant },
+        GraphemeBreakRange{ 0xaaa, 0xab0, GraphemeBreak::ConjunctConsonant },
+        GraphemeBreakRange{ 0xab2, 0xab3, GraphemeBreak::ConjunctConsonant },
+        GraphemeBreakRange{ 0xab5, 0xab9, GraphemeBreak::ConjunctConsonant },
+        GraphemeBreakRange{ 0xabc, 0xabc, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xabe, 0xac0, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0xac1, 0xac5, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xac7, 0xac8, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xac9, 0xac9, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0xacb, 0xacc, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0xacd, 0xacd, GraphemeBreak::ConjunctLinker },
+        GraphemeBreakRange{ 0xae2, 0xae3, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xaf9, 0xaf9, GraphemeBreak::ConjunctConsonant },
+        GraphemeBreakRange{ 0xafa, 0xaff, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xb01, 0xb01, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xb02, 0xb03, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0xb15, 0xb28, GraphemeBreak::ConjunctConsonant },
+        GraphemeBreakRange{ 0xb2a, 0xb30, GraphemeBreak::ConjunctConsonant },
+        GraphemeBreakRange{ 0xb32, 0xb33, GraphemeBreak::ConjunctConsonant },
+        GraphemeBreakRange{ 0xb35, 0xb39, GraphemeBreak::ConjunctConsonant },
+        GraphemeBreakRange{ 0xb3c, 0xb3c, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xb3e, 0xb3f, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xb40, 0xb40, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0xb41, 0xb44, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xb47, 0xb48, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0xb4b, 0xb4c, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0xb4d, 0xb4d, GraphemeBreak::ConjunctLinker },
+        GraphemeBreakRange{ 0xb55, 0xb57, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xb5c, 0xb5d, GraphemeBreak::ConjunctConsonant },
+        GraphemeBreakRange{ 0xb5f, 0xb5f, GraphemeBreak::ConjunctConsonant },
+        GraphemeBreakRange{ 0xb62, 0xb63, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xb71, 0xb71, GraphemeBreak::ConjunctConsonant },
+        GraphemeBreakRange{ 0xb82, 0xb82, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xbbe, 0xbbe, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xbbf, 0xbbf, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0xbc0, 0xbc0, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xbc1, 0xbc2, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0xbc6, 0xbc8, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0xbca, 0xbcc, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0xbcd, 0xbcd, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xbd7, 0xbd7, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xc00, 0xc00, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xc01, 0xc03, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0xc04, 0xc04, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xc15, 0xc28, GraphemeBreak::ConjunctConsonant },
+        GraphemeBreakRange{ 0xc2a, 0xc39, GraphemeBreak::ConjunctConsonant },
+        GraphemeBreakRange{ 0xc3c, 0xc3c, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xc3e, 0xc40, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xc41, 0xc44, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0xc46, 0xc48, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xc4a, 0xc4c, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xc4d, 0xc4d, GraphemeBreak::ConjunctLinker },
+        GraphemeBreakRange{ 0xc55, 0xc56, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xc58, 0xc5a, GraphemeBreak::ConjunctConsonant },
+        GraphemeBreakRange{ 0xc62, 0xc63, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xc81, 0xc81, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xc82, 0xc83, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0xcbc, 0xcbc, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xcbe, 0xcbe, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0xcbf, 0xcc0, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xcc1, 0xcc1, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0xcc2, 0xcc2, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xcc3, 0xcc4, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0xcc6, 0xcc8, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xcca, 0xccd, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xcd5, 0xcd6, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xce2, 0xce3, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xcf3, 0xcf3, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0xd00, 0xd01, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xd02, 0xd03, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0xd15, 0xd3a, GraphemeBreak::ConjunctConsonant },
+        GraphemeBreakRange{ 0xd3b, 0xd3c, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xd3e, 0xd3e, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xd3f, 0xd40, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0xd41, 0xd44, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xd46, 0xd48, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0xd4a, 0xd4c, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0xd4d, 0xd4d, GraphemeBreak::ConjunctLinker },
+        GraphemeBreakRange{ 0xd4e, 0xd4e, GraphemeBreak::Prepend },
+        GraphemeBreakRange{ 0xd57, 0xd57, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xd62, 0xd63, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xd81, 0xd81, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xd82, 0xd83, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0xdca, 0xdca, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xdcf, 0xdcf, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xdd0, 0xdd1, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0xdd2, 0xdd4, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xdd6, 0xdd6, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xdd8, 0xdde, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0xddf, 0xddf, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xdf2, 0xdf3, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0xe31, 0xe31, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xe33, 0xe33, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0xe34, 0xe3a, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xe47, 0xe4e, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xeb1, 0xeb1, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xeb3, 0xeb3, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0xeb4, 0xebc, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xec8, 0xece, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xf18, 0xf19, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xf35, 0xf35, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xf37, 0xf37, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xf39, 0xf39, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xf3e, 0xf3f, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0xf71, 0xf7e, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xf7f, 0xf7f, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0xf80, 0xf84, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xf86, 0xf87, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xf8d, 0xf97, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xf99, 0xfbc, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xfc6, 0xfc6, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x102d, 0x1030, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1031, 0x1031, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x1032, 0x1037, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1039, 0x103a, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x103b, 0x103c, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x103d, 0x103e, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1056, 0x1057, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x1058, 0x1059, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x105e, 0x1060, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1071, 0x1074, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1082, 0x1082, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1084, 0x1084, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x1085, 0x1086, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x108d, 0x108d, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x109d, 0x109d, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1100, 0x115f, GraphemeBreak::L },
+        GraphemeBreakRange{ 0x1160, 0x11a7, GraphemeBreak::V },
+        GraphemeBreakRange{ 0x11a8, 0x11ff, GraphemeBreak::T },
+        GraphemeBreakRange{ 0x135d, 0x135f, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1712, 0x1715, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1732, 0x1734, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1752, 0x1753, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1772, 0x1773, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x17b4, 0x17b5, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x17b6, 0x17b6, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x17b7, 0x17bd, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x17be, 0x17c5, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x17c6, 0x17c6, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x17c7, 0x17c8, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x17c9, 0x17d3, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x17dd, 0x17dd, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x180b, 0x180d, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x180e, 0x180e, GraphemeBreak::Control },
+        GraphemeBreakRange{ 0x180f, 0x180f, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1885, 0x1886, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x18a9, 0x18a9, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1920, 0x1922, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1923, 0x1926, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x1927, 0x1928, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1929, 0x192b, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x1930, 0x1931, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x1932, 0x1932, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1933, 0x1938, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x1939, 0x193b, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1a17, 0x1a18, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1a19, 0x1a1a, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x1a1b, 0x1a1b, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1a55, 0x1a55, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x1a56, 0x1a56, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1a57, 0x1a57, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x1a58, 0x1a5e, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1a60, 0x1a60, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1a62, 0x1a62, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1a65, 0x1a6c, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1a6d, 0x1a72, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x1a73, 0x1a7c, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1a7f, 0x1a7f, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1ab0, 0x1ace, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1b00, 0x1b03, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1b04, 0x1b04, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x1b34, 0x1b3d, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1b3e, 0x1b41, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x1b42, 0x1b44, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1b6b, 0x1b73, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1b80, 0x1b81, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1b82, 0x1b82, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x1ba1, 0x1ba1, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x1ba2, 0x1ba5, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1ba6, 0x1ba7, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x1ba8, 0x1bad, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1be6, 0x1be6, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1be7, 0x1be7, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x1be8, 0x1be9, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1bea, 0x1bec, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x1bed, 0x1bed, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1bee, 0x1bee, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x1bef, 0x1bf3, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1c24, 0x1c2b, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x1c2c, 0x1c33, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1c34, 0x1c35, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x1c36, 0x1c37, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1cd0, 0x1cd2, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1cd4, 0x1ce0, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1ce1, 0x1ce1, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x1ce2, 0x1ce8, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1ced, 0x1ced, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1cf4, 0x1cf4, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1cf7, 0x1cf7, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x1cf8, 0x1cf9, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1dc0, 0x1dff, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x200b, 0x200b, GraphemeBreak::Control },
+        GraphemeBreakRange{ 0x200c, 0x200c, GraphemeBreak::Extend },
+        GraphemeBreakRange{ 0x200d, 0x200d, GraphemeBreak::ZWJ },
+        GraphemeBreakRange{ 0x200e, 0x200f, GraphemeBreak::Control },
+        GraphemeBreakRange{ 0x2028, 0x202e, GraphemeBreak::Control },
+        GraphemeBreakRange{ 0x203c, 0x203c, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0x2049, 0x2049, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0x2060, 0x206f, GraphemeBreak::Control },
+        GraphemeBreakRange{ 0x20d0, 0x20f0, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x2122, 0x2122, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0x2139, 0x2139, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0x2194, 0x2199, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0x21a9, 0x21aa, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0x231a, 0x231b, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0x2328, 0x2328, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0x2388, 0x2388, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0x23cf, 0x23cf, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0x23e9, 0x23f3, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0x23f8, 0x23fa, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0x24c2, 0x24c2, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0x25aa, 0x25ab, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0x25b6, 0x25b6, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0x25c0, 0x25c0, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0x25fb, 0x25fe, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0x2600, 0x2605, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0x2607, 0x2612, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0x2614, 0x2685, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0x2690, 0x2705, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0x2708, 0x2712, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0x2714, 0x2714, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0x2716, 0x2716, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0x271d, 0x271d, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0x2721, 0x2721, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0x2728, 0x2728, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0x2733, 0x2734, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0x2744, 0x2744, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0x2747, 0x2747, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0x274c, 0x274c, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0x274e, 0x274e, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0x2753, 0x2755, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0x2757, 0x2757, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0x2763, 0x2767, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0x2795, 0x2797, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0x27a1, 0x27a1, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0x27b0, 0x27b0, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0x27bf, 0x27bf, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0x2934, 0x2935, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0x2b05, 0x2b07, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0x2b1b, 0x2b1c, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0x2b50, 0x2b50, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0x2b55, 0x2b55, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0x2cef, 0x2cf1, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x2d7f, 0x2d7f, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x2de0, 0x2dff, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x302a, 0x302f, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x3030, 0x3030, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0x303d, 0x303d, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0x3099, 0x309a, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x3297, 0x3297, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0x3299, 0x3299, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0xa66f, 0xa672, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xa674, 0xa67d, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xa69e, 0xa69f, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xa6f0, 0xa6f1, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xa802, 0xa802, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xa806, 0xa806, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xa80b, 0xa80b, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xa823, 0xa824, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0xa825, 0xa826, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xa827, 0xa827, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0xa82c, 0xa82c, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xa880, 0xa881, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0xa8b4, 0xa8c3, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0xa8c4, 0xa8c5, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xa8e0, 0xa8f1, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xa8ff, 0xa8ff, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xa926, 0xa92d, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xa947, 0xa951, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xa952, 0xa952, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0xa953, 0xa953, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xa960, 0xa97c, GraphemeBreak::L },
+        GraphemeBreakRange{ 0xa980, 0xa982, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xa983, 0xa983, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0xa9b3, 0xa9b3, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xa9b4, 0xa9b5, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0xa9b6, 0xa9b9, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xa9ba, 0xa9bb, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0xa9bc, 0xa9bd, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xa9be, 0xa9bf, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0xa9c0, 0xa9c0, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xa9e5, 0xa9e5, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xaa29, 0xaa2e, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xaa2f, 0xaa30, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0xaa31, 0xaa32, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xaa33, 0xaa34, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0xaa35, 0xaa36, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xaa43, 0xaa43, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xaa4c, 0xaa4c, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xaa4d, 0xaa4d, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0xaa7c, 0xaa7c, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xaab0, 0xaab0, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xaab2, 0xaab4, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xaab7, 0xaab8, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xaabe, 0xaabf, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xaac1, 0xaac1, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xaaeb, 0xaaeb, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0xaaec, 0xaaed, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xaaee, 0xaaef, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0xaaf5, 0xaaf5, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0xaaf6, 0xaaf6, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xabe3, 0xabe4, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0xabe5, 0xabe5, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xabe6, 0xabe7, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0xabe8, 0xabe8, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xabe9, 0xabea, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0xabec, 0xabec, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0xabed, 0xabed, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xd7b0, 0xd7c6, GraphemeBreak::V },
+        GraphemeBreakRange{ 0xd7cb, 0xd7fb, GraphemeBreak::T },
+        GraphemeBreakRange{ 0xfb1e, 0xfb1e, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xfe00, 0xfe0f, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xfe20, 0xfe2f, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xfeff, 0xfeff, GraphemeBreak::Control },
+        GraphemeBreakRange{ 0xff9e, 0xff9f, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xfff0, 0xfffb, GraphemeBreak::Control },
+        GraphemeBreakRange{ 0x101fd, 0x101fd, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x102e0, 0x102e0, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x10376, 0x1037a, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x10a01, 0x10a03, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x10a05, 0x10a06, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x10a0c, 0x10a0f, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x10a38, 0x10a3a, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x10a3f, 0x10a3f, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x10ae5, 0x10ae6, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x10d24, 0x10d27, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x10d69, 0x10d6d, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x10eab, 0x10eac, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x10efc, 0x10eff, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x10f46, 0x10f50, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x10f82, 0x10f85, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x11000, 0x11000, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x11001, 0x11001, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x11002, 0x11002, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x11038, 0x11046, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x11070, 0x11070, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x11073, 0x11074, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1107f, 0x11081, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x11082, 0x11082, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x110b0, 0x110b2, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x110b3, 0x110b6, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x110b7, 0x110b8, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x110b9, 0x110ba, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x110bd, 0x110bd, GraphemeBreak::Prepend },
+        GraphemeBreakRange{ 0x110c2, 0x110c2, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x110cd, 0x110cd, GraphemeBreak::Prepend },
+        GraphemeBreakRange{ 0x11100, 0x11102, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x11127, 0x1112b, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1112c, 0x1112c, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x1112d, 0x11134, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x11145, 0x11146, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x11173, 0x11173, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x11180, 0x11181, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x11182, 0x11182, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x111b3, 0x111b5, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x111b6, 0x111be, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x111bf, 0x111bf, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x111c0, 0x111c0, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x111c2, 0x111c3, GraphemeBreak::Prepend },
+        GraphemeBreakRange{ 0x111c9, 0x111cc, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x111ce, 0x111ce, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x111cf, 0x111cf, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1122c, 0x1122e, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x1122f, 0x11231, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x11232, 0x11233, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x11234, 0x11237, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1123e, 0x1123e, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x11241, 0x11241, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x112df, 0x112df, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x112e0, 0x112e2, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x112e3, 0x112ea, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x11300, 0x11301, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x11302, 0x11303, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x1133b, 0x1133c, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1133e, 0x1133e, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1133f, 0x1133f, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x11340, 0x11340, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x11341, 0x11344, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x11347, 0x11348, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x1134b, 0x1134c, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x1134d, 0x1134d, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x11357, 0x11357, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x11362, 0x11363, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x11366, 0x1136c, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x11370, 0x11374, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x113b8, 0x113b8, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x113b9, 0x113ba, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x113bb, 0x113c0, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x113c2, 0x113c2, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x113c5, 0x113c5, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x113c7, 0x113c9, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x113ca, 0x113ca, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x113cc, 0x113cd, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x113ce, 0x113d0, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x113d1, 0x113d1, GraphemeBreak::Prepend },
+        GraphemeBreakRange{ 0x113d2, 0x113d2, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x113e1, 0x113e2, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x11435, 0x11437, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x11438, 0x1143f, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x11440, 0x11441, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x11442, 0x11444, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x11445, 0x11445, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x11446, 0x11446, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1145e, 0x1145e, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x114b0, 0x114b0, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x114b1, 0x114b2, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x114b3, 0x114b8, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x114b9, 0x114b9, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x114ba, 0x114ba, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x114bb, 0x114bc, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x114bd, 0x114bd, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x114be, 0x114be, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x114bf, 0x114c0, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x114c1, 0x114c1, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x114c2, 0x114c3, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x115af, 0x115af, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x115b0, 0x115b1, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x115b2, 0x115b5, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x115b8, 0x115bb, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x115bc, 0x115bd, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x115be, 0x115be, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x115bf, 0x115c0, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x115dc, 0x115dd, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x11630, 0x11632, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x11633, 0x1163a, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1163b, 0x1163c, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x1163d, 0x1163d, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1163e, 0x1163e, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x1163f, 0x11640, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x116ab, 0x116ab, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x116ac, 0x116ac, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x116ad, 0x116ad, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x116ae, 0x116af, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x116b0, 0x116b7, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1171d, 0x1171d, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1171e, 0x1171e, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x1171f, 0x1171f, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x11722, 0x11725, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x11726, 0x11726, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x11727, 0x1172b, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1182c, 0x1182e, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x1182f, 0x11837, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x11838, 0x11838, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x11839, 0x1183a, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x11930, 0x11930, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x11931, 0x11935, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x11937, 0x11938, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x1193b, 0x1193e, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1193f, 0x1193f, GraphemeBreak::Prepend },
+        GraphemeBreakRange{ 0x11940, 0x11940, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x11941, 0x11941, GraphemeBreak::Prepend },
+        GraphemeBreakRange{ 0x11942, 0x11942, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x11943, 0x11943, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x119d1, 0x119d3, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x119d4, 0x119d7, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x119da, 0x119db, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x119dc, 0x119df, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x119e0, 0x119e0, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x119e4, 0x119e4, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x11a01, 0x11a0a, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x11a33, 0x11a38, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x11a39, 0x11a39, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x11a3a, 0x11a3a, GraphemeBreak::Prepend },
+        GraphemeBreakRange{ 0x11a3b, 0x11a3e, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x11a47, 0x11a47, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x11a51, 0x11a56, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x11a57, 0x11a58, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x11a59, 0x11a5b, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x11a84, 0x11a89, GraphemeBreak::Prepend },
+        GraphemeBreakRange{ 0x11a8a, 0x11a96, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x11a97, 0x11a97, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x11a98, 0x11a99, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x11c2f, 0x11c2f, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x11c30, 0x11c36, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x11c38, 0x11c3d, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x11c3e, 0x11c3e, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x11c3f, 0x11c3f, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x11c92, 0x11ca7, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x11ca9, 0x11ca9, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x11caa, 0x11cb0, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x11cb1, 0x11cb1, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x11cb2, 0x11cb3, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x11cb4, 0x11cb4, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x11cb5, 0x11cb6, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x11d31, 0x11d36, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x11d3a, 0x11d3a, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x11d3c, 0x11d3d, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x11d3f, 0x11d45, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x11d46, 0x11d46, GraphemeBreak::Prepend },
+        GraphemeBreakRange{ 0x11d47, 0x11d47, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x11d8a, 0x11d8e, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x11d90, 0x11d91, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x11d93, 0x11d94, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x11d95, 0x11d95, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x11d96, 0x11d96, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x11d97, 0x11d97, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x11ef3, 0x11ef4, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x11ef5, 0x11ef6, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x11f00, 0x11f01, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x11f02, 0x11f02, GraphemeBreak::Prepend },
+        GraphemeBreakRange{ 0x11f03, 0x11f03, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x11f34, 0x11f35, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x11f36, 0x11f3a, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x11f3e, 0x11f3f, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x11f40, 0x11f42, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x11f5a, 0x11f5a, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x13430, 0x1343f, GraphemeBreak::Control },
+        GraphemeBreakRange{ 0x13440, 0x13440, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x13447, 0x13455, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1611e, 0x16129, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1612a, 0x1612c, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x1612d, 0x1612f, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x16af0, 0x16af4, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x16b30, 0x16b36, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x16d63, 0x16d63, GraphemeBreak::V },
+        GraphemeBreakRange{ 0x16d67, 0x16d6a, GraphemeBreak::V },
+        GraphemeBreakRange{ 0x16f4f, 0x16f4f, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x16f51, 0x16f87, GraphemeBreak::SpacingMark },
+        GraphemeBreakRange{ 0x16f8f, 0x16f92, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x16fe4, 0x16fe4, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x16ff0, 0x16ff1, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1bc9d, 0x1bc9e, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1bca0, 0x1bca3, GraphemeBreak::Control },
+        GraphemeBreakRange{ 0x1cf00, 0x1cf2d, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1cf30, 0x1cf46, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1d165, 0x1d169, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1d16d, 0x1d172, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1d173, 0x1d17a, GraphemeBreak::Control },
+        GraphemeBreakRange{ 0x1d17b, 0x1d182, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1d185, 0x1d18b, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1d1aa, 0x1d1ad, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1d242, 0x1d244, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1da00, 0x1da36, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1da3b, 0x1da6c, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1da75, 0x1da75, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1da84, 0x1da84, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1da9b, 0x1da9f, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1daa1, 0x1daaf, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1e000, 0x1e006, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1e008, 0x1e018, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1e01b, 0x1e021, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1e023, 0x1e024, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1e026, 0x1e02a, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1e08f, 0x1e08f, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1e130, 0x1e136, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1e2ae, 0x1e2ae, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1e2ec, 0x1e2ef, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1e4ec, 0x1e4ef, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1e5ee, 0x1e5ef, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1e8d0, 0x1e8d6, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1e944, 0x1e94a, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1f000, 0x1f0ff, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0x1f10d, 0x1f10f, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0x1f12f, 0x1f12f, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0x1f16c, 0x1f171, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0x1f17e, 0x1f17f, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0x1f18e, 0x1f18e, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0x1f191, 0x1f19a, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0x1f1ad, 0x1f1e5, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0x1f1e6, 0x1f1ff, GraphemeBreak::RegionalIndicator },
+        GraphemeBreakRange{ 0x1f201, 0x1f20f, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0x1f21a, 0x1f21a, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0x1f22f, 0x1f22f, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0x1f232, 0x1f23a, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0x1f23c, 0x1f23f, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0x1f249, 0x1f3fa, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0x1f3fb, 0x1f3ff, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0x1f400, 0x1f53d, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0x1f546, 0x1f64f, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0x1f680, 0x1f6ff, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0x1f774, 0x1f77f, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0x1f7d5, 0x1f7ff, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0x1f80c, 0x1f80f, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0x1f848, 0x1f84f, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0x1f85a, 0x1f85f, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0x1f888, 0x1f88f, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0x1f8ae, 0x1f8ff, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0x1f90c, 0x1f93a, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0x1f93c, 0x1f945, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0x1f947, 0x1faff, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0x1fc00, 0x1fffd, GraphemeBreak::ExtendedPictographic },
+        GraphemeBreakRange{ 0xe0000, 0xe001f, GraphemeBreak::Control },
+        GraphemeBreakRange{ 0xe0020, 0xe007f, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xe0080, 0xe00ff, GraphemeBreak::Control },
+        GraphemeBreakRange{ 0xe0100, 0xe01ef, GraphemeBreak::ConjunctExtend },
+        GraphemeBreakRange{ 0xe01f0, 0xe0fff, GraphemeBreak::Control },
+    };
+
+    // Whether there's some text before the current position that allows the rules GB9c, GB11 and GB12/13
+    // to join the next code point. Only the forward iteration tracks it; IsBoundary() looks back instead.
+    struct Lookbehind final
+    {
+        // The text ends with ExtendedPictographic Extend*.
+        bool extendedPictographic = false;
+        // The text ends with ExtendedPictographic Extend* ZWJ. (GB11)
+        bool emojiZwj = false;
+        // The text ends with an odd number of regional indicators. (GB12/13)
+        bool oddRegionalIndicators = false;
+        // The text ends with ConjunctConsonant [ConjunctExtend ConjunctLinker ZWJ]*.
+        bool conjunctConsonant = false;
+        // ...and that sequence contains at least one ConjunctLinker. (GB9c)
+        bool conjunctLinked = false;
+
+        void Push(GraphemeBreak value) noexcept;
+    };
+
+    constexpr bool isControl(const GraphemeBreak value) noexcept
+    {
+        return value == GraphemeBreak::Control || value == GraphemeBreak::CR || value == GraphemeBreak::LF;
+    }
+
+    // Grapheme_Cluster_Break=Extend, of which the Indic_Conjunct_Break values are subsets.
+    constexpr bool isExtend(const GraphemeBreak value) noexcept
+    {
+        return value == GraphemeBreak::Extend || value == GraphemeBreak::ConjunctLinker || value == GraphemeBreak::ConjunctExtend;
+    }
+
+    void Lookbehind::Push(const GraphemeBreak value) noexcept
+    {
+        emojiZwj = value == GraphemeBreak::ZWJ && extendedPictographic;
+        extendedPictographic = value == GraphemeBreak::ExtendedPictographic || (extendedPictographic && isExtend(value));
+        oddRegionalIndicators = value == GraphemeBreak::RegionalIndicator && !oddRegionalIndicators;
+
+        if (value == GraphemeBreak::ConjunctConsonant)
+        {
+            conjunctConsonant = true;
+            conjunctLinked = false;
+        }
+        else if (conjunctConsonant && value == GraphemeBreak::ConjunctLinker)
+        {
+            conjunctLinked = true;
+        }
+        else if (!conjunctConsonant || (value != GraphemeBreak::ConjunctExtend && value != GraphemeBreak::ZWJ))
+        {
+            conjunctConsonant = false;
+            conjunctLinked = false;
+        }
+    }
+
+    // Applies the rules GB3 to GB999 to the two code points around a potential boundary.
+    bool isBreak(const GraphemeBreak left, const GraphemeBreak right, const Lookbehind& lookbehind) noexcept
+    {
+        // GB3
+        if (left == GraphemeBreak::CR && right == GraphemeBreak::LF)
+        {
+            return false;
+        }
+        // GB4, GB5
+        if (isControl(left) || isControl(right))
+        {
+            return true;
+        }
+        // GB6
+        if (left == GraphemeBreak::L && (right == GraphemeBreak::L || right == GraphemeBreak::V || right == GraphemeBreak::LV || right == GraphemeBreak::LVT))
+        {
+            return false;
+        }
+        // GB7
+        if ((left == GraphemeBreak::LV || left == GraphemeBreak::V) && (right == GraphemeBreak::V || right == GraphemeBreak::T))
+        {
+            return false;
+        }
+        // GB8
+        if ((left == GraphemeBreak::LVT || left == GraphemeBreak::T) && right == GraphemeBreak::T)
+        {
+            return false;
+        }
+        // GB9, GB9a
+        if (isExtend(right) || right == GraphemeBreak::ZWJ || right == GraphemeBreak::SpacingMark)
+        {
+            return false;
+        }
+        // GB9b
+        if (left == GraphemeBreak::Prepend)
+        {
+            return false;
+        }
+        // GB9c
+        if (right == GraphemeBreak::ConjunctConsonant && lookbehind.conjunctLinked)
+        {
+            return false;
+        }
+        // GB11
+        if (right == GraphemeBreak::ExtendedPictographic && lookbehind.emojiZwj)
+        {
+            return false;
+        }
+        // GB12, GB13
+        if (right == GraphemeBreak::RegionalIndicator && lookbehind.oddRegionalIndicators)
+        {
+            return false;
+        }
+        // GB999
+        return true;
+    }
+
+    // Decodes the code point that starts at text[offset] and stores the number of code units it takes up in length.
+    char32_t codepointAt(const std::wstring_view text, const size_t offset, size_t& length) noexcept
+    {
+        const auto wch = til::at(text, offset);
+        if (Utf16Parser::IsLeadingSurrogate(wch) && offset + 1 < text.size())
+        {
+            const auto next = til::at(text, offset + 1);
+            if (Utf16Parser::IsTrailingSurrogate(next))
+            {
+                length = 2;
+                return 0x10000 + ((static_cast<char32_t>(wch) - 0xD800) << 10) + (static_cast<char32_t>(next) - 0xDC00);
+            }
+        }
+        length = 1;
+        return wch;
+    }
+
+    // Decodes the code point that ends right before text[offset].
+    char32_t codepointBefore(const std::wstring_view text, const size_t offset, size_t& length) noexcept
+    {
+        const auto wch = til::at(text, offset - 1);
+        if (Utf16Parser::IsTrailingSurrogate(wch) && offset >= 2)
+        {
+            const auto prev = til::at(text, offset - 2);
+            if (Utf16Parser::IsLeadingSurrogate(prev))
+            {
+                length = 2;
+                return 0x10000 + ((static_cast<char32_t>(prev) - 0xD800) << 10) + (static_cast<char32_t>(wch) - 0xDC00);
+            }
+        }
+        length = 1;
+        return wch;
+    }
+
+    // Returns the properties of the code points before text[offset], as far back as they matter for the given right side.
+    Lookbehind lookBehind(const std::wstring_view text, size_t offset, const GraphemeBreak right) noexcept
+    {
+        Lookbehind lookbehind;
+        size_t length = 0;
+
+        if (right == GraphemeBreak::RegionalIndicator)
+        {
+            while (offset > 0 && GraphemeClusterIterator::GetBreakProperty(codepointBefore(text, offset, length)) == GraphemeBreak::RegionalIndicator)
+            {
+                lookbehind.oddRegionalIndicators = !lookbehind.oddRegionalIndicators;
+                offset -= length;
+            }
+        }
+        else if (right == GraphemeBreak::ExtendedPictographic)
+        {
+            if (GraphemeClusterIterator::GetBreakProperty(codepointBefore(text, offset, length)) == GraphemeBreak::ZWJ)
+            {
+                offset -= length;
+                while (offset > 0)
+                {
+                    const auto value = GraphemeClusterIterator::GetBreakProperty(codepointBefore(text, offset, length));
+                    if (!isExtend(value))
+                    {
+                        lookbehind.emojiZwj = value == GraphemeBreak::ExtendedPictographic;
+                        break;
+                    }
+                    offset -= length;
+                }
+            }
+        }
+        else if (right == GraphemeBreak::ConjunctConsonant)
+        {
+            auto linked = false;
+            while (offset > 0)
+            {
+                const auto value = GraphemeClusterIterator::GetBreakProperty(codepointBefore(text, offset, length));
+                if (value == GraphemeBreak::ConjunctLinker)
+                {
+                    linked = true;
+                }
+                else if (value != GraphemeBreak::ConjunctExtend && value != GraphemeBreak::ZWJ)
+                {
+                    lookbehind.conjunctLinked = linked && value == GraphemeBreak::ConjunctConsonant;
+                    break;
+                }
+                offset -= length;
+            }
+        }
+
+        return lookbehind;
+    }
+}
+
+GraphemeClusterIterator::GraphemeClusterIterator(const std::wstring_view text, const size_t offset, const Segmentation segmentation) noexcept :
+    _text{ text },
+    _begin{ std::min(offset, text.size()) },
+    _segmentation{ segmentation }
+{
+    // Snap to the beginning of the cluster (or surrogate pair) that contains the offset.
+    if (_segmentation == Segmentation::Codepoints)
+    {
+        if (_begin > 0 && _begin < _text.size() && Utf16Parser::IsLeadingSurrogate(til::at(_text, _begin - 1)) && Utf16Parser::IsTrailingSurrogate(til::at(_text, _begin)))
+        {
+            _begin--;
+        }
+    }
+    else if (!IsBoundary(_text, _begin))
+    {
+        _begin = _PreviousBoundary(_begin);
+    }
+    _end = _NextBoundary(_begin);
+}
+
+// Routine Description:
+// - Returns the Grapheme_Cluster_Break property of the given code point, merged with its
+//   Extended_Pictographic and Indic_Conjunct_Break properties (see GraphemeBreak).
+GraphemeBreak GraphemeClusterIterator::GetBreakProperty(const char32_t codepoint) noexcept
+{
+    // Printable ASCII is by far the most common input.
+    if (codepoint >= 0x20 && codepoint < 0x7F)
+    {
+        return GraphemeBreak::Other;
+    }
+    if (codepoint >= 0xAC00 && codepoint <= 0xD7A3)
+    {
+        // Every 28th Hangul syllable starting at U+AC00 consists of a leading
+        // and a vowel jamo. The ones in between additionally have a trailing jamo.
+        return (codepoint - 0xAC00) % 28 == 0 ? GraphemeBreak::LV : GraphemeBreak::LVT;
+    }
+    if (codepoint >= 0xD800 && codepoint <= 0xDFFF)
+    {
+        // Surrogates are Control, which makes unpaired ones clusters of their own.
+        return GraphemeBreak::Control;
+    }
+
+    const auto it = std::lower_bound(s_graphemeBreakTable.begin(), s_graphemeBreakTable.end(), codepoint);
+    if (it != s_graphemeBreakTable.end() && it->lowerBound <= codepoint)
+    {
+        return it->value;
+    }
+    return GraphemeBreak::Other;
+}
+
+// Routine Description:
+// - Checks whether an extended grapheme cluster boundary lies in front of text[offset].
+// - The beginning and the end of the text are boundaries, the middle of a surrogate pair isn't.
+// Arguments:
+// - text - The text to check.
+// - offset - The offset of the potential boundary.
+// Return Value:
+// - true if text can be split at offset.
+bool GraphemeClusterIterator::IsBoundary(const std::wstring_view text, const size_t offset) noexcept
+{
+    // GB1, GB2
+    if (offset == 0 || offset >= text.size())
+    {
+        return true;
+    }
+
+    if (Utf16Parser::IsLeadingSurrogate(til::at(text, offset - 1)) && Utf16Parser::IsTrailingSurrogate(til::at(text, offset)))
+    {
+        return false;
+    }
+
+    size_t leftLength = 0;
+    size_t rightLength = 0;
+    const auto leftCodepoint = codepointBefore(text, offset, leftLength);
+    const auto rightCodepoint = codepointAt(text, offset, rightLength);
+    // Latin, Greek, Cyrillic etc. never combine, except for CR LF.
+    if (leftCodepoint < 0x300 && rightCodepoint < 0x300)
+    {
+        return leftCodepoint != L'\r' || rightCodepoint != L'\n';
+    }
+
+    const auto left = GetBreakProperty(leftCodepoint);
+    const auto right = GetBreakProperty(rightCodepoint);
+    return isBreak(left, right, lookBehind(text, offset, right));
+}
+
+// Routine Description:
+// - Returns the number of columns the current cluster occupies. Just like the text buffer,
+//   this only looks at the first code point, so it's either 1 or 2 (or 0 at the end).
+til::CoordType GraphemeClusterIterator::Columns() const
+{
+    if (_begin == _end)
+    {
+        return 0;
+    }
+
+    const auto wch = til::at(_text, _begin);
+    if (wch < 0x80)
+    {
+        return 1;
+    }
+
+    size_t length = 0;
+    codepointAt(_text, _begin, length);
+    return IsGlyphFullWidth(_text.substr(_begin, length)) ? 2 : 1;
+}
+
+GraphemeClusterIterator& GraphemeClusterIterator::operator++() noexcept
+{
+    _begin = _end;
+    _end = _NextBoundary(_begin);
+    return *this;
+}
+
+GraphemeClusterIterator GraphemeClusterIterator::operator++(int) noexcept
+{
+    auto copy = *this;
+    ++*this;
+    return copy;
+}
+
+GraphemeClusterIterator& GraphemeClusterIterator::operator--() noexcept
+{
+    _end = _begin;
+    _begin = _PreviousBoundary(_begin);
+    return *this;
+}
+
+GraphemeClusterIterator GraphemeClusterIterator::operator--(int) noexcept
+{
+    auto copy = *this;
+    --*this;
+    return copy;
+}
+
+// Routine Description:
+// - Finds the end of the cluster that starts at the given offset.
+// - It walks forward code point by code point and tracks just enough state
+//   to apply the rules that depend on the preceding text, so it never looks back.
+size_t GraphemeClusterIterator::_NextBoundary(const size_t offset) const noexcept
+{
+    if (offset >= _text.size())
+    {
+        return _text.size();
+    }
+
+    size_t length = 0;
+    auto leftCodepoint = codepointAt(_text, offset, length);
+    auto end = offset + length;
+    if (_segmentation == Segmentation::Codepoints)
+    {
+        return end;
+    }
+
+    auto left = GetBreakProperty(leftCodepoint);
+    Lookbehind lookbehind;
+    lookbehind.Push(left);
+
+    while (end < _text.size())
+    {
+        const auto rightCodepoint = codepointAt(_text, end, length);
+        // Latin, Greek, Cyrillic etc. never combine, except for CR LF.
+        if (leftCodepoint < 0x300 && rightCodepoint < 0x300 && (leftCodepoint != L'\r' || rightCodepoint != L'\n'))
+        {
+            break;
+        }
+
+        const auto right = GetBreakProperty(rightCodepoint);
+        if (isBreak(left, right, lookbehind))
+        {
+            break;
+        }
+
+        lookbehind.Push(right);
+        leftCodepoint = rightCodepoint;
+        left = right;
+        end += length;
+    }
+
+    return end;
+}
+
+// Routine Description:
+// - Finds the beginning of the cluster that ends at the given offset.
+size_t GraphemeClusterIterator::_PreviousBoundary(size_t offset) const noexcept
+{
+    size_t length = 0;
+    while (offset > 0)
+    {
+        codepointBefore(_text, offset, length);
+        offset -= length;
+        if (_segmentation == Segmentation::Codepoints || IsBoundary(_text, offset))
+        {
+            break;
+        }
+    }
+    return offset;
+}
@@ -20,6 +20,8 @@ struct ITextRangeProvider;
 
 namespace Microsoft::Console::Types
 {
+    class UiaTextSnapshotCache;
+
     class IUiaData : public IBaseData
     {
     public:
@@ -42,6 +44,7 @@ namespace Microsoft::Console::Types
         virtual const til::point GetSelectionEnd() const noexcept = 0;
         virtual void ColorSelection(const til::point coordSelectionStart, const til::point coordSelectionEnd, const TextAttribute attr) = 0;
         virtual const bool IsUiaDataInitialized() const noexcept = 0;
+        virtual UiaTextSnapshotCache& GetUiaTextSnapshotCache() noexcept = 0;
     };
 
     // See docs/virtual-dtors.md for an explanation of why this is weird.
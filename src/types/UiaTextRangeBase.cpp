@@ -4,7 +4,6 @@
 #include "precomp.h"
 #include "UiaTextRangeBase.hpp"
 #include "ScreenInfoUiaProviderBase.h"
-#include "../buffer/out/search.h"
 #include "UiaTracing.h"
 
 using namespace Microsoft::Console::Types;
@@ -130,6 +129,7 @@ try
     _pData = a._pData;
     _wordDelimiters = a._wordDelimiters;
     _blockRange = a._blockRange;
+    _snapshot = a._snapshot;
 
     UiaTracing::TextRange::Constructor(*this);
     return S_OK;
@@ -158,9 +158,6 @@ til::point UiaTextRangeBase::GetEndpoint(TextPatternRangeEndpoint endpoint) cons
 // - true if range is degenerate, false otherwise.
 bool UiaTextRangeBase::SetEndpoint(TextPatternRangeEndpoint endpoint, const til::point val) noexcept
 {
-    // GH#6402: Get the actual buffer size here, instead of the one
-    //          constrained by the virtual bottom.
-    const auto bufferSize = _pData->GetTextBuffer().GetSize();
     switch (endpoint)
     {
     case TextPatternRangeEndpoint_End:
@@ -269,7 +266,18 @@ IFACEMETHODIMP UiaTextRangeBase::ExpandToEnclosingUnit(_In_ TextUnit unit) noexc
 
     try
     {
-        _expandToEnclosingUnit(unit);
+        if (unit != TextUnit_Character && unit <= TextUnit_Word)
+        {
+            // Words are looked up in a snapshot of the buffer,
+            // so we don't need to hold the lock while doing so.
+            const auto& snapshot = _refreshSnapshot();
+            Unlock.reset();
+            _expandToEnclosingWord(snapshot);
+        }
+        else
+        {
+            _expandToEnclosingUnit(unit);
+        }
         UiaTracing::TextRange::ExpandToEnclosingUnit(unit, *this);
         return S_OK;
     }
@@ -306,9 +314,7 @@ void UiaTextRangeBase::_expandToEnclosingUnit(TextUnit unit)
     }
     else if (unit <= TextUnit_Word)
     {
-        // expand to word
-        _start = buffer.GetWordStart(_start, _wordDelimiters, true, documentEnd);
-        _end = buffer.GetWordEnd(_start, _wordDelimiters, true, documentEnd);
+        _expandToEnclosingWord(_refreshSnapshot());
     }
     else if (unit <= TextUnit_Line)
     {
@@ -334,6 +340,31 @@ void UiaTextRangeBase::_expandToEnclosingUnit(TextUnit unit)
     }
 }
 
+// Method Description:
+// - Moves _start and _end endpoints to encompass the enclosing word.
+// - Unlike _expandToEnclosingUnit(), this doesn't require the console lock,
+//   because it only looks at the given snapshot.
+// Arguments:
+// - snapshot - the snapshot of the text buffer to look up words in
+// Return Value:
+// - <none>
+void UiaTextRangeBase::_expandToEnclosingWord(const UiaTextSnapshot& snapshot) noexcept
+{
+    const auto documentEnd{ snapshot.GetDocumentEnd() };
+
+    // If we're past document end,
+    // set us to ONE BEFORE the document end.
+    // This allows us to expand properly.
+    if (_start >= documentEnd)
+    {
+        _start = documentEnd;
+        snapshot.GetSize().DecrementInBounds(_start, true);
+    }
+
+    _start = snapshot.GetWordStart(_start, documentEnd);
+    _end = snapshot.GetWordEnd(_start, documentEnd);
+}
+
 // Method Description:
 // - Verify that the given attribute has the desired formatting saved in the attributeId and val
 // Arguments:
@@ -507,34 +538,16 @@ try
     }
 
     // Get some useful variables
-    const auto& buffer{ _pData->GetTextBuffer() };
-    const auto bufferSize{ buffer.GetSize() };
     const auto inclusiveEnd{ _getInclusiveEnd() };
+    const auto& snapshot{ _refreshSnapshot() };
+    const auto& bufferSize{ snapshot.GetSize() };
 
-    // Start/End for the resulting range.
-    // NOTE: we store these as "first" and "second" anchor because,
-    //       we just want to know what the inclusive range is.
-    //       We'll do some post-processing to fix this on the way out.
-    std::optional<til::point> resultFirstAnchor;
-    std::optional<til::point> resultSecondAnchor;
-    const auto attemptUpdateAnchors = [=, &resultFirstAnchor, &resultSecondAnchor](const TextBufferCellIterator iter) {
-        const auto attrFound{ _verifyAttr(attributeId, val, iter->TextAttr()).value() };
-        if (attrFound)
-        {
-            // populate the first anchor if it's not populated.
-            // otherwise, populate the second anchor.
-            if (!resultFirstAnchor.has_value())
-            {
-                resultFirstAnchor = iter.Pos();
-                resultSecondAnchor = iter.Pos();
-            }
-            else
-            {
-                resultSecondAnchor = iter.Pos();
-            }
-        }
-        return attrFound;
-    };
+    // The search itself only looks at the snapshot. Colors however are resolved
+    // through the color table, which is still protected by the console lock.
+    if (attributeId != UIA_BackgroundColorAttributeId && attributeId != UIA_ForegroundColorAttributeId)
+    {
+        Unlock.reset();
+    }
 
     // Start/End for the direction to perform the search in
     // We need searchEnd to be exclusive. This allows the for-loop below to
@@ -552,8 +565,8 @@ try
         bufferSize.IncrementInBounds(searchEndExclusive, true);
     }
 
-    // Iterate from searchStart to searchEnd in the buffer.
-    // If we find the attribute we're looking for, we update resultFirstAnchor/SecondAnchor appropriately.
+    // Search from searchStart to searchEnd in the snapshot.
+    // The result is the first contiguous range of cells that have the attribute we're looking for.
 #pragma warning(suppress : 26496) // TRANSITIONAL: false positive in VS 16.11
     auto viewportRange{ bufferSize };
     if (_blockRange)
@@ -564,45 +577,25 @@ try
         const auto height{ std::abs(inclusiveEnd.Y - _start.Y + 1) };
         viewportRange = Viewport::FromDimensions({ originX, originY }, width, height);
     }
-    auto iter{ buffer.GetCellDataAt(searchStart, viewportRange) };
-    const auto iterStep{ searchBackwards ? -1 : 1 };
-    for (; iter && iter.Pos() != searchEndExclusive; iter += iterStep)
-    {
-        if (!attemptUpdateAnchors(iter) && resultFirstAnchor.has_value() && resultSecondAnchor.has_value())
-        {
-            // Exit the loop early if...
-            // - the cell we're looking at doesn't have the attr we're looking for
-            // - the anchors have been populated
-            // This means that we've found a contiguous range where the text attribute was found.
-            // No point in searching through the rest of the search space.
-            // TLDR: keep updating the second anchor and make the range wider until the attribute changes.
-            break;
-        }
-    }
 
-    // Corner case: we couldn't actually move the searchEnd to make it exclusive
-    // (i.e. DecrementInBounds on Origin doesn't move it)
-    if (searchEndInclusive == searchEndExclusive)
-    {
-        attemptUpdateAnchors(iter);
-    }
+    const auto result{ snapshot.FindAttribute(searchStart, searchEndExclusive, viewportRange, searchBackwards, [&](const TextAttribute& attr) {
+        return _verifyAttr(attributeId, val, attr).value();
+    }) };
 
     // If a result was found, populate ppRetVal with the UiaTextRange
     // representing the found selection anchors.
-    if (resultFirstAnchor.has_value() && resultSecondAnchor.has_value())
+    if (result.has_value())
     {
         RETURN_IF_FAILED(Clone(ppRetVal));
         auto& range = static_cast<UiaTextRangeBase&>(**ppRetVal);
 
-        // IMPORTANT: resultFirstAnchor and resultSecondAnchor make up an inclusive range.
-        range._start = searchBackwards ? *resultSecondAnchor : *resultFirstAnchor;
-        range._end = searchBackwards ? *resultFirstAnchor : *resultSecondAnchor;
+        // IMPORTANT: the result is an inclusive range in the order the cells were found in.
+        range._start = searchBackwards ? result->second : result->first;
+        range._end = searchBackwards ? result->first : result->second;
 
         // We need to make the end exclusive!
         // But be careful here, we might be a block range
-        auto exclusiveIter{ buffer.GetCellDataAt(range._end, viewportRange) };
-        ++exclusiveIter;
-        range._end = exclusiveIter.Pos();
+        viewportRange.IncrementInBounds(range._end);
     }
 
     UiaTracing::TextRange::FindAttribute(*this, attributeId, val, searchBackwards, static_cast<UiaTextRangeBase&>(**ppRetVal));
@@ -627,34 +620,31 @@ try
 
     const std::wstring queryText{ text, SysStringLen(text) };
     const auto bufferSize = _getOptimizedBufferSize();
-    const auto sensitivity = ignoreCase ? Search::Sensitivity::CaseInsensitive : Search::Sensitivity::CaseSensitive;
 
-    auto searchDirection = Search::Direction::Forward;
+    // The search only looks at the snapshot, which doesn't need the lock.
+    const auto& snapshot = _refreshSnapshot();
+    Unlock.reset();
+
     auto searchAnchor = _start;
     if (searchBackward)
     {
-        searchDirection = Search::Direction::Backward;
-
         // we need to convert the end to inclusive
-        // because Search operates with an inclusive til::point
+        // because the search operates with an inclusive til::point
         searchAnchor = _end;
         bufferSize.DecrementInBounds(searchAnchor, true);
     }
 
-    Search searcher{ *_pData, queryText, searchDirection, sensitivity, searchAnchor };
-
-    if (searcher.FindNext())
+    if (const auto foundLocation = snapshot.FindText(queryText, searchAnchor, searchBackward, ignoreCase))
     {
-        const auto foundLocation = searcher.GetFoundLocation();
-        const auto start = foundLocation.first;
+        const auto start = foundLocation->first;
 
         // we need to increment the position of end because it's exclusive
-        auto end = foundLocation.second;
+        auto end = foundLocation->second;
         bufferSize.IncrementInBounds(end, true);
 
         // make sure what was found is within the bounds of the current range
-        if ((searchDirection == Search::Direction::Forward && end < _end) ||
-            (searchDirection == Search::Direction::Backward && start > _start))
+        if ((!searchBackward && end < _end) ||
+            (searchBackward && start > _start))
         {
             RETURN_IF_FAILED(Clone(ppRetVal));
             auto& range = static_cast<UiaTextRangeBase&>(**ppRetVal);
@@ -964,8 +954,9 @@ try
     });
     RETURN_HR_IF(E_FAIL, !_pData->IsUiaDataInitialized());
 
-    const auto text = _getTextValue(maxLength);
+    const auto& snapshot = _refreshSnapshot();
     Unlock.reset();
+    const auto text = _getTextValue(snapshot, maxLength);
 
     *pRetVal = SysAllocString(text.c_str());
     RETURN_HR_IF_NULL(E_OUTOFMEMORY, *pRetVal);
@@ -976,15 +967,22 @@ try
 CATCH_RETURN();
 
 // Method Description:
-// - Helper method for GetText(). Retrieves the text that the UiaTextRange encompasses as a wstring
+// - Retrieves the text that the UiaTextRange encompasses as a wstring.
+// - This is used by tracing, which may run after the console lock was released.
+//   That's why it uses the last snapshot this range has seen, if there is one.
 // Arguments:
-// - maxLength - the maximum size of the retrieved text. nullopt means we don't care about the size.
+// - maxLength - the maximum size of the retrieved text. -1 means we don't care about the size.
 // Return Value:
 // - the text that the UiaTextRange encompasses
 #pragma warning(push)
 #pragma warning(disable : 26447) // compiler isn't filtering throws inside the try/catch
 std::wstring UiaTextRangeBase::_getTextValue(til::CoordType maxLength) const
 {
+    if (_snapshot)
+    {
+        return _getTextValue(*_snapshot, maxLength);
+    }
+
     std::wstring textData{};
     if (!IsDegenerate())
     {
@@ -1020,8 +1018,55 @@ std::wstring UiaTextRangeBase::_getTextValue(til::CoordType maxLength) const
 
     return textData;
 }
+
+// Method Description:
+// - Helper method for GetText(). Retrieves the text that the UiaTextRange encompasses
+//   from the given snapshot. This doesn't require the console lock.
+// Arguments:
+// - snapshot - the snapshot of the text buffer to read from
+// - maxLength - the maximum size of the retrieved text. -1 means we don't care about the size.
+// Return Value:
+// - the text that the UiaTextRange encompasses
+std::wstring UiaTextRangeBase::_getTextValue(const UiaTextSnapshot& snapshot, til::CoordType maxLength) const
+{
+    std::wstring textData{};
+    if (!IsDegenerate())
+    {
+        const auto& bufferSize = snapshot.GetSize();
+
+        // TODO GH#5406: create a different UIA parent object for each TextBuffer
+        // nvaccess/nvda#11428: Ensure our endpoints are in bounds
+        // otherwise, we'll FailFast catastrophically
+        THROW_HR_IF(E_FAIL, !bufferSize.IsInBounds(_start) || !bufferSize.IsInBounds(_end));
+
+        // convert _end to be inclusive
+        auto inclusiveEnd = _end;
+        bufferSize.DecrementInBounds(inclusiveEnd, true);
+
+        textData = snapshot.GetText(_start, inclusiveEnd, _blockRange);
+    }
+
+    if (maxLength >= 0)
+    {
+        textData.resize(maxLength);
+    }
+
+    return textData;
+}
 #pragma warning(pop)
 
+// Method Description:
+// - Brings the snapshot of the text buffer up to date.
+// - IMPORTANT: the console lock must be held while calling this.
+//   The returned snapshot however can be used after releasing it.
+// Return Value:
+// - the current snapshot of the text buffer
+const UiaTextSnapshot& UiaTextRangeBase::_refreshSnapshot()
+{
+    _snapshot = _pData->GetUiaTextSnapshotCache().Update(_pData->GetTextBuffer(), _pData->GetTextBufferEndPosition(), _wordDelimiters);
+    return *_snapshot;
+}
+
 IFACEMETHODIMP UiaTextRangeBase::Move(_In_ TextUnit unit,
                                       _In_ int count,
                                       _Out_ int* pRetVal) noexcept
@@ -1036,12 +1081,20 @@ try
     });
     RETURN_HR_IF(E_FAIL, !_pData->IsUiaDataInitialized());
 
+    // Words are looked up in a snapshot of the buffer,
+    // so we don't need to hold the lock while moving by them.
+    const UiaTextSnapshot* snapshot = nullptr;
+    if (unit != TextUnit::TextUnit_Character && unit <= TextUnit::TextUnit_Word)
+    {
+        snapshot = &_refreshSnapshot();
+        Unlock.reset();
+    }
+
     // We can abstract this movement by moving _start
     // GH#7342: check if we're past the documentEnd
     // If so, clamp each endpoint to the end of the document.
     constexpr auto endpoint = TextPatternRangeEndpoint::TextPatternRangeEndpoint_Start;
-    const auto bufferSize{ _pData->GetTextBuffer().GetSize() };
-    const auto documentEnd = _getDocumentEnd();
+    const auto documentEnd = snapshot ? snapshot->GetDocumentEnd() : _getDocumentEnd();
     if (_start > documentEnd)
     {
         _start = documentEnd;
@@ -1061,7 +1114,7 @@ try
         }
         else if (unit <= TextUnit::TextUnit_Word)
         {
-            _moveEndpointByUnitWord(count, endpoint, pRetVal, preventBoundary);
+            _moveEndpointByUnitWord(*snapshot, count, endpoint, pRetVal, preventBoundary);
         }
         else if (unit <= TextUnit::TextUnit_Line)
         {
@@ -1079,6 +1132,11 @@ try
         // To keep it that way, move _end to the new _start.
         _end = _start;
     }
+    else if (snapshot)
+    {
+        // then just expand to get our _end
+        _expandToEnclosingWord(*snapshot);
+    }
     else
     {
         // then just expand to get our _end
@@ -1105,16 +1163,36 @@ IFACEMETHODIMP UiaTextRangeBase::MoveEndpointByUnit(_In_ TextPatternRangeEndpoin
     RETURN_HR_IF(E_FAIL, !_pData->IsUiaDataInitialized());
     RETURN_HR_IF(S_OK, count == 0);
 
+    // Words are looked up in a snapshot of the buffer,
+    // so we don't need to hold the lock while moving by them.
+    const UiaTextSnapshot* snapshot = nullptr;
+    if (unit != TextUnit::TextUnit_Character && unit <= TextUnit::TextUnit_Word)
+    {
+        try
+        {
+            snapshot = &_refreshSnapshot();
+        }
+        CATCH_RETURN();
+        Unlock.reset();
+    }
+
     // GH#7342: check if we're past the documentEnd
     // If so, clamp each endpoint to the end of the document.
-    const auto bufferSize{ _pData->GetTextBuffer().GetSize() };
+    const auto bufferSize{ snapshot ? snapshot->GetSize() : _pData->GetTextBuffer().GetSize() };
 
     auto documentEnd = bufferSize.EndExclusive();
-    try
+    if (snapshot)
     {
-        documentEnd = _getDocumentEnd();
+        documentEnd = snapshot->GetDocumentEnd();
+    }
+    else
+    {
+        try
+        {
+            documentEnd = _getDocumentEnd();
+        }
+        CATCH_LOG();
     }
-    CATCH_LOG();
 
     if (_start > documentEnd)
     {
@@ -1133,7 +1211,7 @@ IFACEMETHODIMP UiaTextRangeBase::MoveEndpointByUnit(_In_ TextPatternRangeEndpoin
         }
         else if (unit <= TextUnit::TextUnit_Word)
         {
-            _moveEndpointByUnitWord(count, endpoint, pRetVal);
+            _moveEndpointByUnitWord(*snapshot, count, endpoint, pRetVal);
         }
         else if (unit <= TextUnit::TextUnit_Line)
         {
@@ -1480,7 +1558,8 @@ void UiaTextRangeBase::_moveEndpointByUnitCharacter(_In_ const int moveCount,
 //                      create a degenerate range
 // Return Value:
 // - <none>
-void UiaTextRangeBase::_moveEndpointByUnitWord(_In_ const int moveCount,
+void UiaTextRangeBase::_moveEndpointByUnitWord(_In_ const UiaTextSnapshot& snapshot,
+                                               _In_ const int moveCount,
                                                _In_ const TextPatternRangeEndpoint endpoint,
                                                _Out_ const gsl::not_null<int*> pAmountMoved,
                                                _In_ const bool preventBufferEnd)
@@ -1494,10 +1573,8 @@ void UiaTextRangeBase::_moveEndpointByUnitWord(_In_ const int moveCount,
 
     const auto allowBottomExclusive = !preventBufferEnd;
     const auto moveDirection = (moveCount > 0) ? MovementDirection::Forward : MovementDirection::Backward;
-    const auto& buffer = _pData->GetTextBuffer();
-    const auto bufferSize = buffer.GetSize();
-    const auto bufferOrigin = bufferSize.Origin();
-    const auto documentEnd = _getDocumentEnd();
+    const auto bufferOrigin = snapshot.GetSize().Origin();
+    const auto documentEnd = snapshot.GetDocumentEnd();
 
     auto resultPos = GetEndpoint(endpoint);
     auto nextPos = resultPos;
@@ -1514,7 +1591,7 @@ void UiaTextRangeBase::_moveEndpointByUnitWord(_In_ const int moveCount,
             {
                 success = false;
             }
-            else if (buffer.MoveToNextWord(nextPos, _wordDelimiters, documentEnd))
+            else if (snapshot.MoveToNextWord(nextPos, documentEnd))
             {
                 resultPos = nextPos;
                 (*pAmountMoved)++;
@@ -1536,7 +1613,7 @@ void UiaTextRangeBase::_moveEndpointByUnitWord(_In_ const int moveCount,
             {
                 success = false;
             }
-            else if (allowBottomExclusive && _tryMoveToWordStart(buffer, documentEnd, resultPos))
+            else if (allowBottomExclusive && _tryMoveToWordStart(snapshot, resultPos))
             {
                 // IMPORTANT: _tryMoveToWordStart modifies resultPos if successful
                 // Degenerate ranges first move to the beginning of the word,
@@ -1544,7 +1621,7 @@ void UiaTextRangeBase::_moveEndpointByUnitWord(_In_ const int moveCount,
                 // to the next branch and move to the previous word!
                 (*pAmountMoved)--;
             }
-            else if (buffer.MoveToPreviousWord(nextPos, _wordDelimiters))
+            else if (snapshot.MoveToPreviousWord(nextPos))
             {
                 resultPos = nextPos;
                 (*pAmountMoved)--;
@@ -1566,15 +1643,14 @@ void UiaTextRangeBase::_moveEndpointByUnitWord(_In_ const int moveCount,
 // Routine Description:
 // - tries to move resultingPos to the beginning of the word
 // Arguments:
-// - buffer - the text buffer we're operating on
-// - documentEnd - the document end of the buffer (see _getDocumentEnd())
+// - snapshot - the snapshot of the text buffer we're operating on
 // - resultingPos - the position we're starting from and modifying
 // Return Value:
 // - true --> we were not at the beginning of the word, and we updated resultingPos to be so
 // - false --> otherwise (we're already at the beginning of the word)
-bool UiaTextRangeBase::_tryMoveToWordStart(const TextBuffer& buffer, const til::point documentEnd, til::point& resultingPos) const
+bool UiaTextRangeBase::_tryMoveToWordStart(const UiaTextSnapshot& snapshot, til::point& resultingPos) const noexcept
 {
-    const auto wordStart{ buffer.GetWordStart(resultingPos, _wordDelimiters, true, documentEnd) };
+    const auto wordStart{ snapshot.GetWordStart(resultingPos, snapshot.GetDocumentEnd()) };
     if (resultingPos != wordStart)
     {
         resultingPos = wordStart;
@@ -21,6 +21,7 @@ Author(s):
 #include "inc/viewport.hpp"
 #include "../buffer/out/textBuffer.hpp"
 #include "IUiaData.h"
+#include "UiaTextSnapshot.hpp"
 #include "unicode.hpp"
 #include "IUiaTraceable.h"
 
@@ -139,10 +140,18 @@ namespace Microsoft::Console::Types
         til::point _end{};
         bool _blockRange{};
 
+        // The most recent snapshot of the buffer this range has seen.
+        // Clones share it, so that ranges derived from each other
+        // don't need to copy the same rows over and over again.
+        std::shared_ptr<const UiaTextSnapshot> _snapshot;
+
         // This is used by tracing to extract the text value
         // that the UiaTextRange currently encompasses.
         // GetText() cannot be used as it's not const
         std::wstring _getTextValue(til::CoordType maxLength = -1) const;
+        std::wstring _getTextValue(const UiaTextSnapshot& snapshot, til::CoordType maxLength) const;
+
+        const UiaTextSnapshot& _refreshSnapshot();
 
         til::rect _getTerminalRect() const;
 
@@ -155,6 +164,7 @@ namespace Microsoft::Console::Types
         void _getBoundingRect(const til::rect& textRect, _Inout_ std::vector<double>& coords) const;
 
         void _expandToEnclosingUnit(TextUnit unit);
+        void _expandToEnclosingWord(const UiaTextSnapshot& snapshot) noexcept;
 
         void
         _moveEndpointByUnitCharacter(_In_ const int moveCount,
@@ -163,7 +173,8 @@ namespace Microsoft::Console::Types
                                      _In_ const bool preventBufferEnd = false);
 
         void
-        _moveEndpointByUnitWord(_In_ const int moveCount,
+        _moveEndpointByUnitWord(_In_ const UiaTextSnapshot& snapshot,
+                                _In_ const int moveCount,
                                 _In_ const TextPatternRangeEndpoint endpoint,
                                 const gsl::not_null<int*> pAmountMoved,
                                 _In_ const bool preventBufferEnd = false);
@@ -182,7 +193,7 @@ namespace Microsoft::Console::Types
 
         std::optional<bool> _verifyAttr(TEXTATTRIBUTEID attributeId, VARIANT val, const TextAttribute& attr) const;
         bool _initializeAttrQuery(TEXTATTRIBUTEID attributeId, VARIANT* pRetVal, const TextAttribute& attr) const;
-        bool _tryMoveToWordStart(const TextBuffer& buffer, const til::point documentEnd, til::point& resultingPos) const;
+        bool _tryMoveToWordStart(const UiaTextSnapshot& snapshot, til::point& resultingPos) const noexcept;
 
         til::point _getInclusiveEnd() const noexcept;
 
@@ -0,0 +1,679 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "UiaTextSnapshot.hpp"
+#include "../buffer/out/search.h"
+
+using namespace Microsoft::Console::Types;
+
+// Routine Description:
+// - Returns the glyph stored in the given column. Trailing cells of wide glyphs
+//   return the same glyph as their leading cell, just like CharRow::GlyphAt().
+std::wstring_view UiaTextSnapshot::Row::GlyphAt(const til::CoordType column) const noexcept
+{
+    const auto begin = til::at(offsets, gsl::narrow_cast<size_t>(column));
+    const auto end = til::at(offsets, gsl::narrow_cast<size_t>(column) + 1);
+    return std::wstring_view{ text }.substr(begin, end - begin);
+}
+
+// Routine Description:
+// - Returns the span of regular characters that contains the given column, if any.
+const UiaTextSnapshot::Span* UiaTextSnapshot::Row::WordAt(const til::CoordType column) const noexcept
+{
+    const auto it = NextWord(column);
+    return it && it->begin <= column ? it : nullptr;
+}
+
+// Routine Description:
+// - Returns the first span of regular characters that ends after the given column, if any.
+const UiaTextSnapshot::Span* UiaTextSnapshot::Row::NextWord(const til::CoordType column) const noexcept
+{
+    const auto it = std::upper_bound(words.begin(), words.end(), column, [](const til::CoordType value, const Span& span) {
+        return value < span.end;
+    });
+    return it != words.end() ? &*it : nullptr;
+}
+
+// Routine Description:
+// - Returns the attribute run that contains the given column.
+// Arguments:
+// - column - the column to look up
+// - begin - receives the first column of the run
+const UiaTextSnapshot::AttributeRun& UiaTextSnapshot::Row::AttributeRunAt(const til::CoordType column, til::CoordType& begin) const noexcept
+{
+    auto it = std::upper_bound(attributes.begin(), attributes.end(), column, [](const til::CoordType value, const AttributeRun& run) {
+        return value < run.end;
+    });
+    // The runs always cover the entire row, but let's be defensive about it.
+    if (it == attributes.end())
+    {
+        --it;
+    }
+    begin = it == attributes.begin() ? 0 : (it - 1)->end;
+    return *it;
+}
+
+const Viewport& UiaTextSnapshot::GetSize() const noexcept
+{
+    return _size;
+}
+
+til::point UiaTextSnapshot::GetTextBufferEndPosition() const noexcept
+{
+    return _textBufferEnd;
+}
+
+// Routine Description:
+// - The equivalent of UiaTextRangeBase::_getDocumentEnd() at the time the snapshot was taken:
+//   The line beneath the cursor or last legible character (whichever is further down).
+til::point UiaTextSnapshot::GetDocumentEnd() const noexcept
+{
+    return _documentEnd;
+}
+
+std::wstring_view UiaTextSnapshot::GetWordDelimiters() const noexcept
+{
+    return _wordDelimiters;
+}
+
+// Routine Description:
+// - Retrieves the text between the given endpoints, the same way
+//   TextBuffer::GetText() does for the rects of TextBuffer::GetTextRects().
+//   Rows are separated by CRLF, unless the row was wrapped.
+// Arguments:
+// - start - the first cell (inclusive)
+// - inclusiveEnd - the last cell (inclusive)
+// - blockRange - whether the endpoints describe a rectangle instead of a stream of text
+// Return Value:
+// - the text in the range
+std::wstring UiaTextSnapshot::GetText(const til::point start, const til::point inclusiveEnd, const bool blockRange) const
+{
+    const auto [higher, lower] = start <= inclusiveEnd ? std::make_pair(start, inclusiveEnd) : std::make_pair(inclusiveEnd, start);
+
+    std::wstring text;
+    text.reserve(gsl::narrow_cast<size_t>(lower.y - higher.y + 1) * gsl::narrow_cast<size_t>(_size.Width() + 2));
+
+    for (auto y = higher.y; y <= lower.y; ++y)
+    {
+        const auto& row = _row(y);
+
+        til::point left{ _size.Left(), y };
+        til::point right{ _size.RightInclusive(), y };
+        if (blockRange || higher.y == lower.y)
+        {
+            left.x = std::min(higher.x, lower.x);
+            right.x = std::max(higher.x, lower.x);
+        }
+        else
+        {
+            left.x = y == higher.y ? higher.x : left.x;
+            right.x = y == lower.y ? lower.x : right.x;
+        }
+
+        // Expand the row to include wide glyphs fully (see TextBuffer::_ExpandTextRow).
+        if (til::at(row.dbcs, left.x).IsTrailing())
+        {
+            if (left.x == _size.Left())
+            {
+                _size.IncrementInBounds(left);
+            }
+            else
+            {
+                _size.DecrementInBounds(left);
+            }
+        }
+        if (til::at(row.dbcs, right.x).IsLeading())
+        {
+            if (right.x == _size.RightInclusive())
+            {
+                _size.DecrementInBounds(right);
+            }
+            else
+            {
+                _size.IncrementInBounds(right);
+            }
+        }
+
+        for (auto x = left.x; x <= right.x; ++x)
+        {
+            if (!til::at(row.dbcs, x).IsTrailing())
+            {
+                text.append(row.GlyphAt(x));
+            }
+        }
+
+        if (y < lower.y && !row.wrapForced)
+        {
+            text.push_back(UNICODE_CARRIAGERETURN);
+            text.push_back(UNICODE_LINEFEED);
+        }
+    }
+
+    return text;
+}
+
+// Routine Description:
+// - The equivalent of TextBuffer::GetWordStart() in accessibility mode.
+// Arguments:
+// - target - a position on the word you are currently on
+// - limit - the last possible position in the buffer that can be explored
+// Return Value:
+// - The position of the first character on the current/previous readable word (inclusive)
+til::point UiaTextSnapshot::GetWordStart(const til::point target, const til::point limit) const noexcept
+{
+    if (target == _size.Origin())
+    {
+        // can't expand left
+        return target;
+    }
+    else if (target == _size.EndExclusive())
+    {
+        // GH#7664: Treat EndExclusive as EndInclusive so
+        // that it actually points to a space in the buffer
+        return _getWordStart(_size.BottomRightInclusive());
+    }
+    else if (target >= limit)
+    {
+        return _getWordStart(limit);
+    }
+    return _getWordStart(target);
+}
+
+// Routine Description:
+// - The equivalent of TextBuffer::GetWordEnd() in accessibility mode.
+// Return Value:
+// - The position of the first character of the next readable word (exclusive end of the current one).
+til::point UiaTextSnapshot::GetWordEnd(const til::point target, const til::point limit) const noexcept
+{
+    // Already at/past the limit. Can't move forward.
+    if (target >= limit)
+    {
+        return target;
+    }
+    return _getWordEnd(target, limit);
+}
+
+// Routine Description:
+// - The equivalent of TextBuffer::MoveToNextWord().
+// Return Value:
+// - true, if pos was moved to the first character of the next word.
+bool UiaTextSnapshot::MoveToNextWord(til::point& pos, const til::point limit) const noexcept
+{
+    const auto copy = _getWordEnd(pos, limit);
+    if (copy >= limit)
+    {
+        return false;
+    }
+
+    pos = copy;
+    return true;
+}
+
+// Routine Description:
+// - The equivalent of TextBuffer::MoveToPreviousWord().
+// Return Value:
+// - true, if pos was moved to the first character of the previous word.
+bool UiaTextSnapshot::MoveToPreviousWord(til::point& pos) const noexcept
+{
+    // move to the beginning of the current word
+    auto copy = GetWordStart(pos, _size.EndExclusive());
+
+    if (!_size.DecrementInBounds(copy, true))
+    {
+        // can't move behind current word
+        return false;
+    }
+
+    // move to the beginning of the previous word
+    pos = GetWordStart(copy, _size.EndExclusive());
+    return true;
+}
+
+// Routine Description:
+// - Finds the first contiguous range of cells whose attribute satisfies the predicate.
+//   Cells are visited in the order a TextBufferCellIterator bound to the given viewport
+//   would visit them, but entire attribute runs are tested at once.
+// Arguments:
+// - searchStart - the cell to start searching at
+// - searchEndExclusive - the cell to stop the search at
+// - bounds - the area to search in. Reaching its end (or start) ends the search, too.
+// - searchBackward - whether to search towards the origin of the buffer
+// - predicate - returns true for the attributes we're looking for
+// Return Value:
+// - The first and last matching cell in search order, if any.
+std::optional<UiaTextSnapshot::CellRange> UiaTextSnapshot::FindAttribute(const til::point searchStart,
+                                                                        const til::point searchEndExclusive,
+                                                                        const Viewport& bounds,
+                                                                        const bool searchBackward,
+                                                                        const AttributePredicate& predicate) const
+{
+    std::optional<til::point> first;
+    til::point last;
+
+    auto pos = searchStart;
+    while (pos != searchEndExclusive)
+    {
+        til::CoordType runBegin;
+        const auto& run = _row(pos.y).AttributeRunAt(pos.x, runBegin);
+
+        // The cells [segmentBegin, segmentEnd) of this row share the same attribute.
+        auto segmentBegin = searchBackward ? std::max(runBegin, bounds.Left()) : pos.x;
+        auto segmentEnd = searchBackward ? pos.x + 1 : std::min(run.end, bounds.RightExclusive());
+
+        // Stop right before searchEndExclusive if it's part of this segment.
+        auto reachedEnd = false;
+        if (searchEndExclusive.y == pos.y)
+        {
+            if (!searchBackward && searchEndExclusive.x > pos.x && searchEndExclusive.x < segmentEnd)
+            {
+                segmentEnd = searchEndExclusive.x;
+                reachedEnd = true;
+            }
+            else if (searchBackward && searchEndExclusive.x < pos.x && searchEndExclusive.x >= segmentBegin)
+            {
+                segmentBegin = searchEndExclusive.x + 1;
+                reachedEnd = true;
+            }
+        }
+
+        if (predicate(run.attr))
+        {
+            if (!first)
+            {
+                first = pos;
+            }
+            last = { searchBackward ? segmentBegin : segmentEnd - 1, pos.y };
+        }
+        else if (first)
+        {
+            // We found a contiguous range with the attribute and it just ended.
+            break;
+        }
+
+        if (reachedEnd)
+        {
+            break;
+        }
+
+        if (searchBackward)
+        {
+            if (segmentBegin > bounds.Left())
+            {
+                pos.x = segmentBegin - 1;
+            }
+            else if (pos.y > bounds.Top())
+            {
+                pos = { bounds.RightInclusive(), pos.y - 1 };
+            }
+            else
+            {
+                break;
+            }
+        }
+        else
+        {
+            if (segmentEnd < bounds.RightExclusive())
+            {
+                pos.x = segmentEnd;
+            }
+            else if (pos.y < bounds.BottomInclusive())
+            {
+                pos = { bounds.Left(), pos.y + 1 };
+            }
+            else
+            {
+                break;
+            }
+        }
+    }
+
+    if (!first)
+    {
+        return std::nullopt;
+    }
+    return CellRange{ *first, last };
+}
+
+// Routine Description:
+// - The equivalent of Search::FindNext() for a Search starting at the given anchor.
+//   Like Search, the search wraps around the buffer and skips everything past the
+//   text buffer end position.
+// Arguments:
+// - text - the text to search for
+// - anchor - the position to start searching at
+// - searchBackward - whether to search towards the origin of the buffer
+// - ignoreCase - whether to compare the text case insensitively
+// Return Value:
+// - The first and last (inclusive) cell of the match, if any.
+std::optional<UiaTextSnapshot::CellRange> UiaTextSnapshot::FindText(const std::wstring& text,
+                                                                   const til::point anchor,
+                                                                   const bool searchBackward,
+                                                                   const bool ignoreCase) const
+{
+    const auto needle = Search::s_CreateNeedleFromString(text);
+
+    auto next = anchor;
+    do
+    {
+        til::point end;
+        if (_matchesAt(needle, next, ignoreCase, end))
+        {
+            return CellRange{ next, end };
+        }
+
+        if (searchBackward)
+        {
+            _size.DecrementInBoundsCircular(next);
+        }
+        else
+        {
+            _size.IncrementInBoundsCircular(next);
+        }
+
+        // To reduce wrap-around time, skip everything past the end of the written text.
+        if (next > _textBufferEnd)
+        {
+            next = searchBackward ? _textBufferEnd : til::point{};
+        }
+    } while (next != anchor);
+
+    return std::nullopt;
+}
+
+const UiaTextSnapshot::Row& UiaTextSnapshot::_row(const til::CoordType y) const noexcept
+{
+    return *til::at(_rows, gsl::narrow_cast<size_t>(y));
+}
+
+// Routine Description:
+// - Returns the first cell at or after pos that isn't a regular character,
+//   or the EndExclusive position if there is none.
+til::point UiaTextSnapshot::_skipRegular(til::point pos) const noexcept
+{
+    while (pos.y < _size.Height())
+    {
+        const auto word = _row(pos.y).WordAt(pos.x);
+        if (!word)
+        {
+            return pos;
+        }
+        if (word->end < _size.Width())
+        {
+            return { word->end, pos.y };
+        }
+        // The word continues on the next row.
+        pos = { 0, pos.y + 1 };
+    }
+    return _size.EndExclusive();
+}
+
+// Routine Description:
+// - Returns the first regular character at or after pos,
+//   or the EndExclusive position if there is none.
+til::point UiaTextSnapshot::_skipNonRegular(til::point pos) const noexcept
+{
+    while (pos.y < _size.Height())
+    {
+        if (const auto word = _row(pos.y).NextWord(pos.x))
+        {
+            return { std::max(word->begin, pos.x), pos.y };
+        }
+        pos = { 0, pos.y + 1 };
+    }
+    return _size.EndExclusive();
+}
+
+// Routine Description:
+// - The equivalent of TextBuffer::_GetWordStartForAccessibility():
+//   Moves back to the last regular character at or before target
+//   and from there to the beginning of its word.
+til::point UiaTextSnapshot::_getWordStart(const til::point target) const noexcept
+{
+    auto y = target.y;
+    auto x = target.x;
+
+    // Find the word at or before target.
+    const Span* word = nullptr;
+    for (;;)
+    {
+        const auto& row = _row(y);
+        if (const auto next = row.NextWord(x); next && next->begin <= x)
+        {
+            word = next;
+            break;
+        }
+
+        // There's no word that contains x, so pick the last one that starts before it.
+        const auto it = std::upper_bound(row.words.begin(), row.words.end(), x, [](const til::CoordType value, const Span& span) {
+            return value < span.begin;
+        });
+        if (it != row.words.begin())
+        {
+            word = &*(it - 1);
+            break;
+        }
+
+        if (y == 0)
+        {
+            // There's no readable text before target. We can't move any further back.
+            return _size.Origin();
+        }
+        --y;
+        x = _size.RightInclusive();
+    }
+
+    // Words continue across row boundaries if the previous row ends in a regular character.
+    auto begin = word->begin;
+    while (begin == 0 && y > 0)
+    {
+        const auto previous = _row(y - 1).WordAt(_size.RightInclusive());
+        if (!previous)
+        {
+            break;
+        }
+        --y;
+        begin = previous->begin;
+    }
+
+    return { begin, y };
+}
+
+// Routine Description:
+// - The equivalent of TextBuffer::_GetWordEndForAccessibility().
+// Return Value:
+// - The first character of the next readable word, clamped to limit.
+//   If there's no next word, this is one past the end of the buffer.
+til::point UiaTextSnapshot::_getWordEnd(const til::point target, const til::point limit) const noexcept
+{
+    if (target >= limit)
+    {
+        // if we're already on/past the last RegularChar,
+        // clamp result to that position and make it exclusive
+        auto result = limit;
+        _size.IncrementInBounds(result, true);
+        return result;
+    }
+
+    // Both steps only move forward, so clamping the result is
+    // equivalent to stopping the walk as soon as we reach the limit.
+    return std::min(_skipNonRegular(_skipRegular(target)), limit);
+}
+
+// Routine Description:
+// - The equivalent of Search::_FindNeedleInHaystackAt().
+bool UiaTextSnapshot::_matchesAt(const std::vector<std::vector<wchar_t>>& needle, const til::point pos, const bool ignoreCase, til::point& end) const noexcept
+{
+    const auto applySensitivity = [=](const wchar_t wch) noexcept {
+        return ignoreCase ? ::towlower(wch) : wch;
+    };
+
+    auto bufferPos = pos;
+    for (const auto& needleCell : needle)
+    {
+        const auto hay = _row(bufferPos.y).GlyphAt(bufferPos.x);
+        if (hay.size() != needleCell.size() ||
+            !std::equal(hay.begin(), hay.end(), needleCell.begin(), [&](const wchar_t a, const wchar_t b) noexcept {
+                return applySensitivity(a) == applySensitivity(b);
+            }))
+        {
+            return false;
+        }
+
+        _size.IncrementInBoundsCircular(bufferPos);
+    }
+
+    _size.DecrementInBoundsCircular(bufferPos);
+    end = bufferPos;
+    return true;
+}
+
+// Routine Description:
+// - Copies the contents of the given row.
+// Arguments:
+// - row - the row to copy
+// - wordDelimiters - the characters that separate words, in addition to whitespace and control characters
+// Return Value:
+// - the immutable copy of the row
+std::shared_ptr<const UiaTextSnapshot::Row> UiaTextSnapshot::s_CaptureRow(const ROW& row, const std::wstring_view wordDelimiters)
+{
+    auto result = std::make_shared<Row>();
+    const auto& charRow = row.GetCharRow();
+    const auto width = charRow.size();
+    const auto columns = gsl::narrow_cast<size_t>(width);
+
+    result->revision = row.GetRevision();
+    result->measureRight = charRow.MeasureRight();
+    result->wrapForced = row.WasWrapForced();
+
+    result->text.reserve(columns);
+    result->offsets.reserve(columns + 1);
+    result->dbcs.reserve(columns);
+
+    std::optional<til::CoordType> wordBegin;
+    for (til::CoordType x = 0; x < width; ++x)
+    {
+        const std::wstring_view glyph = charRow.GlyphAt(x);
+        result->offsets.push_back(gsl::narrow<uint32_t>(result->text.size()));
+        result->text.append(glyph);
+        result->dbcs.push_back(charRow.DbcsAttrAt(x));
+
+        // This is CharRow::DelimiterClassAt() == DelimiterClass::RegularChar.
+        const auto wch = glyph.empty() ? UNICODE_SPACE : glyph.front();
+        const auto regular = wch > UNICODE_SPACE && wordDelimiters.find(wch) == std::wstring_view::npos;
+        if (regular && !wordBegin)
+        {
+            wordBegin = x;
+        }
+        else if (!regular && wordBegin)
+        {
+            result->words.push_back({ *wordBegin, x });
+            wordBegin.reset();
+        }
+    }
+    result->offsets.push_back(gsl::narrow<uint32_t>(result->text.size()));
+    if (wordBegin)
+    {
+        result->words.push_back({ *wordBegin, width });
+    }
+
+    const auto& runs = row.GetAttrRow().GetRuns();
+    result->attributes.reserve(runs.size());
+    til::CoordType end = 0;
+    for (const auto& run : runs)
+    {
+        end += run.length;
+        result->attributes.push_back({ run.value, end });
+    }
+
+    return result;
+}
+
+// Routine Description:
+// - Brings the snapshot up to date with the given buffer and returns it.
+//   Rows that didn't change since the previous call are shared with the previous snapshot,
+//   even if they moved to a different position, for instance because the buffer scrolled.
+// - The console lock must be held.
+// Arguments:
+// - buffer - the buffer to take a snapshot of
+// - textBufferEnd - the position of the end of the text in the buffer (see IBaseData::GetTextBufferEndPosition())
+// - wordDelimiters - the characters that separate words, in addition to whitespace and control characters
+// Return Value:
+// - the snapshot. It remains valid and unchanged after the console lock is released.
+std::shared_ptr<const UiaTextSnapshot> UiaTextSnapshotCache::Update(const TextBuffer& buffer,
+                                                                    const til::point textBufferEnd,
+                                                                    const std::wstring_view wordDelimiters)
+{
+    const auto size = buffer.GetSize();
+    const auto cursorPosition = buffer.GetCursor().GetPosition();
+    const auto height = size.Height();
+    const auto previous = _snapshot.get();
+    const auto compatible = previous && previous->_size == size && previous->_wordDelimiters == wordDelimiters;
+
+    if (compatible && previous->_textBufferEnd == textBufferEnd && previous->_cursorPosition == cursorPosition)
+    {
+        auto unchanged = true;
+        for (til::CoordType y = 0; y < height && unchanged; ++y)
+        {
+            unchanged = buffer.GetRowByOffset(y).GetRevision() == previous->_row(y).revision;
+        }
+        if (unchanged)
+        {
+            return _snapshot;
+        }
+    }
+
+    std::shared_ptr<UiaTextSnapshot> snapshot{ new UiaTextSnapshot{} };
+    snapshot->_size = size;
+    snapshot->_textBufferEnd = textBufferEnd;
+    snapshot->_cursorPosition = cursorPosition;
+    snapshot->_wordDelimiters = wordDelimiters;
+    snapshot->_rows.reserve(gsl::narrow_cast<size_t>(height));
+
+    // Maps the revisions of the previous snapshot's rows to their index.
+    // It's only needed once rows moved, so it's built lazily.
+    std::unordered_map<uint64_t, size_t> previousRows;
+
+    for (til::CoordType y = 0; y < height; ++y)
+    {
+        const auto& row = buffer.GetRowByOffset(y);
+        const auto revision = row.GetRevision();
+
+        std::shared_ptr<const UiaTextSnapshot::Row> captured;
+        if (compatible)
+        {
+            if (previous->_row(y).revision == revision)
+            {
+                captured = til::at(previous->_rows, gsl::narrow_cast<size_t>(y));
+            }
+            else
+            {
+                if (previousRows.empty())
+                {
+                    previousRows.reserve(previous->_rows.size());
+                    for (size_t i = 0; i < previous->_rows.size(); ++i)
+                    {
+                        previousRows.emplace(previous->_rows[i]->revision, i);
+                    }
+                }
+                if (const auto it = previousRows.find(revision); it != previousRows.end())
+                {
+                    captured = til::at(previous->_rows, it->second);
+                }
+            }
+        }
+
+        snapshot->_rows.emplace_back(captured ? std::move(captured) : UiaTextSnapshot::s_CaptureRow(row, wordDelimiters));
+    }
+
+    // This is TextBuffer::GetLastNonSpaceCharacter() for the area up to textBufferEnd.
+    auto lastCharY = std::clamp(textBufferEnd.y, 0, height - 1);
+    while (lastCharY > 0 && snapshot->_row(lastCharY).measureRight <= 0)
+    {
+        --lastCharY;
+    }
+    snapshot->_documentEnd = { 0, std::max(lastCharY, cursorPosition.y) + 1 };
+
+    _snapshot = std::move(snapshot);
+    return _snapshot;
+}
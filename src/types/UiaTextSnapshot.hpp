@@ -0,0 +1,139 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- UiaTextSnapshot.hpp
+
+Abstract:
+- An immutable copy of the text, attributes and word boundaries of a TextBuffer.
+  UI Automation queries that need to walk large parts of the buffer (GetText,
+  FindText, FindAttribute and word navigation) are answered from a snapshot,
+  so that the console lock is only held while the snapshot is brought up to date.
+- Snapshots are created by UiaTextSnapshotCache. Rows are shared between
+  consecutive snapshots and only rows whose ROW::GetRevision() changed since the
+  previous snapshot are copied again. Each row precomputes the spans of readable
+  ("regular") characters and its attribute runs, which lets word navigation and
+  attribute searches skip over entire words and runs instead of visiting every cell.
+--*/
+
+#pragma once
+
+#include "inc/viewport.hpp"
+#include "../buffer/out/textBuffer.hpp"
+
+#ifdef UNIT_TESTING
+class UiaTextRangeTests;
+#endif
+
+namespace Microsoft::Console::Types
+{
+    class UiaTextSnapshot final
+    {
+    public:
+        // An inclusive range of cells, in the order they were found in.
+        using CellRange = std::pair<til::point, til::point>;
+        using AttributePredicate = std::function<bool(const TextAttribute&)>;
+
+        UiaTextSnapshot(const UiaTextSnapshot&) = delete;
+        UiaTextSnapshot(UiaTextSnapshot&&) = delete;
+        UiaTextSnapshot& operator=(const UiaTextSnapshot&) = delete;
+        UiaTextSnapshot& operator=(UiaTextSnapshot&&) = delete;
+        ~UiaTextSnapshot() = default;
+
+        const Viewport& GetSize() const noexcept;
+        til::point GetTextBufferEndPosition() const noexcept;
+        til::point GetDocumentEnd() const noexcept;
+        std::wstring_view GetWordDelimiters() const noexcept;
+
+        std::wstring GetText(const til::point start, const til::point inclusiveEnd, const bool blockRange) const;
+
+        til::point GetWordStart(const til::point target, const til::point limit) const noexcept;
+        til::point GetWordEnd(const til::point target, const til::point limit) const noexcept;
+        bool MoveToNextWord(til::point& pos, const til::point limit) const noexcept;
+        bool MoveToPreviousWord(til::point& pos) const noexcept;
+
+        std::optional<CellRange> FindAttribute(const til::point searchStart,
+                                               const til::point searchEndExclusive,
+                                               const Viewport& bounds,
+                                               const bool searchBackward,
+                                               const AttributePredicate& predicate) const;
+        std::optional<CellRange> FindText(const std::wstring& text,
+                                          const til::point anchor,
+                                          const bool searchBackward,
+                                          const bool ignoreCase) const;
+
+    private:
+        friend class UiaTextSnapshotCache;
+
+        // A [begin, end) span of columns.
+        struct Span
+        {
+            til::CoordType begin;
+            til::CoordType end;
+        };
+
+        struct AttributeRun
+        {
+            TextAttribute attr;
+            // The column after the last one this attribute applies to.
+            til::CoordType end;
+        };
+
+        struct Row
+        {
+            uint64_t revision{};
+            // The glyphs of all cells, including the trailing halves of wide glyphs.
+            std::wstring text;
+            // The offset of each column's glyph in text, plus one entry for the end of text.
+            std::vector<uint32_t> offsets;
+            std::vector<DbcsAttribute> dbcs;
+            std::vector<AttributeRun> attributes;
+            // The spans of cells that are DelimiterClass::RegularChar, from left to right.
+            std::vector<Span> words;
+            til::CoordType measureRight{};
+            bool wrapForced{};
+
+            std::wstring_view GlyphAt(const til::CoordType column) const noexcept;
+            const Span* WordAt(const til::CoordType column) const noexcept;
+            const Span* NextWord(const til::CoordType column) const noexcept;
+            const AttributeRun& AttributeRunAt(const til::CoordType column, til::CoordType& begin) const noexcept;
+        };
+
+        UiaTextSnapshot() = default;
+
+        static std::shared_ptr<const Row> s_CaptureRow(const ROW& row, const std::wstring_view wordDelimiters);
+
+        const Row& _row(const til::CoordType y) const noexcept;
+        til::point _skipRegular(til::point pos) const noexcept;
+        til::point _skipNonRegular(til::point pos) const noexcept;
+        til::point _getWordStart(const til::point target) const noexcept;
+        til::point _getWordEnd(const til::point target, const til::point limit) const noexcept;
+        bool _matchesAt(const std::vector<std::vector<wchar_t>>& needle, const til::point pos, const bool ignoreCase, til::point& end) const noexcept;
+
+        std::vector<std::shared_ptr<const Row>> _rows;
+        Viewport _size;
+        til::point _textBufferEnd;
+        til::point _cursorPosition;
+        til::point _documentEnd;
+        std::wstring _wordDelimiters;
+
+#ifdef UNIT_TESTING
+        friend class ::UiaTextRangeTests;
+#endif
+    };
+
+    // Holds on to the most recent snapshot of a buffer, so that the next one only needs
+    // to copy the rows that changed in the meantime.
+    // The console lock must be held while calling Update().
+    class UiaTextSnapshotCache final
+    {
+    public:
+        std::shared_ptr<const UiaTextSnapshot> Update(const TextBuffer& buffer,
+                                                      const til::point textBufferEnd,
+                                                      const std::wstring_view wordDelimiters);
+
+    private:
+        std::shared_ptr<const UiaTextSnapshot> _snapshot;
+    };
+}
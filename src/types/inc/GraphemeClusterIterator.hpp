@@ -0,0 +1,131 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- GraphemeClusterIterator.hpp
+
+Abstract:
+- Splits UTF-16 text into extended grapheme clusters ("user-perceived characters")
+  according to the rules of UAX #29, without allocating. It can be iterated forwards
+  and backwards and returns views into the given text.
+- It can also split the text into plain code points, which is what the text buffer
+  stores in each of its cells. Callers that map text onto buffer cells need that.
+- Unpaired surrogates are returned as clusters of their own, one column wide.
+--*/
+
+#pragma once
+
+#include <iterator>
+#include <string_view>
+
+// The Grapheme_Cluster_Break property of a code point, merged with the Extended_Pictographic
+// and Indic_Conjunct_Break properties that the rules need as well. The Conjunct values have
+// Grapheme_Cluster_Break=Other (Consonant) or Grapheme_Cluster_Break=Extend (Linker, Extend).
+enum class GraphemeBreak : uint8_t
+{
+    Other,
+    Control,
+    CR,
+    LF,
+    Extend,
+    ZWJ,
+    RegionalIndicator,
+    Prepend,
+    SpacingMark,
+    L,
+    V,
+    T,
+    LV,
+    LVT,
+    ExtendedPictographic,
+    ConjunctConsonant,
+    ConjunctLinker,
+    ConjunctExtend,
+};
+
+class GraphemeClusterIterator final
+{
+public:
+    enum class Segmentation
+    {
+        GraphemeClusters,
+        Codepoints,
+    };
+
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = std::wstring_view;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = std::wstring_view;
+
+    GraphemeClusterIterator() = default;
+    // Points to the cluster that contains the given offset or to the end if offset >= text.size().
+    GraphemeClusterIterator(std::wstring_view text, size_t offset = 0, Segmentation segmentation = Segmentation::GraphemeClusters) noexcept;
+
+    static GraphemeBreak GetBreakProperty(char32_t codepoint) noexcept;
+    static bool IsBoundary(std::wstring_view text, size_t offset) noexcept;
+
+    std::wstring_view operator*() const noexcept
+    {
+        return _text.substr(_begin, _end - _begin);
+    }
+
+    GraphemeClusterIterator& operator++() noexcept;
+    GraphemeClusterIterator operator++(int) noexcept;
+    GraphemeClusterIterator& operator--() noexcept;
+    GraphemeClusterIterator operator--(int) noexcept;
+
+    bool operator==(const GraphemeClusterIterator& other) const noexcept
+    {
+        return _text.data() == other._text.data() && _begin == other._begin;
+    }
+
+    bool operator!=(const GraphemeClusterIterator& other) const noexcept
+    {
+        return !(*this == other);
+    }
+
+    // The offset of the current cluster in the text.
+    size_t Offset() const noexcept
+    {
+        return _begin;
+    }
+
+    // The number of columns the current cluster occupies: 2 if its first code point is wide and 1 otherwise.
+    til::CoordType Columns() const;
+
+private:
+    size_t _NextBoundary(size_t offset) const noexcept;
+    size_t _PreviousBoundary(size_t offset) const noexcept;
+
+    std::wstring_view _text;
+    size_t _begin = 0;
+    size_t _end = 0;
+    Segmentation _segmentation = Segmentation::GraphemeClusters;
+};
+
+// Allows iterating over the clusters of a string with a range-based for loop.
+class GraphemeClusters final
+{
+public:
+    explicit GraphemeClusters(std::wstring_view text, GraphemeClusterIterator::Segmentation segmentation = GraphemeClusterIterator::Segmentation::GraphemeClusters) noexcept :
+        _text{ text },
+        _segmentation{ segmentation }
+    {
+    }
+
+    GraphemeClusterIterator begin() const noexcept
+    {
+        return { _text, 0, _segmentation };
+    }
+
+    GraphemeClusterIterator end() const noexcept
+    {
+        return { _text, _text.size(), _segmentation };
+    }
+
+private:
+    std::wstring_view _text;
+    GraphemeClusterIterator::Segmentation _segmentation;
+};
@@ -14,12 +14,9 @@ Author(s):
 
 #pragma once
 
-#include <vector>
-
 class Utf16Parser final
 {
 public:
-    static std::vector<std::vector<wchar_t>> Parse(std::wstring_view wstr);
     static std::wstring_view ParseNext(std::wstring_view wstr) noexcept;
 
     // Routine Description:
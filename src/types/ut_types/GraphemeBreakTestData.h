@@ -0,0 +1,1105 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#pragma once
+
+// The test cases from GraphemeBreakTest.txt of Unicode 16.0.0[1], without their comments.
+// ÷ marks a grapheme cluster boundary and × the lack of one. The cases that contain
+// surrogate code points are left out, as they can't be represented in valid UTF-16.
+//
+// [1]: https://www.unicode.org/Public/16.0.0/ucd/auxiliary/GraphemeBreakTest.txt
+static constexpr std::array<std::wstring_view, 1093> s_graphemeBreakTestCases{
+    L"÷ 0020 ÷ 0020 ÷",
+    L"÷ 0020 × 0308 ÷ 0020 ÷",
+    L"÷ 0020 ÷ 000D ÷",
+    L"÷ 0020 × 0308 ÷ 000D ÷",
+    L"÷ 0020 ÷ 000A ÷",
+    L"÷ 0020 × 0308 ÷ 000A ÷",
+    L"÷ 0020 ÷ 0001 ÷",
+    L"÷ 0020 × 0308 ÷ 0001 ÷",
+    L"÷ 0020 × 200C ÷",
+    L"÷ 0020 × 0308 × 200C ÷",
+    L"÷ 0020 ÷ 1F1E6 ÷",
+    L"÷ 0020 × 0308 ÷ 1F1E6 ÷",
+    L"÷ 0020 ÷ 0600 ÷",
+    L"÷ 0020 × 0308 ÷ 0600 ÷",
+    L"÷ 0020 ÷ 1100 ÷",
+    L"÷ 0020 × 0308 ÷ 1100 ÷",
+    L"÷ 0020 ÷ 1160 ÷",
+    L"÷ 0020 × 0308 ÷ 1160 ÷",
+    L"÷ 0020 ÷ 11A8 ÷",
+    L"÷ 0020 × 0308 ÷ 11A8 ÷",
+    L"÷ 0020 ÷ AC00 ÷",
+    L"÷ 0020 × 0308 ÷ AC00 ÷",
+    L"÷ 0020 ÷ AC01 ÷",
+    L"÷ 0020 × 0308 ÷ AC01 ÷",
+    L"÷ 0020 ÷ 0904 ÷",
+    L"÷ 0020 × 0308 ÷ 0904 ÷",
+    L"÷ 0020 ÷ 0D4E ÷",
+    L"÷ 0020 × 0308 ÷ 0D4E ÷",
+    L"÷ 0020 ÷ 0915 ÷",
+    L"÷ 0020 × 0308 ÷ 0915 ÷",
+    L"÷ 0020 ÷ 231A ÷",
+    L"÷ 0020 × 0308 ÷ 231A ÷",
+    L"÷ 0020 × 0300 ÷",
+    L"÷ 0020 × 0308 × 0300 ÷",
+    L"÷ 0020 × 0900 ÷",
+    L"÷ 0020 × 0308 × 0900 ÷",
+    L"÷ 0020 × 094D ÷",
+    L"÷ 0020 × 0308 × 094D ÷",
+    L"÷ 0020 × 200D ÷",
+    L"÷ 0020 × 0308 × 200D ÷",
+    L"÷ 0020 ÷ 0378 ÷",
+    L"÷ 0020 × 0308 ÷ 0378 ÷",
+    L"÷ 000D ÷ 0020 ÷",
+    L"÷ 000D ÷ 0308 ÷ 0020 ÷",
+    L"÷ 000D ÷ 000D ÷",
+    L"÷ 000D ÷ 0308 ÷ 000D ÷",
+    L"÷ 000D × 000A ÷",
+    L"÷ 000D ÷ 0308 ÷ 000A ÷",
+    L"÷ 000D ÷ 0001 ÷",
+    L"÷ 000D ÷ 0308 ÷ 0001 ÷",
+    L"÷ 000D ÷ 200C ÷",
+    L"÷ 000D ÷ 0308 × 200C ÷",
+    L"÷ 000D ÷ 1F1E6 ÷",
+    L"÷ 000D ÷ 0308 ÷ 1F1E6 ÷",
+    L"÷ 000D ÷ 0600 ÷",
+    L"÷ 000D ÷ 0308 ÷ 0600 ÷",
+    L"÷ 000D ÷ 0A03 ÷",
+    L"÷ 000D ÷ 1100 ÷",
+    L"÷ 000D ÷ 0308 ÷ 1100 ÷",
+    L"÷ 000D ÷ 1160 ÷",
+    L"÷ 000D ÷ 0308 ÷ 1160 ÷",
+    L"÷ 000D ÷ 11A8 ÷",
+    L"÷ 000D ÷ 0308 ÷ 11A8 ÷",
+    L"÷ 000D ÷ AC00 ÷",
+    L"÷ 000D ÷ 0308 ÷ AC00 ÷",
+    L"÷ 000D ÷ AC01 ÷",
+    L"÷ 000D ÷ 0308 ÷ AC01 ÷",
+    L"÷ 000D ÷ 0903 ÷",
+    L"÷ 000D ÷ 0904 ÷",
+    L"÷ 000D ÷ 0308 ÷ 0904 ÷",
+    L"÷ 000D ÷ 0D4E ÷",
+    L"÷ 000D ÷ 0308 ÷ 0D4E ÷",
+    L"÷ 000D ÷ 0915 ÷",
+    L"÷ 000D ÷ 0308 ÷ 0915 ÷",
+    L"÷ 000D ÷ 231A ÷",
+    L"÷ 000D ÷ 0308 ÷ 231A ÷",
+    L"÷ 000D ÷ 0300 ÷",
+    L"÷ 000D ÷ 0308 × 0300 ÷",
+    L"÷ 000D ÷ 0900 ÷",
+    L"÷ 000D ÷ 0308 × 0900 ÷",
+    L"÷ 000D ÷ 094D ÷",
+    L"÷ 000D ÷ 0308 × 094D ÷",
+    L"÷ 000D ÷ 200D ÷",
+    L"÷ 000D ÷ 0308 × 200D ÷",
+    L"÷ 000D ÷ 0378 ÷",
+    L"÷ 000D ÷ 0308 ÷ 0378 ÷",
+    L"÷ 000A ÷ 0020 ÷",
+    L"÷ 000A ÷ 0308 ÷ 0020 ÷",
+    L"÷ 000A ÷ 000D ÷",
+    L"÷ 000A ÷ 0308 ÷ 000D ÷",
+    L"÷ 000A ÷ 000A ÷",
+    L"÷ 000A ÷ 0308 ÷ 000A ÷",
+    L"÷ 000A ÷ 0001 ÷",
+    L"÷ 000A ÷ 0308 ÷ 0001 ÷",
+    L"÷ 000A ÷ 200C ÷",
+    L"÷ 000A ÷ 0308 × 200C ÷",
+    L"÷ 000A ÷ 1F1E6 ÷",
+    L"÷ 000A ÷ 0308 ÷ 1F1E6 ÷",
+    L"÷ 000A ÷ 0600 ÷",
+    L"÷ 000A ÷ 0308 ÷ 0600 ÷",
+    L"÷ 000A ÷ 0A03 ÷",
+    L"÷ 000A ÷ 1100 ÷",
+    L"÷ 000A ÷ 0308 ÷ 1100 ÷",
+    L"÷ 000A ÷ 1160 ÷",
+    L"÷ 000A ÷ 0308 ÷ 1160 ÷",
+    L"÷ 000A ÷ 11A8 ÷",
+    L"÷ 000A ÷ 0308 ÷ 11A8 ÷",
+    L"÷ 000A ÷ AC00 ÷",
+    L"÷ 000A ÷ 0308 ÷ AC00 ÷",
+    L"÷ 000A ÷ AC01 ÷",
+    L"÷ 000A ÷ 0308 ÷ AC01 ÷",
+    L"÷ 000A ÷ 0903 ÷",
+    L"÷ 000A ÷ 0904 ÷",
+    L"÷ 000A ÷ 0308 ÷ 0904 ÷",
+    L"÷ 000A ÷ 0D4E ÷",
+    L"÷ 000A ÷ 0308 ÷ 0D4E ÷",
+    L"÷ 000A ÷ 0915 ÷",
+    L"÷ 000A ÷ 0308 ÷ 0915 ÷",
+    L"÷ 000A ÷ 231A ÷",
+    L"÷ 000A ÷ 0308 ÷ 231A ÷",
+    L"÷ 000A ÷ 0300 ÷",
+    L"÷ 000A ÷ 0308 × 0300 ÷",
+    L"÷ 000A ÷ 0900 ÷",
+    L"÷ 000A ÷ 0308 × 0900 ÷",
+    L"÷ 000A ÷ 094D ÷",
+    L"÷ 000A ÷ 0308 × 094D ÷",
+    L"÷ 000A ÷ 200D ÷",
+    L"÷ 000A ÷ 0308 × 200D ÷",
+    L"÷ 000A ÷ 0378 ÷",
+    L"÷ 000A ÷ 0308 ÷ 0378 ÷",
+    L"÷ 0001 ÷ 0020 ÷",
+    L"÷ 0001 ÷ 0308 ÷ 0020 ÷",
+    L"÷ 0001 ÷ 000D ÷",
+    L"÷ 0001 ÷ 0308 ÷ 000D ÷",
+    L"÷ 0001 ÷ 000A ÷",
+    L"÷ 0001 ÷ 0308 ÷ 000A ÷",
+    L"÷ 0001 ÷ 0001 ÷",
+    L"÷ 0001 ÷ 0308 ÷ 0001 ÷",
+    L"÷ 0001 ÷ 200C ÷",
+    L"÷ 0001 ÷ 0308 × 200C ÷",
+    L"÷ 0001 ÷ 1F1E6 ÷",
+    L"÷ 0001 ÷ 0308 ÷ 1F1E6 ÷",
+    L"÷ 0001 ÷ 0600 ÷",
+    L"÷ 0001 ÷ 0308 ÷ 0600 ÷",
+    L"÷ 0001 ÷ 0A03 ÷",
+    L"÷ 0001 ÷ 1100 ÷",
+    L"÷ 0001 ÷ 0308 ÷ 1100 ÷",
+    L"÷ 0001 ÷ 1160 ÷",
+    L"÷ 0001 ÷ 0308 ÷ 1160 ÷",
+    L"÷ 0001 ÷ 11A8 ÷",
+    L"÷ 0001 ÷ 0308 ÷ 11A8 ÷",
+    L"÷ 0001 ÷ AC00 ÷",
+    L"÷ 0001 ÷ 0308 ÷ AC00 ÷",
+    L"÷ 0001 ÷ AC01 ÷",
+    L"÷ 0001 ÷ 0308 ÷ AC01 ÷",
+    L"÷ 0001 ÷ 0903 ÷",
+    L"÷ 0001 ÷ 0904 ÷",
+    L"÷ 0001 ÷ 0308 ÷ 0904 ÷",
+    L"÷ 0001 ÷ 0D4E ÷",
+    L"÷ 0001 ÷ 0308 ÷ 0D4E ÷",
+    L"÷ 0001 ÷ 0915 ÷",
+    L"÷ 0001 ÷ 0308 ÷ 0915 ÷",
+    L"÷ 0001 ÷ 231A ÷",
+    L"÷ 0001 ÷ 0308 ÷ 231A ÷",
+    L"÷ 0001 ÷ 0300 ÷",
+    L"÷ 0001 ÷ 0308 × 0300 ÷",
+    L"÷ 0001 ÷ 0900 ÷",
+    L"÷ 0001 ÷ 0308 × 0900 ÷",
+    L"÷ 0001 ÷ 094D ÷",
+    L"÷ 0001 ÷ 0308 × 094D ÷",
+    L"÷ 0001 ÷ 200D ÷",
+    L"÷ 0001 ÷ 0308 × 200D ÷",
+    L"÷ 0001 ÷ 0378 ÷",
+    L"÷ 0001 ÷ 0308 ÷ 0378 ÷",
+    L"÷ 200C ÷ 0020 ÷",
+    L"÷ 200C × 0308 ÷ 0020 ÷",
+    L"÷ 200C ÷ 000D ÷",
+    L"÷ 200C × 0308 ÷ 000D ÷",
+    L"÷ 200C ÷ 000A ÷",
+    L"÷ 200C × 0308 ÷ 000A ÷",
+    L"÷ 200C ÷ 0001 ÷",
+    L"÷ 200C × 0308 ÷ 0001 ÷",
+    L"÷ 200C × 200C ÷",
+    L"÷ 200C × 0308 × 200C ÷",
+    L"÷ 200C ÷ 1F1E6 ÷",
+    L"÷ 200C × 0308 ÷ 1F1E6 ÷",
+    L"÷ 200C ÷ 0600 ÷",
+    L"÷ 200C × 0308 ÷ 0600 ÷",
+    L"÷ 200C ÷ 1100 ÷",
+    L"÷ 200C × 0308 ÷ 1100 ÷",
+    L"÷ 200C ÷ 1160 ÷",
+    L"÷ 200C × 0308 ÷ 1160 ÷",
+    L"÷ 200C ÷ 11A8 ÷",
+    L"÷ 200C × 0308 ÷ 11A8 ÷",
+    L"÷ 200C ÷ AC00 ÷",
+    L"÷ 200C × 0308 ÷ AC00 ÷",
+    L"÷ 200C ÷ AC01 ÷",
+    L"÷ 200C × 0308 ÷ AC01 ÷",
+    L"÷ 200C ÷ 0904 ÷",
+    L"÷ 200C × 0308 ÷ 0904 ÷",
+    L"÷ 200C ÷ 0D4E ÷",
+    L"÷ 200C × 0308 ÷ 0D4E ÷",
+    L"÷ 200C ÷ 0915 ÷",
+    L"÷ 200C × 0308 ÷ 0915 ÷",
+    L"÷ 200C ÷ 231A ÷",
+    L"÷ 200C × 0308 ÷ 231A ÷",
+    L"÷ 200C × 0300 ÷",
+    L"÷ 200C × 0308 × 0300 ÷",
+    L"÷ 200C × 0900 ÷",
+    L"÷ 200C × 0308 × 0900 ÷",
+    L"÷ 200C × 094D ÷",
+    L"÷ 200C × 0308 × 094D ÷",
+    L"÷ 200C × 200D ÷",
+    L"÷ 200C × 0308 × 200D ÷",
+    L"÷ 200C ÷ 0378 ÷",
+    L"÷ 200C × 0308 ÷ 0378 ÷",
+    L"÷ 1F1E6 ÷ 0020 ÷",
+    L"÷ 1F1E6 × 0308 ÷ 0020 ÷",
+    L"÷ 1F1E6 ÷ 000D ÷",
+    L"÷ 1F1E6 × 0308 ÷ 000D ÷",
+    L"÷ 1F1E6 ÷ 000A ÷",
+    L"÷ 1F1E6 × 0308 ÷ 000A ÷",
+    L"÷ 1F1E6 ÷ 0001 ÷",
+    L"÷ 1F1E6 × 0308 ÷ 0001 ÷",
+    L"÷ 1F1E6 × 200C ÷",
+    L"÷ 1F1E6 × 0308 × 200C ÷",
+    L"÷ 1F1E6 × 1F1E6 ÷",
+    L"÷ 1F1E6 × 0308 ÷ 1F1E6 ÷",
+    L"÷ 1F1E6 ÷ 0600 ÷",
+    L"÷ 1F1E6 × 0308 ÷ 0600 ÷",
+    L"÷ 1F1E6 ÷ 1100 ÷",
+    L"÷ 1F1E6 × 0308 ÷ 1100 ÷",
+    L"÷ 1F1E6 ÷ 1160 ÷",
+    L"÷ 1F1E6 × 0308 ÷ 1160 ÷",
+    L"÷ 1F1E6 ÷ 11A8 ÷",
+    L"÷ 1F1E6 × 0308 ÷ 11A8 ÷",
+    L"÷ 1F1E6 ÷ AC00 ÷",
+    L"÷ 1F1E6 × 0308 ÷ AC00 ÷",
+    L"÷ 1F1E6 ÷ AC01 ÷",
+    L"÷ 1F1E6 × 0308 ÷ AC01 ÷",
+    L"÷ 1F1E6 ÷ 0904 ÷",
+    L"÷ 1F1E6 × 0308 ÷ 0904 ÷",
+    L"÷ 1F1E6 ÷ 0D4E ÷",
+    L"÷ 1F1E6 × 0308 ÷ 0D4E ÷",
+    L"÷ 1F1E6 ÷ 0915 ÷",
+    L"÷ 1F1E6 × 0308 ÷ 0915 ÷",
+    L"÷ 1F1E6 ÷ 231A ÷",
+    L"÷ 1F1E6 × 0308 ÷ 231A ÷",
+    L"÷ 1F1E6 × 0300 ÷",
+    L"÷ 1F1E6 × 0308 × 0300 ÷",
+    L"÷ 1F1E6 × 0900 ÷",
+    L"÷ 1F1E6 × 0308 × 0900 ÷",
+    L"÷ 1F1E6 × 094D ÷",
+    L"÷ 1F1E6 × 0308 × 094D ÷",
+    L"÷ 1F1E6 × 200D ÷",
+    L"÷ 1F1E6 × 0308 × 200D ÷",
+    L"÷ 1F1E6 ÷ 0378 ÷",
+    L"÷ 1F1E6 × 0308 ÷ 0378 ÷",
+    L"÷ 0600 × 0308 ÷ 0020 ÷",
+    L"÷ 0600 ÷ 000D ÷",
+    L"÷ 0600 × 0308 ÷ 000D ÷",
+    L"÷ 0600 ÷ 000A ÷",
+    L"÷ 0600 × 0308 ÷ 000A ÷",
+    L"÷ 0600 ÷ 0001 ÷",
+    L"÷ 0600 × 0308 ÷ 0001 ÷",
+    L"÷ 0600 × 200C ÷",
+    L"÷ 0600 × 0308 × 200C ÷",
+    L"÷ 0600 × 0308 ÷ 1F1E6 ÷",
+    L"÷ 0600 × 0308 ÷ 0600 ÷",
+    L"÷ 0600 × 0308 ÷ 1100 ÷",
+    L"÷ 0600 × 0308 ÷ 1160 ÷",
+    L"÷ 0600 × 0308 ÷ 11A8 ÷",
+    L"÷ 0600 × 0308 ÷ AC00 ÷",
+    L"÷ 0600 × 0308 ÷ AC01 ÷",
+    L"÷ 0600 × 0308 ÷ 0904 ÷",
+    L"÷ 0600 × 0308 ÷ 0D4E ÷",
+    L"÷ 0600 × 0308 ÷ 0915 ÷",
+    L"÷ 0600 × 0308 ÷ 231A ÷",
+    L"÷ 0600 × 0300 ÷",
+    L"÷ 0600 × 0308 × 0300 ÷",
+    L"÷ 0600 × 0900 ÷",
+    L"÷ 0600 × 0308 × 0900 ÷",
+    L"÷ 0600 × 094D ÷",
+    L"÷ 0600 × 0308 × 094D ÷",
+    L"÷ 0600 × 200D ÷",
+    L"÷ 0600 × 0308 × 200D ÷",
+    L"÷ 0600 × 0308 ÷ 0378 ÷",
+    L"÷ 0A03 ÷ 0020 ÷",
+    L"÷ 0A03 × 0308 ÷ 0020 ÷",
+    L"÷ 0A03 ÷ 000D ÷",
+    L"÷ 0A03 × 0308 ÷ 000D ÷",
+    L"÷ 0A03 ÷ 000A ÷",
+    L"÷ 0A03 × 0308 ÷ 000A ÷",
+    L"÷ 0A03 ÷ 0001 ÷",
+    L"÷ 0A03 × 0308 ÷ 0001 ÷",
+    L"÷ 0A03 × 200C ÷",
+    L"÷ 0A03 × 0308 × 200C ÷",
+    L"÷ 0A03 ÷ 1F1E6 ÷",
+    L"÷ 0A03 × 0308 ÷ 1F1E6 ÷",
+    L"÷ 0A03 ÷ 0600 ÷",
+    L"÷ 0A03 × 0308 ÷ 0600 ÷",
+    L"÷ 0A03 ÷ 1100 ÷",
+    L"÷ 0A03 × 0308 ÷ 1100 ÷",
+    L"÷ 0A03 ÷ 1160 ÷",
+    L"÷ 0A03 × 0308 ÷ 1160 ÷",
+    L"÷ 0A03 ÷ 11A8 ÷",
+    L"÷ 0A03 × 0308 ÷ 11A8 ÷",
+    L"÷ 0A03 ÷ AC00 ÷",
+    L"÷ 0A03 × 0308 ÷ AC00 ÷",
+    L"÷ 0A03 ÷ AC01 ÷",
+    L"÷ 0A03 × 0308 ÷ AC01 ÷",
+    L"÷ 0A03 ÷ 0904 ÷",
+    L"÷ 0A03 × 0308 ÷ 0904 ÷",
+    L"÷ 0A03 ÷ 0D4E ÷",
+    L"÷ 0A03 × 0308 ÷ 0D4E ÷",
+    L"÷ 0A03 ÷ 0915 ÷",
+    L"÷ 0A03 × 0308 ÷ 0915 ÷",
+    L"÷ 0A03 ÷ 231A ÷",
+    L"÷ 0A03 × 0308 ÷ 231A ÷",
+    L"÷ 0A03 × 0300 ÷",
+    L"÷ 0A03 × 0308 × 0300 ÷",
+    L"÷ 0A03 × 0900 ÷",
+    L"÷ 0A03 × 0308 × 0900 ÷",
+    L"÷ 0A03 × 094D ÷",
+    L"÷ 0A03 × 0308 × 094D ÷",
+    L"÷ 0A03 × 200D ÷",
+    L"÷ 0A03 × 0308 × 200D ÷",
+    L"÷ 0A03 ÷ 0378 ÷",
+    L"÷ 0A03 × 0308 ÷ 0378 ÷",
+    L"÷ 1100 ÷ 0020 ÷",
+    L"÷ 1100 × 0308 ÷ 0020 ÷",
+    L"÷ 1100 ÷ 000D ÷",
+    L"÷ 1100 × 0308 ÷ 000D ÷",
+    L"÷ 1100 ÷ 000A ÷",
+    L"÷ 1100 × 0308 ÷ 000A ÷",
+    L"÷ 1100 ÷ 0001 ÷",
+    L"÷ 1100 × 0308 ÷ 0001 ÷",
+    L"÷ 1100 × 200C ÷",
+    L"÷ 1100 × 0308 × 200C ÷",
+    L"÷ 1100 ÷ 1F1E6 ÷",
+    L"÷ 1100 × 0308 ÷ 1F1E6 ÷",
+    L"÷ 1100 ÷ 0600 ÷",
+    L"÷ 1100 × 0308 ÷ 0600 ÷",
+    L"÷ 1100 × 1100 ÷",
+    L"÷ 1100 × 0308 ÷ 1100 ÷",
+    L"÷ 1100 × 1160 ÷",
+    L"÷ 1100 × 0308 ÷ 1160 ÷",
+    L"÷ 1100 ÷ 11A8 ÷",
+    L"÷ 1100 × 0308 ÷ 11A8 ÷",
+    L"÷ 1100 × AC00 ÷",
+    L"÷ 1100 × 0308 ÷ AC00 ÷",
+    L"÷ 1100 × AC01 ÷",
+    L"÷ 1100 × 0308 ÷ AC01 ÷",
+    L"÷ 1100 ÷ 0904 ÷",
+    L"÷ 1100 × 0308 ÷ 0904 ÷",
+    L"÷ 1100 ÷ 0D4E ÷",
+    L"÷ 1100 × 0308 ÷ 0D4E ÷",
+    L"÷ 1100 ÷ 0915 ÷",
+    L"÷ 1100 × 0308 ÷ 0915 ÷",
+    L"÷ 1100 ÷ 231A ÷",
+    L"÷ 1100 × 0308 ÷ 231A ÷",
+    L"÷ 1100 × 0300 ÷",
+    L"÷ 1100 × 0308 × 0300 ÷",
+    L"÷ 1100 × 0900 ÷",
+    L"÷ 1100 × 0308 × 0900 ÷",
+    L"÷ 1100 × 094D ÷",
+    L"÷ 1100 × 0308 × 094D ÷",
+    L"÷ 1100 × 200D ÷",
+    L"÷ 1100 × 0308 × 200D ÷",
+    L"÷ 1100 ÷ 0378 ÷",
+    L"÷ 1100 × 0308 ÷ 0378 ÷",
+    L"÷ 1160 ÷ 0020 ÷",
+    L"÷ 1160 × 0308 ÷ 0020 ÷",
+    L"÷ 1160 ÷ 000D ÷",
+    L"÷ 1160 × 0308 ÷ 000D ÷",
+    L"÷ 1160 ÷ 000A ÷",
+    L"÷ 1160 × 0308 ÷ 000A ÷",
+    L"÷ 1160 ÷ 0001 ÷",
+    L"÷ 1160 × 0308 ÷ 0001 ÷",
+    L"÷ 1160 × 200C ÷",
+    L"÷ 1160 × 0308 × 200C ÷",
+    L"÷ 1160 ÷ 1F1E6 ÷",
+    L"÷ 1160 × 0308 ÷ 1F1E6 ÷",
+    L"÷ 1160 ÷ 0600 ÷",
+    L"÷ 1160 × 0308 ÷ 0600 ÷",
+    L"÷ 1160 ÷ 1100 ÷",
+    L"÷ 1160 × 0308 ÷ 1100 ÷",
+    L"÷ 1160 × 1160 ÷",
+    L"÷ 1160 × 0308 ÷ 1160 ÷",
+    L"÷ 1160 × 11A8 ÷",
+    L"÷ 1160 × 0308 ÷ 11A8 ÷",
+    L"÷ 1160 ÷ AC00 ÷",
+    L"÷ 1160 × 0308 ÷ AC00 ÷",
+    L"÷ 1160 ÷ AC01 ÷",
+    L"÷ 1160 × 0308 ÷ AC01 ÷",
+    L"÷ 1160 ÷ 0904 ÷",
+    L"÷ 1160 × 0308 ÷ 0904 ÷",
+    L"÷ 1160 ÷ 0D4E ÷",
+    L"÷ 1160 × 0308 ÷ 0D4E ÷",
+    L"÷ 1160 ÷ 0915 ÷",
+    L"÷ 1160 × 0308 ÷ 0915 ÷",
+    L"÷ 1160 ÷ 231A ÷",
+    L"÷ 1160 × 0308 ÷ 231A ÷",
+    L"÷ 1160 × 0300 ÷",
+    L"÷ 1160 × 0308 × 0300 ÷",
+    L"÷ 1160 × 0900 ÷",
+    L"÷ 1160 × 0308 × 0900 ÷",
+    L"÷ 1160 × 094D ÷",
+    L"÷ 1160 × 0308 × 094D ÷",
+    L"÷ 1160 × 200D ÷",
+    L"÷ 1160 × 0308 × 200D ÷",
+    L"÷ 1160 ÷ 0378 ÷",
+    L"÷ 1160 × 0308 ÷ 0378 ÷",
+    L"÷ 11A8 ÷ 0020 ÷",
+    L"÷ 11A8 × 0308 ÷ 0020 ÷",
+    L"÷ 11A8 ÷ 000D ÷",
+    L"÷ 11A8 × 0308 ÷ 000D ÷",
+    L"÷ 11A8 ÷ 000A ÷",
+    L"÷ 11A8 × 0308 ÷ 000A ÷",
+    L"÷ 11A8 ÷ 0001 ÷",
+    L"÷ 11A8 × 0308 ÷ 0001 ÷",
+    L"÷ 11A8 × 200C ÷",
+    L"÷ 11A8 × 0308 × 200C ÷",
+    L"÷ 11A8 ÷ 1F1E6 ÷",
+    L"÷ 11A8 × 0308 ÷ 1F1E6 ÷",
+    L"÷ 11A8 ÷ 0600 ÷",
+    L"÷ 11A8 × 0308 ÷ 0600 ÷",
+    L"÷ 11A8 ÷ 1100 ÷",
+    L"÷ 11A8 × 0308 ÷ 1100 ÷",
+    L"÷ 11A8 ÷ 1160 ÷",
+    L"÷ 11A8 × 0308 ÷ 1160 ÷",
+    L"÷ 11A8 × 11A8 ÷",
+    L"÷ 11A8 × 0308 ÷ 11A8 ÷",
+    L"÷ 11A8 ÷ AC00 ÷",
+    L"÷ 11A8 × 0308 ÷ AC00 ÷",
+    L"÷ 11A8 ÷ AC01 ÷",
+    L"÷ 11A8 × 0308 ÷ AC01 ÷",
+    L"÷ 11A8 ÷ 0904 ÷",
+    L"÷ 11A8 × 0308 ÷ 0904 ÷",
+    L"÷ 11A8 ÷ 0D4E ÷",
+    L"÷ 11A8 × 0308 ÷ 0D4E ÷",
+    L"÷ 11A8 ÷ 0915 ÷",
+    L"÷ 11A8 × 0308 ÷ 0915 ÷",
+    L"÷ 11A8 ÷ 231A ÷",
+    L"÷ 11A8 × 0308 ÷ 231A ÷",
+    L"÷ 11A8 × 0300 ÷",
+    L"÷ 11A8 × 0308 × 0300 ÷",
+    L"÷ 11A8 × 0900 ÷",
+    L"÷ 11A8 × 0308 × 0900 ÷",
+    L"÷ 11A8 × 094D ÷",
+    L"÷ 11A8 × 0308 × 094D ÷",
+    L"÷ 11A8 × 200D ÷",
+    L"÷ 11A8 × 0308 × 200D ÷",
+    L"÷ 11A8 ÷ 0378 ÷",
+    L"÷ 11A8 × 0308 ÷ 0378 ÷",
+    L"÷ AC00 ÷ 0020 ÷",
+    L"÷ AC00 × 0308 ÷ 0020 ÷",
+    L"÷ AC00 ÷ 000D ÷",
+    L"÷ AC00 × 0308 ÷ 000D ÷",
+    L"÷ AC00 ÷ 000A ÷",
+    L"÷ AC00 × 0308 ÷ 000A ÷",
+    L"÷ AC00 ÷ 0001 ÷",
+    L"÷ AC00 × 0308 ÷ 0001 ÷",
+    L"÷ AC00 × 200C ÷",
+    L"÷ AC00 × 0308 × 200C ÷",
+    L"÷ AC00 ÷ 1F1E6 ÷",
+    L"÷ AC00 × 0308 ÷ 1F1E6 ÷",
+    L"÷ AC00 ÷ 0600 ÷",
+    L"÷ AC00 × 0308 ÷ 0600 ÷",
+    L"÷ AC00 ÷ 1100 ÷",
+    L"÷ AC00 × 0308 ÷ 1100 ÷",
+    L"÷ AC00 × 1160 ÷",
+    L"÷ AC00 × 0308 ÷ 1160 ÷",
+    L"÷ AC00 × 11A8 ÷",
+    L"÷ AC00 × 0308 ÷ 11A8 ÷",
+    L"÷ AC00 ÷ AC00 ÷",
+    L"÷ AC00 × 0308 ÷ AC00 ÷",
+    L"÷ AC00 ÷ AC01 ÷",
+    L"÷ AC00 × 0308 ÷ AC01 ÷",
+    L"÷ AC00 ÷ 0904 ÷",
+    L"÷ AC00 × 0308 ÷ 0904 ÷",
+    L"÷ AC00 ÷ 0D4E ÷",
+    L"÷ AC00 × 0308 ÷ 0D4E ÷",
+    L"÷ AC00 ÷ 0915 ÷",
+    L"÷ AC00 × 0308 ÷ 0915 ÷",
+    L"÷ AC00 ÷ 231A ÷",
+    L"÷ AC00 × 0308 ÷ 231A ÷",
+    L"÷ AC00 × 0300 ÷",
+    L"÷ AC00 × 0308 × 0300 ÷",
+    L"÷ AC00 × 0900 ÷",
+    L"÷ AC00 × 0308 × 0900 ÷",
+    L"÷ AC00 × 094D ÷",
+    L"÷ AC00 × 0308 × 094D ÷",
+    L"÷ AC00 × 200D ÷",
+    L"÷ AC00 × 0308 × 200D ÷",
+    L"÷ AC00 ÷ 0378 ÷",
+    L"÷ AC00 × 0308 ÷ 0378 ÷",
+    L"÷ AC01 ÷ 0020 ÷",
+    L"÷ AC01 × 0308 ÷ 0020 ÷",
+    L"÷ AC01 ÷ 000D ÷",
+    L"÷ AC01 × 0308 ÷ 000D ÷",
+    L"÷ AC01 ÷ 000A ÷",
+    L"÷ AC01 × 0308 ÷ 000A ÷",
+    L"÷ AC01 ÷ 0001 ÷",
+    L"÷ AC01 × 0308 ÷ 0001 ÷",
+    L"÷ AC01 × 200C ÷",
+    L"÷ AC01 × 0308 × 200C ÷",
+    L"÷ AC01 ÷ 1F1E6 ÷",
+    L"÷ AC01 × 0308 ÷ 1F1E6 ÷",
+    L"÷ AC01 ÷ 0600 ÷",
+    L"÷ AC01 × 0308 ÷ 0600 ÷",
+    L"÷ AC01 ÷ 1100 ÷",
+    L"÷ AC01 × 0308 ÷ 1100 ÷",
+    L"÷ AC01 ÷ 1160 ÷",
+    L"÷ AC01 × 0308 ÷ 1160 ÷",
+    L"÷ AC01 × 11A8 ÷",
+    L"÷ AC01 × 0308 ÷ 11A8 ÷",
+    L"÷ AC01 ÷ AC00 ÷",
+    L"÷ AC01 × 0308 ÷ AC00 ÷",
+    L"÷ AC01 ÷ AC01 ÷",
+    L"÷ AC01 × 0308 ÷ AC01 ÷",
+    L"÷ AC01 ÷ 0904 ÷",
+    L"÷ AC01 × 0308 ÷ 0904 ÷",
+    L"÷ AC01 ÷ 0D4E ÷",
+    L"÷ AC01 × 0308 ÷ 0D4E ÷",
+    L"÷ AC01 ÷ 0915 ÷",
+    L"÷ AC01 × 0308 ÷ 0915 ÷",
+    L"÷ AC01 ÷ 231A ÷",
+    L"÷ AC01 × 0308 ÷ 231A ÷",
+    L"÷ AC01 × 0300 ÷",
+    L"÷ AC01 × 0308 × 0300 ÷",
+    L"÷ AC01 × 0900 ÷",
+    L"÷ AC01 × 0308 × 0900 ÷",
+    L"÷ AC01 × 094D ÷",
+    L"÷ AC01 × 0308 × 094D ÷",
+    L"÷ AC01 × 200D ÷",
+    L"÷ AC01 × 0308 × 200D ÷",
+    L"÷ AC01 ÷ 0378 ÷",
+    L"÷ AC01 × 0308 ÷ 0378 ÷",
+    L"÷ 0903 ÷ 0020 ÷",
+    L"÷ 0903 × 0308 ÷ 0020 ÷",
+    L"÷ 0903 ÷ 000D ÷",
+    L"÷ 0903 × 0308 ÷ 000D ÷",
+    L"÷ 0903 ÷ 000A ÷",
+    L"÷ 0903 × 0308 ÷ 000A ÷",
+    L"÷ 0903 ÷ 0001 ÷",
+    L"÷ 0903 × 0308 ÷ 0001 ÷",
+    L"÷ 0903 × 200C ÷",
+    L"÷ 0903 × 0308 × 200C ÷",
+    L"÷ 0903 ÷ 1F1E6 ÷",
+    L"÷ 0903 × 0308 ÷ 1F1E6 ÷",
+    L"÷ 0903 ÷ 0600 ÷",
+    L"÷ 0903 × 0308 ÷ 0600 ÷",
+    L"÷ 0903 ÷ 1100 ÷",
+    L"÷ 0903 × 0308 ÷ 1100 ÷",
+    L"÷ 0903 ÷ 1160 ÷",
+    L"÷ 0903 × 0308 ÷ 1160 ÷",
+    L"÷ 0903 ÷ 11A8 ÷",
+    L"÷ 0903 × 0308 ÷ 11A8 ÷",
+    L"÷ 0903 ÷ AC00 ÷",
+    L"÷ 0903 × 0308 ÷ AC00 ÷",
+    L"÷ 0903 ÷ AC01 ÷",
+    L"÷ 0903 × 0308 ÷ AC01 ÷",
+    L"÷ 0903 ÷ 0904 ÷",
+    L"÷ 0903 × 0308 ÷ 0904 ÷",
+    L"÷ 0903 ÷ 0D4E ÷",
+    L"÷ 0903 × 0308 ÷ 0D4E ÷",
+    L"÷ 0903 ÷ 0915 ÷",
+    L"÷ 0903 × 0308 ÷ 0915 ÷",
+    L"÷ 0903 ÷ 231A ÷",
+    L"÷ 0903 × 0308 ÷ 231A ÷",
+    L"÷ 0903 × 0300 ÷",
+    L"÷ 0903 × 0308 × 0300 ÷",
+    L"÷ 0903 × 0900 ÷",
+    L"÷ 0903 × 0308 × 0900 ÷",
+    L"÷ 0903 × 094D ÷",
+    L"÷ 0903 × 0308 × 094D ÷",
+    L"÷ 0903 × 200D ÷",
+    L"÷ 0903 × 0308 × 200D ÷",
+    L"÷ 0903 ÷ 0378 ÷",
+    L"÷ 0903 × 0308 ÷ 0378 ÷",
+    L"÷ 0904 ÷ 0020 ÷",
+    L"÷ 0904 × 0308 ÷ 0020 ÷",
+    L"÷ 0904 ÷ 000D ÷",
+    L"÷ 0904 × 0308 ÷ 000D ÷",
+    L"÷ 0904 ÷ 000A ÷",
+    L"÷ 0904 × 0308 ÷ 000A ÷",
+    L"÷ 0904 ÷ 0001 ÷",
+    L"÷ 0904 × 0308 ÷ 0001 ÷",
+    L"÷ 0904 × 200C ÷",
+    L"÷ 0904 × 0308 × 200C ÷",
+    L"÷ 0904 ÷ 1F1E6 ÷",
+    L"÷ 0904 × 0308 ÷ 1F1E6 ÷",
+    L"÷ 0904 ÷ 0600 ÷",
+    L"÷ 0904 × 0308 ÷ 0600 ÷",
+    L"÷ 0904 ÷ 1100 ÷",
+    L"÷ 0904 × 0308 ÷ 1100 ÷",
+    L"÷ 0904 ÷ 1160 ÷",
+    L"÷ 0904 × 0308 ÷ 1160 ÷",
+    L"÷ 0904 ÷ 11A8 ÷",
+    L"÷ 0904 × 0308 ÷ 11A8 ÷",
+    L"÷ 0904 ÷ AC00 ÷",
+    L"÷ 0904 × 0308 ÷ AC00 ÷",
+    L"÷ 0904 ÷ AC01 ÷",
+    L"÷ 0904 × 0308 ÷ AC01 ÷",
+    L"÷ 0904 ÷ 0904 ÷",
+    L"÷ 0904 × 0308 ÷ 0904 ÷",
+    L"÷ 0904 ÷ 0D4E ÷",
+    L"÷ 0904 × 0308 ÷ 0D4E ÷",
+    L"÷ 0904 ÷ 0915 ÷",
+    L"÷ 0904 × 0308 ÷ 0915 ÷",
+    L"÷ 0904 ÷ 231A ÷",
+    L"÷ 0904 × 0308 ÷ 231A ÷",
+    L"÷ 0904 × 0300 ÷",
+    L"÷ 0904 × 0308 × 0300 ÷",
+    L"÷ 0904 × 0900 ÷",
+    L"÷ 0904 × 0308 × 0900 ÷",
+    L"÷ 0904 × 094D ÷",
+    L"÷ 0904 × 0308 × 094D ÷",
+    L"÷ 0904 × 200D ÷",
+    L"÷ 0904 × 0308 × 200D ÷",
+    L"÷ 0904 ÷ 0378 ÷",
+    L"÷ 0904 × 0308 ÷ 0378 ÷",
+    L"÷ 0D4E × 0308 ÷ 0020 ÷",
+    L"÷ 0D4E ÷ 000D ÷",
+    L"÷ 0D4E × 0308 ÷ 000D ÷",
+    L"÷ 0D4E ÷ 000A ÷",
+    L"÷ 0D4E × 0308 ÷ 000A ÷",
+    L"÷ 0D4E ÷ 0001 ÷",
+    L"÷ 0D4E × 0308 ÷ 0001 ÷",
+    L"÷ 0D4E × 200C ÷",
+    L"÷ 0D4E × 0308 × 200C ÷",
+    L"÷ 0D4E × 0308 ÷ 1F1E6 ÷",
+    L"÷ 0D4E × 0308 ÷ 0600 ÷",
+    L"÷ 0D4E × 0308 ÷ 1100 ÷",
+    L"÷ 0D4E × 0308 ÷ 1160 ÷",
+    L"÷ 0D4E × 0308 ÷ 11A8 ÷",
+    L"÷ 0D4E × 0308 ÷ AC00 ÷",
+    L"÷ 0D4E × 0308 ÷ AC01 ÷",
+    L"÷ 0D4E × 0308 ÷ 0904 ÷",
+    L"÷ 0D4E × 0308 ÷ 0D4E ÷",
+    L"÷ 0D4E × 0308 ÷ 0915 ÷",
+    L"÷ 0D4E × 0308 ÷ 231A ÷",
+    L"÷ 0D4E × 0300 ÷",
+    L"÷ 0D4E × 0308 × 0300 ÷",
+    L"÷ 0D4E × 0900 ÷",
+    L"÷ 0D4E × 0308 × 0900 ÷",
+    L"÷ 0D4E × 094D ÷",
+    L"÷ 0D4E × 0308 × 094D ÷",
+    L"÷ 0D4E × 200D ÷",
+    L"÷ 0D4E × 0308 × 200D ÷",
+    L"÷ 0D4E × 0308 ÷ 0378 ÷",
+    L"÷ 0915 ÷ 0020 ÷",
+    L"÷ 0915 × 0308 ÷ 0020 ÷",
+    L"÷ 0915 ÷ 000D ÷",
+    L"÷ 0915 × 0308 ÷ 000D ÷",
+    L"÷ 0915 ÷ 000A ÷",
+    L"÷ 0915 × 0308 ÷ 000A ÷",
+    L"÷ 0915 ÷ 0001 ÷",
+    L"÷ 0915 × 0308 ÷ 0001 ÷",
+    L"÷ 0915 × 200C ÷",
+    L"÷ 0915 × 0308 × 200C ÷",
+    L"÷ 0915 ÷ 1F1E6 ÷",
+    L"÷ 0915 × 0308 ÷ 1F1E6 ÷",
+    L"÷ 0915 ÷ 0600 ÷",
+    L"÷ 0915 × 0308 ÷ 0600 ÷",
+    L"÷ 0915 ÷ 1100 ÷",
+    L"÷ 0915 × 0308 ÷ 1100 ÷",
+    L"÷ 0915 ÷ 1160 ÷",
+    L"÷ 0915 × 0308 ÷ 1160 ÷",
+    L"÷ 0915 ÷ 11A8 ÷",
+    L"÷ 0915 × 0308 ÷ 11A8 ÷",
+    L"÷ 0915 ÷ AC00 ÷",
+    L"÷ 0915 × 0308 ÷ AC00 ÷",
+    L"÷ 0915 ÷ AC01 ÷",
+    L"÷ 0915 × 0308 ÷ AC01 ÷",
+    L"÷ 0915 ÷ 0904 ÷",
+    L"÷ 0915 × 0308 ÷ 0904 ÷",
+    L"÷ 0915 ÷ 0D4E ÷",
+    L"÷ 0915 × 0308 ÷ 0D4E ÷",
+    L"÷ 0915 ÷ 0915 ÷",
+    L"÷ 0915 × 0308 ÷ 0915 ÷",
+    L"÷ 0915 ÷ 231A ÷",
+    L"÷ 0915 × 0308 ÷ 231A ÷",
+    L"÷ 0915 × 0300 ÷",
+    L"÷ 0915 × 0308 × 0300 ÷",
+    L"÷ 0915 × 0900 ÷",
+    L"÷ 0915 × 0308 × 0900 ÷",
+    L"÷ 0915 × 094D ÷",
+    L"÷ 0915 × 0308 × 094D ÷",
+    L"÷ 0915 × 200D ÷",
+    L"÷ 0915 × 0308 × 200D ÷",
+    L"÷ 0915 ÷ 0378 ÷",
+    L"÷ 0915 × 0308 ÷ 0378 ÷",
+    L"÷ 231A ÷ 0020 ÷",
+    L"÷ 231A × 0308 ÷ 0020 ÷",
+    L"÷ 231A ÷ 000D ÷",
+    L"÷ 231A × 0308 ÷ 000D ÷",
+    L"÷ 231A ÷ 000A ÷",
+    L"÷ 231A × 0308 ÷ 000A ÷",
+    L"÷ 231A ÷ 0001 ÷",
+    L"÷ 231A × 0308 ÷ 0001 ÷",
+    L"÷ 231A × 200C ÷",
+    L"÷ 231A × 0308 × 200C ÷",
+    L"÷ 231A ÷ 1F1E6 ÷",
+    L"÷ 231A × 0308 ÷ 1F1E6 ÷",
+    L"÷ 231A ÷ 0600 ÷",
+    L"÷ 231A × 0308 ÷ 0600 ÷",
+    L"÷ 231A ÷ 1100 ÷",
+    L"÷ 231A × 0308 ÷ 1100 ÷",
+    L"÷ 231A ÷ 1160 ÷",
+    L"÷ 231A × 0308 ÷ 1160 ÷",
+    L"÷ 231A ÷ 11A8 ÷",
+    L"÷ 231A × 0308 ÷ 11A8 ÷",
+    L"÷ 231A ÷ AC00 ÷",
+    L"÷ 231A × 0308 ÷ AC00 ÷",
+    L"÷ 231A ÷ AC01 ÷",
+    L"÷ 231A × 0308 ÷ AC01 ÷",
+    L"÷ 231A ÷ 0904 ÷",
+    L"÷ 231A × 0308 ÷ 0904 ÷",
+    L"÷ 231A ÷ 0D4E ÷",
+    L"÷ 231A × 0308 ÷ 0D4E ÷",
+    L"÷ 231A ÷ 0915 ÷",
+    L"÷ 231A × 0308 ÷ 0915 ÷",
+    L"÷ 231A ÷ 231A ÷",
+    L"÷ 231A × 0308 ÷ 231A ÷",
+    L"÷ 231A × 0300 ÷",
+    L"÷ 231A × 0308 × 0300 ÷",
+    L"÷ 231A × 0900 ÷",
+    L"÷ 231A × 0308 × 0900 ÷",
+    L"÷ 231A × 094D ÷",
+    L"÷ 231A × 0308 × 094D ÷",
+    L"÷ 231A × 200D ÷",
+    L"÷ 231A × 0308 × 200D ÷",
+    L"÷ 231A ÷ 0378 ÷",
+    L"÷ 231A × 0308 ÷ 0378 ÷",
+    L"÷ 0300 ÷ 0020 ÷",
+    L"÷ 0300 × 0308 ÷ 0020 ÷",
+    L"÷ 0300 ÷ 000D ÷",
+    L"÷ 0300 × 0308 ÷ 000D ÷",
+    L"÷ 0300 ÷ 000A ÷",
+    L"÷ 0300 × 0308 ÷ 000A ÷",
+    L"÷ 0300 ÷ 0001 ÷",
+    L"÷ 0300 × 0308 ÷ 0001 ÷",
+    L"÷ 0300 × 200C ÷",
+    L"÷ 0300 × 0308 × 200C ÷",
+    L"÷ 0300 ÷ 1F1E6 ÷",
+    L"÷ 0300 × 0308 ÷ 1F1E6 ÷",
+    L"÷ 0300 ÷ 0600 ÷",
+    L"÷ 0300 × 0308 ÷ 0600 ÷",
+    L"÷ 0300 ÷ 1100 ÷",
+    L"÷ 0300 × 0308 ÷ 1100 ÷",
+    L"÷ 0300 ÷ 1160 ÷",
+    L"÷ 0300 × 0308 ÷ 1160 ÷",
+    L"÷ 0300 ÷ 11A8 ÷",
+    L"÷ 0300 × 0308 ÷ 11A8 ÷",
+    L"÷ 0300 ÷ AC00 ÷",
+    L"÷ 0300 × 0308 ÷ AC00 ÷",
+    L"÷ 0300 ÷ AC01 ÷",
+    L"÷ 0300 × 0308 ÷ AC01 ÷",
+    L"÷ 0300 ÷ 0904 ÷",
+    L"÷ 0300 × 0308 ÷ 0904 ÷",
+    L"÷ 0300 ÷ 0D4E ÷",
+    L"÷ 0300 × 0308 ÷ 0D4E ÷",
+    L"÷ 0300 ÷ 0915 ÷",
+    L"÷ 0300 × 0308 ÷ 0915 ÷",
+    L"÷ 0300 ÷ 231A ÷",
+    L"÷ 0300 × 0308 ÷ 231A ÷",
+    L"÷ 0300 × 0300 ÷",
+    L"÷ 0300 × 0308 × 0300 ÷",
+    L"÷ 0300 × 0900 ÷",
+    L"÷ 0300 × 0308 × 0900 ÷",
+    L"÷ 0300 × 094D ÷",
+    L"÷ 0300 × 0308 × 094D ÷",
+    L"÷ 0300 × 200D ÷",
+    L"÷ 0300 × 0308 × 200D ÷",
+    L"÷ 0300 ÷ 0378 ÷",
+    L"÷ 0300 × 0308 ÷ 0378 ÷",
+    L"÷ 0900 ÷ 0020 ÷",
+    L"÷ 0900 × 0308 ÷ 0020 ÷",
+    L"÷ 0900 ÷ 000D ÷",
+    L"÷ 0900 × 0308 ÷ 000D ÷",
+    L"÷ 0900 ÷ 000A ÷",
+    L"÷ 0900 × 0308 ÷ 000A ÷",
+    L"÷ 0900 ÷ 0001 ÷",
+    L"÷ 0900 × 0308 ÷ 0001 ÷",
+    L"÷ 0900 × 200C ÷",
+    L"÷ 0900 × 0308 × 200C ÷",
+    L"÷ 0900 ÷ 1F1E6 ÷",
+    L"÷ 0900 × 0308 ÷ 1F1E6 ÷",
+    L"÷ 0900 ÷ 0600 ÷",
+    L"÷ 0900 × 0308 ÷ 0600 ÷",
+    L"÷ 0900 ÷ 1100 ÷",
+    L"÷ 0900 × 0308 ÷ 1100 ÷",
+    L"÷ 0900 ÷ 1160 ÷",
+    L"÷ 0900 × 0308 ÷ 1160 ÷",
+    L"÷ 0900 ÷ 11A8 ÷",
+    L"÷ 0900 × 0308 ÷ 11A8 ÷",
+    L"÷ 0900 ÷ AC00 ÷",
+    L"÷ 0900 × 0308 ÷ AC00 ÷",
+    L"÷ 0900 ÷ AC01 ÷",
+    L"÷ 0900 × 0308 ÷ AC01 ÷",
+    L"÷ 0900 ÷ 0904 ÷",
+    L"÷ 0900 × 0308 ÷ 0904 ÷",
+    L"÷ 0900 ÷ 0D4E ÷",
+    L"÷ 0900 × 0308 ÷ 0D4E ÷",
+    L"÷ 0900 ÷ 0915 ÷",
+    L"÷ 0900 × 0308 ÷ 0915 ÷",
+    L"÷ 0900 ÷ 231A ÷",
+    L"÷ 0900 × 0308 ÷ 231A ÷",
+    L"÷ 0900 × 0300 ÷",
+    L"÷ 0900 × 0308 × 0300 ÷",
+    L"÷ 0900 × 0900 ÷",
+    L"÷ 0900 × 0308 × 0900 ÷",
+    L"÷ 0900 × 094D ÷",
+    L"÷ 0900 × 0308 × 094D ÷",
+    L"÷ 0900 × 200D ÷",
+    L"÷ 0900 × 0308 × 200D ÷",
+    L"÷ 0900 ÷ 0378 ÷",
+    L"÷ 0900 × 0308 ÷ 0378 ÷",
+    L"÷ 094D ÷ 0020 ÷",
+    L"÷ 094D × 0308 ÷ 0020 ÷",
+    L"÷ 094D ÷ 000D ÷",
+    L"÷ 094D × 0308 ÷ 000D ÷",
+    L"÷ 094D ÷ 000A ÷",
+    L"÷ 094D × 0308 ÷ 000A ÷",
+    L"÷ 094D ÷ 0001 ÷",
+    L"÷ 094D × 0308 ÷ 0001 ÷",
+    L"÷ 094D × 200C ÷",
+    L"÷ 094D × 0308 × 200C ÷",
+    L"÷ 094D ÷ 1F1E6 ÷",
+    L"÷ 094D × 0308 ÷ 1F1E6 ÷",
+    L"÷ 094D ÷ 0600 ÷",
+    L"÷ 094D × 0308 ÷ 0600 ÷",
+    L"÷ 094D ÷ 1100 ÷",
+    L"÷ 094D × 0308 ÷ 1100 ÷",
+    L"÷ 094D ÷ 1160 ÷",
+    L"÷ 094D × 0308 ÷ 1160 ÷",
+    L"÷ 094D ÷ 11A8 ÷",
+    L"÷ 094D × 0308 ÷ 11A8 ÷",
+    L"÷ 094D ÷ AC00 ÷",
+    L"÷ 094D × 0308 ÷ AC00 ÷",
+    L"÷ 094D ÷ AC01 ÷",
+    L"÷ 094D × 0308 ÷ AC01 ÷",
+    L"÷ 094D ÷ 0904 ÷",
+    L"÷ 094D × 0308 ÷ 0904 ÷",
+    L"÷ 094D ÷ 0D4E ÷",
+    L"÷ 094D × 0308 ÷ 0D4E ÷",
+    L"÷ 094D ÷ 0915 ÷",
+    L"÷ 094D × 0308 ÷ 0915 ÷",
+    L"÷ 094D ÷ 231A ÷",
+    L"÷ 094D × 0308 ÷ 231A ÷",
+    L"÷ 094D × 0300 ÷",
+    L"÷ 094D × 0308 × 0300 ÷",
+    L"÷ 094D × 0900 ÷",
+    L"÷ 094D × 0308 × 0900 ÷",
+    L"÷ 094D × 094D ÷",
+    L"÷ 094D × 0308 × 094D ÷",
+    L"÷ 094D × 200D ÷",
+    L"÷ 094D × 0308 × 200D ÷",
+    L"÷ 094D ÷ 0378 ÷",
+    L"÷ 094D × 0308 ÷ 0378 ÷",
+    L"÷ 200D ÷ 0020 ÷",
+    L"÷ 200D × 0308 ÷ 0020 ÷",
+    L"÷ 200D ÷ 000D ÷",
+    L"÷ 200D × 0308 ÷ 000D ÷",
+    L"÷ 200D ÷ 000A ÷",
+    L"÷ 200D × 0308 ÷ 000A ÷",
+    L"÷ 200D ÷ 0001 ÷",
+    L"÷ 200D × 0308 ÷ 0001 ÷",
+    L"÷ 200D × 200C ÷",
+    L"÷ 200D × 0308 × 200C ÷",
+    L"÷ 200D ÷ 1F1E6 ÷",
+    L"÷ 200D × 0308 ÷ 1F1E6 ÷",
+    L"÷ 200D ÷ 0600 ÷",
+    L"÷ 200D × 0308 ÷ 0600 ÷",
+    L"÷ 200D ÷ 1100 ÷",
+    L"÷ 200D × 0308 ÷ 1100 ÷",
+    L"÷ 200D ÷ 1160 ÷",
+    L"÷ 200D × 0308 ÷ 1160 ÷",
+    L"÷ 200D ÷ 11A8 ÷",
+    L"÷ 200D × 0308 ÷ 11A8 ÷",
+    L"÷ 200D ÷ AC00 ÷",
+    L"÷ 200D × 0308 ÷ AC00 ÷",
+    L"÷ 200D ÷ AC01 ÷",
+    L"÷ 200D × 0308 ÷ AC01 ÷",
+    L"÷ 200D ÷ 0904 ÷",
+    L"÷ 200D × 0308 ÷ 0904 ÷",
+    L"÷ 200D ÷ 0D4E ÷",
+    L"÷ 200D × 0308 ÷ 0D4E ÷",
+    L"÷ 200D ÷ 0915 ÷",
+    L"÷ 200D × 0308 ÷ 0915 ÷",
+    L"÷ 200D ÷ 231A ÷",
+    L"÷ 200D × 0308 ÷ 231A ÷",
+    L"÷ 200D × 0300 ÷",
+    L"÷ 200D × 0308 × 0300 ÷",
+    L"÷ 200D × 0900 ÷",
+    L"÷ 200D × 0308 × 0900 ÷",
+    L"÷ 200D × 094D ÷",
+    L"÷ 200D × 0308 × 094D ÷",
+    L"÷ 200D × 200D ÷",
+    L"÷ 200D × 0308 × 200D ÷",
+    L"÷ 200D ÷ 0378 ÷",
+    L"÷ 200D × 0308 ÷ 0378 ÷",
+    L"÷ 0378 ÷ 0020 ÷",
+    L"÷ 0378 × 0308 ÷ 0020 ÷",
+    L"÷ 0378 ÷ 000D ÷",
+    L"÷ 0378 × 0308 ÷ 000D ÷",
+    L"÷ 0378 ÷ 000A ÷",
+    L"÷ 0378 × 0308 ÷ 000A ÷",
+    L"÷ 0378 ÷ 0001 ÷",
+    L"÷ 0378 × 0308 ÷ 0001 ÷",
+    L"÷ 0378 × 200C ÷",
+    L"÷ 0378 × 0308 × 200C ÷",
+    L"÷ 0378 ÷ 1F1E6 ÷",
+    L"÷ 0378 × 0308 ÷ 1F1E6 ÷",
+    L"÷ 0378 ÷ 0600 ÷",
+    L"÷ 0378 × 0308 ÷ 0600 ÷",
+    L"÷ 0378 ÷ 1100 ÷",
+    L"÷ 0378 × 0308 ÷ 1100 ÷",
+    L"÷ 0378 ÷ 1160 ÷",
+    L"÷ 0378 × 0308 ÷ 1160 ÷",
+    L"÷ 0378 ÷ 11A8 ÷",
+    L"÷ 0378 × 0308 ÷ 11A8 ÷",
+    L"÷ 0378 ÷ AC00 ÷",
+    L"÷ 0378 × 0308 ÷ AC00 ÷",
+    L"÷ 0378 ÷ AC01 ÷",
+    L"÷ 0378 × 0308 ÷ AC01 ÷",
+    L"÷ 0378 ÷ 0904 ÷",
+    L"÷ 0378 × 0308 ÷ 0904 ÷",
+    L"÷ 0378 ÷ 0D4E ÷",
+    L"÷ 0378 × 0308 ÷ 0D4E ÷",
+    L"÷ 0378 ÷ 0915 ÷",
+    L"÷ 0378 × 0308 ÷ 0915 ÷",
+    L"÷ 0378 ÷ 231A ÷",
+    L"÷ 0378 × 0308 ÷ 231A ÷",
+    L"÷ 0378 × 0300 ÷",
+    L"÷ 0378 × 0308 × 0300 ÷",
+    L"÷ 0378 × 0900 ÷",
+    L"÷ 0378 × 0308 × 0900 ÷",
+    L"÷ 0378 × 094D ÷",
+    L"÷ 0378 × 0308 × 094D ÷",
+    L"÷ 0378 × 200D ÷",
+    L"÷ 0378 × 0308 × 200D ÷",
+    L"÷ 0378 ÷ 0378 ÷",
+    L"÷ 0378 × 0308 ÷ 0378 ÷",
+    L"÷ 000D × 000A ÷ 0061 ÷ 000A ÷ 0308 ÷",
+    L"÷ 0061 × 0308 ÷",
+    L"÷ 0020 × 200D ÷ 0646 ÷",
+    L"÷ 0646 × 200D ÷ 0020 ÷",
+    L"÷ 1100 × 1100 ÷",
+    L"÷ AC00 × 11A8 ÷ 1100 ÷",
+    L"÷ AC01 × 11A8 ÷ 1100 ÷",
+    L"÷ 1F1E6 × 1F1E7 ÷ 1F1E8 ÷ 0062 ÷",
+    L"÷ 0061 ÷ 1F1E6 × 1F1E7 ÷ 1F1E8 ÷ 0062 ÷",
+    L"÷ 0061 ÷ 1F1E6 × 1F1E7 × 200D ÷ 1F1E8 ÷ 0062 ÷",
+    L"÷ 0061 ÷ 1F1E6 × 200D ÷ 1F1E7 × 1F1E8 ÷ 0062 ÷",
+    L"÷ 0061 ÷ 1F1E6 × 1F1E7 ÷ 1F1E8 × 1F1E9 ÷ 0062 ÷",
+    L"÷ 0061 × 200D ÷",
+    L"÷ 0061 × 0308 ÷ 0062 ÷",
+    L"÷ 1F476 × 1F3FF ÷ 1F476 ÷",
+    L"÷ 0061 × 1F3FF ÷ 1F476 ÷",
+    L"÷ 0061 × 1F3FF ÷ 1F476 × 200D × 1F6D1 ÷",
+    L"÷ 1F476 × 1F3FF × 0308 × 200D × 1F476 × 1F3FF ÷",
+    L"÷ 1F6D1 × 200D × 1F6D1 ÷",
+    L"÷ 0061 × 200D ÷ 1F6D1 ÷",
+    L"÷ 2701 × 200D × 2701 ÷",
+    L"÷ 0061 × 200D ÷ 2701 ÷",
+    L"÷ 0915 ÷ 0924 ÷",
+    L"÷ 0915 × 094D ÷ 0061 ÷",
+    L"÷ 0061 × 094D ÷ 0924 ÷",
+    L"÷ 003F × 094D ÷ 0924 ÷",
+    L"÷ 0020 × 0A03 ÷",
+    L"÷ 0020 × 0308 × 0A03 ÷",
+    L"÷ 0020 × 0903 ÷",
+    L"÷ 0020 × 0308 × 0903 ÷",
+    L"÷ 000D ÷ 0308 × 0A03 ÷",
+    L"÷ 000D ÷ 0308 × 0903 ÷",
+    L"÷ 000A ÷ 0308 × 0A03 ÷",
+    L"÷ 000A ÷ 0308 × 0903 ÷",
+    L"÷ 0001 ÷ 0308 × 0A03 ÷",
+    L"÷ 0001 ÷ 0308 × 0903 ÷",
+    L"÷ 200C × 0A03 ÷",
+    L"÷ 200C × 0308 × 0A03 ÷",
+    L"÷ 200C × 0903 ÷",
+    L"÷ 200C × 0308 × 0903 ÷",
+    L"÷ 1F1E6 × 0A03 ÷",
+    L"÷ 1F1E6 × 0308 × 0A03 ÷",
+    L"÷ 1F1E6 × 0903 ÷",
+    L"÷ 1F1E6 × 0308 × 0903 ÷",
+    L"÷ 0600 × 0020 ÷",
+    L"÷ 0600 × 1F1E6 ÷",
+    L"÷ 0600 × 0600 ÷",
+    L"÷ 0600 × 0A03 ÷",
+    L"÷ 0600 × 0308 × 0A03 ÷",
+    L"÷ 0600 × 1100 ÷",
+    L"÷ 0600 × 1160 ÷",
+    L"÷ 0600 × 11A8 ÷",
+    L"÷ 0600 × AC00 ÷",
+    L"÷ 0600 × AC01 ÷",
+    L"÷ 0600 × 0903 ÷",
+    L"÷ 0600 × 0308 × 0903 ÷",
+    L"÷ 0600 × 0904 ÷",
+    L"÷ 0600 × 0D4E ÷",
+    L"÷ 0600 × 0915 ÷",
+    L"÷ 0600 × 231A ÷",
+    L"÷ 0600 × 0378 ÷",
+    L"÷ 0A03 × 0A03 ÷",
+    L"÷ 0A03 × 0308 × 0A03 ÷",
+    L"÷ 0A03 × 0903 ÷",
+    L"÷ 0A03 × 0308 × 0903 ÷",
+    L"÷ 1100 × 0A03 ÷",
+    L"÷ 1100 × 0308 × 0A03 ÷",
+    L"÷ 1100 × 0903 ÷",
+    L"÷ 1100 × 0308 × 0903 ÷",
+    L"÷ 1160 × 0A03 ÷",
+    L"÷ 1160 × 0308 × 0A03 ÷",
+    L"÷ 1160 × 0903 ÷",
+    L"÷ 1160 × 0308 × 0903 ÷",
+    L"÷ 11A8 × 0A03 ÷",
+    L"÷ 11A8 × 0308 × 0A03 ÷",
+    L"÷ 11A8 × 0903 ÷",
+    L"÷ 11A8 × 0308 × 0903 ÷",
+    L"÷ AC00 × 0A03 ÷",
+    L"÷ AC00 × 0308 × 0A03 ÷",
+    L"÷ AC00 × 0903 ÷",
+    L"÷ AC00 × 0308 × 0903 ÷",
+    L"÷ AC01 × 0A03 ÷",
+    L"÷ AC01 × 0308 × 0A03 ÷",
+    L"÷ AC01 × 0903 ÷",
+    L"÷ AC01 × 0308 × 0903 ÷",
+    L"÷ 0903 × 0A03 ÷",
+    L"÷ 0903 × 0308 × 0A03 ÷",
+    L"÷ 0903 × 0903 ÷",
+    L"÷ 0903 × 0308 × 0903 ÷",
+    L"÷ 0904 × 0A03 ÷",
+    L"÷ 0904 × 0308 × 0A03 ÷",
+    L"÷ 0904 × 0903 ÷",
+    L"÷ 0904 × 0308 × 0903 ÷",
+    L"÷ 0D4E × 0020 ÷",
+    L"÷ 0D4E × 1F1E6 ÷",
+    L"÷ 0D4E × 0600 ÷",
+    L"÷ 0D4E × 0A03 ÷",
+    L"÷ 0D4E × 0308 × 0A03 ÷",
+    L"÷ 0D4E × 1100 ÷",
+    L"÷ 0D4E × 1160 ÷",
+    L"÷ 0D4E × 11A8 ÷",
+    L"÷ 0D4E × AC00 ÷",
+    L"÷ 0D4E × AC01 ÷",
+    L"÷ 0D4E × 0903 ÷",
+    L"÷ 0D4E × 0308 × 0903 ÷",
+    L"÷ 0D4E × 0904 ÷",
+    L"÷ 0D4E × 0D4E ÷",
+    L"÷ 0D4E × 0915 ÷",
+    L"÷ 0D4E × 231A ÷",
+    L"÷ 0D4E × 0378 ÷",
+    L"÷ 0915 × 0A03 ÷",
+    L"÷ 0915 × 0308 × 0A03 ÷",
+    L"÷ 0915 × 0903 ÷",
+    L"÷ 0915 × 0308 × 0903 ÷",
+    L"÷ 231A × 0A03 ÷",
+    L"÷ 231A × 0308 × 0A03 ÷",
+    L"÷ 231A × 0903 ÷",
+    L"÷ 231A × 0308 × 0903 ÷",
+    L"÷ 0300 × 0A03 ÷",
+    L"÷ 0300 × 0308 × 0A03 ÷",
+    L"÷ 0300 × 0903 ÷",
+    L"÷ 0300 × 0308 × 0903 ÷",
+    L"÷ 0900 × 0A03 ÷",
+    L"÷ 0900 × 0308 × 0A03 ÷",
+    L"÷ 0900 × 0903 ÷",
+    L"÷ 0900 × 0308 × 0903 ÷",
+    L"÷ 094D × 0A03 ÷",
+    L"÷ 094D × 0308 × 0A03 ÷",
+    L"÷ 094D × 0903 ÷",
+    L"÷ 094D × 0308 × 0903 ÷",
+    L"÷ 200D × 0A03 ÷",
+    L"÷ 200D × 0308 × 0A03 ÷",
+    L"÷ 200D × 0903 ÷",
+    L"÷ 200D × 0308 × 0903 ÷",
+    L"÷ 0378 × 0A03 ÷",
+    L"÷ 0378 × 0308 × 0A03 ÷",
+    L"÷ 0378 × 0903 ÷",
+    L"÷ 0378 × 0308 × 0903 ÷",
+    L"÷ 0061 × 0903 ÷ 0062 ÷",
+    L"÷ 0061 ÷ 0600 × 0062 ÷",
+    L"÷ 0915 × 094D × 0924 ÷",
+    L"÷ 0915 × 094D × 094D × 0924 ÷",
+    L"÷ 0915 × 094D × 200D × 0924 ÷",
+    L"÷ 0915 × 093C × 200D × 094D × 0924 ÷",
+    L"÷ 0915 × 093C × 094D × 200D × 0924 ÷",
+    L"÷ 0915 × 094D × 0924 × 094D × 092F ÷",
+    L"÷ 0915 × 094D × 094D × 0924 ÷",
+};
@@ -0,0 +1,225 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "WexTestClass.h"
+#include "../../inc/consoletaeftemplates.hpp"
+
+#include "../inc/GraphemeClusterIterator.hpp"
+#include "GraphemeBreakTestData.h"
+
+using namespace WEX::Common;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+
+using Segmentation = GraphemeClusterIterator::Segmentation;
+
+class GraphemeClusterIteratorTests
+{
+    TEST_CLASS(GraphemeClusterIteratorTests);
+
+    // Returns the length of each cluster of the text, iterating forwards.
+    static std::vector<size_t> _split(const std::wstring_view text, const Segmentation segmentation = Segmentation::GraphemeClusters)
+    {
+        std::vector<size_t> lengths;
+        for (const auto cluster : GraphemeClusters{ text, segmentation })
+        {
+            lengths.emplace_back(cluster.size());
+        }
+        return lengths;
+    }
+
+    // Returns the length of each cluster of the text, iterating backwards, but in the same order as _split().
+    static std::vector<size_t> _splitBackwards(const std::wstring_view text, const Segmentation segmentation = Segmentation::GraphemeClusters)
+    {
+        std::vector<size_t> lengths;
+        const GraphemeClusters clusters{ text, segmentation };
+        for (auto it = clusters.end(); it != clusters.begin();)
+        {
+            --it;
+            lengths.emplace_back((*it).size());
+        }
+        std::reverse(lengths.begin(), lengths.end());
+        return lengths;
+    }
+
+    static void _verifySplit(const std::wstring_view text, const std::vector<size_t>& expected, const Segmentation segmentation = Segmentation::GraphemeClusters)
+    {
+        VERIFY_IS_TRUE(expected == _split(text, segmentation));
+        VERIFY_IS_TRUE(expected == _splitBackwards(text, segmentation));
+
+        if (segmentation == Segmentation::GraphemeClusters)
+        {
+            size_t offset = 0;
+            for (const auto length : expected)
+            {
+                for (size_t i = 1; i < length; ++i)
+                {
+                    VERIFY_IS_FALSE(GraphemeClusterIterator::IsBoundary(text, offset + i));
+                }
+                offset += length;
+                VERIFY_IS_TRUE(GraphemeClusterIterator::IsBoundary(text, offset));
+            }
+        }
+    }
+
+    TEST_METHOD(SplitsPlainText)
+    {
+        _verifySplit(L"", {});
+        _verifySplit(L"abc", { 1, 1, 1 });
+        // lowercase be, latin small letter m with dot above, hiragana su
+        _verifySplit(L"\x0431\x1E41\x3059", { 1, 1, 1 });
+        // smiling face with sunglasses emoji
+        _verifySplit(L"a\xD83D\xDE0E"
+                     L"b",
+                     { 1, 2, 1 });
+    }
+
+    TEST_METHOD(SplitsUnpairedSurrogates)
+    {
+        // A lone trailing surrogate, a lone leading surrogate followed by a combining mark, and a lone leading surrogate at the end.
+        _verifySplit(L"\xDE0E"
+                     L"a\xD83D\x0301\xD83D\xDE0E\xD83D",
+                     { 1, 1, 1, 1, 2, 1 });
+    }
+
+    TEST_METHOD(JoinsCombiningMarks)
+    {
+        // e + combining acute accent + combining diaeresis
+        _verifySplit(L"e\x0301\x0308"
+                     L"e",
+                     { 3, 1 });
+        // Devanagari ka + vowel sign i (SpacingMark)
+        _verifySplit(L"\x0915\x093F", { 2 });
+        // A combining mark at the start of the text or after a control character is a cluster of its own.
+        _verifySplit(L"\x0301\n\x0301", { 1, 1, 1 });
+    }
+
+    TEST_METHOD(JoinsCarriageReturnLineFeed)
+    {
+        _verifySplit(L"a\r\n\n\r\r\n", { 1, 2, 1, 1, 2 });
+    }
+
+    TEST_METHOD(JoinsHangul)
+    {
+        // Conjoining jamo: L V T, L L V
+        _verifySplit(L"\x1100\x1161\x11A8\x1100\x1100\x1161", { 3, 3 });
+        // Precomposed syllables: GA (LV) + T, GAG (LVT) + T, GAG (LVT) + V
+        _verifySplit(L"\xAC00\x11A8\xAC01\x11A8\xAC01\x1161", { 2, 2, 1, 1 });
+    }
+
+    TEST_METHOD(PairsRegionalIndicators)
+    {
+        // U S D E U
+        _verifySplit(L"\xD83C\xDDFA\xD83C\xDDF8\xD83C\xDDE9\xD83C\xDDEA\xD83C\xDDFA", { 4, 4, 2 });
+        // U a S D
+        _verifySplit(L"\xD83C\xDDFA"
+                     L"a\xD83C\xDDF8\xD83C\xDDE9",
+                     { 2, 1, 4 });
+    }
+
+    TEST_METHOD(JoinsEmojiZwjSequences)
+    {
+        // man ZWJ woman ZWJ girl
+        _verifySplit(L"\xD83D\xDC68\x200D\xD83D\xDC69\x200D\xD83D\xDC67", { 8 });
+        // thumbs up + skin tone modifier
+        _verifySplit(L"\xD83D\xDC4D\xD83C\xDFFD", { 4 });
+        // ZWJ only joins extended pictographics: a ZWJ woman
+        _verifySplit(L"a\x200D\xD83D\xDC69", { 2, 2 });
+    }
+
+    TEST_METHOD(JoinsIndicConjuncts)
+    {
+        // Devanagari ka + virama + ssa
+        _verifySplit(L"\x0915\x094D\x0937", { 3 });
+        // Devanagari ka + nukta + virama + ZWJ + ssa
+        _verifySplit(L"\x0915\x093C\x094D\x200D\x0937", { 5 });
+        // Without a virama the consonants stay apart: ka + nukta + ssa
+        _verifySplit(L"\x0915\x093C\x0937", { 2, 1 });
+    }
+
+    TEST_METHOD(SplitsCodepoints)
+    {
+        _verifySplit(L"e\x0301\r\n\xD83D\xDC68\x200D\xD83D\xDC69\xDE0E", { 1, 1, 1, 1, 2, 1, 2, 1 }, Segmentation::Codepoints);
+    }
+
+    TEST_METHOD(StartsInTheMiddleOfClusters)
+    {
+        const std::wstring_view text{ L"ae\x0301\x0308\xD83D\xDE0E" };
+
+        GraphemeClusterIterator it{ text, 2 };
+        VERIFY_ARE_EQUAL(1u, it.Offset());
+        VERIFY_ARE_EQUAL(text.substr(1, 3), *it);
+        ++it;
+        VERIFY_ARE_EQUAL(4u, it.Offset());
+        VERIFY_ARE_EQUAL(text.substr(4, 2), *it);
+        --it;
+        --it;
+        VERIFY_ARE_EQUAL(0u, it.Offset());
+
+        it = GraphemeClusterIterator{ text, 5, Segmentation::Codepoints };
+        VERIFY_ARE_EQUAL(4u, it.Offset());
+        it = GraphemeClusterIterator{ text, 3, Segmentation::Codepoints };
+        VERIFY_ARE_EQUAL(3u, it.Offset());
+        VERIFY_IS_TRUE((GraphemeClusterIterator{ text, 100 } == GraphemeClusters{ text }.end()));
+    }
+
+    TEST_METHOD(PassesGraphemeBreakTest)
+    {
+        SetVerifyOutput settings(VerifyOutputSettings::LogOnlyFailures);
+
+        for (const auto testCase : s_graphemeBreakTestCases)
+        {
+            Log::Comment(NoThrowString().Format(L"%.*s", gsl::narrow_cast<int>(testCase.size()), testCase.data()));
+
+            // Each case is a list of code points in hex, separated by ÷ (break) or × (no break).
+            std::wstring text;
+            std::vector<size_t> expected;
+            size_t clusterStart = 0;
+            for (size_t pos = 0; pos < testCase.size();)
+            {
+                const auto end = std::min(testCase.find(L' ', pos), testCase.size());
+                const auto token = testCase.substr(pos, end - pos);
+                pos = end + 1;
+
+                if (token == L"÷")
+                {
+                    if (text.size() != clusterStart)
+                    {
+                        expected.emplace_back(text.size() - clusterStart);
+                        clusterStart = text.size();
+                    }
+                }
+                else if (token != L"×")
+                {
+                    const auto codepoint = std::stoul(std::wstring{ token }, nullptr, 16);
+                    if (codepoint > 0xFFFF)
+                    {
+                        text.push_back(gsl::narrow_cast<wchar_t>(0xD7C0 + (codepoint >> 10)));
+                        text.push_back(gsl::narrow_cast<wchar_t>(0xDC00 + (codepoint & 0x3FF)));
+                    }
+                    else
+                    {
+                        text.push_back(gsl::narrow_cast<wchar_t>(codepoint));
+                    }
+                }
+            }
+
+            _verifySplit(text, expected);
+        }
+    }
+
+    TEST_METHOD(CountsColumns)
+    {
+        const std::wstring_view text{ L"ae\x0301\x3059\x3099" };
+        const GraphemeClusters clusters{ text };
+
+        std::vector<til::CoordType> columns;
+        for (auto it = clusters.begin(); it != clusters.end(); ++it)
+        {
+            columns.emplace_back(it.Columns());
+        }
+        VERIFY_IS_TRUE((std::vector<til::CoordType>{ 1, 1, 2 }) == columns);
+        VERIFY_ARE_EQUAL(0, clusters.end().Columns());
+    }
+};
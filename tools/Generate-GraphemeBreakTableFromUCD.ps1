@@ -0,0 +1,158 @@
+# Copyright (c) Microsoft Corporation.
+# Licensed under the MIT license.
+
+#Requires -Version 7
+
+################################################################################
+# This script generates the s_graphemeBreakTable array in
+# src/types/GraphemeClusterIterator.cpp from the Unicode Character Database[1].
+# It merges the three properties that the UAX #29[2] rules look at into one
+# GraphemeBreak value per codepoint:
+#
+# * Grapheme_Cluster_Break from auxiliary/GraphemeBreakProperty.txt
+# * Extended_Pictographic from emoji/emoji-data.txt
+# * Indic_Conjunct_Break (InCB) from DerivedCoreProperties.txt
+#
+# Extended_Pictographic and InCB=Consonant only apply to codepoints that are
+# Grapheme_Cluster_Break=Other, InCB=Linker and InCB=Extend only to those that
+# are Grapheme_Cluster_Break=Extend (except for the ZWJ, which stays a ZWJ).
+#
+# Codepoints that end up as Other aren't emitted. Neither are the Hangul
+# syllables (LV and LVT), which GetBreakProperty() tells apart arithmetically,
+# nor the surrogates, which are never looked up.
+#
+# Invoke as ./Generate-GraphemeBreakTableFromUCD.ps1 | Out-File -Encoding
+#           UTF-8 Temporary.cpp
+# from a directory that contains the three files.
+#
+# [1]: https://www.unicode.org/Public/UCD/latest/ucd/
+# [2]: https://www.unicode.org/reports/tr29/
+
+[Diagnostics.CodeAnalysis.SuppressMessageAttribute('PSAvoidUsingPositionalParameters', '')]
+[CmdletBinding()]
+Param(
+    [string]$GraphemeBreakPropertyPath = "GraphemeBreakProperty.txt",
+    [string]$EmojiDataPath = "emoji-data.txt",
+    [string]$DerivedCorePropertiesPath = "DerivedCoreProperties.txt"
+)
+
+$MaxCodepoint = 0x10FFFF
+
+# Calls $Action with the first and last codepoint and the fields of each
+# entry in a UCD file, like "0915..0939 ; InCB; Consonant # Lo [37] ...".
+Function Read-UCDFile([string]$Path, [scriptblock]$Action) {
+    ForEach ($line in [System.IO.File]::ReadLines((Resolve-Path $Path))) {
+        $data = ($line -split "#", 2)[0].Trim()
+        If ($data.Length -eq 0) {
+            Continue
+        }
+
+        $fields = $data -split ";" | ForEach-Object { $_.Trim() }
+        $range = $fields[0] -split "\.\."
+        $first = [Convert]::ToInt32($range[0], 16)
+        $last = [Convert]::ToInt32($range[-1], 16)
+        & $Action $first $last $fields
+    }
+}
+
+# Returns the Unicode version from the first line of a UCD file, like "# GraphemeBreakProperty-16.0.0.txt".
+Function Get-UCDVersion([string]$Path) {
+    $header = Get-Content $Path -TotalCount 1
+    If ($header -match "-(\d+\.\d+\.\d+)\.txt") {
+        Return $Matches[1]
+    }
+    Return "(unknown)"
+}
+
+$GraphemeBreakNames = @{
+    "Control"            = "Control";
+    "CR"                 = "CR";
+    "LF"                 = "LF";
+    "Extend"             = "Extend";
+    "ZWJ"                = "ZWJ";
+    "Regional_Indicator" = "RegionalIndicator";
+    "Prepend"            = "Prepend";
+    "SpacingMark"        = "SpacingMark";
+    "L"                  = "L";
+    "V"                  = "V";
+    "T"                  = "T";
+    "LV"                 = "LV";
+    "LVT"                = "LVT";
+}
+
+$values = [string[]]::new($MaxCodepoint + 1)
+
+Read-UCDFile $GraphemeBreakPropertyPath {
+    Param($first, $last, $fields)
+    $value = $GraphemeBreakNames[$fields[1]]
+    If ($null -eq $value) {
+        Throw "Unknown Grapheme_Cluster_Break value: $($fields[1])"
+    }
+    For ($cp = $first; $cp -le $last; $cp++) {
+        $values[$cp] = $value
+    }
+}
+
+Read-UCDFile $EmojiDataPath {
+    Param($first, $last, $fields)
+    If ($fields[1] -ne "Extended_Pictographic") {
+        Return
+    }
+    For ($cp = $first; $cp -le $last; $cp++) {
+        If ($null -eq $values[$cp]) {
+            $values[$cp] = "ExtendedPictographic"
+        }
+    }
+}
+
+Read-UCDFile $DerivedCorePropertiesPath {
+    Param($first, $last, $fields)
+    If ($fields[1] -ne "InCB") {
+        Return
+    }
+    For ($cp = $first; $cp -le $last; $cp++) {
+        Switch ($fields[2]) {
+            "Consonant" {
+                If ($null -eq $values[$cp]) {
+                    $values[$cp] = "ConjunctConsonant"
+                }
+            }
+            "Linker" {
+                If ($values[$cp] -eq "Extend") {
+                    $values[$cp] = "ConjunctLinker"
+                }
+            }
+            "Extend" {
+                If ($values[$cp] -eq "Extend") {
+                    $values[$cp] = "ConjunctExtend"
+                }
+            }
+        }
+    }
+}
+
+$ranges = [System.Collections.Generic.List[object]]::new(1024)
+$covered = 0
+For ($cp = 0; $cp -le $MaxCodepoint; $cp++) {
+    $value = $values[$cp]
+    If ($null -eq $value -or $value -eq "LV" -or $value -eq "LVT" -or ($cp -ge 0xD800 -and $cp -le 0xDFFF)) {
+        Continue
+    }
+
+    $covered++
+    $last = $ranges.Count -gt 0 ? $ranges[$ranges.Count - 1] : $null
+    If ($null -ne $last -and $last.End -eq $cp - 1 -and $last.Value -eq $value) {
+        $last.End = $cp
+    } Else {
+        $ranges.Add([pscustomobject]@{ Start = $cp; End = $cp; Value = $value })
+    }
+}
+
+# Emit Code
+"    // Generated by {0} from Unicode {1}." -f $MyInvocation.MyCommand.Name, (Get-UCDVersion $GraphemeBreakPropertyPath)
+"    // {0} (0x{0:X}) codepoints covered." -f $covered
+"    static constexpr std::array<GraphemeBreakRange, {0}> s_graphemeBreakTable{{" -f $ranges.Count
+ForEach ($range in $ranges) {
+"        GraphemeBreakRange{{ 0x{0:x}, 0x{1:x}, GraphemeBreak::{2} }}," -f $range.Start, $range.End, $range.Value
+}
+"    };"